@@ -0,0 +1,149 @@
+package com.harmony.agent.bench;
+
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.List;
+import java.util.Random;
+import java.util.stream.Stream;
+
+/**
+ * 基准测试输入数据（固定种子，结果可复现）
+ */
+public final class BenchmarkData {
+
+    public static final long SEED = 0x5EED_2024L;
+
+    private static final String[] RISKY_STATEMENTS = {
+        "    strcpy(buf, input);",
+        "    sprintf(buf, \"%s-%d\", input, n);",
+        "    gets(buf);",
+        "    char *p = malloc(n);",
+        "    system(input);",
+        "    memcpy(buf, input, n);",
+        "    free(p);"
+    };
+
+    private static final String[] SAFE_STATEMENTS = {
+        "    n = n * 31 + i;",
+        "    if (n > limit) { n = limit; }",
+        "    for (int j = 0; j < n && j < 16; j++) { total += table[j]; }",
+        "    total ^= (n << 3);",
+        "    snprintf(buf, sizeof(buf), \"%d\", n);",
+        "    /* keep the compiler quiet */"
+    };
+
+    private BenchmarkData() {
+    }
+
+    /**
+     * 生成约 lines 行的 C 源码，函数长度 20~60 行，约 5% 的语句是风险调用
+     */
+    public static String cSource(int lines, long seed) {
+        Random random = new Random(seed);
+        StringBuilder source = new StringBuilder(lines * 32);
+        source.append("#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n\n");
+        source.append("static int table[16];\n\n");
+
+        int written = 6;
+        int function = 0;
+        while (written < lines) {
+            int bodyLines = 20 + random.nextInt(41);
+            source.append("int func_").append(function++).append("(const char *input, int n, int limit) {\n");
+            source.append("    char buf[64];\n    int total = 0;\n    int i = 0;\n");
+            for (int i = 0; i < bodyLines; i++) {
+                String[] pool = random.nextInt(100) < 5 ? RISKY_STATEMENTS : SAFE_STATEMENTS;
+                source.append(pool[random.nextInt(pool.length)]).append('\n');
+            }
+            source.append("    return total;\n}\n\n");
+            written += bodyLines + 7;
+        }
+        return source.toString();
+    }
+
+    /**
+     * 生成 count 个问题，均匀分布在 files 个文件上
+     */
+    public static List<SecurityIssue> issues(int count, int files, long seed) {
+        Random random = new Random(seed);
+        IssueSeverity[] severities = IssueSeverity.values();
+        IssueCategory[] categories = {
+            IssueCategory.BUFFER_OVERFLOW, IssueCategory.MEMORY_LEAK, IssueCategory.USE_AFTER_FREE,
+            IssueCategory.NULL_DEREFERENCE, IssueCategory.RACE_CONDITION
+        };
+
+        List<SecurityIssue> issues = new ArrayList<>(count);
+        for (int i = 0; i < count; i++) {
+            String file = "/bench/src/module_" + (i % 50) + "/file_" + (i % files) + ".c";
+            int line = 1 + random.nextInt(2000);
+            issues.add(new SecurityIssue.Builder()
+                .id("BENCH-" + i)
+                .title("Synthetic issue " + i)
+                .description("Synthetic issue generated for benchmarking")
+                .severity(severities[random.nextInt(severities.length)])
+                .category(categories[random.nextInt(categories.length)])
+                .location(new CodeLocation(file, line, 0, "strcpy(buf, input);"))
+                .analyzer(random.nextBoolean() ? "clang-tidy" : "semgrep")
+                .build());
+        }
+        return issues;
+    }
+
+    /**
+     * 写出包含 entries 条记录的 compile_commands.json，返回文件路径
+     */
+    public static Path writeCompileCommands(Path dir, int entries) throws IOException {
+        StringBuilder json = new StringBuilder(entries * 256).append("[\n");
+        for (int i = 0; i < entries; i++) {
+            String module = "module_" + (i % 50);
+            json.append("  {\n")
+                .append("    \"directory\": \"").append(dir.resolve("build")).append("\",\n")
+                .append("    \"command\": \"/usr/bin/cc -DBENCH=1 -DMODULE=").append(i % 50)
+                .append(" -I").append(dir.resolve("include")).append(" -I").append(dir.resolve("src/" + module))
+                .append(" -std=c11 -O2 -o CMakeFiles/").append(module).append(".dir/file_").append(i)
+                .append(".c.o -c ").append(dir.resolve("src/" + module + "/file_" + i + ".c")).append("\",\n")
+                .append("    \"file\": \"").append(dir.resolve("src/" + module + "/file_" + i + ".c")).append("\"\n")
+                .append("  }").append(i + 1 < entries ? ",\n" : "\n");
+        }
+        json.append("]\n");
+
+        Path file = dir.resolve("compile_commands.json");
+        Files.writeString(file, json);
+        return file;
+    }
+
+    /**
+     * 将 user.home 指向临时目录，避免基准测试写入真实的 ~/.harmony_agent 缓存
+     * 必须在首次使用 PersistentCacheManager 之前调用（其缓存目录在类初始化时确定）
+     */
+    public static Path isolateUserHome() throws IOException {
+        Path home = Files.createTempDirectory("harmony-bench-home");
+        System.setProperty("user.home", home.toString());
+        return home;
+    }
+
+    public static void deleteRecursively(Path root) {
+        if (root == null || !Files.exists(root)) {
+            return;
+        }
+        try (Stream<Path> paths = Files.walk(root)) {
+            paths.sorted(Comparator.reverseOrder()).forEach(path -> {
+                try {
+                    Files.deleteIfExists(path);
+                } catch (IOException e) {
+                    throw new UncheckedIOException(e);
+                }
+            });
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+package com.harmony.agent.bench;
+
+import org.openjdk.jmh.results.format.ResultFormatType;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.options.ChainedOptionsBuilder;
+import org.openjdk.jmh.runner.options.CommandLineOptions;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+/**
+ * 基准测试入口
+ *
+ * 接受所有标准 JMH 命令行参数；未指定时默认以 JSON 格式输出到 jmh-result.json，
+ * 便于按版本归档和对比回归。
+ *
+ * 示例：
+ *   java -jar target/benchmarks.jar                       运行全部
+ *   java -jar target/benchmarks.jar RegexAnalyzer -p lines=2000
+ *   java -jar target/benchmarks.jar -rff results/1.0.0.json
+ */
+public class BenchmarkMain {
+
+    public static final String DEFAULT_RESULT_FILE = "jmh-result.json";
+
+    public static void main(String[] args) throws Exception {
+        CommandLineOptions cli = new CommandLineOptions(args);
+        if (cli.shouldHelp() || cli.shouldList() || cli.shouldListProfilers()
+                || cli.shouldListResultFormats() || cli.shouldListWithParams()) {
+            // 帮助与列表类参数交给 JMH 自带的处理
+            org.openjdk.jmh.Main.main(args);
+            return;
+        }
+
+        ChainedOptionsBuilder builder = new OptionsBuilder().parent(cli);
+        if (!cli.getResultFormat().hasValue()) {
+            builder.resultFormat(ResultFormatType.JSON);
+        }
+        if (!cli.getResult().hasValue()) {
+            builder.result(DEFAULT_RESULT_FILE);
+        }
+        new Runner(builder.build()).run();
+    }
+}
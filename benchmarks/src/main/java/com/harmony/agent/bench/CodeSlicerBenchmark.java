@@ -0,0 +1,68 @@
+package com.harmony.agent.bench;
+
+import com.harmony.agent.core.ai.CodeSlicer;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * CodeSlicer.getContextSlice：文件内容已缓存（warm）与每次新建切片器（cold，含读盘）
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class CodeSlicerBenchmark {
+
+    @Param({"500", "5000", "50000"})
+    public int lines;
+
+    private Path dir;
+    private Path file;
+    private CodeSlicer warmSlicer;
+    private int[] targetLines;
+    private int cursor;
+
+    @Setup(Level.Trial)
+    public void setUp() throws Exception {
+        dir = Files.createTempDirectory("bench-slicer");
+        file = dir.resolve("input.c");
+        String source = BenchmarkData.cSource(lines, BenchmarkData.SEED);
+        Files.writeString(file, source);
+
+        int actualLines = (int) source.lines().count();
+        Random random = new Random(BenchmarkData.SEED);
+        targetLines = new int[1024];
+        for (int i = 0; i < targetLines.length; i++) {
+            targetLines[i] = 1 + random.nextInt(actualLines);
+        }
+
+        warmSlicer = new CodeSlicer();
+        warmSlicer.getContextSlice(file, 1);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        BenchmarkData.deleteRecursively(dir);
+    }
+
+    private int nextLine() {
+        cursor = (cursor + 1) & (targetLines.length - 1);
+        return targetLines[cursor];
+    }
+
+    @Benchmark
+    public String sliceWarm() {
+        return warmSlicer.getContextSlice(file, nextLine());
+    }
+
+    @Benchmark
+    public String sliceCold() {
+        return new CodeSlicer().getContextSlice(file, nextLine());
+    }
+}
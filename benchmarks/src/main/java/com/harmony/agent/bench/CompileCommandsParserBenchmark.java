@@ -0,0 +1,43 @@
+package com.harmony.agent.bench;
+
+import com.harmony.agent.core.parser.CompileCommandsParser;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * CompileCommandsParser 加载 compile_commands.json 并建立按源文件的索引
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class CompileCommandsParserBenchmark {
+
+    @Param({"100", "1000", "10000"})
+    public int entries;
+
+    private Path dir;
+    private Path compileCommands;
+
+    @Setup(Level.Trial)
+    public void setUp() throws Exception {
+        dir = Files.createTempDirectory("bench-compdb");
+        compileCommands = BenchmarkData.writeCompileCommands(dir, entries);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        BenchmarkData.deleteRecursively(dir);
+    }
+
+    @Benchmark
+    public int load() throws Exception {
+        CompileCommandsParser parser = new CompileCommandsParser(compileCommands);
+        return parser.getCommandsBySourceFile().size();
+    }
+}
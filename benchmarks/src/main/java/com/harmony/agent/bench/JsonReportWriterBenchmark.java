@@ -0,0 +1,68 @@
+package com.harmony.agent.bench;
+
+import com.harmony.agent.core.model.ScanResult;
+import com.harmony.agent.core.report.JsonReportWriter;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.time.Instant;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * JsonReportWriter 写出与读回（随问题数量变化）
+ * ScanResult 含 java.time 字段，Gson 反射需要打开 java.time 包
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(value = 1, jvmArgsAppend = "--add-opens=java.base/java.time=ALL-UNNAMED")
+@State(Scope.Benchmark)
+public class JsonReportWriterBenchmark {
+
+    @Param({"100", "1000", "10000"})
+    public int issueCount;
+
+    private Path dir;
+    private Path writeTarget;
+    private Path readSource;
+    private JsonReportWriter writer;
+    private ScanResult result;
+
+    @Setup(Level.Trial)
+    public void setUp() throws Exception {
+        dir = Files.createTempDirectory("bench-json");
+        writeTarget = dir.resolve("write.json");
+        readSource = dir.resolve("read.json");
+        writer = new JsonReportWriter();
+
+        Instant start = Instant.parse("2024-01-01T00:00:00Z");
+        result = new ScanResult.Builder()
+            .sourcePath("/bench/src")
+            .startTime(start)
+            .endTime(start.plusSeconds(42))
+            .addIssues(BenchmarkData.issues(issueCount, Math.max(1, issueCount / 20), BenchmarkData.SEED))
+            .addAnalyzer("clang-tidy")
+            .addAnalyzer("semgrep")
+            .addStatistic("total_files", issueCount / 20)
+            .build();
+        writer.write(result, readSource);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        BenchmarkData.deleteRecursively(dir);
+    }
+
+    @Benchmark
+    public Path write() throws Exception {
+        writer.write(result, writeTarget);
+        return writeTarget;
+    }
+
+    @Benchmark
+    public ScanResult read() throws Exception {
+        return writer.read(readSource);
+    }
+}
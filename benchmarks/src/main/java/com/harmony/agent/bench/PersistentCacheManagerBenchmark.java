@@ -0,0 +1,67 @@
+package com.harmony.agent.bench;
+
+import com.harmony.agent.core.ai.PersistentCacheManager;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * PersistentCacheManager get/put
+ *
+ * keyCount=100 时工作集常驻 L1；keyCount=5000 超过 L1 容量（500），
+ * 顺序轮询使几乎每次 get 都落到 L2 磁盘读取并回填 L1。
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class PersistentCacheManagerBenchmark {
+
+    @Param({"100", "5000"})
+    public int keyCount;
+
+    @Param({"256", "16384"})
+    public int valueBytes;
+
+    private Path home;
+    private PersistentCacheManager cache;
+    private String[] keys;
+    private String value;
+    private int cursor;
+
+    @Setup(Level.Trial)
+    public void setUp() throws Exception {
+        home = BenchmarkData.isolateUserHome();
+        cache = new PersistentCacheManager("bench", true);
+
+        value = "x".repeat(valueBytes);
+        keys = new String[keyCount];
+        for (int i = 0; i < keyCount; i++) {
+            keys[i] = "bench-key-" + i;
+            cache.put(keys[i], value);
+        }
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        BenchmarkData.deleteRecursively(home);
+    }
+
+    private String nextKey() {
+        cursor = cursor + 1 == keys.length ? 0 : cursor + 1;
+        return keys[cursor];
+    }
+
+    @Benchmark
+    public String get() {
+        return cache.get(nextKey());
+    }
+
+    @Benchmark
+    public void put() {
+        cache.put(nextKey(), value);
+    }
+}
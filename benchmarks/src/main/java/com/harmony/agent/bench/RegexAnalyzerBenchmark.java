@@ -0,0 +1,47 @@
+package com.harmony.agent.bench;
+
+import com.harmony.agent.core.analyzer.RegexAnalyzer;
+import com.harmony.agent.core.model.SecurityIssue;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * RegexAnalyzer.analyze 单文件耗时（随文件行数变化）
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class RegexAnalyzerBenchmark {
+
+    @Param({"200", "2000", "20000"})
+    public int lines;
+
+    private Path dir;
+    private Path file;
+    private RegexAnalyzer analyzer;
+
+    @Setup(Level.Trial)
+    public void setUp() throws Exception {
+        dir = Files.createTempDirectory("bench-regex");
+        file = dir.resolve("input.c");
+        Files.writeString(file, BenchmarkData.cSource(lines, BenchmarkData.SEED));
+        analyzer = new RegexAnalyzer();
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        BenchmarkData.deleteRecursively(dir);
+    }
+
+    @Benchmark
+    public List<SecurityIssue> analyze() throws Exception {
+        return analyzer.analyze(file);
+    }
+}
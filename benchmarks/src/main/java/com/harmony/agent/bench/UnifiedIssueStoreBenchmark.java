@@ -0,0 +1,59 @@
+package com.harmony.agent.bench;
+
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.store.UnifiedIssueStore;
+import org.openjdk.jmh.annotations.*;
+
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * UnifiedIssueStore 批量写入与查询
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class UnifiedIssueStoreBenchmark {
+
+    @Param({"1000", "10000", "100000"})
+    public int issueCount;
+
+    private List<SecurityIssue> issues;
+    private UnifiedIssueStore populated;
+    private String sampleFile;
+
+    @Setup(Level.Trial)
+    public void setUp() {
+        issues = BenchmarkData.issues(issueCount, Math.max(1, issueCount / 20), BenchmarkData.SEED);
+        populated = new UnifiedIssueStore();
+        populated.addIssues(issues);
+        sampleFile = issues.get(issues.size() / 2).getLocation().getFilePath();
+    }
+
+    @Benchmark
+    public UnifiedIssueStore ingest() {
+        UnifiedIssueStore store = new UnifiedIssueStore();
+        store.addIssues(issues);
+        return store;
+    }
+
+    @Benchmark
+    public List<SecurityIssue> queryByFile() {
+        return populated.getIssuesByFile(sampleFile);
+    }
+
+    @Benchmark
+    public List<SecurityIssue> queryBySeverity() {
+        return populated.getIssuesBySeverity(IssueSeverity.HIGH);
+    }
+
+    @Benchmark
+    public Map<String, List<SecurityIssue>> fileIndex() {
+        return populated.getIssuesByFileIndex();
+    }
+}
@@ -0,0 +1,83 @@
+package com.harmony.agent.llm.provider;
+
+import com.harmony.agent.bench.BenchmarkData;
+import com.harmony.agent.llm.model.LLMRequest;
+import com.harmony.agent.llm.model.LLMResponse;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * CachedLLMProvider.generateCacheKey（每次 LLM 调用前都会计算）
+ * 与被测类同包以访问包级方法
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class CachedLLMProviderBenchmark {
+
+    @Param({"1000", "20000", "100000"})
+    public int promptChars;
+
+    private Path home;
+    private CachedLLMProvider provider;
+    private LLMRequest request;
+
+    @Setup(Level.Trial)
+    public void setUp() throws Exception {
+        home = BenchmarkData.isolateUserHome();
+        provider = new CachedLLMProvider(new NoopProvider(), "bench_llm");
+
+        String code = BenchmarkData.cSource(promptChars / 30 + 1, BenchmarkData.SEED);
+        request = LLMRequest.builder()
+            .model("gpt-4o-mini")
+            .temperature(0.2)
+            .addSystemMessage("You are a security reviewer. Answer in JSON.")
+            .addUserMessage(code.substring(0, Math.min(code.length(), promptChars)))
+            .build();
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        BenchmarkData.deleteRecursively(home);
+    }
+
+    @Benchmark
+    public String generateCacheKey() {
+        return provider.generateCacheKey(request);
+    }
+
+    /**
+     * 不发出请求的占位 provider
+     */
+    private static class NoopProvider implements LLMProvider {
+        @Override
+        public LLMResponse sendRequest(LLMRequest request) {
+            throw new UnsupportedOperationException("benchmark provider");
+        }
+
+        @Override
+        public String getProviderName() {
+            return "noop";
+        }
+
+        @Override
+        public boolean isAvailable() {
+            return true;
+        }
+
+        @Override
+        public String[] getAvailableModels() {
+            return new String[] {"gpt-4o-mini"};
+        }
+
+        @Override
+        public boolean supportsModel(String model) {
+            return true;
+        }
+    }
+}
@@ -1,9 +1,13 @@
 package com.harmony.agent;
 
 import com.harmony.agent.cli.HarmonyAgentCLI;
+import com.harmony.agent.core.metrics.ProfileRecorder;
+import com.harmony.agent.server.RemoteClient;
 import org.fusesource.jansi.AnsiConsole;
 import picocli.CommandLine;
 
+import java.nio.file.Path;
+
 /**
  * HarmonySafeAgent - OpenHarmony Security Analysis Tool
  *
@@ -12,6 +16,21 @@ import picocli.CommandLine;
 public class Main {
 
     public static void main(String[] args) {
+        // Thin client mode: forward to a running `serve` instance without initializing the CLI.
+        // The flag may follow the subcommand; commands the server does not expose are rejected there.
+        int remote = RemoteClient.remoteFlagIndex(args);
+        if (remote >= 0) {
+            String flag = args[remote];
+            String url = flag.contains("=")
+                ? flag.substring(flag.indexOf('=') + 1)
+                : RemoteClient.defaultServerUrl();
+            String[] rest = new String[args.length - 1];
+            System.arraycopy(args, 0, rest, 0, remote);
+            System.arraycopy(args, remote + 1, rest, remote, args.length - remote - 1);
+            int exitCode = new RemoteClient(url).run(rest, System.out, System.err);
+            System.exit(exitCode);
+        }
+
         // Install ANSI support for Windows
         AnsiConsole.systemInstall();
 
@@ -32,6 +51,12 @@ public class Main {
 
             // Execute
             int exitCode = cmd.execute(args);
+
+            // Flush the --profile recording before exiting
+            Path profile = ProfileRecorder.stop();
+            if (profile != null) {
+                System.err.println("JFR recording written: " + profile);
+            }
             System.exit(exitCode);
 
         } catch (Exception e) {
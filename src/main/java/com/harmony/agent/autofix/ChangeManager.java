@@ -1,5 +1,6 @@
 package com.harmony.agent.autofix;
 
+import com.harmony.agent.core.parser.SourceModelCache;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -89,8 +90,11 @@ public class ChangeManager {
             lines.add(startLine - 1 + i, newLines[i]);
         }
 
-        // Write back to file
-        Files.write(filePath, lines);
+        // Write back to file (same bytes as Files.write(path, lines)) and refresh the shared
+        // structural model incrementally, so slicing/scoring after the fix only relexes the edit
+        String newContent = lines.isEmpty() ? "" : String.join(System.lineSeparator(), lines) + System.lineSeparator();
+        Files.writeString(filePath, newContent);
+        SourceModelCache.global().update(filePath, newContent);
 
         // Create applied change record
         String changeId = generateChangeId();
@@ -143,6 +147,7 @@ public class ChangeManager {
 
         // Restore original content
         Files.writeString(filePath, lastChange.getOriginalContent());
+        SourceModelCache.global().update(filePath, lastChange.getOriginalContent());
 
         logger.info("Rolled back change: {}", lastChange.getSummary());
 
@@ -2,7 +2,7 @@ package com.harmony.agent.autofix;
 
 import com.harmony.agent.core.analyzer.AnalyzerException;
 import com.harmony.agent.core.analyzer.RustAnalyzer;
-import com.harmony.agent.core.analyzer.SemgrepAnalyzer;
+import com.harmony.agent.core.analyzer.StructuralAnalyzer;
 import com.harmony.agent.core.compile.CompileCommandsParser;
 import com.harmony.agent.core.model.IssueCategory;
 import com.harmony.agent.core.model.ProjectType;
@@ -26,7 +26,7 @@ import java.util.List;
  * This is NOT an LLM role - it's a tool executor
  *
  * Supports:
- * - C/C++ projects: Clang/GCC compilation + Semgrep re-analysis
+ * - C/C++ projects: Clang/GCC compilation + in-JVM rule-pack re-analysis
  * - Java projects: Maven compilation
  *
  * Responsibilities:
@@ -45,7 +45,7 @@ public class CodeValidator {
     private final File workingDirectory;
     private final ProjectType projectType;
     private final CompileCommandsParser compileCommandsParser;
-    private final SemgrepAnalyzer semgrepAnalyzer;  // For C/C++ re-analysis
+    private final StructuralAnalyzer structuralAnalyzer;  // For C/C++ re-analysis (no Semgrep process)
     private final RustAnalyzer rustAnalyzer;  // For Rust re-analysis
 
     public CodeValidator(ToolExecutor toolExecutor, File workingDirectory) {
@@ -53,7 +53,7 @@ public class CodeValidator {
         this.workingDirectory = workingDirectory;
         this.projectType = ProjectType.detectFromDirectory(workingDirectory);
         this.compileCommandsParser = new CompileCommandsParser(workingDirectory);
-        this.semgrepAnalyzer = new SemgrepAnalyzer();  // Initialize Semgrep analyzer
+        this.structuralAnalyzer = new StructuralAnalyzer();  // Bundled rule packs, matched in-process
         this.rustAnalyzer = new RustAnalyzer();  // Initialize Rust analyzer
 
         logger.info("Detected project type: {}", projectType.getDisplayName());
@@ -64,11 +64,11 @@ public class CodeValidator {
                 logger.warn("compile_commands.json not found - C/C++ validation may fail");
             }
 
-            // Check if Semgrep is available for re-analysis
-            if (!semgrepAnalyzer.isAvailable()) {
-                logger.warn("Semgrep not available - C/C++ re-analysis will be skipped");
+            // Check if the bundled rule packs loaded for re-analysis
+            if (!structuralAnalyzer.isAvailable()) {
+                logger.warn("Rule packs not available - C/C++ re-analysis will be skipped");
             } else {
-                logger.info("Semgrep available for re-analysis: {}", semgrepAnalyzer.getVersion());
+                logger.info("Rule packs available for re-analysis: {}", structuralAnalyzer.getVersion());
             }
         }
 
@@ -120,7 +120,7 @@ public class CodeValidator {
      * Validate C/C++ code
      * 1. Get compile command from compile_commands.json
      * 2. Run Clang/GCC compilation
-     * 3. Re-run Semgrep analyzer to verify issue is fixed
+     * 3. Re-run the bundled rule packs in-process to verify issue is fixed
      */
     private ValidationResult validateCppCode(Path filePath, String newCode, SecurityIssue originalIssue) {
         Path backupFile = null;
@@ -184,28 +184,28 @@ public class CodeValidator {
                 );
             }
 
-            // Step 5: Re-run Semgrep analyzer (if original issue provided)
+            // Step 5: Re-run the rule packs (if original issue provided)
             if (originalIssue != null) {
-                logger.info("Re-running Semgrep analysis to verify issue is fixed...");
+                logger.info("Re-running rule-pack analysis to verify issue is fixed...");
 
-                if (!semgrepAnalyzer.isAvailable()) {
-                    logger.warn("Semgrep not available - skipping re-analysis");
+                if (!structuralAnalyzer.isAvailable()) {
+                    logger.warn("Rule packs not available - skipping re-analysis");
                     return ValidationResult.pass(
-                        "Compilation passed, but re-analysis skipped (Semgrep not available)",
+                        "Compilation passed, but re-analysis skipped (rule packs not available)",
                         null
                     );
                 }
 
                 try {
-                    // Re-analyze the file with Semgrep
-                    List<SecurityIssue> newIssues = semgrepAnalyzer.analyze(filePath);
-                    logger.info("Semgrep re-analysis found {} issues", newIssues.size());
+                    // Re-analyze the file in-process (no Semgrep/Python startup)
+                    List<SecurityIssue> newIssues = structuralAnalyzer.analyze(filePath);
+                    logger.info("Rule-pack re-analysis found {} issues", newIssues.size());
 
                     // Check if the original issue still exists
                     if (stillContainsIssue(newIssues, originalIssue)) {
                         logger.warn("Original issue still detected after fix!");
                         return ValidationResult.fail(
-                            "Validation FAILED: Original issue still detected by Semgrep",
+                            "Validation FAILED: Original issue still detected by rule packs",
                             List.of(
                                 "Issue: " + originalIssue.getTitle(),
                                 "Location: " + originalIssue.getLocation(),
@@ -218,7 +218,7 @@ public class CodeValidator {
                     logger.info("✓ Original issue no longer detected - fix verified!");
 
                 } catch (AnalyzerException e) {
-                    logger.warn("Semgrep re-analysis failed: {}", e.getMessage());
+                    logger.warn("Rule-pack re-analysis failed: {}", e.getMessage());
                     return ValidationResult.pass(
                         "Compilation passed, but re-analysis failed: " + e.getMessage(),
                         null
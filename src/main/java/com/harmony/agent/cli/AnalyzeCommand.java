@@ -6,6 +6,9 @@ import com.harmony.agent.autofix.AutoFixOrchestrator;
 import com.harmony.agent.autofix.ChangeManager;
 import com.harmony.agent.autofix.CodeValidator;
 import com.harmony.agent.core.AnalysisEngine;
+import com.harmony.agent.core.analyzer.StructuralAnalyzer;
+import com.harmony.agent.core.memory.HeapBudget;
+import com.harmony.agent.core.metrics.AnalysisMetrics;
 import com.harmony.agent.core.model.IssueCategory;
 import com.harmony.agent.core.model.IssueSeverity;
 import com.harmony.agent.core.model.ScanResult;
@@ -79,6 +82,26 @@ public class AnalyzeCommand implements Callable<Integer> {
     )
     private String compileCommandsPath;
 
+    @Option(
+        names = {"--trace"},
+        paramLabel = "FILE",
+        description = "Write per-issue lifecycle spans as Chrome trace-event JSON (open in chrome://tracing or Perfetto)"
+    )
+    private String tracePath;
+
+    @Option(
+        names = {"--heap-budget"},
+        paramLabel = "SIZE",
+        description = "Size caches/buffers from this heap budget and spill intermediate results to disk (e.g. 2g, 512m, auto)"
+    )
+    private String heapBudget;
+
+    @Option(
+        names = {"--mixed"},
+        description = "Mixed-language monorepo: detect C/C++ and Rust per subtree and scan both in one parallel pass"
+    )
+    private boolean mixedLanguages;
+
     @Override
     public Integer call() {
         ConsolePrinter printer = parent.getPrinter();
@@ -122,6 +145,16 @@ public class AnalyzeCommand implements Callable<Integer> {
                 }
             }
 
+            HeapBudget budget = HeapBudget.UNLIMITED;
+            if (heapBudget != null) {
+                try {
+                    budget = HeapBudget.parse(heapBudget);
+                } catch (IllegalArgumentException e) {
+                    printer.error(e.getMessage());
+                    return 1;
+                }
+            }
+
             // Get configuration
             AppConfig config = configManager.getConfig();
 
@@ -145,6 +178,12 @@ public class AnalyzeCommand implements Callable<Integer> {
             if (compileCommandsPath != null) {
                 printer.info("Compile Commands: " + compileCommandsPath);
             }
+            if (budget.isLimited()) {
+                printer.info("Heap Budget: " + budget);
+            }
+            if (mixedLanguages) {
+                printer.info("Languages: mixed (C/C++ + Rust, per subtree)");
+            }
 
             printer.blank();
 
@@ -175,6 +214,11 @@ public class AnalyzeCommand implements Callable<Integer> {
                 );
             }
             AnalysisEngine engine = new AnalysisEngine(sourcePath, analysisConfig);
+            if (tracePath != null) {
+                engine.setTracePath(Paths.get(tracePath));
+            }
+            engine.setHeapBudget(budget);
+            engine.setMixedLanguages(mixedLanguages);
 
             try {
                 // Show available analyzers
@@ -186,7 +230,7 @@ public class AnalyzeCommand implements Callable<Integer> {
 
                 // Show note about external analyzers
                 boolean hasExternalAnalyzer = analyzerNames.stream()
-                    .anyMatch(name -> !name.equals("RegexAnalyzer"));
+                    .anyMatch(name -> !name.equals("RegexAnalyzer") && !name.equals(StructuralAnalyzer.NAME));
 
                 if (!hasExternalAnalyzer) {
                     printer.warning("Using built-in analyzer only");
@@ -266,6 +310,18 @@ public class AnalyzeCommand implements Callable<Integer> {
                 printer.keyValue("  Analysis Time", String.format("%.2f seconds", result.getDuration().toMillis() / 1000.0));
                 printer.keyValue("  Files Analyzed", String.valueOf(fileCount));
                 printer.keyValue("  Analyzers Used", String.join(", ", result.getAnalyzersUsed()));
+                String phaseSummary = AnalysisMetrics.formatPhaseSummary(result.getStatistics());
+                if (!phaseSummary.isEmpty()) {
+                    printer.keyValue("  Phases", phaseSummary);
+                }
+                String heapSummary = AnalysisMetrics.formatHeapSummary(result.getStatistics());
+                if (!heapSummary.isEmpty()) {
+                    printer.keyValue("  Peak Heap", heapSummary);
+                }
+                String aiSummary = AnalysisMetrics.formatAiSummary(result.getStatistics());
+                if (aiSummary != null) {
+                    printer.keyValue("  AI", aiSummary);
+                }
                 printer.blank();
 
                 // Success message
@@ -284,6 +340,10 @@ public class AnalyzeCommand implements Callable<Integer> {
                     printer.info("Use -o/--output option to generate an HTML report");
                 }
 
+                if (tracePath != null) {
+                    printer.info("Issue trace written: " + tracePath);
+                }
+
                 // Show "Active Advisor" menu if there are critical issues
                 if (result.hasCriticalIssues()) {
                     showActiveAdvisorMenu(result);
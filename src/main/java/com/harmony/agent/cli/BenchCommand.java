@@ -0,0 +1,194 @@
+package com.harmony.agent.cli;
+
+import com.google.gson.GsonBuilder;
+import com.google.gson.JsonArray;
+import com.google.gson.JsonObject;
+import com.harmony.agent.core.metrics.BenchmarkComparator;
+import picocli.CommandLine;
+import picocli.CommandLine.Command;
+import picocli.CommandLine.Option;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.Callable;
+
+/**
+ * 基准结果工具
+ *
+ * 用法:
+ * java -jar harmony-safe-agent.jar bench compare --baseline base/ --candidate head/
+ * java -jar harmony-safe-agent.jar bench compare --baseline jmh-main.json --candidate jmh-pr.json \
+ *     --threshold 3 --metric-threshold 'e2e.memory.*=10'
+ */
+@Command(
+    name = "bench",
+    description = "Benchmark result utilities",
+    mixinStandardHelpOptions = true,
+    subcommands = {BenchCommand.CompareCommand.class}
+)
+public class BenchCommand implements Runnable {
+
+    @CommandLine.Spec
+    private CommandLine.Model.CommandSpec spec;
+
+    @Override
+    public void run() {
+        spec.commandLine().usage(System.out);
+    }
+
+    /**
+     * 对比两组基准结果；存在回归时退出码为 1，输入错误为 2，便于 CI 拦截合并
+     */
+    @Command(
+        name = "compare",
+        description = "Compare JMH / offline E2E benchmark results and fail on statistically significant regressions",
+        mixinStandardHelpOptions = true
+    )
+    public static class CompareCommand implements Callable<Integer> {
+
+        static final int EXIT_REGRESSION = 1;
+        static final int EXIT_INPUT_ERROR = 2;
+
+        @Option(
+            names = {"--baseline"},
+            required = true,
+            arity = "1..*",
+            description = "Baseline result files or directories (JMH JSON or OfflineE2EBenchmark reports)"
+        )
+        private List<Path> baseline;
+
+        @Option(
+            names = {"--candidate"},
+            required = true,
+            arity = "1..*",
+            description = "Candidate result files or directories"
+        )
+        private List<Path> candidate;
+
+        @Option(
+            names = {"--threshold"},
+            description = "Default regression threshold in percent (default: ${DEFAULT-VALUE})",
+            defaultValue = "" + BenchmarkComparator.DEFAULT_THRESHOLD_PCT
+        )
+        private double threshold;
+
+        @Option(
+            names = {"--metric-threshold"},
+            description = "Per-metric threshold, glob=percent (e.g. 'e2e.phases.*=10'); first match wins"
+        )
+        private Map<String, Double> metricThresholds;
+
+        @Option(
+            names = {"--json"},
+            description = "Also write the comparison as JSON to this file"
+        )
+        private Path jsonOutput;
+
+        @Override
+        public Integer call() {
+            BenchmarkComparator comparator = new BenchmarkComparator(threshold);
+            if (metricThresholds != null) {
+                metricThresholds.forEach(comparator::threshold);
+            }
+
+            List<BenchmarkComparator.Comparison> comparisons;
+            try {
+                BenchmarkComparator.ResultSet base = BenchmarkComparator.load(baseline);
+                BenchmarkComparator.ResultSet cand = BenchmarkComparator.load(candidate);
+                comparisons = comparator.compare(base, cand);
+                if (comparisons.isEmpty()) {
+                    System.err.println("❌ No common metrics between baseline and candidate");
+                    return EXIT_INPUT_ERROR;
+                }
+                if (jsonOutput != null) {
+                    writeJson(comparisons, jsonOutput);
+                }
+            } catch (IOException e) {
+                System.err.println("❌ " + e.getMessage());
+                return EXIT_INPUT_ERROR;
+            }
+
+            printTable(comparisons);
+            long regressions = comparisons.stream()
+                .filter(c -> c.verdict() == BenchmarkComparator.Verdict.REGRESSION)
+                .count();
+            long insufficient = comparisons.stream()
+                .filter(c -> c.verdict() == BenchmarkComparator.Verdict.INSUFFICIENT_DATA)
+                .count();
+
+            System.out.println();
+            if (insufficient > 0) {
+                System.out.println("⚠️  " + insufficient + " metric(s) have fewer than 2 samples per side "
+                    + "and were not gated (run the benchmark several times)");
+            }
+            if (regressions > 0) {
+                System.out.println("❌ " + regressions + " regression(s) beyond threshold");
+                return EXIT_REGRESSION;
+            }
+            System.out.println("✅ No significant regressions");
+            return 0;
+        }
+
+        private static void printTable(List<BenchmarkComparator.Comparison> comparisons) {
+            int width = comparisons.stream().mapToInt(c -> c.metric().length()).max().orElse(10);
+            String format = "%-" + width + "s  %14s  %14s  %9s  %-22s  %6s  %s%n";
+            System.out.printf(format, "metric", "baseline", "candidate", "change", "95% CI", "limit", "verdict");
+            for (BenchmarkComparator.Comparison c : comparisons) {
+                String ci = Double.isNaN(c.ciLowPct())
+                    ? "n/a"
+                    : String.format("[%+.1f%%, %+.1f%%]", c.ciLowPct(), c.ciHighPct());
+                System.out.printf(format,
+                    c.metric(),
+                    String.format("%.4g %s", c.baselineMean(), c.unit()),
+                    String.format("%.4g %s", c.candidateMean(), c.unit()),
+                    Double.isNaN(c.changePct()) ? "n/a" : String.format("%+.1f%%", c.changePct()),
+                    ci,
+                    String.format("%.0f%%", c.thresholdPct()),
+                    verdictLabel(c));
+            }
+        }
+
+        private static String verdictLabel(BenchmarkComparator.Comparison c) {
+            return switch (c.verdict()) {
+                case REGRESSION -> "REGRESSION";
+                case IMPROVEMENT -> "improved";
+                case UNCHANGED -> "~";
+                case INSUFFICIENT_DATA -> "n<2 (" + c.baselineCount() + "/" + c.candidateCount() + ")";
+            };
+        }
+
+        private static void writeJson(List<BenchmarkComparator.Comparison> comparisons, Path output)
+                throws IOException {
+            JsonArray array = new JsonArray();
+            for (BenchmarkComparator.Comparison c : comparisons) {
+                JsonObject json = new JsonObject();
+                json.addProperty("metric", c.metric());
+                json.addProperty("unit", c.unit());
+                json.addProperty("direction", c.direction().name().toLowerCase());
+                json.addProperty("baseline_samples", c.baselineCount());
+                json.addProperty("baseline_mean", c.baselineMean());
+                json.addProperty("candidate_samples", c.candidateCount());
+                json.addProperty("candidate_mean", c.candidateMean());
+                addFinite(json, "change_pct", c.changePct());
+                addFinite(json, "ci_low_pct", c.ciLowPct());
+                addFinite(json, "ci_high_pct", c.ciHighPct());
+                json.addProperty("threshold_pct", c.thresholdPct());
+                json.addProperty("verdict", c.verdict().name().toLowerCase());
+                array.add(json);
+            }
+            if (output.toAbsolutePath().getParent() != null) {
+                Files.createDirectories(output.toAbsolutePath().getParent());
+            }
+            Files.writeString(output, new GsonBuilder().setPrettyPrinting().create().toJson(array));
+        }
+
+        private static void addFinite(JsonObject json, String key, double value) {
+            if (Double.isFinite(value)) {
+                json.addProperty(key, value);
+            }
+        }
+    }
+}
@@ -1,12 +1,16 @@
 package com.harmony.agent.cli;
 
 import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.metrics.ProfileRecorder;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 import picocli.CommandLine;
 import picocli.CommandLine.Command;
 import picocli.CommandLine.Option;
 
+import java.io.IOException;
+import java.nio.file.Path;
+import java.nio.file.Paths;
 import java.util.concurrent.Callable;
 
 /**
@@ -26,7 +30,10 @@ import java.util.concurrent.Callable;
         ReviewCommand.class,             // NEW: AI-powered code review
         ReportCommand.class,
         ConfigCommand.class,
-        CacheStatsCommand.class  // ✨ P1 Optimization: Cache statistics
+        CacheStatsCommand.class, // ✨ P1 Optimization: Cache statistics
+        ServeCommand.class,      // Resident server for IDE/CI integrations
+        BenchCommand.class,      // Benchmark regression gate
+        TriageCommand.class      // Human verdicts for the durable verdict store
     }
 )
 public class HarmonyAgentCLI implements Callable<Integer> {
@@ -42,6 +49,29 @@ public class HarmonyAgentCLI implements Callable<Integer> {
     private final ConsolePrinter printer;
     private final ConfigManager configManager;
 
+    /**
+     * Start a JFR recording as soon as the option is parsed so the whole command is covered
+     */
+    @Option(
+        names = {"--profile"},
+        arity = "0..1",
+        fallbackValue = "",
+        paramLabel = "FILE",
+        description = "Record a Java Flight Recorder profile of this run (default: harmony-agent-<timestamp>.jfr)"
+    )
+    private void setProfile(String file) {
+        if (file == null) {
+            return;  // option not given (picocli may reset setters to the default value)
+        }
+        Path output = file.isBlank() ? ProfileRecorder.defaultPath() : Paths.get(file);
+        try {
+            Path target = ProfileRecorder.start(output);
+            printer.info("Profiling enabled, JFR recording: " + target);
+        } catch (IOException | IllegalStateException e) {
+            printer.warning("Failed to start JFR recording: " + e.getMessage());
+        }
+    }
+
     public HarmonyAgentCLI() {
         this.printer = new ConsolePrinter(!noColor);
         this.configManager = ConfigManager.getInstance();
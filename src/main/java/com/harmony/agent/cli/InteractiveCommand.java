@@ -8,8 +8,11 @@ import com.harmony.agent.autofix.PendingChange;
 import com.harmony.agent.autofix.AppliedChange;
 import com.harmony.agent.cli.completion.CommandCompleter;
 import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.metrics.MetricsExporter;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.core.store.StoreSession;
 import com.harmony.agent.llm.LLMClient;
+import com.harmony.agent.task.TaskEventLog;
 import com.harmony.agent.task.TodoListManager;
 import com.harmony.agent.tools.ToolExecutor;
 import com.harmony.agent.tools.result.AnalysisResult;
@@ -23,10 +26,12 @@ import org.jline.terminal.Terminal;
 import org.jline.terminal.TerminalBuilder;
 import org.jline.utils.InfoCmp;
 import picocli.CommandLine.Command;
+import picocli.CommandLine.Option;
 import picocli.CommandLine.ParentCommand;
 
 import java.io.File;
 import java.io.IOException;
+import java.nio.file.Path;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
@@ -80,12 +85,25 @@ public class InteractiveCommand implements Callable<Integer> {
     @ParentCommand
     private HarmonyAgentCLI parent;
 
+    @Option(
+        names = {"--metrics-port"},
+        description = "Expose OpenMetrics on http://127.0.0.1:<port>/metrics while the session runs"
+    )
+    private Integer metricsPort;
+
+    @Option(
+        names = {"--metrics-textfile"},
+        description = "Write OpenMetrics to this file periodically (node_exporter textfile collector)"
+    )
+    private Path metricsTextfile;
+
     private ConsolePrinter printer;
     private ConfigManager configManager;
     private Terminal terminal;
     private LineReader lineReader;
     private boolean running = true;
     private List<String> conversationHistory;
+    // Heavy subsystems are created on first use (see getLlmClient() etc.) to keep cold start fast
     private LLMClient llmClient;
     private TodoListManager todoListManager;
     private ToolExecutor toolExecutor;
@@ -98,6 +116,8 @@ public class InteractiveCommand implements Callable<Integer> {
     // System command execution support
     private File currentWorkingDirectory;
 
+    private final List<MetricsExporter> metricsExporters = new ArrayList<>();
+
     @Override
     public Integer call() {
         printer = parent.getPrinter();
@@ -146,31 +166,28 @@ public class InteractiveCommand implements Callable<Integer> {
             // Setup Ctrl+T key binding for viewing todolist
             setupKeyBindings();
 
-            // Initialize LLM client
-            llmClient = new LLMClient(configManager);
-
-            // Initialize TodoListManager
-            todoListManager = new TodoListManager(llmClient, printer);
-
-            // Initialize ToolExecutor
-            toolExecutor = new ToolExecutor(currentWorkingDirectory);
-
-            // Initialize AutoFixOrchestrator and ChangeManager
-            CodeValidator codeValidator = new CodeValidator(toolExecutor, currentWorkingDirectory);
-            autoFixOrchestrator = new AutoFixOrchestrator(llmClient, codeValidator);
+            // LLM client, todo manager, tool executor, auto-fix and AI memory are created lazily
             changeManager = new ChangeManager();
 
             // Initialize StoreSession for unified issue store
             storeSession = new StoreSession();
             printer.info("初始化统一问题存储会话: " + storeSession.getSessionId());
 
-            // Initialize AIMemoryManager for storing AI memories
-            aiMemoryManager = new com.harmony.agent.llm.orchestrator.AIMemoryManager();
-            printer.info("初始化 AI 记忆管理器");
+            startMetricsExporters();
 
             // Show welcome message
             showWelcome();
 
+            // Resume a /plan the previous run left unfinished (replays the event log; no LLM client needed)
+            if (!new TaskEventLog().listSessions().isEmpty()) {
+                getTodoListManager().recoverUnfinishedPlan();
+            }
+
+            // Warm up the LLM client (providers + background MCP connects) while the user types
+            Thread warmUp = new Thread(this::getLlmClient, "interactive-warmup");
+            warmUp.setDaemon(true);
+            warmUp.start();
+
             // Start REPL loop
             while (running) {
                 String input = readInput();
@@ -198,6 +215,8 @@ public class InteractiveCommand implements Callable<Integer> {
             }
             return 1;
         } finally {
+            metricsExporters.forEach(MetricsExporter::close);
+
             // Close terminal
             if (terminal != null) {
                 try {
@@ -209,6 +228,69 @@ public class InteractiveCommand implements Callable<Integer> {
         }
     }
 
+    /**
+     * Start the optional OpenMetrics exporters (--metrics-port / --metrics-textfile)
+     */
+    private void startMetricsExporters() {
+        try {
+            if (metricsPort != null) {
+                MetricsExporter http = MetricsExporter.startHttp(MetricsRegistry.global(), metricsPort);
+                metricsExporters.add(http);
+                printer.info("Metrics: http://127.0.0.1:" + http.getPort() + "/metrics");
+            }
+            if (metricsTextfile != null) {
+                metricsExporters.add(MetricsExporter.startTextfile(MetricsRegistry.global(), metricsTextfile,
+                    MetricsExporter.DEFAULT_TEXTFILE_INTERVAL_SECONDS));
+                printer.info("Metrics textfile: " + metricsTextfile);
+            }
+        } catch (IOException e) {
+            printer.warning("Failed to start metrics exporter: " + e.getMessage());
+        }
+    }
+
+    /**
+     * Lazily create the LLM client (provider factory, roles, orchestrator, MCP connections)
+     */
+    private synchronized LLMClient getLlmClient() {
+        if (llmClient == null) {
+            llmClient = new LLMClient(configManager);
+        }
+        return llmClient;
+    }
+
+    private synchronized TodoListManager getTodoListManager() {
+        if (todoListManager == null) {
+            todoListManager = new TodoListManager(this::getLlmClient, printer);
+        }
+        return todoListManager;
+    }
+
+    private synchronized ToolExecutor getToolExecutor() {
+        if (toolExecutor == null) {
+            toolExecutor = new ToolExecutor(currentWorkingDirectory);
+        }
+        return toolExecutor;
+    }
+
+    private synchronized AutoFixOrchestrator getAutoFixOrchestrator() {
+        if (autoFixOrchestrator == null) {
+            CodeValidator codeValidator = new CodeValidator(getToolExecutor(), currentWorkingDirectory);
+            autoFixOrchestrator = new AutoFixOrchestrator(getLlmClient(), codeValidator);
+        }
+        return autoFixOrchestrator;
+    }
+
+    private synchronized com.harmony.agent.llm.orchestrator.AIMemoryManager getAiMemoryManager() {
+        if (aiMemoryManager == null) {
+            aiMemoryManager = new com.harmony.agent.llm.orchestrator.AIMemoryManager();
+        }
+        return aiMemoryManager;
+    }
+
+    private synchronized boolean hasActiveTodoList() {
+        return todoListManager != null && todoListManager.hasActiveTodoList();
+    }
+
     /**
      * Get history file location
      * Creates ~/.harmony-agent/history if it doesn't exist
@@ -232,9 +314,9 @@ public class InteractiveCommand implements Callable<Integer> {
         // Create a widget to handle Ctrl+T
         lineReader.getWidgets().put("show-tasks", () -> {
             // Display todolist when Ctrl+T is pressed
-            if (todoListManager.hasActiveTodoList()) {
+            if (hasActiveTodoList()) {
                 terminal.writer().println();
-                todoListManager.displayFullTodoList();
+                getTodoListManager().displayFullTodoList();
                 lineReader.callWidget(LineReader.REDRAW_LINE);
                 lineReader.callWidget(LineReader.REDISPLAY);
             } else {
@@ -273,7 +355,7 @@ public class InteractiveCommand implements Callable<Integer> {
 
         // Show LLM architecture status
         printer.keyValue("AI Model", configManager.getConfig().getAi().getModel());
-        if (llmClient.isUsingRealLLM()) {
+        if (LLMClient.hasConfiguredProvider(configManager)) {
             printer.keyValue("LLM Mode", "✨ Orchestrator (Multi-Role Architecture)");
             printer.keyValue("Status", "\u001B[32mActive\u001B[0m - Using real LLM providers");
         } else {
@@ -451,7 +533,7 @@ public class InteractiveCommand implements Callable<Integer> {
             printer.spinner("Thinking...", false);
 
             // Get AI response
-            String response = llmClient.chat(input, conversationHistory);
+            String response = getLlmClient().chat(input, conversationHistory);
 
             printer.spinner("Thinking", true);
             printer.blank();
@@ -593,9 +675,9 @@ public class InteractiveCommand implements Callable<Integer> {
         }
 
         // Check if there's already an active todo list
-        if (todoListManager.hasActiveTodoList()) {
+        if (hasActiveTodoList()) {
             printer.warning("当前已有活跃的任务计划。");
-            printer.info("当前进度: " + todoListManager.getProgressSummary());
+            printer.info("当前进度: " + getTodoListManager().getProgressSummary());
             printer.info("使用 /next 继续执行，或 /tasks 查看所有任务");
             printer.blank();
             printer.info("若要创建新计划，请先完成或清除当前计划:");
@@ -604,7 +686,7 @@ public class InteractiveCommand implements Callable<Integer> {
         }
 
         // Create new todo list
-        todoListManager.createTodoList(args);
+        getTodoListManager().createTodoList(args);
     }
 
     /**
@@ -612,39 +694,39 @@ public class InteractiveCommand implements Callable<Integer> {
      * 根据任务类型自动路由到合适的角色执行
      */
     private void handleExecuteCommand() {
-        if (!todoListManager.hasActiveTodoList()) {
+        if (!hasActiveTodoList()) {
             printer.warning("没有活跃的任务计划。");
             printer.info("使用 /plan <需求> 创建一个新的任务计划。");
             return;
         }
 
-        todoListManager.executeCurrentTask();
+        getTodoListManager().executeCurrentTask();
     }
 
     /**
      * Handle /tasks command - show full todo list
      */
     private void handleTasksCommand() {
-        if (!todoListManager.hasActiveTodoList()) {
+        if (!hasActiveTodoList()) {
             printer.warning("没有活跃的任务计划。");
             printer.info("使用 /plan <需求> 创建一个新的任务计划。");
             return;
         }
 
-        todoListManager.displayFullTodoList();
+        getTodoListManager().displayFullTodoList();
     }
 
     /**
      * Handle /current command - show current task only
      */
     private void handleCurrentTaskCommand() {
-        if (!todoListManager.hasActiveTodoList()) {
+        if (!hasActiveTodoList()) {
             printer.warning("没有活跃的任务计划。");
             printer.info("使用 /plan <需求> 创建一个新的任务计划。");
             return;
         }
 
-        todoListManager.displayCurrentTask();
+        getTodoListManager().displayCurrentTask();
     }
 
     /**
@@ -762,6 +844,11 @@ public class InteractiveCommand implements Callable<Integer> {
             parentField.setAccessible(true);
             parentField.set(strategicCmd, parent);
 
+            // Reuse issues from this session instead of re-running analyzers
+            if (storeSession != null && storeSession.getStore().getTotalIssueCount() > 0) {
+                strategicCmd.setIssueStore(storeSession.getStore());
+            }
+
             // Parse and execute
             int exitCode = cmd.execute(argArray);
 
@@ -995,7 +1082,7 @@ public class InteractiveCommand implements Callable<Integer> {
 
         try {
             printer.spinner("Compiling...", false);
-            CompileResult result = toolExecutor.compileMaven(cleanFirst);
+            CompileResult result = getToolExecutor().compileMaven(cleanFirst);
             printer.spinner("Compiling", true);
             printer.blank();
 
@@ -1052,7 +1139,7 @@ public class InteractiveCommand implements Callable<Integer> {
 
         try {
             printer.spinner("Running tests...", false);
-            TestResult result = toolExecutor.runTests(testPattern);
+            TestResult result = getToolExecutor().runTests(testPattern);
             printer.spinner("Running tests", true);
             printer.blank();
 
@@ -1105,7 +1192,7 @@ public class InteractiveCommand implements Callable<Integer> {
 
         try {
             printer.spinner("Analyzing...", false);
-            AnalysisResult result = toolExecutor.analyzeWithSpotBugs(null);
+            AnalysisResult result = getToolExecutor().analyzeWithSpotBugs(null);
             printer.spinner("Analyzing", true);
             printer.blank();
 
@@ -1276,7 +1363,7 @@ public class InteractiveCommand implements Callable<Integer> {
                 try {
                     // 生成修复（最多重试 3 次）
                     printer.spinner("Generating fix (with compilation validation)...", false);
-                    PendingChange pendingChange = autoFixOrchestrator.generateFix(issue, 3);
+                    PendingChange pendingChange = getAutoFixOrchestrator().generateFix(issue, 3);
                     printer.spinner("Generating fix", true);
                     printer.blank();
 
@@ -1836,7 +1923,7 @@ public class InteractiveCommand implements Callable<Integer> {
         // LLM Architecture status
         printer.subheader("LLM Architecture");
         printer.blank();
-        if (llmClient.isUsingRealLLM()) {
+        if (LLMClient.hasConfiguredProvider(configManager)) {
             printer.keyValue("  Architecture", "Dual-Strategy (Provider + Role)");
             printer.keyValue("  Analyzer Role", "OpenAI GPT-3.5-turbo");
             printer.keyValue("  Planner Role", "Claude 3 Sonnet");
@@ -2152,7 +2239,7 @@ public class InteractiveCommand implements Callable<Integer> {
 
             // 将文件内容存储到 AI 记忆
             String fullContent = String.join("\n", lines);
-            aiMemoryManager.rememberFile(file.getAbsolutePath(), fullContent);
+            getAiMemoryManager().rememberFile(file.getAbsolutePath(), fullContent);
 
         } catch (Exception e) {
             printer.error("Failed to read file: " + e.getMessage());
@@ -2280,7 +2367,7 @@ public class InteractiveCommand implements Callable<Integer> {
 
                 // 将搜索结果存储到 AI 记忆
                 String searchResults = String.join("\n", matches);
-                aiMemoryManager.rememberSearchResult(pattern, searchResults);
+                getAiMemoryManager().rememberSearchResult(pattern, searchResults);
             }
             printer.blank();
 
@@ -2346,7 +2433,7 @@ public class InteractiveCommand implements Callable<Integer> {
 
                 // 将 grep 结果存储到 AI 记忆
                 String grepResults = String.join("\n", matches);
-                aiMemoryManager.rememberSearchResult("grep:" + pattern, grepResults);
+                getAiMemoryManager().rememberSearchResult("grep:" + pattern, grepResults);
             }
             printer.blank();
 
@@ -0,0 +1,122 @@
+package com.harmony.agent.cli;
+
+import com.harmony.agent.core.metrics.MetricsExporter;
+import com.harmony.agent.core.metrics.MetricsRegistry;
+import com.harmony.agent.core.store.StoreSession;
+import com.harmony.agent.server.AgentServer;
+import com.harmony.agent.server.AgentService;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import picocli.CommandLine.Command;
+import picocli.CommandLine.Option;
+import picocli.CommandLine.ParentCommand;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.concurrent.Callable;
+
+/**
+ * Serve command - runs a resident local server so IDE/CI integrations avoid per-call startup cost
+ */
+@Command(
+    name = "serve",
+    description = "Run as a resident local server (JSON-RPC over HTTP on 127.0.0.1)",
+    mixinStandardHelpOptions = true
+)
+public class ServeCommand implements Callable<Integer> {
+
+    private static final Logger logger = LoggerFactory.getLogger(ServeCommand.class);
+
+    @ParentCommand
+    private HarmonyAgentCLI parent;
+
+    @Option(
+        names = {"-p", "--port"},
+        description = "Port to listen on (default: ${DEFAULT-VALUE})",
+        defaultValue = "" + AgentServer.DEFAULT_PORT
+    )
+    private int port;
+
+    @Option(
+        names = {"-t", "--threads"},
+        description = "Concurrent request handlers (default: number of CPUs)"
+    )
+    private Integer threads;
+
+    @Option(
+        names = {"--restore"},
+        description = "Restore issues from the last session cache on startup"
+    )
+    private boolean restore;
+
+    @Option(
+        names = {"--metrics-textfile"},
+        description = "Also write OpenMetrics to this file periodically (node_exporter textfile collector)"
+    )
+    private Path metricsTextfile;
+
+    @Override
+    public Integer call() {
+        ConsolePrinter printer = parent.getPrinter();
+
+        try {
+            StoreSession session = createSession(printer);
+            AgentService service = new AgentService(session.getStore());
+            int workerCount = threads != null ? threads : Runtime.getRuntime().availableProcessors();
+            AgentServer server = new AgentServer(service, port, workerCount);
+
+            Runtime.getRuntime().addShutdownHook(new Thread(server::stop, "agent-server-shutdown"));
+            server.start();
+            MetricsExporter textfileExporter = metricsTextfile != null
+                ? MetricsExporter.startTextfile(MetricsRegistry.global(), metricsTextfile,
+                    MetricsExporter.DEFAULT_TEXTFILE_INTERVAL_SECONDS)
+                : null;
+
+            printer.header("HarmonySafeAgent Server");
+            printer.keyValue("  Endpoint", "http://127.0.0.1:" + server.getPort() + "/rpc");
+            printer.keyValue("  Metrics", "http://127.0.0.1:" + server.getPort() + "/metrics"
+                + (metricsTextfile != null ? " + " + metricsTextfile : ""));
+            printer.keyValue("  Workers", String.valueOf(workerCount));
+            printer.keyValue("  Token", server.getTokenFile().toString());
+            printer.keyValue("  Methods", "analyze, query, fix, fix.apply, status, shutdown");
+            printer.blank();
+            printer.info("Client usage: harmony-agent --remote analyze <path>");
+            printer.info("Press Ctrl+C to stop");
+
+            server.awaitShutdown();
+            if (textfileExporter != null) {
+                textfileExporter.close();
+            }
+
+            try {
+                session.save();
+                logger.info("Session cache saved");
+            } catch (Exception e) {
+                logger.warn("Failed to save session cache: {}", e.getMessage());
+            }
+            printer.success("Server stopped");
+            return 0;
+
+        } catch (Exception e) {
+            printer.error("Server failed: " + e.getMessage());
+            if (parent.isVerbose()) {
+                e.printStackTrace();
+            }
+            return 1;
+        }
+    }
+
+    private StoreSession createSession(ConsolePrinter printer) {
+        Path cachePath = StoreSession.getDefaultSessionCachePath();
+        if (restore && Files.exists(cachePath)) {
+            try {
+                StoreSession session = new StoreSession(cachePath);
+                printer.info("Restored " + session.getStore().getTotalIssueCount() + " issues from session cache");
+                return session;
+            } catch (Exception e) {
+                printer.warning("Failed to restore session cache: " + e.getMessage());
+            }
+        }
+        return new StoreSession();
+    }
+}
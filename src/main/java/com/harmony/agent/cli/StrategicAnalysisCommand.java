@@ -1,6 +1,9 @@
 package com.harmony.agent.cli;
 
 import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.store.StoreSession;
+import com.harmony.agent.core.store.UnifiedIssueStore;
+import com.harmony.agent.strategic.ModuleResolver;
 import com.harmony.agent.strategic.SecurityScoringService;
 import com.harmony.agent.strategic.TriageAdvisor;
 import com.harmony.agent.strategic.SecurityScoringService.SecurityScore;
@@ -15,6 +18,7 @@ import com.harmony.agent.llm.LLMClient;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 import picocli.CommandLine.Command;
+import picocli.CommandLine.Option;
 import picocli.CommandLine.Parameters;
 import picocli.CommandLine.ParentCommand;
 
@@ -24,8 +28,10 @@ import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.Paths;
 import java.util.ArrayList;
+import java.util.HashSet;
 import java.util.List;
 import java.util.Scanner;
+import java.util.Set;
 import java.util.concurrent.Callable;
 import java.util.stream.Stream;
 
@@ -52,6 +58,20 @@ public class StrategicAnalysisCommand implements Callable<Integer> {
     )
     private String sourcePath;
 
+    @Option(
+        names = {"--store"},
+        description = "Issue store or JSON report to score from (default: current interactive session, then ~/.harmony-agent/session-cache.json)"
+    )
+    private String storePath;
+
+    @Option(
+        names = {"-g", "--group-by"},
+        description = "Module granularity for triage: FILE, DIRECTORY, TARGET (compile_commands.json build target) (default: ${DEFAULT-VALUE})",
+        defaultValue = "DIRECTORY"
+    )
+    private ModuleResolver.Granularity groupBy;
+
+    private UnifiedIssueStore issueStore;  // 交互模式下注入的会话 Store
     private SecurityScoringService scoringService;
     private TriageAdvisor triageAdvisor;
     private ToolExecutor toolExecutor;
@@ -80,38 +100,65 @@ public class StrategicAnalysisCommand implements Callable<Integer> {
             printer.header("🛡️ Strategic Security Analysis");
             printer.info("Target: " + sourcePath);
             printer.info("Mode: P-Strategic (T1.1 Scoring + T1.2 Triage)");
+            printer.info("Group by: " + groupBy);
             printer.blank();
 
-            // 第一步：运行静态分析
-            printer.spinner("Running static analysis...", false);
-            AnalysisResult analysisResult = toolExecutor.analyzeWithSpotBugs(null);
-            printer.spinner("Running static analysis", true);
-
-            // 第二步：发现源码文件
+            // 第一步：发现源码文件
             List<String> sourceFiles = discoverSourceFiles(path);
-            printer.info("Discovered " + sourceFiles.size() + " source files");
-            printer.blank();
-
-            // 第三步：运行 P-Strategic (T1.1 + T1.2)
-            printer.header("P-Strategic Analysis");
-            printer.blank();
 
-            List<SecurityScore> scores = new ArrayList<>();
-            List<TriageRecommendation> recommendations = new ArrayList<>();
-
-            for (String filePath : sourceFiles) {
-                // T1.1 SecurityScoringService 计算评分
-                printer.spinner("Scoring " + new File(filePath).getName() + "...", false);
-                SecurityScore score = scoringService.calculateScore(filePath, analysisResult);
-                scores.add(score);
-                printer.spinner("Scoring " + new File(filePath).getName(), true);
+            // 第二步：获取问题来源 - 优先使用已有的统一问题存储，不再重新运行分析工具
+            UnifiedIssueStore store = resolveIssueStore(path);
+            List<SecurityScore> scores;
+
+            if (store != null) {
+                addStoreFiles(path, store, sourceFiles);
+                printer.info(String.format("Using existing issue store: %d issues in %d files",
+                    store.getTotalIssueCount(), store.getIndexedFiles().size()));
+                printer.info("Discovered " + sourceFiles.size() + " source files");
+                printer.blank();
+
+                printer.header("P-Strategic Analysis");
+                printer.blank();
+                printer.spinner("Scoring " + sourceFiles.size() + " files...", false);
+                scores = scoringService.calculateScores(sourceFiles, store);
+                printer.spinner("Scoring " + sourceFiles.size() + " files", true);
+
+            } else if (Files.exists(Paths.get(System.getProperty("user.dir"), "pom.xml"))) {
+                // Java 项目且没有已有结果：沿用 SpotBugs
+                printer.spinner("Running static analysis...", false);
+                AnalysisResult analysisResult = toolExecutor.analyzeWithSpotBugs(null);
+                printer.spinner("Running static analysis", true);
+                printer.info("Discovered " + sourceFiles.size() + " source files");
+                printer.blank();
+
+                printer.header("P-Strategic Analysis");
+                printer.blank();
+                printer.spinner("Scoring " + sourceFiles.size() + " files...", false);
+                scores = scoringService.calculateScores(sourceFiles, analysisResult);
+                printer.spinner("Scoring " + sourceFiles.size() + " files", true);
+
+            } else {
+                printer.warning("No issue store found for this path - scoring on code metrics only");
+                printer.info("Run 'analyze' first (or pass --store <report.json>) to include static analysis findings");
+                printer.info("Discovered " + sourceFiles.size() + " source files");
+                printer.blank();
+
+                printer.header("P-Strategic Analysis");
+                printer.blank();
+                printer.spinner("Scoring " + sourceFiles.size() + " files...", false);
+                scores = scoringService.calculateScores(sourceFiles, (UnifiedIssueStore) null);
+                printer.spinner("Scoring " + sourceFiles.size() + " files", true);
+            }
 
-                // T1.2 TriageAdvisor 决策
-                TriageRecommendation recommendation = triageAdvisor.recommend(score);
-                recommendations.add(recommendation);
+            // 第三步：T1.2 TriageAdvisor 按模块聚合并决策（按优先级排序）
+            ModuleResolver moduleResolver = ModuleResolver.create(path, groupBy);
+            List<TriageRecommendation> recommendations = triageAdvisor.recommendBatch(scores, moduleResolver);
+            printer.info(String.format("Triage by %s: %d modules", groupBy, recommendations.size()));
+            printer.blank();
 
-                // 显示结果
-                displayModuleResult(score, recommendation);
+            // 显示结果
+            for (TriageRecommendation recommendation : recommendations) {
+                displayModuleResult(recommendation.getSecurityScore(), recommendation);
             }
 
             // 第四步：生成战略摘要
@@ -138,6 +185,72 @@ public class StrategicAnalysisCommand implements Callable<Integer> {
         }
     }
 
+    /**
+     * 注入交互会话中的统一问题存储（优先于磁盘缓存）
+     */
+    public void setIssueStore(UnifiedIssueStore issueStore) {
+        this.issueStore = issueStore;
+    }
+
+    /**
+     * 解析问题来源：注入的会话 Store → --store 指定文件 → 默认会话缓存
+     * 只有包含目标路径下问题的 Store 才会被使用
+     */
+    private UnifiedIssueStore resolveIssueStore(Path targetPath) {
+        if (issueStore != null && coversPath(issueStore, targetPath)) {
+            return issueStore;
+        }
+
+        if (storePath != null) {
+            try {
+                UnifiedIssueStore loaded = UnifiedIssueStore.loadFromDisk(Paths.get(storePath));
+                if (loaded.getTotalIssueCount() == 0) {
+                    printer.warning("Issue store is empty: " + storePath);
+                }
+                return loaded;
+            } catch (IOException e) {
+                printer.warning("Failed to load issue store " + storePath + ": " + e.getMessage());
+                return null;
+            }
+        }
+
+        Path sessionCache = StoreSession.getDefaultSessionCachePath();
+        if (Files.exists(sessionCache)) {
+            try {
+                UnifiedIssueStore cached = UnifiedIssueStore.loadFromDisk(sessionCache);
+                if (coversPath(cached, targetPath)) {
+                    return cached;
+                }
+            } catch (IOException e) {
+                logger.debug("Failed to load session cache: {}", e.getMessage());
+            }
+        }
+        return null;
+    }
+
+    private boolean coversPath(UnifiedIssueStore store, Path targetPath) {
+        Path target = targetPath.toAbsolutePath().normalize();
+        return store.getIndexedFiles().stream()
+            .anyMatch(file -> Paths.get(file).toAbsolutePath().normalize().startsWith(target));
+    }
+
+    /**
+     * 将 Store 中位于目标路径下、但未被文件发现覆盖的文件（如头文件）加入评分列表
+     */
+    private void addStoreFiles(Path targetPath, UnifiedIssueStore store, List<String> sourceFiles) {
+        Path target = targetPath.toAbsolutePath().normalize();
+        Set<Path> known = new HashSet<>();
+        for (String file : sourceFiles) {
+            known.add(Paths.get(file).toAbsolutePath().normalize());
+        }
+        for (String file : store.getIndexedFiles()) {
+            Path normalized = Paths.get(file).toAbsolutePath().normalize();
+            if (normalized.startsWith(target) && known.add(normalized)) {
+                sourceFiles.add(file);
+            }
+        }
+    }
+
     /**
      * 发现源码文件
      */
@@ -168,7 +281,7 @@ public class StrategicAnalysisCommand implements Callable<Integer> {
      * 显示单个模块的分析结果
      */
     private void displayModuleResult(SecurityScore score, TriageRecommendation recommendation) {
-        String fileName = score.getFileName();
+        String fileName = score.getModuleName();
         int securityScore = score.getScore();
         
         // 根据分数显示不同颜色
@@ -204,6 +317,13 @@ public class StrategicAnalysisCommand implements Callable<Integer> {
                 printer.keyValue("  Issues", String.format("Critical: %d, High: %d, Medium: %d, Low: %d",
                     score.getCriticalCount(), score.getHighCount(), score.getMediumCount(), score.getLowCount()));
             }
+            if (score.getMetrics() != null && score.getComplexityPenalty() > 0) {
+                printer.keyValue("  Metrics", String.format("Functions: %d, Max CC: %d, Max nesting: %d, goto/longjmp: %d, Unsafe calls: %d",
+                    score.getMetrics().getFunctionCount(), score.getMetrics().getMaxCyclomaticComplexity(),
+                    score.getMetrics().getMaxNestingDepth(),
+                    score.getMetrics().getTotalGotoCount() + score.getMetrics().getTotalLongjmpCount(),
+                    score.getMetrics().getTotalUnsafeCallCount()));
+            }
             printer.blank();
         }
     }
@@ -238,7 +358,7 @@ public class StrategicAnalysisCommand implements Callable<Integer> {
             String riskIcon = getRiskIcon(score.getScore());
             
             summary.append(String.format("%s %s (%d/100分): 建议%s\n", 
-                riskIcon, score.getFileName(), score.getScore(), rec.getRecommendation().getDescription()));
+                riskIcon, score.getModuleName(), score.getScore(), rec.getRecommendation().getDescription()));
         }
 
         printer.info(summary.toString());
@@ -0,0 +1,142 @@
+package com.harmony.agent.cli;
+
+import com.harmony.agent.core.ai.VerdictStore;
+import picocli.CommandLine.ArgGroup;
+import picocli.CommandLine.Command;
+import picocli.CommandLine.Option;
+import picocli.CommandLine.Parameters;
+import picocli.CommandLine.ParentCommand;
+
+import java.util.Comparator;
+import java.util.List;
+import java.util.Optional;
+import java.util.concurrent.Callable;
+
+/**
+ * Triage command - records a human verdict in the durable verdict store
+ *
+ * The fingerprint comes from an analyzed issue's verdict_fingerprint metadata. Findings the AI
+ * rejected are not in the report; {@code --list} shows their stored verdicts and fingerprints.
+ * Human verdicts override AI verdicts and apply to later scans until the issue's function changes.
+ */
+@Command(
+    name = "triage",
+    description = "Record a human verdict for a finding (by verdict fingerprint) across future scans",
+    mixinStandardHelpOptions = true
+)
+public class TriageCommand implements Callable<Integer> {
+
+    @ParentCommand
+    private HarmonyAgentCLI parent;
+
+    @Parameters(
+        index = "0",
+        arity = "0..1",
+        description = "Verdict fingerprint (verdict_fingerprint in the JSON report, or from --list)"
+    )
+    private String fingerprint;
+
+    @ArgGroup(exclusive = true, multiplicity = "1")
+    private Decision decision;
+
+    static class Decision {
+        @Option(names = {"--confirm"}, description = "The finding is a real vulnerability")
+        boolean confirm;
+
+        @Option(names = {"--reject"}, description = "The finding is a false positive")
+        boolean reject;
+
+        @Option(names = {"--list"}, description = "List stored verdicts with their fingerprints")
+        boolean list;
+    }
+
+    @Option(
+        names = {"-f", "--file"},
+        description = "With --list: only verdicts for files whose path contains this text"
+    )
+    private String fileFilter;
+
+    @Option(
+        names = {"-r", "--reason"},
+        description = "Why (shown in reports and kept with the verdict)"
+    )
+    private String reason = "Triaged by a reviewer";
+
+    @Option(
+        names = {"-s", "--severity"},
+        description = "Severity for a confirmed finding: critical | high | medium | low | info"
+    )
+    private String severity;
+
+    @Override
+    public Integer call() {
+        ConsolePrinter printer = parent.getPrinter();
+
+        try {
+            if (severity != null && !severity.toLowerCase().matches("critical|high|medium|low|info")) {
+                printer.error("Invalid severity: " + severity);
+                return 1;
+            }
+
+            VerdictStore store = VerdictStore.global();
+            if (decision.list) {
+                return list(printer, store);
+            }
+            if (fingerprint == null) {
+                printer.error("A verdict fingerprint is required with --confirm or --reject");
+                return 1;
+            }
+
+            Optional<VerdictStore.Verdict> existing = store.get(fingerprint);
+            if (existing.isEmpty()) {
+                printer.warning("No stored verdict for this fingerprint; recording it without location details");
+            }
+
+            String location = existing.map(VerdictStore.Verdict::location).orElse(null);
+            String file = existing.map(VerdictStore.Verdict::file).orElse(null);
+            String rule = existing.map(VerdictStore.Verdict::rule).orElse(null);
+            String finalSeverity = severity != null ? severity.toUpperCase()
+                : existing.map(VerdictStore.Verdict::severity).orElse(null);
+
+            store.record(new VerdictStore.Verdict(fingerprint, location, file, rule, decision.confirm,
+                finalSeverity, reason, VerdictStore.Source.HUMAN, null, null, System.currentTimeMillis()));
+
+            printer.success("Recorded human verdict: " + (decision.confirm ? "confirmed" : "false positive"));
+            if (file != null) {
+                printer.keyValue("File", file);
+                printer.keyValue("Rule", rule);
+            }
+            existing.ifPresent(verdict -> printer.keyValue("Replaces",
+                verdict.source().name().toLowerCase() + " verdict ("
+                    + (verdict.vulnerability() ? "confirmed" : "false positive") + ")"));
+            return 0;
+
+        } catch (Exception e) {
+            printer.error("Triage failed: " + e.getMessage());
+            if (parent.isVerbose()) {
+                e.printStackTrace();
+            }
+            return 1;
+        }
+    }
+
+    private int list(ConsolePrinter printer, VerdictStore store) {
+        List<VerdictStore.Verdict> verdicts = store.getVerdicts().stream()
+            .filter(verdict -> fileFilter == null
+                || (verdict.file() != null && verdict.file().contains(fileFilter)))
+            .sorted(Comparator.comparing((VerdictStore.Verdict verdict) -> String.valueOf(verdict.file()))
+                .thenComparing(verdict -> String.valueOf(verdict.rule())))
+            .toList();
+        printer.header("Stored Verdicts (" + verdicts.size() + ")");
+        for (VerdictStore.Verdict verdict : verdicts) {
+            printer.blank();
+            printer.keyValue("Fingerprint", verdict.fingerprint());
+            printer.keyValue("Verdict", verdict.source().name().toLowerCase() + " - "
+                + (verdict.vulnerability() ? "confirmed" : "false positive"));
+            printer.keyValue("File", String.valueOf(verdict.file()));
+            printer.keyValue("Rule", String.valueOf(verdict.rule()));
+            printer.keyValue("Reason", String.valueOf(verdict.reason()));
+        }
+        return 0;
+    }
+}
@@ -31,6 +31,8 @@ public class AppConfig {
         private int tokensPerMinuteLimit = 60000; // TPM mode: max tokens per minute
         private double safetyMargin = 0.8; // Safety margin (0.8 = 80% of limit)
         private int validationConcurrency = 3; // Default: max 3 concurrent validations
+        private long validationTokenBudget = 0; // Estimated prompt tokens per analysis run (0 = unlimited)
+        private boolean verdictStoreEnabled = true; // Reuse triage verdicts across scans (~/.harmony_agent/verdicts)
 
         // Multiple providers configuration
         private Map<String, ProviderConfig> providers = new HashMap<>();
@@ -81,6 +83,16 @@ public class AppConfig {
             this.validationConcurrency = validationConcurrency;
         }
 
+        public long getValidationTokenBudget() { return validationTokenBudget; }
+        public void setValidationTokenBudget(long validationTokenBudget) {
+            this.validationTokenBudget = validationTokenBudget;
+        }
+
+        public boolean isVerdictStoreEnabled() { return verdictStoreEnabled; }
+        public void setVerdictStoreEnabled(boolean verdictStoreEnabled) {
+            this.verdictStoreEnabled = verdictStoreEnabled;
+        }
+
         public Map<String, ProviderConfig> getProviders() { return providers; }
         public void setProviders(Map<String, ProviderConfig> providers) { this.providers = providers; }
 
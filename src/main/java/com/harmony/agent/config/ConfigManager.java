@@ -123,6 +123,8 @@ public class ConfigManager {
                     if (aiMap.containsKey("tokens_per_minute_limit")) config.getAi().setTokensPerMinuteLimit(((Number) aiMap.get("tokens_per_minute_limit")).intValue());
                     if (aiMap.containsKey("safety_margin")) config.getAi().setSafetyMargin(((Number) aiMap.get("safety_margin")).doubleValue());
                     if (aiMap.containsKey("validation_concurrency")) config.getAi().setValidationConcurrency(((Number) aiMap.get("validation_concurrency")).intValue());
+                    if (aiMap.containsKey("validation_token_budget")) config.getAi().setValidationTokenBudget(((Number) aiMap.get("validation_token_budget")).longValue());
+                    if (aiMap.containsKey("verdict_store_enabled")) config.getAi().setVerdictStoreEnabled((Boolean) aiMap.get("verdict_store_enabled"));
 
                     // Load providers configuration
                     if (aiMap.containsKey("providers")) {
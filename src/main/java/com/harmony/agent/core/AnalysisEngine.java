@@ -2,13 +2,25 @@ package com.harmony.agent.core;
 
 import com.harmony.agent.config.ConfigManager;
 import com.harmony.agent.core.ai.DecisionEngine;
+import com.harmony.agent.core.ai.PersistentCacheManager;
 import com.harmony.agent.core.analyzer.Analyzer;
 import com.harmony.agent.core.analyzer.AnalyzerException;
 import com.harmony.agent.core.analyzer.ClangAnalyzer;
+import com.harmony.agent.core.analyzer.RustAnalyzer;
 import com.harmony.agent.core.analyzer.SemgrepAnalyzer;
+import com.harmony.agent.core.analyzer.StructuralAnalyzer;
 import com.harmony.agent.core.analyzer.RegexAnalyzer;
+import com.harmony.agent.core.memory.HeapBudget;
+import com.harmony.agent.core.memory.IssueSpillBuffer;
+import com.harmony.agent.core.metrics.AnalysisMetrics;
+import com.harmony.agent.core.metrics.IssueTracer;
+import com.harmony.agent.core.metrics.JfrEvents;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.core.model.ScanResult;
 import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.parser.CallGraph;
+import com.harmony.agent.core.parser.ProjectFacts;
+import com.harmony.agent.core.parser.SourceModelCache;
 import com.harmony.agent.core.report.ReportGenerator;
 import com.harmony.agent.core.scanner.CodeScanner;
 import com.harmony.agent.core.store.UnifiedIssueStore;
@@ -21,6 +33,8 @@ import java.nio.file.Paths;
 import java.time.Instant;
 import java.util.*;
 import java.util.concurrent.*;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.stream.Collectors;
 
 /**
@@ -30,6 +44,14 @@ public class AnalysisEngine {
 
     private static final Logger logger = LoggerFactory.getLogger(AnalysisEngine.class);
 
+    // Process-wide gauges for long-running modes (serve / interactive)
+    private static final MetricsRegistry.Gauge ANALYSES_IN_FLIGHT = MetricsRegistry.global().gauge(
+        "harmony_analyses_in_flight", "Analyses currently running");
+    private static final MetricsRegistry.Gauge TASKS_QUEUED = MetricsRegistry.global().gauge(
+        "harmony_analysis_tasks_queued", "Analyzer tasks waiting in the engine executor");
+    private static final MetricsRegistry.Gauge TASKS_ACTIVE = MetricsRegistry.global().gauge(
+        "harmony_analysis_tasks_active", "Analyzer tasks running in the engine executor");
+
     private final String sourcePath;
     private final AnalysisConfig config;
     private final CodeScanner scanner;
@@ -38,6 +60,9 @@ public class AnalysisEngine {
     private final DecisionEngine decisionEngine;
     private final ReportGenerator reportGenerator;
     private final boolean aiEnhancementEnabled;
+    private Path tracePath;  // Chrome trace output for per-issue lifecycle spans (null = disabled)
+    private HeapBudget heapBudget = HeapBudget.UNLIMITED;
+    private boolean mixedLanguages;  // detect C/C++ and Rust per subtree instead of from the root marker
 
     public AnalysisEngine(String sourcePath, AnalysisConfig config) {
         this.sourcePath = sourcePath;
@@ -94,6 +119,13 @@ public class AnalysisEngine {
             logger.warn("Semgrep analyzer not available - ensure semgrep is installed");
         }
 
+        // In-JVM matcher over the bundled rule packs: no Python, no process per batch
+        StructuralAnalyzer structuralAnalyzer = new StructuralAnalyzer(this.executorService);
+        if (structuralAnalyzer.isAvailable()) {
+            analyzers.add(structuralAnalyzer);
+            logger.info("Built-in structural matcher enabled: {}", structuralAnalyzer.getVersion());
+        }
+
         // Always add built-in regex analyzer as fallback
         RegexAnalyzer regexAnalyzer = new RegexAnalyzer();
         analyzers.add(regexAnalyzer);
@@ -102,40 +134,129 @@ public class AnalysisEngine {
         return analyzers;
     }
 
+    /**
+     * Record per-issue lifecycle spans and write them as Chrome trace-event JSON after each analysis
+     */
+    public void setTracePath(Path tracePath) {
+        this.tracePath = tracePath;
+    }
+
+    /**
+     * Size caches and intermediate buffers from a heap budget; raw analyzer output beyond it spills to disk
+     */
+    public void setHeapBudget(HeapBudget heapBudget) {
+        this.heapBudget = heapBudget != null ? heapBudget : HeapBudget.UNLIMITED;
+        decisionEngine.limitSliceCache(this.heapBudget.sliceCacheFiles());
+        if (this.heapBudget.exceedsMaxHeap()) {
+            logger.warn("Heap budget {} exceeds max heap {}MB; raise -Xmx to match",
+                this.heapBudget, Runtime.getRuntime().maxMemory() / (1024 * 1024));
+        }
+    }
+
+    /**
+     * Scan a mixed-language monorepo in one pass: C/C++ files go to the level-selected analyzers and
+     * each Cargo workspace gets its own Rust analyzer run, all on the same pool and merged into one result
+     */
+    public void setMixedLanguages(boolean mixedLanguages) {
+        this.mixedLanguages = mixedLanguages;
+    }
+
     /**
      * Run full analysis
      */
     public ScanResult analyze() throws IOException, AnalyzerException {
+        MetricsRegistry registry = MetricsRegistry.global();
+        long start = System.nanoTime();
+        String outcome = "error";
+        ANALYSES_IN_FLIGHT.inc();
+        try {
+            ScanResult result = runAnalysis();
+            outcome = "success";
+            registry.counter("harmony_analysis_files", "Source files analyzed")
+                .inc(((Number) result.getStatistics().getOrDefault("total_files", 0)).doubleValue());
+            registry.counter("harmony_analysis_issues", "Issues reported after deduplication and AI filtering")
+                .inc(result.getTotalIssueCount());
+            return result;
+        } finally {
+            ANALYSES_IN_FLIGHT.dec();
+            registry.summary("harmony_analysis_duration_seconds", "End-to-end analysis time").observeSince(start);
+            registry.counter("harmony_analyses", "Analyses by outcome", "outcome", outcome).inc();
+        }
+    }
+
+    private ScanResult runAnalysis() throws IOException, AnalyzerException {
         logger.info("Starting analysis of: {}", sourcePath);
         Instant startTime = Instant.now();
+        AnalysisMetrics metrics = new AnalysisMetrics();
+        if (tracePath != null) {
+            metrics.setTracer(IssueTracer.create());
+        }
+        IssueTracer tracer = metrics.getTracer();
 
         // Scan for files
-        List<Path> files = config.isIncremental() ?
-            scanner.scanIncremental() : scanner.scanAll();
+        List<Path> files;
+        CodeScanner.SourceSet sources = null;
+        try (AnalysisMetrics.Timer ignored = metrics.time(AnalysisMetrics.PHASE_SCAN)) {
+            if (mixedLanguages) {
+                sources = config.isIncremental() ?
+                    scanner.scanMixedIncremental() : scanner.scanMixed();
+                files = sources.getAllFiles();
+            } else {
+                files = config.isIncremental() ?
+                    scanner.scanIncremental() : scanner.scanAll();
+            }
+        }
 
         logger.info("Scanning complete. Found {} files to analyze", files.size());
 
         if (files.isEmpty()) {
             logger.warn("No files found to analyze");
-            return createEmptyResult(startTime);
-        }
-
-        // Analyze files
-        List<SecurityIssue> allIssues = analyzeFiles(files);
+            return createEmptyResult(startTime, metrics);
+        }
+
+        // Analyze files (raw results beyond the heap budget spill to disk until dedup)
+        List<SecurityIssue> allIssues;
+        List<AnalyzerJob> jobs = planJobs(files, sources);
+
+        // Project fact index for AI pre-filters and prompts, built on the pool alongside the analyzers
+        List<Path> factFiles = sources != null ? sources.getCFiles() : files;
+        Future<ProjectFacts> projectFacts = aiEnhancementEnabled
+            ? executorService.submit(() -> buildProjectFacts(factFiles, metrics))
+            : null;
+        Future<CallGraph> callGraph = aiEnhancementEnabled
+            ? executorService.submit(() -> buildCallGraph(factFiles, metrics))
+            : null;
+        try (IssueSpillBuffer rawIssues = new IssueSpillBuffer(heapBudget.issueBufferSize())) {
+            try (AnalysisMetrics.Timer ignored = metrics.time(AnalysisMetrics.PHASE_ANALYSIS)) {
+                analyzeFiles(jobs, metrics, rawIssues);
+            }
 
-        // Deduplicate issues
-        allIssues = deduplicateIssues(allIssues);
+            // Deduplicate issues
+            try (AnalysisMetrics.Timer ignored = metrics.time(AnalysisMetrics.PHASE_DEDUP)) {
+                allIssues = deduplicateIssues(rawIssues, tracer);
+            }
+            if (rawIssues.getSpilledCount() > 0) {
+                metrics.increment("spilled_issues", rawIssues.getSpilledCount());
+                logger.info("Spilled {} of {} raw issues to disk (heap budget {})",
+                    rawIssues.getSpilledCount(), rawIssues.size(), heapBudget);
+            }
+        }
 
         // AI Enhancement: Validate issues and filter false positives
+        int aiFilteredCount = 0;
         if (aiEnhancementEnabled) {
             logger.info("Enhancing {} issues with AI validation...", allIssues.size());
             int beforeCount = allIssues.size();
-            allIssues = decisionEngine.enhanceIssues(allIssues);
+            decisionEngine.setProjectFacts(awaitIndex(projectFacts, "Project fact index"));
+            decisionEngine.setCallGraph(awaitIndex(callGraph, "Call graph"));
+            try (AnalysisMetrics.Timer ignored = metrics.time(AnalysisMetrics.PHASE_AI_VALIDATION)) {
+                allIssues = decisionEngine.enhanceIssues(allIssues, metrics);
+            }
             int afterCount = allIssues.size();
-            int filtered = beforeCount - afterCount;
+            aiFilteredCount = beforeCount - afterCount;
 
             logger.info("AI enhancement complete: {} issues → {} issues ({} filtered)",
-                beforeCount, afterCount, filtered);
+                beforeCount, afterCount, aiFilteredCount);
         } else {
             logger.debug("AI enhancement disabled, using static analysis results only");
         }
@@ -152,22 +273,38 @@ public class AnalysisEngine {
         for (Analyzer analyzer : analyzers) {
             resultBuilder.addAnalyzer(analyzer.getName());
         }
+        jobs.stream()
+            .map(AnalyzerJob::analyzer)
+            .filter(RustAnalyzer.class::isInstance)
+            .findFirst()
+            .ifPresent(rust -> resultBuilder.addAnalyzer(rust.getName()));
 
         // Add statistics
         resultBuilder.addStatistic("total_files", files.size());
+        if (sources != null) {
+            resultBuilder.addStatistic("files_c_cpp", sources.getCFiles().size());
+            resultBuilder.addStatistic("files_rust", sources.getRustFileCount());
+            resultBuilder.addStatistic("rust_workspaces", sources.getRustWorkspaces().size());
+        }
         resultBuilder.addStatistic("total_issues", allIssues.size());
         resultBuilder.addStatistic("analyzers_count", analyzers.size());
 
         // Add AI filtering statistics
         if (aiEnhancementEnabled) {
-            int beforeCount = allIssues.size() + (allIssues.size() > 0 ?
-                (int) allIssues.stream()
-                    .filter(i -> i.getMetadata().containsKey("ai_validated"))
-                    .count() : 0);
-            int filtered = beforeCount - allIssues.size();
-            resultBuilder.addStatistic("ai_filtered_count", filtered);
+            resultBuilder.addStatistic("ai_filtered_count", aiFilteredCount);
+        }
+        if (heapBudget.isLimited()) {
+            resultBuilder.addStatistic("heap_budget_mb", heapBudget.getBytes() / (1024 * 1024));
+        }
+
+        if (tracer.isEnabled()) {
+            for (SecurityIssue issue : allIssues) {
+                tracer.instant(issue.getId(), "reported",
+                    "severity", issue.getSeverity().name(), "analyzer", issue.getAnalyzer());
+            }
         }
 
+        metrics.toStatistics().forEach(resultBuilder::addStatistic);
         ScanResult result = resultBuilder.build();
 
         logger.info("Analysis complete. Found {} issues in {} files",
@@ -178,9 +315,19 @@ public class AnalysisEngine {
             try {
                 Path outputPath = Paths.get(config.getOutputPath());
                 logger.info("Generating HTML report at: {}", outputPath);
-                reportGenerator.generate(result, outputPath);
+                try (AnalysisMetrics.Timer ignored = metrics.time(AnalysisMetrics.PHASE_REPORTING);
+                     IssueTracer.Span span = tracer.engineSpan("report")) {
+                    span.arg("issues", result.getTotalIssueCount());
+                    reportGenerator.generate(result, outputPath);
+                }
                 logger.info("Report generated successfully: {}", outputPath);
 
+                // Carry the reporting phase into the result so the JSON report and the caller see it;
+                // the HTML report was rendered before its own phase finished and leaves it out
+                ScanResult.Builder withReporting = result.toBuilder();
+                metrics.toStatistics().forEach(withReporting::addStatistic);
+                result = withReporting.build();
+
                 // Also generate JSON report for machine reading (used by suggest/refactor commands)
                 String jsonPath = config.getOutputPath().replaceFirst("\\.html$", ".json");
                 if (jsonPath.equals(config.getOutputPath())) {
@@ -198,6 +345,15 @@ public class AnalysisEngine {
             }
         }
 
+        if (tracer.isEnabled()) {
+            try {
+                tracer.writeChromeTrace(tracePath);
+                logger.info("Issue trace written: {} ({} events)", tracePath, tracer.getEventCount());
+            } catch (IOException e) {
+                logger.warn("Failed to write issue trace {}: {}", tracePath, e.getMessage());
+            }
+        }
+
         return result;
     }
 
@@ -223,9 +379,17 @@ public class AnalysisEngine {
     }
 
     /**
-     * Analyze files with available analyzers
+     * One analyzer run over a set of files
      */
-    private List<SecurityIssue> analyzeFiles(List<Path> files) throws AnalyzerException {
+    private record AnalyzerJob(Analyzer analyzer, List<Path> files) {
+    }
+
+    /**
+     * Plan analyzer runs: every level-selected analyzer over all files, or in mixed-language mode
+     * the selected analyzers over the C/C++ files plus one Rust analyzer per Cargo workspace
+     */
+    private List<AnalyzerJob> planJobs(List<Path> files, CodeScanner.SourceSet sources)
+            throws AnalyzerException {
         if (analyzers.isEmpty()) {
             throw new AnalyzerException("No analyzers available");
         }
@@ -237,17 +401,104 @@ public class AnalysisEngine {
             throw new AnalyzerException("No suitable analyzers for level: " + config.getLevel());
         }
 
-        List<SecurityIssue> allIssues = new ArrayList<>();
+        List<AnalyzerJob> jobs = new ArrayList<>();
+        List<Path> cFiles = sources != null ? sources.getCFiles() : files;
+        if (!cFiles.isEmpty()) {
+            for (Analyzer analyzer : selectedAnalyzers) {
+                jobs.add(new AnalyzerJob(analyzer, cFiles));
+            }
+        }
+
+        if (sources != null && !sources.getRustWorkspaces().isEmpty()) {
+            String cargoPath = ConfigManager.getInstance().getConfig().getTools().getCargoPath();
+            if (new RustAnalyzer(cargoPath, null).isAvailable()) {
+                sources.getRustWorkspaces().forEach((root, rustFiles) ->
+                    jobs.add(new AnalyzerJob(new RustAnalyzer(cargoPath, root), rustFiles)));
+            } else {
+                logger.warn("Cargo not available - skipping {} Rust files in {} workspace(s)",
+                    sources.getRustFileCount(), sources.getRustWorkspaces().size());
+            }
+        }
+        return jobs;
+    }
+
+    /**
+     * One token pass over the project's C/C++ files: threading, entry points, allocator wrappers.
+     * Models go through the shared cache, so slicing the reported files later can reuse them.
+     * Facts are project-wide (a wrapper defined in an unchanged file still counts), so an
+     * incremental scan indexes every file, not just the changed ones.
+     */
+    private ProjectFacts buildProjectFacts(List<Path> files, AnalysisMetrics metrics) throws IOException {
+        long start = System.nanoTime();
+        ProjectFacts facts = ProjectFacts.build(projectCFiles(files), scanner.getCompileCommands(),
+            SourceModelCache.global());
+        metrics.addDuration("fact_index", System.nanoTime() - start);
+        metrics.increment("fact_index_files", facts.getFileCount());
+        return facts;
+    }
+
+    /**
+     * Approximate call graph for reachability ordering and caller context. Per-file extraction is
+     * cached on disk, so an incremental scan indexes the whole project while reparsing only changed files.
+     */
+    private CallGraph buildCallGraph(List<Path> files, AnalysisMetrics metrics) throws IOException {
+        long start = System.nanoTime();
+        CallGraph graph = CallGraph.build(projectCFiles(files), SourceModelCache.global(), openCallGraphCache());
+        metrics.addDuration("call_graph", System.nanoTime() - start);
+        metrics.increment("call_graph_functions", graph.getFunctionCount());
+        metrics.increment("call_graph_cached_files", graph.getCachedFileCount());
+        return graph;
+    }
+
+    /**
+     * The scanned C/C++ files, or the whole project's when the scan only holds git-changed files
+     */
+    private List<Path> projectCFiles(List<Path> files) throws IOException {
+        if (!config.isIncremental()) {
+            return files;
+        }
+        return mixedLanguages ? scanner.scanMixed().getCFiles() : scanner.scanAll();
+    }
+
+    private static PersistentCacheManager openCallGraphCache() {
+        try {
+            return new PersistentCacheManager("callgraph");
+        } catch (RuntimeException e) {
+            logger.warn("Call graph cache disabled: {}", e.getMessage());
+            return null;
+        }
+    }
 
+    /**
+     * Wait for a project index; AI validation falls back to per-issue heuristics if it failed
+     */
+    private <T> T awaitIndex(Future<T> index, String name) {
+        if (index == null) {
+            return null;
+        }
+        try {
+            return index.get(config.getTimeout(), TimeUnit.SECONDS);
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return null;
+        } catch (ExecutionException | TimeoutException e) {
+            logger.warn("{} unavailable, using per-issue heuristics: {}", name, e.getMessage());
+            index.cancel(true);
+            return null;
+        }
+    }
+
+    /**
+     * Run the planned analyzer jobs, appending each job's results to the sink
+     */
+    private void analyzeFiles(List<AnalyzerJob> jobs, AnalysisMetrics metrics, IssueSpillBuffer sink) {
         if (config.isParallel()) {
             // Parallel analysis
-            allIssues = analyzeParallel(files, selectedAnalyzers);
+            analyzeParallel(jobs, metrics, sink);
         } else {
             // Sequential analysis
-            allIssues = analyzeSequential(files, selectedAnalyzers);
+            analyzeSequential(jobs, metrics, sink);
         }
-
-        return allIssues;
     }
 
     /**
@@ -261,14 +512,14 @@ public class AnalysisEngine {
 
         switch (level) {
             case "quick":
-                // Quick mode: Use only Semgrep (fast pattern matching)
+                // Quick mode: bundled rule packs matched in-process (no Semgrep startup)
                 for (Analyzer analyzer : analyzers) {
-                    if (analyzer.getName().equals("Semgrep")) {
+                    if (analyzer.getName().equals(StructuralAnalyzer.NAME)) {
                         selected.add(analyzer);
                         logger.info("Quick mode: Using {}", analyzer.getName());
                     }
                 }
-                // Fallback to regex if semgrep not available
+                // Fallback to regex if the rule packs could not be loaded
                 if (selected.isEmpty()) {
                     for (Analyzer analyzer : analyzers) {
                         if (analyzer.getName().contains("Regex")) {
@@ -281,10 +532,12 @@ public class AnalysisEngine {
 
             case "standard":
             case "deep":
-                // Standard/Deep mode: Use Semgrep + Clang-Tidy
+                // Standard/Deep mode: Use Semgrep + Clang-Tidy, with the in-JVM matcher standing in for Semgrep
+                boolean hasSemgrep = analyzers.stream().anyMatch(analyzer -> analyzer.getName().equals("Semgrep"));
                 for (Analyzer analyzer : analyzers) {
                     if (analyzer.getName().equals("Semgrep") ||
-                        analyzer.getName().equals("Clang-Tidy")) {
+                        analyzer.getName().equals("Clang-Tidy") ||
+                        (!hasSemgrep && analyzer.getName().equals(StructuralAnalyzer.NAME))) {
                         selected.add(analyzer);
                         logger.info("{} mode: Using {}", level, analyzer.getName());
                     }
@@ -314,76 +567,125 @@ public class AnalysisEngine {
     /**
      * Sequential file analysis
      */
-    private List<SecurityIssue> analyzeSequential(List<Path> files, List<Analyzer> selectedAnalyzers) {
-        List<SecurityIssue> allIssues = new ArrayList<>();
-
-        for (Analyzer analyzer : selectedAnalyzers) {
-            logger.info("Running analyzer: {} (batch mode)", analyzer.getName());
-
-            try {
-                // Use batch analysis method for efficiency
-                List<SecurityIssue> issues = analyzer.analyzeAll(files);
-                allIssues.addAll(issues);
-                logger.info("{} found {} issues", analyzer.getName(), issues.size());
-            } catch (AnalyzerException e) {
-                logger.error("Batch analysis failed for {}: {}", analyzer.getName(), e.getMessage());
-            }
+    private void analyzeSequential(List<AnalyzerJob> jobs, AnalysisMetrics metrics, IssueSpillBuffer sink) {
+        for (AnalyzerJob job : jobs) {
+            logger.info("Running analyzer: {} on {} files (batch mode)",
+                job.analyzer().getName(), job.files().size());
+            runAnalyzer(job.analyzer(), job.files(), metrics, sink);
         }
-
-        return allIssues;
     }
 
     /**
      * Parallel file analysis
      */
-    private List<SecurityIssue> analyzeParallel(List<Path> files, List<Analyzer> selectedAnalyzers) {
-        List<Future<List<SecurityIssue>>> futures = new ArrayList<>();
-
-        // Submit analysis tasks for each analyzer (each analyzer runs in parallel)
-        for (Analyzer analyzer : selectedAnalyzers) {
-            logger.info("Running analyzer in parallel: {} (batch mode)", analyzer.getName());
-
-            Future<List<SecurityIssue>> future = executorService.submit(() -> {
+    private void analyzeParallel(List<AnalyzerJob> jobs, AnalysisMetrics metrics, IssueSpillBuffer sink) {
+        List<Future<?>> futures = new ArrayList<>();
+        List<AtomicBoolean> started = new ArrayList<>();
+
+        // Submit one task per job (analyzers and Cargo workspaces all run in parallel)
+        for (AnalyzerJob job : jobs) {
+            logger.info("Running analyzer in parallel: {} on {} files (batch mode)",
+                job.analyzer().getName(), job.files().size());
+
+            AtomicBoolean claim = new AtomicBoolean();
+            started.add(claim);
+            TASKS_QUEUED.inc();
+            futures.add(executorService.submit(() -> {
+                if (!claim.compareAndSet(false, true)) {
+                    return;  // cancelled before it started
+                }
+                TASKS_QUEUED.dec();
+                TASKS_ACTIVE.inc();
                 try {
-                    // Use batch analysis method for efficiency
-                    List<SecurityIssue> issues = analyzer.analyzeAll(files);
-                    logger.info("{} found {} issues", analyzer.getName(), issues.size());
-                    return issues;
-                } catch (AnalyzerException e) {
-                    logger.error("Batch analysis failed for {}: {}", analyzer.getName(), e.getMessage());
-                    return new ArrayList<>();
+                    runAnalyzer(job.analyzer(), job.files(), metrics, sink);
+                } finally {
+                    TASKS_ACTIVE.dec();
                 }
-            });
-
-            futures.add(future);
+            }));
         }
 
-        // Collect results
-        List<SecurityIssue> allIssues = new ArrayList<>();
-        for (Future<List<SecurityIssue>> future : futures) {
+        // Wait for completion (results are already in the sink); once a job fails or times out,
+        // cancel the jobs still running instead of waiting out the timeout for each of them
+        for (Future<?> future : futures) {
             try {
-                List<SecurityIssue> issues = future.get(config.getTimeout(), TimeUnit.SECONDS);
-                allIssues.addAll(issues);
+                future.get(config.getTimeout(), TimeUnit.SECONDS);
             } catch (InterruptedException | ExecutionException | TimeoutException e) {
-                logger.error("Failed to get analysis results", e);
+                logger.error("Failed to get analysis results, cancelling remaining analyzer jobs", e);
+                cancelAll(futures, started);
+                if (e instanceof InterruptedException) {
+                    Thread.currentThread().interrupt();
+                }
+                return;
             }
         }
+    }
 
-        return allIssues;
+    private static void cancelAll(List<Future<?>> futures, List<AtomicBoolean> started) {
+        for (int i = 0; i < futures.size(); i++) {
+            if (started.get(i).compareAndSet(false, true)) {
+                TASKS_QUEUED.dec();  // never ran: it will not leave the queued gauge itself
+            }
+            futures.get(i).cancel(true);
+        }
+    }
+
+    /**
+     * Run one analyzer, streaming its result batches straight into the shared sink
+     * (no per-analyzer combined list, no re-concatenation in the engine)
+     */
+    private void runAnalyzer(Analyzer analyzer, List<Path> files, AnalysisMetrics metrics, IssueSpillBuffer sink) {
+        IssueTracer tracer = metrics.getTracer();
+        JfrEvents.AnalyzerRun event = new JfrEvents.AnalyzerRun();
+        event.begin();
+        long start = System.nanoTime();
+        AtomicInteger issueCount = new AtomicInteger();
+        try (IssueTracer.Span span = tracer.engineSpan(analyzer.getName())) {
+            analyzer.analyzeAll(files, issues -> {
+                issueCount.addAndGet(issues.size());
+                traceEmitted(tracer, analyzer, issues);
+                sink.addAll(issues);
+            });
+            span.arg("files", files.size()).arg("issues", issueCount.get());
+        } catch (AnalyzerException e) {
+            logger.error("Batch analysis failed for {}: {}", analyzer.getName(), e.getMessage());
+            return;
+        }
+        metrics.recordAnalyzer(analyzer.getName(), files.size(), issueCount.get(), System.nanoTime() - start);
+        event.finish(analyzer.getName(), "batch", files.size(), issueCount.get());
+        logger.info("{} found {} issues", analyzer.getName(), issueCount.get());
+    }
+
+    /**
+     * Record an "emitted" instant on each issue's trace row
+     */
+    private static void traceEmitted(IssueTracer tracer, Analyzer analyzer, List<SecurityIssue> issues) {
+        if (!tracer.isEnabled()) {
+            return;
+        }
+        for (SecurityIssue issue : issues) {
+            tracer.instant(issue.getId(), "emitted",
+                "analyzer", analyzer.getName(),
+                "severity", issue.getSeverity().name(),
+                "location", issue.getLocation().toString());
+        }
     }
 
     /**
      * Deduplicate issues based on hash
      */
-    private List<SecurityIssue> deduplicateIssues(List<SecurityIssue> issues) {
+    private List<SecurityIssue> deduplicateIssues(IssueSpillBuffer issues, IssueTracer tracer) throws IOException {
         Map<String, SecurityIssue> uniqueIssues = new LinkedHashMap<>();
 
-        for (SecurityIssue issue : issues) {
+        issues.drain(issue -> {
             String hash = issue.getHash();
-            if (!uniqueIssues.containsKey(hash)) {
+            SecurityIssue kept = uniqueIssues.get(hash);
+            if (kept == null) {
                 uniqueIssues.put(hash, issue);
+                tracer.instant(issue.getId(), "dedup", "result", "kept");
+            } else {
+                tracer.instant(issue.getId(), "dedup", "result", "duplicate", "duplicate_of", kept.getId());
             }
-        }
+        });
 
         int duplicateCount = issues.size() - uniqueIssues.size();
         if (duplicateCount > 0) {
@@ -396,14 +698,15 @@ public class AnalysisEngine {
     /**
      * Create empty result (no files found)
      */
-    private ScanResult createEmptyResult(Instant startTime) {
-        return new ScanResult.Builder()
+    private ScanResult createEmptyResult(Instant startTime, AnalysisMetrics metrics) {
+        ScanResult.Builder builder = new ScanResult.Builder()
             .sourcePath(sourcePath)
             .startTime(startTime)
             .endTime(Instant.now())
             .addStatistic("total_files", 0)
-            .addStatistic("total_issues", 0)
-            .build();
+            .addStatistic("total_issues", 0);
+        metrics.toStatistics().forEach(builder::addStatistic);
+        return builder.build();
     }
 
     /**
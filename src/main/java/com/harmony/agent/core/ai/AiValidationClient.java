@@ -1,16 +1,19 @@
 package com.harmony.agent.core.ai;
 
 import com.google.common.util.concurrent.RateLimiter;
+import com.harmony.agent.config.AppConfig;
 import com.harmony.agent.config.ConfigManager;
 import com.harmony.agent.llm.model.LLMRequest;
 import com.harmony.agent.llm.model.LLMResponse;
 import com.harmony.agent.llm.model.Message;
 import com.harmony.agent.llm.provider.LLMProvider;
 import com.harmony.agent.llm.provider.ProviderFactory;
+import com.harmony.agent.llm.provider.SiliconFlowProvider;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
 import java.util.List;
+import java.util.concurrent.atomic.LongAdder;
 
 /**
  * AI Validation Client - Specialized client for security issue validation
@@ -30,6 +33,13 @@ public class AiValidationClient {
     private final ConfigManager configManager;
     private final RateLimiter rateLimiter; // Client-side rate limiting
 
+    // 调用统计（累计值，调用方按前后快照求差）
+    private final LongAdder requestCount = new LongAdder();
+    private final LongAdder retryCount = new LongAdder();
+    private final LongAdder failureCount = new LongAdder();
+    private final LongAdder promptTokens = new LongAdder();
+    private final LongAdder completionTokens = new LongAdder();
+
     /**
      * Constructor with default configuration
      */
@@ -68,6 +78,12 @@ public class AiValidationClient {
         // Create provider factory
         ProviderFactory factory = ProviderFactory.createDefault(openaiKey, claudeKey, siliconflowKey, nhhKey);
 
+        // SiliconFlow（OpenAI 兼容）支持 providers.siliconflow.base_url 覆盖，可指向私有网关或本地桩服务
+        String siliconflowBaseUrl = providerBaseUrl(configManager, "siliconflow");
+        if (siliconflowBaseUrl != null && siliconflowKey != null && !siliconflowKey.isEmpty()) {
+            factory.registerProvider("siliconflow", new SiliconFlowProvider(siliconflowKey, siliconflowBaseUrl));
+        }
+
         // Use OpenAI for validation (fast and cost-effective)
         // Can be configured to use Claude for more complex analysis
         String providerName = configManager.getConfig().getAi().getProvider();
@@ -90,6 +106,17 @@ public class AiValidationClient {
         }
     }
 
+    /**
+     * 读取 providers.&lt;name&gt;.base_url，未配置时返回 null
+     */
+    private static String providerBaseUrl(ConfigManager configManager, String providerName) {
+        AppConfig.ProviderConfig providerConfig = configManager.getConfig().getAi().getProviders().get(providerName);
+        if (providerConfig == null || providerConfig.getBaseUrl() == null || providerConfig.getBaseUrl().isBlank()) {
+            return null;
+        }
+        return providerConfig.getBaseUrl();
+    }
+
     /**
      * Constructor with custom provider
      */
@@ -127,6 +154,10 @@ public class AiValidationClient {
         IOException lastException = null;
 
         for (int attempt = 0; attempt < MAX_RETRIES; attempt++) {
+            if (attempt > 0) {
+                retryCount.increment();
+            }
+            requestCount.increment();
             try {
                 return sendRequestInternal(prompt, expectJson);
             } catch (IOException e) {
@@ -145,6 +176,7 @@ public class AiValidationClient {
             }
         }
 
+        failureCount.increment();
         throw new AiClientException("AI validation failed after " + MAX_RETRIES + " retries",
             lastException);
     }
@@ -159,12 +191,13 @@ public class AiValidationClient {
             .temperature(DEFAULT_TEMPERATURE)
             .maxTokens(DEFAULT_MAX_TOKENS);
 
-        // Add system message for JSON mode
+        // Add system message for JSON mode; providers with structured output also get the schema
         if (expectJson) {
             requestBuilder.addSystemMessage(
                 "You are a security analysis expert. " +
                 "Always respond with valid JSON only, no additional text."
             );
+            requestBuilder.jsonSchema("issue_validation", PromptBuilder.VALIDATION_RESPONSE_SCHEMA);
         }
 
         // Add user prompt
@@ -181,6 +214,9 @@ public class AiValidationClient {
             throw new IOException("LLM request failed: " + response.getErrorMessage());
         }
 
+        promptTokens.add(response.getPromptTokens());
+        completionTokens.add(response.getCompletionTokens());
+
         String content = response.getContent();
         if (content == null || content.trim().isEmpty()) {
             throw new IOException("LLM returned empty response");
@@ -213,6 +249,27 @@ public class AiValidationClient {
         return model;
     }
 
+    /**
+     * 获取累计调用统计（HTTP 请求数含重试）
+     */
+    public UsageStats getUsageStats() {
+        return new UsageStats(requestCount.sum(), retryCount.sum(), failureCount.sum(),
+            promptTokens.sum(), completionTokens.sum());
+    }
+
+    /**
+     * 调用统计快照
+     */
+    public record UsageStats(long requests, long retries, long failures,
+                             long promptTokens, long completionTokens) {
+
+        public UsageStats minus(UsageStats other) {
+            return new UsageStats(requests - other.requests, retries - other.retries,
+                failures - other.failures, promptTokens - other.promptTokens,
+                completionTokens - other.completionTokens);
+        }
+    }
+
     /**
      * Custom exception for AI client errors
      */
@@ -2,6 +2,7 @@ package com.harmony.agent.core.ai;
 
 import com.google.common.cache.Cache;
 import com.google.common.cache.CacheBuilder;
+import com.harmony.agent.core.metrics.IssueTracer;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -98,7 +99,11 @@ public class CachedAiValidationClient {
         if (usePersistentCache) {
             // 使用新的持久化缓存 (P1 优化) - 线程安全
             synchronized (cacheLock) {
-                String cached = persistentCache.get(cacheKey);
+                String cached;
+                try (IssueTracer.Span span = IssueTracer.currentSpan("cache_lookup")) {
+                    cached = persistentCache.get(cacheKey);
+                    span.arg("result", cached != null ? "hit" : "miss");
+                }
                 if (cached != null) {
                     logger.debug("Cache HIT (persistent) - returning cached response");
                     return cached;
@@ -106,7 +111,10 @@ public class CachedAiValidationClient {
 
                 logger.debug("Cache MISS - sending request to LLM");
                 synchronized (delegateLock) {
-                    String result = delegate.sendRequest(prompt, expectJson);
+                    String result;
+                    try (IssueTracer.Span ignored = IssueTracer.currentSpan("llm_call")) {
+                        result = delegate.sendRequest(prompt, expectJson);
+                    }
                     persistentCache.put(cacheKey, result);
                     return result;
                 }
@@ -119,7 +127,9 @@ public class CachedAiValidationClient {
                     String result = legacyCache.get(cacheKey, () -> {
                         logger.debug("Cache MISS - sending request to LLM");
                         synchronized (delegateLock) {
-                            return delegate.sendRequest(prompt, expectJson);
+                            try (IssueTracer.Span ignored = IssueTracer.currentSpan("llm_call")) {
+                                return delegate.sendRequest(prompt, expectJson);
+                            }
                         }
                     });
 
@@ -139,6 +149,20 @@ public class CachedAiValidationClient {
         }
     }
 
+    /**
+     * 移除某个提示的缓存响应（例如响应无法解析时，避免后续扫描重放同一个坏响应）
+     */
+    public void invalidate(String prompt, boolean expectJson) {
+        String cacheKey = createCacheKey(prompt, expectJson);
+        synchronized (cacheLock) {
+            if (usePersistentCache && persistentCache != null) {
+                persistentCache.remove(cacheKey);
+            } else {
+                legacyCache.invalidate(cacheKey);
+            }
+        }
+    }
+
     /**
      * 创建缓存键
      * 使用哈希值以节省长提示的内存
@@ -170,6 +194,13 @@ public class CachedAiValidationClient {
         return delegate.getModelName();
     }
 
+    /**
+     * 获取底层客户端的调用统计（缓存命中不计入）
+     */
+    public AiValidationClient.UsageStats getUsageStats() {
+        return delegate.getUsageStats();
+    }
+
     /**
      * 获取缓存统计信息
      */
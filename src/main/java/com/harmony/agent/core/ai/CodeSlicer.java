@@ -1,27 +1,30 @@
 package com.harmony.agent.core.ai;
 
+import com.harmony.agent.core.parser.CallGraph;
+import com.harmony.agent.core.parser.SourceModel;
+import com.harmony.agent.core.parser.SourceModelCache;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
 import java.io.IOException;
-import java.nio.file.Files;
 import java.nio.file.Path;
 import java.util.Collections;
 import java.util.List;
-import java.util.Map;
-import java.util.concurrent.ConcurrentHashMap;
 import java.util.regex.Pattern;
 
 /**
  * Code Slicer - Extract code context for AI analysis
- * Extracts relevant code snippets (function bodies) based on line numbers
+ * Extracts relevant code snippets (function bodies) based on line numbers.
+ * Function ranges come from the shared {@link SourceModelCache}, so slices stay current
+ * after autofix edits and a re-slice after a small edit only relexes the edited region.
+ * With a project {@link CallGraph}, 1-hop caller snippets can be added under a fixed size budget.
  */
 public class CodeSlicer {
 
     private static final Logger logger = LoggerFactory.getLogger(CodeSlicer.class);
 
-    // Cache for file contents to avoid repeated disk reads
-    private final Map<Path, List<String>> fileCache = new ConcurrentHashMap<>();
+    // Per-file structural models (LRU when bounded by a heap budget)
+    private final SourceModelCache models;
 
     // Pattern for detecting function signatures in C/C++
     private static final Pattern FUNCTION_PATTERN = Pattern.compile(
@@ -33,6 +36,19 @@ public class CodeSlicer {
     private static final int FALLBACK_AFTER_LINES = 20;
     private static final int MAX_FUNCTION_SEARCH_LINES = 50;
 
+    // 1-hop caller context: a few lines around each call site, ~500 prompt tokens at most
+    private static final int MAX_CALLERS = 3;
+    private static final int CALLER_CONTEXT_LINES = 2;
+    private static final int MAX_CALLER_CONTEXT_CHARS = 2000;
+
+    public CodeSlicer() {
+        this(SourceModelCache.global());
+    }
+
+    public CodeSlicer(SourceModelCache models) {
+        this.models = models;
+    }
+
     /**
      * Get code context slice for a specific issue location
      *
@@ -42,7 +58,8 @@ public class CodeSlicer {
      */
     public String getContextSlice(Path file, int lineNumber) {
         try {
-            List<String> lines = getLines(file);
+            SourceModel model = getModel(file);
+            List<String> lines = model != null ? model.getLines() : Collections.emptyList();
 
             if (lines.isEmpty()) {
                 return "[Error: File is empty or cannot be read]";
@@ -56,9 +73,17 @@ public class CodeSlicer {
             // Convert to 0-based index
             int issueLineIndex = lineNumber - 1;
 
-            // Find function boundaries
-            int functionStart = findFunctionStart(lines, issueLineIndex);
-            int functionEnd = findFunctionEnd(lines, functionStart, issueLineIndex);
+            // Find function boundaries: token-level ranges first, line heuristics as fallback
+            SourceModel.Function function = model.functionAt(lineNumber).orElse(null);
+            int functionStart;
+            int functionEnd;
+            if (function != null) {
+                functionStart = function.startLine() - 1;
+                functionEnd = Math.min(function.endLine(), lines.size()) - 1;
+            } else {
+                functionStart = findFunctionStart(lines, issueLineIndex);
+                functionEnd = findFunctionEnd(lines, functionStart, issueLineIndex);
+            }
 
             // Extract the slice
             List<String> slice = lines.subList(functionStart, Math.min(functionEnd + 1, lines.size()));
@@ -83,17 +108,57 @@ public class CodeSlicer {
     }
 
     /**
-     * Get cached file lines
+     * Get call-site snippets from the direct callers of the function containing the issue line.
+     * Reachable callers come first; snippets that would exceed the caller context budget are dropped.
+     *
+     * @param callGraph Project call graph (null = no caller context)
+     * @return Caller snippets, or an empty string if no callers are known
      */
-    private List<String> getLines(Path file) {
-        return fileCache.computeIfAbsent(file, f -> {
-            try {
-                return Files.readAllLines(f);
-            } catch (IOException e) {
-                logger.error("Failed to read file for slicing: {}", f, e);
-                return Collections.emptyList();
+    public String getCallerContext(Path file, int lineNumber, CallGraph callGraph) {
+        if (callGraph == null) {
+            return "";
+        }
+        StringBuilder result = new StringBuilder();
+        int shown = 0;
+        for (CallGraph.CallSite site : callGraph.callersOf(file.toString(), lineNumber)) {
+            if (shown == MAX_CALLERS) {
+                break;
+            }
+            SourceModel model = getModel(site.file());
+            List<String> lines = model != null ? model.getLines() : Collections.emptyList();
+            if (site.line() < 1 || site.line() > lines.size()) {
+                continue;
+            }
+
+            int from = Math.max(1, site.line() - CALLER_CONTEXT_LINES);
+            int to = Math.min(lines.size(), site.line() + CALLER_CONTEXT_LINES);
+            StringBuilder snippet = new StringBuilder(String.format("// Caller: %s() in %s (lines %d-%d)\n",
+                site.caller(), site.file().getFileName(), from, to));
+            for (int lineNum = from; lineNum <= to; lineNum++) {
+                String marker = (lineNum == site.line()) ? " <<< CALL" : "";
+                snippet.append(String.format("%4d: %s%s\n", lineNum, lines.get(lineNum - 1), marker));
+            }
+            if (result.length() + snippet.length() > MAX_CALLER_CONTEXT_CHARS) {
+                break;
             }
-        });
+            result.append(snippet);
+            shown++;
+        }
+        return result.toString();
+    }
+
+    /**
+     * Get the cached structural model (incrementally refreshed if the file changed)
+     *
+     * @return the model, or null if the file cannot be read
+     */
+    public SourceModel getModel(Path file) {
+        try {
+            return models.get(file);
+        } catch (IOException e) {
+            logger.error("Failed to read file for slicing: {}", file, e);
+            return null;
+        }
     }
 
     /**
@@ -175,14 +240,21 @@ public class CodeSlicer {
      * Clear the file cache (useful for testing or low-memory scenarios)
      */
     public void clearCache() {
-        fileCache.clear();
+        models.clear();
         logger.debug("Code slicer cache cleared");
     }
 
+    /**
+     * Bound the file cache to the given number of files (least recently used evicted first); 0 = unbounded
+     */
+    public void setMaxCachedFiles(int maxCachedFiles) {
+        models.setMaxEntries(maxCachedFiles);
+    }
+
     /**
      * Get cache statistics
      */
     public int getCacheSize() {
-        return fileCache.size();
+        return models.size();
     }
 }
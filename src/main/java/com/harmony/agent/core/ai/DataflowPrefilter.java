@@ -0,0 +1,533 @@
+package com.harmony.agent.core.ai;
+
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.parser.CLexer;
+import com.harmony.agent.core.parser.ProjectFacts;
+import com.harmony.agent.core.parser.SourceModel;
+
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Locale;
+import java.util.Optional;
+import java.util.Set;
+
+/**
+ * Dataflow Prefilter - refutes mechanically disprovable findings before AI validation
+ *
+ * Runs a small def-use and constant-size pass over the token range of the function that
+ * contains the finding (taken from the cached {@link SourceModel}). Only three shapes are
+ * recognised, and each must hold on straight-line code next to the reported statement:
+ * - allocation followed by an if that leaves (return/goto/break/continue/exit/abort) when the result is NULL
+ * - strcpy() of a string literal into a char array declared large enough
+ * - free(p) immediately followed by p = NULL (later free/use cannot reach freed memory)
+ * Anything else is left to the AI. Allocator and free wrappers from the project's
+ * {@link ProjectFacts} count as malloc/free.
+ */
+public class DataflowPrefilter {
+
+    private static final Set<String> ALLOCATORS = Set.of(
+        "malloc", "calloc", "realloc", "strdup", "strndup", "aligned_alloc"
+    );
+    private static final Set<String> NULL_VALUES = Set.of("NULL", "0", "nullptr");
+    // Statements that leave the allocation's path; asserts do not count (compiled out under NDEBUG)
+    private static final Set<String> LEAVING_STATEMENTS = Set.of("return", "goto", "break", "continue");
+    private static final Set<String> NORETURN_CALLS = Set.of("exit", "abort", "_exit", "_Exit", "quick_exit");
+
+    /**
+     * Try to refute a finding
+     *
+     * @param issue finding from a static analyzer
+     * @param model structural model of the finding's file (may be null)
+     * @return reason the finding is a false positive, or empty if it needs AI validation
+     */
+    public Optional<String> refute(SecurityIssue issue, SourceModel model) {
+        return refute(issue, model, null);
+    }
+
+    /**
+     * Try to refute a finding, treating the project's allocator / free wrappers like malloc / free
+     *
+     * @param facts project fact index (may be null)
+     */
+    public Optional<String> refute(SecurityIssue issue, SourceModel model, ProjectFacts facts) {
+        if (model == null || issue.getLocation() == null) {
+            return Optional.empty();
+        }
+        int line = issue.getLocation().getLineNumber();
+        SourceModel.Function function = model.functionAt(line).orElse(null);
+        if (function == null) {
+            return Optional.empty();
+        }
+
+        FunctionView view = new FunctionView(model, function, facts);
+        String rule = ruleKey(issue);
+        if (rule.contains("strcpy")) {
+            return view.literalCopyFits(line);
+        }
+        if (rule.contains("use-after-free") || rule.contains("double-free")) {
+            return view.nulledAfterFree(line);
+        }
+        if (rule.contains("alloc") && (rule.contains("null") || rule.contains("unchecked"))) {
+            return view.allocationNullChecked(line);
+        }
+        return Optional.empty();
+    }
+
+    /**
+     * Rule identity: Semgrep check_id when present, otherwise the title (regex findings)
+     */
+    static String ruleKey(SecurityIssue issue) {
+        Object checkId = issue.getMetadata().get("check_id");
+        String key = checkId != null ? checkId.toString() : issue.getTitle();
+        return key.toLowerCase(Locale.ROOT).replace('_', '-').replace(' ', '-');
+    }
+
+    /**
+     * Token-level view of one function body
+     */
+    private static final class FunctionView {
+        private final SourceModel model;
+        private final ProjectFacts facts;
+        private final int bodyStart;
+        private final int bodyEnd; // exclusive
+
+        FunctionView(SourceModel model, SourceModel.Function function, ProjectFacts facts) {
+            this.model = model;
+            this.facts = facts;
+            this.bodyStart = function.openBrace() + 1;
+            this.bodyEnd = function.closeBrace() < 0 ? model.getTokenCount() : function.closeBrace();
+        }
+
+        // ===== allocation NULL-checked before use =====
+
+        Optional<String> allocationNullChecked(int line) {
+            for (int i = firstOnLine(line); i >= 0 && i < bodyEnd && model.getTokenLine(i) == line; i++) {
+                if (!isAllocator(text(i)) || !text(i + 1).equals("(")) {
+                    continue;
+                }
+                int close = model.getMatchingBracket(i + 1);
+                if (close < 0) {
+                    return Optional.empty();
+                }
+                // if ((p = malloc(n)) == NULL) return ...;
+                if (text(close + 1).equals(")") && isEqualsNull(close + 2)) {
+                    int condition = enclosingParen(close + 2);
+                    if (condition > bodyStart && enclosingParen(model.getMatchingBracket(close + 1)) == condition
+                            && isOperandStart(model.getMatchingBracket(close + 1) - 1)
+                            && isOperandEnd(close + 4) && leavesWhenTrue(condition)) {
+                        return Optional.of(text(i) + "() result is compared against NULL in the same condition at line "
+                            + line + ", which leaves on NULL");
+                    }
+                    continue;
+                }
+
+                int assign = i - 1;
+                while (assign >= bodyStart && text(assign).equals(")") && model.getMatchingBracket(assign) > 0) {
+                    assign = model.getMatchingBracket(assign) - 1;  // skip casts
+                }
+                if (assign <= bodyStart || !text(assign).equals("=") || !text(close + 1).equals(";")) {
+                    continue;
+                }
+                List<String> target = lvalueBefore(assign);
+                if (target.isEmpty()) {
+                    continue;
+                }
+                // The check must be the next statement at the allocation's depth: a test nested
+                // under another condition does not cover the fall-through path
+                int condition = close + 3;
+                if (!text(close + 2).equals("if") || !text(condition).equals("(")) {
+                    continue;
+                }
+                int use = findOccurrence(target, condition + 1);
+                if (use >= 0 && use < model.getMatchingBracket(condition)
+                        && enclosingParen(use) == condition && isNullTest(use, target.size())
+                        && leavesWhenTrue(condition)) {
+                    return Optional.of(text(i) + "() result assigned to " + String.join("", target)
+                        + " is NULL-checked at line " + model.getTokenLine(use) + ", which leaves on NULL");
+                }
+            }
+            return Optional.empty();
+        }
+
+        /**
+         * Whether the operand at use is true exactly when the pointer is NULL: !p, p == NULL, NULL == p.
+         * A bare truth test (if (p)) is not: its body runs on the non-NULL path.
+         */
+        private boolean isNullTest(int use, int length) {
+            String before = text(use - 1);
+            if (before.equals("!")) {
+                return isOperandStart(use - 2) && isOperandEnd(use + length);
+            }
+            if (isEqualsNull(use + length)) {
+                return isOperandStart(use - 1) && isOperandEnd(use + length + 2);
+            }
+            return before.equals("==") && NULL_VALUES.contains(text(use - 2))
+                && isOperandStart(use - 3) && isOperandEnd(use + length);
+        }
+
+        private boolean isEqualsNull(int operator) {
+            return text(operator).equals("==") && NULL_VALUES.contains(text(operator + 1));
+        }
+
+        // Only || joins operands: when one of them is the NULL test the whole condition holds on NULL
+        private boolean isOperandStart(int index) {
+            return text(index).equals("(") || text(index).equals("||");
+        }
+
+        private boolean isOperandEnd(int index) {
+            return text(index).equals(")") || text(index).equals("||");
+        }
+
+        /**
+         * Whether the if statement with this condition is a top-level || chain whose body
+         * (a single statement, or the last statement of a block) leaves the current path
+         */
+        private boolean leavesWhenTrue(int condition) {
+            if (!text(condition - 1).equals("if")) {
+                return false;
+            }
+            int close = model.getMatchingBracket(condition);
+            if (close < 0) {
+                return false;
+            }
+            for (int j = condition + 1; j < close; j++) {
+                String token = text(j);
+                if (token.equals("(") || token.equals("[")) {
+                    j = model.getMatchingBracket(j);
+                    if (j < 0) {
+                        return false;
+                    }
+                } else if (token.equals("&&") || token.equals("?") || token.equals(",")) {
+                    return false;
+                }
+            }
+
+            int statement = close + 1;
+            if (text(statement).equals("{")) {
+                int end = model.getMatchingBracket(statement);
+                if (end < 0 || !text(end - 1).equals(";")) {
+                    return false;
+                }
+                statement = end - 2;
+                while (statement > close + 1 && !text(statement).equals(";") && !text(statement).equals("{")
+                        && !text(statement).equals("}")) {
+                    if (text(statement).equals(")") || text(statement).equals("]")) {
+                        statement = model.getMatchingBracket(statement);
+                        if (statement < 0) {
+                            return false;
+                        }
+                    }
+                    statement--;
+                }
+                statement++;
+            }
+            return LEAVING_STATEMENTS.contains(text(statement))
+                || (NORETURN_CALLS.contains(text(statement)) && text(statement + 1).equals("("));
+        }
+
+        private int enclosingParen(int index) {
+            for (int j = index - 1; j >= bodyStart; j--) {
+                String token = text(j);
+                if (token.equals(")")) {
+                    j = model.getMatchingBracket(j);
+                    if (j < 0) {
+                        return -1;
+                    }
+                } else if (token.equals("(")) {
+                    return j;
+                } else if (token.equals(";") || token.equals("{") || token.equals("}")) {
+                    return -1;
+                }
+            }
+            return -1;
+        }
+
+        // ===== strcpy of a literal that fits =====
+
+        Optional<String> literalCopyFits(int line) {
+            for (int i = firstOnLine(line); i >= 0 && i < bodyEnd && model.getTokenLine(i) == line; i++) {
+                if (!text(i).equals("strcpy") || !text(i + 1).equals("(") || text(i - 1).equals(".")
+                        || text(i - 1).equals("->")) {
+                    continue;
+                }
+                int close = model.getMatchingBracket(i + 1);
+                if (close < 0 || kind(i + 2) != CLexer.Kind.IDENTIFIER || !text(i + 3).equals(",")) {
+                    continue;
+                }
+                long bytes = literalBytes(i + 4, close);
+                if (bytes < 0) {
+                    continue;
+                }
+                String destination = text(i + 2);
+                int declaration = arrayDeclaration(destination, i);
+                if (declaration < 0) {
+                    continue;
+                }
+                long capacity = parseSize(text(declaration + 2));
+                if (capacity >= bytes) {
+                    return Optional.of("strcpy() copies a " + bytes + "-byte string literal into " + destination
+                        + ", declared as char " + destination + "[" + capacity + "] at line "
+                        + model.getTokenLine(declaration));
+                }
+            }
+            return Optional.empty();
+        }
+
+        /**
+         * Size in bytes (including the terminator) of adjacent plain string literals in [from, to), or -1
+         */
+        private long literalBytes(int from, int to) {
+            if (from >= to) {
+                return -1;
+            }
+            long bytes = 1;
+            for (int j = from; j < to; j++) {
+                String literal = text(j);
+                if (kind(j) != CLexer.Kind.STRING || !literal.startsWith("\"")
+                        || literal.length() < 2 || !literal.endsWith("\"")) {
+                    return -1;
+                }
+                bytes += decodedLength(literal.substring(1, literal.length() - 1));
+            }
+            return bytes;
+        }
+
+        private static long decodedLength(String body) {
+            long bytes = 0;
+            int i = 0;
+            while (i < body.length()) {
+                char c = body.charAt(i);
+                if (c != '\\') {
+                    int codePoint = body.codePointAt(i);
+                    bytes += new String(Character.toChars(codePoint)).getBytes(StandardCharsets.UTF_8).length;
+                    i += Character.charCount(codePoint);
+                    continue;
+                }
+                if (i + 1 >= body.length()) {
+                    return bytes + 1;
+                }
+                char next = body.charAt(i + 1);
+                i += 2;
+                if (next == '\n') {
+                    continue;  // line continuation
+                }
+                if (next == 'u' || next == 'U') {
+                    i = Math.min(body.length(), i + (next == 'u' ? 4 : 8));
+                    bytes += 4;  // universal character name: at most 4 bytes in UTF-8
+                    continue;
+                }
+                if (next == 'x') {
+                    while (i < body.length() && Character.digit(body.charAt(i), 16) >= 0) {
+                        i++;
+                    }
+                } else if (next >= '0' && next <= '7') {
+                    int end = Math.min(body.length(), i + 2);
+                    while (i < end && body.charAt(i) >= '0' && body.charAt(i) <= '7') {
+                        i++;
+                    }
+                }
+                bytes++;
+            }
+            return bytes;
+        }
+
+        /**
+         * Index of the in-scope {@code char name[N]} declaration (N a literal), or -1.
+         * Scans backwards from the use, skipping closed blocks and parenthesised groups (sibling
+         * scopes, parameter lists); the first declaration of the name decides.
+         */
+        private int arrayDeclaration(String name, int use) {
+            for (int j = use - 1; j > 0; j--) {
+                String token = text(j);
+                if (token.equals("}") || token.equals(")")) {
+                    j = model.getMatchingBracket(j);
+                    if (j < 0) {
+                        return -1;
+                    }
+                    continue;
+                }
+                if (!token.equals(name) || kind(j) != CLexer.Kind.IDENTIFIER) {
+                    continue;
+                }
+                String before = text(j - 1);
+                boolean declares = kind(j - 1) == CLexer.Kind.IDENTIFIER || before.equals("*");
+                if (!declares) {
+                    continue;
+                }
+                if (before.equals("char") && text(j + 1).equals("[") && kind(j + 2) == CLexer.Kind.NUMBER
+                        && text(j + 3).equals("]") && !text(j + 4).equals("[") && parseSize(text(j + 2)) > 0) {
+                    return j;
+                }
+                return -1;
+            }
+            return -1;
+        }
+
+        private static long parseSize(String number) {
+            String digits = number.replaceAll("[uUlL]+$", "").replace("'", "");
+            try {
+                return Long.decode(digits);
+            } catch (NumberFormatException e) {
+                return -1;
+            }
+        }
+
+        // ===== free(p); p = NULL; =====
+
+        Optional<String> nulledAfterFree(int line) {
+            int first = firstOnLine(line);
+            if (first < 0) {
+                return Optional.empty();
+            }
+            // Structural rules report at the first free()
+            for (int i = first; i < bodyEnd && model.getTokenLine(i) == line; i++) {
+                if (isFreeCall(i)) {
+                    Optional<String> reason = nulledRightAfter(i);
+                    if (reason.isPresent()) {
+                        return reason;
+                    }
+                    break;
+                }
+            }
+            // Reported at the later use: nearest preceding free() of a pointer used on this line
+            for (int i = first - 1; i >= bodyStart; i--) {
+                if (isFreeCall(i) && occursOnLine(freedPointer(i), first, line)) {
+                    return nulledRightAfter(i);
+                }
+            }
+            return Optional.empty();
+        }
+
+        private Optional<String> nulledRightAfter(int free) {
+            List<String> pointer = freedPointer(free);
+            int next = model.getMatchingBracket(free + 1) + 2;  // after "free(...);"
+            if (pointer.isEmpty() || !matchesAt(pointer, next)) {
+                return Optional.empty();
+            }
+            int assign = next + pointer.size();
+            if (text(assign).equals("=") && NULL_VALUES.contains(text(assign + 1)) && text(assign + 2).equals(";")) {
+                return Optional.of(String.join("", pointer) + " is set to NULL right after " + text(free)
+                    + "() at line " + model.getTokenLine(free)
+                    + "; a later free() is a no-op and no later use can reach freed memory");
+            }
+            return Optional.empty();
+        }
+
+        private boolean isFreeCall(int i) {
+            if (!isDeallocator(text(i)) || !text(i + 1).equals("(") || text(i - 1).equals(".")
+                    || text(i - 1).equals("->")) {
+                return false;
+            }
+            int close = model.getMatchingBracket(i + 1);
+            return close > 0 && text(close + 1).equals(";");
+        }
+
+        /**
+         * Pointer expression inside free(...) when it is a plain lvalue (p, s->p, s.p), else empty
+         */
+        private List<String> freedPointer(int free) {
+            int close = model.getMatchingBracket(free + 1);
+            List<String> pointer = new ArrayList<>();
+            for (int j = free + 2; j < close; j++) {
+                boolean expectIdentifier = pointer.size() % 2 == 0;
+                if (expectIdentifier ? kind(j) != CLexer.Kind.IDENTIFIER
+                        : !(text(j).equals("->") || text(j).equals("."))) {
+                    return List.of();
+                }
+                pointer.add(text(j));
+            }
+            return pointer.size() % 2 == 1 ? pointer : List.of();
+        }
+
+        private boolean occursOnLine(List<String> pointer, int first, int line) {
+            if (pointer.isEmpty()) {
+                return false;
+            }
+            for (int i = first; i < bodyEnd && model.getTokenLine(i) == line; i++) {
+                if (matchesAt(pointer, i)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // ===== helpers =====
+
+        private boolean isAllocator(String name) {
+            return ALLOCATORS.contains(name) || (facts != null && facts.isAllocatorWrapper(name));
+        }
+
+        private boolean isDeallocator(String name) {
+            return name.equals("free") || (facts != null && facts.isDeallocatorWrapper(name));
+        }
+
+        /**
+         * Lvalue ending just before index (p, s->p, s.p) as token texts, else empty
+         */
+        private List<String> lvalueBefore(int index) {
+            int j = index - 1;
+            if (kind(j) != CLexer.Kind.IDENTIFIER) {
+                return List.of();
+            }
+            while (j - 2 >= bodyStart && (text(j - 1).equals("->") || text(j - 1).equals("."))
+                    && kind(j - 2) == CLexer.Kind.IDENTIFIER) {
+                j -= 2;
+            }
+            List<String> lvalue = new ArrayList<>();
+            for (int k = j; k < index; k++) {
+                lvalue.add(text(k));
+            }
+            return lvalue;
+        }
+
+        private int findOccurrence(List<String> target, int from) {
+            for (int i = from; i < bodyEnd; i++) {
+                if (matchesAt(target, i)) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        /**
+         * Whether the token sequence starts at index and is not the tail of a longer member access
+         */
+        private boolean matchesAt(List<String> target, int index) {
+            if (index + target.size() > bodyEnd) {
+                return false;
+            }
+            String before = text(index - 1);
+            if (before.equals("->") || before.equals(".")) {
+                return false;
+            }
+            for (int k = 0; k < target.size(); k++) {
+                if (!text(index + k).equals(target.get(k))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        private int firstOnLine(int line) {
+            for (int i = bodyStart; i < bodyEnd; i++) {
+                int tokenLine = model.getTokenLine(i);
+                if (tokenLine == line) {
+                    return i;
+                }
+                if (tokenLine > line) {
+                    return -1;
+                }
+            }
+            return -1;
+        }
+
+        private String text(int index) {
+            return index >= 0 && index < model.getTokenCount() ? model.getTokenText(index) : "";
+        }
+
+        private CLexer.Kind kind(int index) {
+            return index >= 0 && index < model.getTokenCount() ? model.getTokenKind(index) : null;
+        }
+    }
+}
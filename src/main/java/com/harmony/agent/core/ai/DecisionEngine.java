@@ -1,18 +1,28 @@
 package com.harmony.agent.core.ai;
 
 import com.google.gson.Gson;
+import com.google.gson.JsonObject;
 import com.google.gson.JsonSyntaxException;
 import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.metrics.AnalysisMetrics;
+import com.harmony.agent.core.metrics.IssueTracer;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.core.model.IssueSeverity;
 import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.parser.CallGraph;
+import com.harmony.agent.core.parser.ProjectFacts;
+import com.harmony.agent.core.parser.SourceModel;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
 import java.nio.file.Path;
 import java.nio.file.Paths;
 import java.util.ArrayList;
+import java.util.Comparator;
 import java.util.List;
+import java.util.Optional;
 import java.util.concurrent.*;
+import java.util.concurrent.atomic.AtomicLong;
 import java.util.stream.Collectors;
 
 /**
@@ -23,8 +33,22 @@ public class DecisionEngine {
 
     private static final Logger logger = LoggerFactory.getLogger(DecisionEngine.class);
 
+    // Process-wide gauges for long-running modes (serve / interactive)
+    private static final MetricsRegistry.Gauge VALIDATIONS_QUEUED = MetricsRegistry.global().gauge(
+        "harmony_ai_validations_queued", "AI validation tasks waiting for a worker");
+    private static final MetricsRegistry.Gauge VALIDATIONS_IN_FLIGHT = MetricsRegistry.global().gauge(
+        "harmony_ai_validations_in_flight", "AI validation tasks currently running");
+
+    // Answer field every validation response must carry; without it the verdict would silently default to false
+    private static final String VERDICT_FIELD = "is_vulnerability";
+
     private final CachedAiValidationClient aiClient;
     private final CodeSlicer codeSlicer;
+    private final DataflowPrefilter dataflowPrefilter = new DataflowPrefilter();
+    private volatile ProjectFacts projectFacts; // Whole-project facts for the current scan (null = unknown)
+    private volatile CallGraph callGraph; // Project call graph for prioritization and caller context (null = none)
+    private volatile long validationTokenBudget; // Estimated prompt tokens per run (0 = unlimited)
+    private volatile VerdictStore verdictStore; // Durable triage verdicts across scans (null = disabled)
     private final Gson gson;
     private final ExecutorService executorService; // For parallel AI validation
     private final int validationConcurrency; // Max concurrent validations
@@ -55,6 +79,8 @@ public class DecisionEngine {
         this.gson = new Gson();
         this.executorService = executorService;
         this.validationConcurrency = configManager.getConfig().getAi().getValidationConcurrency();
+        this.validationTokenBudget = configManager.getConfig().getAi().getValidationTokenBudget();
+        this.verdictStore = configManager.getConfig().getAi().isVerdictStoreEnabled() ? VerdictStore.global() : null;
 
         logger.info("Decision Engine initialized with AI provider: {}, concurrency: {}",
             aiClient.getProviderName(), validationConcurrency);
@@ -79,27 +105,71 @@ public class DecisionEngine {
      * @return Enhanced issues list (false positives filtered out)
      */
     public List<SecurityIssue> enhanceIssues(List<SecurityIssue> staticIssues) {
+        return enhanceIssues(staticIssues, new AnalysisMetrics());
+    }
+
+    /**
+     * Enhance security issues and record slicing time, AI usage and cache deltas into metrics
+     *
+     * @param staticIssues Issues from static analyzers
+     * @param metrics Metrics collector for this analysis run
+     * @return Enhanced issues list (false positives filtered out)
+     */
+    public List<SecurityIssue> enhanceIssues(List<SecurityIssue> staticIssues, AnalysisMetrics metrics) {
+        AiValidationClient.UsageStats usageBefore = aiClient.getUsageStats();
+        CachedAiValidationClient.CacheStats cacheBefore = aiClient.getStats();
+
         logger.info("Starting parallel AI enhancement for {} issues (concurrency: {})",
             staticIssues.size(), validationConcurrency);
 
         List<SecurityIssue> enhancedIssues = new ArrayList<>();
-        List<Callable<SecurityIssue>> validationTasks = new ArrayList<>();
+        List<SecurityIssue> toValidate = new ArrayList<>();
         List<SecurityIssue> noValidationNeeded = new ArrayList<>();
+        VerdictStore store = verdictStore;
+        VerdictStore.Scan verdictScan = store != null ? store.beginScan() : null;
 
         // Separate issues into those needing validation and those that don't
         for (SecurityIssue issue : staticIssues) {
             if (needsAiValidation(issue)) {
-                validationTasks.add(new AiValidationTask(issue));
-            } else {
-                // High-confidence analyzer (Clang-Tidy), skip AI validation
-                noValidationNeeded.add(createHighConfidenceIssue(issue));
+                toValidate.add(issue);
+                continue;
+            }
+            // High-confidence analyzer (Clang-Tidy), skip AI validation; a human verdict still applies
+            String fingerprint = verdictScan != null ? verdictFingerprint(issue) : null;
+            Optional<VerdictStore.Verdict> human = fingerprint == null ? Optional.empty()
+                : verdictScan.lookup(fingerprint, null, null).filter(v -> v.source() == VerdictStore.Source.HUMAN);
+            if (human.isPresent()) {
+                metrics.increment("verdict_store_hits", 1);
+                metrics.getTracer().instant(issue.getId(), "verdict",
+                    "result", human.get().vulnerability() ? "confirmed" : "rejected",
+                    "source", "stored human", "reason", human.get().reason());
+                if (human.get().vulnerability()) {
+                    noValidationNeeded.add(createEnhancedIssue(issue, storedValidation(issue, human.get()),
+                        fingerprint, VerdictStore.Source.HUMAN));
+                }
+                continue;
             }
+            noValidationNeeded.add(createHighConfidenceIssue(issue, fingerprint));
+            metrics.getTracer().instant(issue.getId(), "verdict", "result", "skipped",
+                "reason", "high-confidence analyzer");
+        }
+
+        // Reachable code first (nearest to an entry point first), so a token budget is spent there
+        CallGraph graph = callGraph;
+        if (graph != null) {
+            prioritizeByReachability(toValidate, graph, metrics);
+        }
+        AtomicLong budget = validationTokenBudget > 0 ? new AtomicLong(validationTokenBudget) : null;
+        List<Callable<SecurityIssue>> validationTasks = new ArrayList<>();
+        for (SecurityIssue issue : toValidate) {
+            validationTasks.add(new AiValidationTask(issue, metrics, budget, verdictScan));
         }
 
         logger.info("Submitting {} issues for parallel AI validation, {} skipped",
             validationTasks.size(), noValidationNeeded.size());
 
         // Process validation tasks in parallel using a bounded thread pool
+        boolean allLookedUp = true;
         if (!validationTasks.isEmpty()) {
             // Create a dedicated validation pool with limited concurrency
             int poolSize = Math.min(validationConcurrency, validationTasks.size());
@@ -109,6 +179,7 @@ public class DecisionEngine {
                 // Submit all tasks and get futures
                 List<Future<SecurityIssue>> futures = new ArrayList<>();
                 for (Callable<SecurityIssue> task : validationTasks) {
+                    VALIDATIONS_QUEUED.inc();
                     futures.add(validationPool.submit(task));
                 }
 
@@ -132,14 +203,19 @@ public class DecisionEngine {
                         Thread.currentThread().interrupt();
                         logger.error("Interrupted while waiting for AI validation result", e);
                         errors++;
+                        allLookedUp = false;
                     } catch (ExecutionException e) {
                         logger.error("AI validation task failed", e.getCause());
                         errors++;
+                        allLookedUp = false;
                     }
                 }
 
                 logger.info("AI enhancement complete: {} validated, {} filtered, {} errors",
                     validated, filtered, errors);
+                metrics.increment("ai_validated", validated);
+                metrics.increment("ai_rejected", filtered);
+                metrics.increment("ai_validation_errors", errors);
 
             } finally {
                 // Shutdown validation pool
@@ -155,17 +231,75 @@ public class DecisionEngine {
             }
         }
 
+        // Stale AI verdicts can only be told apart once every finding has been looked up
+        if (verdictScan != null && allLookedUp) {
+            metrics.increment("verdict_store_evicted", verdictScan.evictUnseen());
+        }
+
         // Add issues that didn't need validation
         enhancedIssues.addAll(noValidationNeeded);
 
         logger.info("Total output issues: {}", enhancedIssues.size());
 
+        metrics.increment("ai_skipped", noValidationNeeded.size());
+        recordUsage(metrics, usageBefore, cacheBefore);
+
         // Log cache statistics
         logCacheStats();
 
         return enhancedIssues;
     }
 
+    /**
+     * Stable sort: reachable issues by call depth, then issues outside any indexed function,
+     * then issues in dead or test-only code
+     */
+    private void prioritizeByReachability(List<SecurityIssue> issues, CallGraph graph, AnalysisMetrics metrics) {
+        int reachable = 0;
+        int unreachable = 0;
+        for (SecurityIssue issue : issues) {
+            CallGraph.Reachability reachability = graph.reachability(
+                issue.getLocation().getFilePath(), issue.getLocation().getLineNumber());
+            if (reachability == CallGraph.Reachability.REACHABLE) {
+                reachable++;
+            } else if (reachability == CallGraph.Reachability.UNREACHABLE) {
+                unreachable++;
+            }
+            metrics.getTracer().instant(issue.getId(), "reachability", "result", reachability.name().toLowerCase());
+        }
+        issues.sort(Comparator.comparingInt(issue -> validationPriority(graph, issue)));
+        metrics.increment("ai_reachable_issues", reachable);
+        metrics.increment("ai_unreachable_issues", unreachable);
+        logger.info("Reachability: {} reachable, {} unreachable, {} outside indexed functions",
+            reachable, unreachable, issues.size() - reachable - unreachable);
+    }
+
+    private static int validationPriority(CallGraph graph, SecurityIssue issue) {
+        String file = issue.getLocation().getFilePath();
+        int line = issue.getLocation().getLineNumber();
+        return switch (graph.reachability(file, line)) {
+            case REACHABLE -> graph.depth(file, line);
+            case UNKNOWN -> Integer.MAX_VALUE - 1;
+            case UNREACHABLE -> Integer.MAX_VALUE;
+        };
+    }
+
+    /**
+     * Reserve estimated prompt tokens (~4 chars per token); once the budget is spent no new
+     * request starts. Cache hits are charged too, so the estimate errs on the side of saving tokens.
+     */
+    private static boolean reserveTokens(AtomicLong budget, String prompt) {
+        long tokens = (prompt.length() + 3) / 4;
+        long remaining;
+        do {
+            remaining = budget.get();
+            if (remaining <= 0) {
+                return false;
+            }
+        } while (!budget.compareAndSet(remaining, remaining - tokens));
+        return true;
+    }
+
     /**
      * Determine if an issue is likely a Semgrep race condition false positive
      * These are extremely common in single-threaded applications
@@ -192,6 +326,13 @@ public class DecisionEngine {
             return false;
         }
 
+        // Project fact index answers "does anything create threads" once per scan
+        ProjectFacts facts = projectFacts;
+        if (facts != null) {
+            logger.debug("Project fact index: creates threads = {}", facts.createsThreads());
+            return !facts.createsThreads();
+        }
+
         // Check for single-threaded indicators in code
         String codeLower = codeSlice.toLowerCase();
         for (String indicator : SINGLE_THREAD_INDICATORS) {
@@ -269,13 +410,13 @@ public class DecisionEngine {
         String codeSlice = codeSlicer.getContextSlice(filePath, lineNumber);
 
         // Build validation prompt
-        String prompt = PromptBuilder.buildIssueValidationPrompt(issue, codeSlice);
+        String prompt = PromptBuilder.buildIssueValidationPrompt(issue, codeSlice, projectFacts);
 
         // Send to AI
         String jsonResponse = aiClient.sendRequest(prompt, true);
 
         // Parse response
-        AiValidationResponse validation = parseValidationResponse(jsonResponse);
+        AiValidationResponse validation = parseValidationResponse(jsonResponse, new AnalysisMetrics());
 
         if (validation.is_vulnerability) {
             // AI confirmed - create enhanced issue
@@ -288,22 +429,55 @@ public class DecisionEngine {
 
     /**
      * Parse AI validation response
+     *
+     * The response is read as JSON first; if the model wrapped it in prose or markdown, the
+     * validation object is extracted from the text (counted as ai_parse_recovered). A response
+     * with no usable object is counted as ai_parse_failures.
      */
-    private AiValidationResponse parseValidationResponse(String jsonResponse)
+    private AiValidationResponse parseValidationResponse(String jsonResponse, AnalysisMetrics metrics)
             throws JsonSyntaxException {
+        Optional<JsonObject> direct = JsonResponseExtractor.parseObject(jsonResponse, VERDICT_FIELD);
+        Optional<JsonObject> object = direct.isPresent() ? direct
+            : JsonResponseExtractor.extractObject(jsonResponse, VERDICT_FIELD);
         try {
-            return gson.fromJson(jsonResponse, AiValidationResponse.class);
+            if (object.isEmpty()) {
+                throw new JsonSyntaxException("No JSON object with " + VERDICT_FIELD + " in AI response");
+            }
+            AiValidationResponse validation = gson.fromJson(object.get(), AiValidationResponse.class);
+            if (direct.isEmpty()) {
+                logger.debug("Recovered validation JSON from surrounding text");
+                metrics.increment("ai_parse_recovered", 1);
+                recordParseOutcome("recovered");
+            } else {
+                recordParseOutcome("direct");
+            }
+            return validation;
         } catch (JsonSyntaxException e) {
             logger.error("Failed to parse AI response as JSON: {}", jsonResponse);
+            metrics.increment("ai_parse_failures", 1);
+            recordParseOutcome("failed");
             throw e;
         }
     }
 
+    private static void recordParseOutcome(String outcome) {
+        MetricsRegistry.global().counter("harmony_ai_response_parses",
+            "AI validation responses by parse outcome", "outcome", outcome).inc();
+    }
+
     /**
      * Create enhanced issue with AI validation
      */
     private SecurityIssue createEnhancedIssue(SecurityIssue original,
                                               AiValidationResponse validation) {
+        return createEnhancedIssue(original, validation, null, null);
+    }
+
+    /**
+     * Create enhanced issue carrying its verdict fingerprint (for human triage) and verdict source
+     */
+    private SecurityIssue createEnhancedIssue(SecurityIssue original, AiValidationResponse validation,
+                                              String fingerprint, VerdictStore.Source storedSource) {
         // Parse AI suggested severity
         IssueSeverity aiSeverity;
         try {
@@ -315,7 +489,7 @@ public class DecisionEngine {
         }
 
         // Build enhanced issue
-        return new SecurityIssue.Builder()
+        SecurityIssue.Builder builder = new SecurityIssue.Builder()
             .id(original.getId())
             .title(original.getTitle())
             .description(original.getDescription())
@@ -327,17 +501,23 @@ public class DecisionEngine {
             .metadata("ai_validated", true)
             .metadata("ai_confidence", AI_CONFIRMED_CONFIDENCE)
             .metadata("ai_explanation", validation.reason)
-            .metadata("original_severity", original.getSeverity().name())
-            .build();
+            .metadata("original_severity", original.getSeverity().name());
+        if (fingerprint != null) {
+            builder.metadata("verdict_fingerprint", fingerprint);
+        }
+        if (storedSource != null) {
+            builder.metadata("verdict_source", storedSource.name().toLowerCase());
+        }
+        return builder.build();
     }
 
     /**
      * Create high-confidence issue (no AI validation needed)
      */
-    private SecurityIssue createHighConfidenceIssue(SecurityIssue original) {
+    private SecurityIssue createHighConfidenceIssue(SecurityIssue original, String fingerprint) {
         double confidence = getBaselineConfidence(original.getAnalyzer());
 
-        return new SecurityIssue.Builder()
+        SecurityIssue.Builder builder = new SecurityIssue.Builder()
             .id(original.getId())
             .title(original.getTitle())
             .description(original.getDescription())
@@ -348,18 +528,43 @@ public class DecisionEngine {
             .metadata(original.getMetadata())
             .metadata("ai_validated", false)
             .metadata("ai_confidence", confidence)
-            .metadata("validation_skipped", "High confidence analyzer")
-            .build();
+            .metadata("validation_skipped", "High confidence analyzer");
+        if (fingerprint != null) {
+            builder.metadata("verdict_fingerprint", fingerprint);
+        }
+        return builder.build();
+    }
+
+    /**
+     * Create issue kept at static-analysis confidence because the AI token budget was spent
+     */
+    private SecurityIssue createBudgetSkippedIssue(SecurityIssue original, String fingerprint) {
+        SecurityIssue.Builder builder = new SecurityIssue.Builder()
+            .id(original.getId())
+            .title(original.getTitle())
+            .description(original.getDescription())
+            .severity(original.getSeverity())
+            .category(original.getCategory())
+            .location(original.getLocation())
+            .analyzer(original.getAnalyzer())
+            .metadata(original.getMetadata())
+            .metadata("ai_validated", false)
+            .metadata("ai_confidence", getBaselineConfidence(original.getAnalyzer()))
+            .metadata("validation_skipped", "AI token budget exhausted");
+        if (fingerprint != null) {
+            builder.metadata("verdict_fingerprint", fingerprint);
+        }
+        return builder.build();
     }
 
     /**
      * Create fallback issue (AI validation failed)
      */
-    private SecurityIssue createFallbackIssue(SecurityIssue original) {
+    private SecurityIssue createFallbackIssue(SecurityIssue original, String fingerprint) {
         double baseConfidence = getBaselineConfidence(original.getAnalyzer());
         double fallbackConfidence = baseConfidence * AI_FAILED_CONFIDENCE_MULTIPLIER;
 
-        return new SecurityIssue.Builder()
+        SecurityIssue.Builder builder = new SecurityIssue.Builder()
             .id(original.getId())
             .title(original.getTitle())
             .description(original.getDescription())
@@ -370,8 +575,42 @@ public class DecisionEngine {
             .metadata(original.getMetadata())
             .metadata("ai_validated", false)
             .metadata("ai_confidence", fallbackConfidence)
-            .metadata("validation_error", "AI validation failed, using static analysis only")
-            .build();
+            .metadata("validation_error", "AI validation failed, using static analysis only");
+        if (fingerprint != null) {
+            builder.metadata("verdict_fingerprint", fingerprint);
+        }
+        return builder.build();
+    }
+
+    /**
+     * Verdict fingerprint of an issue from its function slice; null if the slice cannot be taken
+     */
+    private String verdictFingerprint(SecurityIssue issue) {
+        if (issue.getLocation() == null) {
+            return null;
+        }
+        String slice = codeSlicer.getContextSlice(Paths.get(issue.getLocation().getFilePath()),
+            issue.getLocation().getLineNumber());
+        return verdictFingerprint(issue, slice);
+    }
+
+    private static String verdictFingerprint(SecurityIssue issue, String functionSlice) {
+        if (functionSlice == null || functionSlice.startsWith("[Error")) {
+            return null;
+        }
+        return VerdictStore.fingerprint(DataflowPrefilter.ruleKey(issue), functionSlice);
+    }
+
+    /**
+     * A stored confirmed verdict in the shape of an AI answer, keeping the issue's severity if none was stored
+     */
+    private static AiValidationResponse storedValidation(SecurityIssue issue, VerdictStore.Verdict verdict) {
+        AiValidationResponse validation = new AiValidationResponse();
+        validation.is_vulnerability = true;
+        validation.reason = verdict.reason();
+        validation.suggested_severity = verdict.severity() != null
+            ? verdict.severity() : issue.getSeverity().name();
+        return validation;
     }
 
     /**
@@ -391,6 +630,28 @@ public class DecisionEngine {
         return 0.5; // Default
     }
 
+    /**
+     * Record AI usage and cache deltas for this run (clients without stats are skipped)
+     */
+    private void recordUsage(AnalysisMetrics metrics, AiValidationClient.UsageStats usageBefore,
+                             CachedAiValidationClient.CacheStats cacheBefore) {
+        AiValidationClient.UsageStats usageAfter = aiClient.getUsageStats();
+        if (usageBefore != null && usageAfter != null) {
+            AiValidationClient.UsageStats usage = usageAfter.minus(usageBefore);
+            metrics.increment("ai_requests", usage.requests());
+            metrics.increment("ai_retries", usage.retries());
+            metrics.increment("ai_failures", usage.failures());
+            metrics.increment("ai_prompt_tokens", usage.promptTokens());
+            metrics.increment("ai_completion_tokens", usage.completionTokens());
+        }
+
+        CachedAiValidationClient.CacheStats cacheAfter = aiClient.getStats();
+        if (cacheBefore != null && cacheAfter != null) {
+            metrics.increment("ai_cache_hits", cacheAfter.getHits() - cacheBefore.getHits());
+            metrics.increment("ai_cache_misses", cacheAfter.getMisses() - cacheBefore.getMisses());
+        }
+    }
+
     /**
      * Log cache statistics
      */
@@ -413,6 +674,45 @@ public class DecisionEngine {
         return aiClient.getStats();
     }
 
+    /**
+     * Use a whole-project fact index (threading, entry points, allocator wrappers) for pre-filters
+     * and prompts; null falls back to per-slice heuristics
+     */
+    public void setProjectFacts(ProjectFacts projectFacts) {
+        this.projectFacts = projectFacts;
+    }
+
+    /**
+     * Use a project call graph to validate reachable issues first and to add 1-hop caller
+     * snippets to code slices; null disables both
+     */
+    public void setCallGraph(CallGraph callGraph) {
+        this.callGraph = callGraph;
+    }
+
+    /**
+     * Use a durable verdict store: stored human verdicts, and AI verdicts from the same model and
+     * prompt version, are applied without asking the AI again; null disables it
+     */
+    public void setVerdictStore(VerdictStore verdictStore) {
+        this.verdictStore = verdictStore;
+    }
+
+    /**
+     * Cap the estimated prompt tokens spent on AI validation per run; 0 = unlimited.
+     * Issues left over when the budget runs out keep their static-analysis confidence.
+     */
+    public void setValidationTokenBudget(long validationTokenBudget) {
+        this.validationTokenBudget = Math.max(0, validationTokenBudget);
+    }
+
+    /**
+     * Bound the code slice file cache (heap budget mode); 0 = unbounded
+     */
+    public void limitSliceCache(int maxFiles) {
+        codeSlicer.setMaxCachedFiles(maxFiles);
+    }
+
     /**
      * Clear AI response cache
      */
@@ -440,56 +740,173 @@ public class DecisionEngine {
             .build();
     }
 
+    /**
+     * Verdict location: file, rule and enclosing function (or line outside functions)
+     */
+    private String verdictLocation(Path file, int line, String rule) {
+        SourceModel model = codeSlicer.getModel(file);
+        SourceModel.Function function = model != null ? model.functionAt(line).orElse(null) : null;
+        String place = function != null ? function.name() + "()" : "line " + line;
+        return file.toAbsolutePath().normalize() + "#" + rule + "#" + place;
+    }
+
     /**
      * Callable task for parallel AI validation
      * Enhanced with pre-filtering for obvious Semgrep false positives
      */
     private class AiValidationTask implements java.util.concurrent.Callable<SecurityIssue> {
         private final SecurityIssue originalIssue;
-
-        public AiValidationTask(SecurityIssue issue) {
+        private final AnalysisMetrics metrics;
+        private final IssueTracer tracer;
+        private final AtomicLong tokenBudget; // Shared by the run's tasks (null = unlimited)
+        private final VerdictStore.Scan verdictScan; // This run's verdict store session (null = disabled)
+        private final long createdNanos = System.nanoTime();
+
+        public AiValidationTask(SecurityIssue issue, AnalysisMetrics metrics, AtomicLong tokenBudget,
+                                VerdictStore.Scan verdictScan) {
             this.originalIssue = issue;
+            this.metrics = metrics;
+            this.tracer = metrics.getTracer();
+            this.tokenBudget = tokenBudget;
+            this.verdictScan = verdictScan;
         }
 
         @Override
         public SecurityIssue call() {
+            VALIDATIONS_QUEUED.dec();
+            VALIDATIONS_IN_FLIGHT.inc();
+            String issueId = originalIssue.getId();
+            tracer.span(issueId, "queued", createdNanos).close();
+            // Bind the issue to this thread so the cache client can add cache/LLM spans
+            try (IssueTracer.Scope ignored = tracer.activate(issueId);
+                 IssueTracer.Span ignoredSpan = tracer.span(issueId, "ai_validation")) {
+                return validate();
+            } finally {
+                VALIDATIONS_IN_FLIGHT.dec();
+            }
+        }
+
+        private SecurityIssue validate() {
+            String fingerprint = null;
             try {
                 // Get code context
                 Path filePath = Paths.get(originalIssue.getLocation().getFilePath());
                 int lineNumber = originalIssue.getLocation().getLineNumber();
 
-                String codeSlice = codeSlicer.getContextSlice(filePath, lineNumber);
+                long sliceStart = System.nanoTime();
+                String functionSlice;
+                String codeSlice;
+                try (IssueTracer.Span span = tracer.span(originalIssue.getId(), "slice")) {
+                    functionSlice = codeSlicer.getContextSlice(filePath, lineNumber);
+                    codeSlice = functionSlice;
+                    String callers = codeSlicer.getCallerContext(filePath, lineNumber, callGraph);
+                    if (callers != null && !callers.isEmpty()) {
+                        codeSlice = codeSlice + "\n" + callers;
+                    }
+                    span.arg("chars", codeSlice != null ? codeSlice.length() : 0);
+                }
+                metrics.addDuration("slicing", System.nanoTime() - sliceStart);
+
+                // Durable verdict for this exact code (human, or AI with the same model and prompt) comes first
+                String rule = DataflowPrefilter.ruleKey(originalIssue);
+                if (verdictScan != null) {
+                    fingerprint = verdictFingerprint(originalIssue, functionSlice);
+                }
+                if (fingerprint != null) {
+                    Optional<VerdictStore.Verdict> stored = verdictScan.lookup(fingerprint, aiClient.getModelName(),
+                        PromptBuilder.VALIDATION_PROMPT_VERSION);
+                    if (stored.isPresent()) {
+                        return applyStoredVerdict(stored.get());
+                    }
+                }
 
                 // Pre-check: Quick filtering for Semgrep race condition false positives
                 if (isSemgrepRaceConditionFalsePositive(originalIssue, codeSlice)) {
                     logger.info("Pre-filtered Semgrep race condition false positive: {} (single-threaded context)",
                         originalIssue.getTitle());
+                    metrics.increment("ai_prefiltered", 1);
+                    tracer.instant(originalIssue.getId(), "verdict", "result", "prefiltered",
+                        "reason", "semgrep race condition in single-threaded context");
                     return null;  // Quick filter - no need to call AI
                 }
 
+                // Pre-check: def-use / constant-size facts that refute the finding outright
+                Optional<String> refutation = dataflowPrefilter.refute(originalIssue, codeSlicer.getModel(filePath),
+                    projectFacts);
+                if (refutation.isPresent()) {
+                    logger.info("Pre-filtered by dataflow check: {} - {}", originalIssue.getTitle(), refutation.get());
+                    metrics.increment("ai_prefiltered", 1);
+                    metrics.increment("dataflow_refuted", 1);
+                    tracer.instant(originalIssue.getId(), "verdict", "result", "prefiltered",
+                        "reason", refutation.get());
+                    return null;
+                }
+
                 // Build validation prompt
-                String prompt = PromptBuilder.buildIssueValidationPrompt(originalIssue, codeSlice);
+                String prompt = PromptBuilder.buildIssueValidationPrompt(originalIssue, codeSlice, projectFacts);
+
+                // Token budget: lower-priority issues queued behind the budget keep static confidence
+                if (tokenBudget != null && !reserveTokens(tokenBudget, prompt)) {
+                    metrics.increment("ai_budget_skipped", 1);
+                    tracer.instant(originalIssue.getId(), "verdict", "result", "skipped",
+                        "reason", "AI token budget exhausted");
+                    return createBudgetSkippedIssue(originalIssue, fingerprint);
+                }
 
                 // Send to AI (rate-limited)
                 String jsonResponse = aiClient.sendRequest(prompt, true);
 
-                // Parse response
-                AiValidationResponse validation = parseValidationResponse(jsonResponse);
+                // Parse response; an unparseable answer must not be replayed from the cache next scan
+                AiValidationResponse validation;
+                try {
+                    validation = parseValidationResponse(jsonResponse, metrics);
+                } catch (JsonSyntaxException e) {
+                    aiClient.invalidate(prompt, true);
+                    throw e;
+                }
+
+                tracer.instant(originalIssue.getId(), "verdict",
+                    "result", validation.is_vulnerability ? "confirmed" : "rejected",
+                    "severity", validation.suggested_severity, "reason", validation.reason);
+                if (fingerprint != null) {
+                    verdictScan.record(new VerdictStore.Verdict(fingerprint, verdictLocation(filePath, lineNumber, rule),
+                        filePath.toAbsolutePath().normalize().toString(), rule, validation.is_vulnerability,
+                        validation.suggested_severity, validation.reason, VerdictStore.Source.AI,
+                        aiClient.getModelName(), PromptBuilder.VALIDATION_PROMPT_VERSION, System.currentTimeMillis()));
+                }
 
                 if (validation.is_vulnerability) {
                     // AI confirmed - create enhanced issue
-                    return createEnhancedIssue(originalIssue, validation);
+                    return createEnhancedIssue(originalIssue, validation, fingerprint, null);
                 } else {
                     // ✅ CRITICAL FIX: AI marked as false positive - return null to filter it out
-                    logger.info("AI filtered false positive: {} - Reason: {}",
-                        originalIssue.getTitle(), validation.reason);
+                    // (the stored verdict stays reachable for triage through its fingerprint)
+                    logger.info("AI filtered false positive: {} - Reason: {}{}",
+                        originalIssue.getTitle(), validation.reason,
+                        fingerprint != null ? " (verdict fingerprint " + fingerprint + ")" : "");
                     return null;  // Return null to completely remove false positives
                 }
             } catch (Exception e) {
-                // AI validation failed - return fallback issue
+                // AI validation failed - return fallback issue (nothing is recorded in the verdict store)
                 logger.error("AI validation failed for issue: {}", originalIssue.getId(), e);
-                return createFallbackIssue(originalIssue);
+                tracer.instant(originalIssue.getId(), "verdict", "result", "error", "reason", e.getMessage());
+                return createFallbackIssue(originalIssue, fingerprint);
+            }
+        }
+
+        private SecurityIssue applyStoredVerdict(VerdictStore.Verdict verdict) {
+            String source = verdict.source().name().toLowerCase();
+            metrics.increment("verdict_store_hits", 1);
+            tracer.instant(originalIssue.getId(), "verdict",
+                "result", verdict.vulnerability() ? "confirmed" : "rejected",
+                "source", "stored " + source, "reason", verdict.reason());
+            if (!verdict.vulnerability()) {
+                logger.info("Stored {} verdict: false positive {} - Reason: {}",
+                    source, originalIssue.getTitle(), verdict.reason());
+                return null;
             }
+            return createEnhancedIssue(originalIssue, storedValidation(originalIssue, verdict),
+                verdict.fingerprint(), verdict.source());
         }
     }
 
@@ -0,0 +1,109 @@
+package com.harmony.agent.core.ai;
+
+import com.google.gson.JsonElement;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParseException;
+import com.google.gson.JsonParser;
+
+import java.util.Optional;
+
+/**
+ * Tolerant extraction of a JSON object from LLM output
+ *
+ * Models without structured output often wrap the answer in markdown fences or prose
+ * ("Here is my analysis: ```json {...} ```"). The extractor scans the text for balanced
+ * {...} candidates, counting braces only outside string literals and dropping trailing
+ * commas, and returns the first one that parses as an object holding the required key.
+ * Parsing is lenient, so single quotes, unquoted names and comments are accepted too.
+ */
+public final class JsonResponseExtractor {
+
+    private JsonResponseExtractor() {
+    }
+
+    /**
+     * Parse the whole text as a JSON object holding the required key
+     */
+    public static Optional<JsonObject> parseObject(String text, String requiredKey) {
+        if (text == null || text.isBlank()) {
+            return Optional.empty();
+        }
+        try {
+            JsonElement element = JsonParser.parseString(text.trim());
+            if (element.isJsonObject() && element.getAsJsonObject().has(requiredKey)) {
+                return Optional.of(element.getAsJsonObject());
+            }
+        } catch (JsonParseException | IllegalStateException e) {
+            // Not a JSON object on its own
+        }
+        return Optional.empty();
+    }
+
+    /**
+     * Find the first JSON object holding the required key anywhere in the text
+     */
+    public static Optional<JsonObject> extractObject(String text, String requiredKey) {
+        if (text == null) {
+            return Optional.empty();
+        }
+        for (int start = text.indexOf('{'); start >= 0; start = text.indexOf('{', start + 1)) {
+            String candidate = balancedObject(text, start);
+            if (candidate == null) {
+                continue;  // Unclosed here; a later brace may still open a complete object
+            }
+            Optional<JsonObject> object = parseObject(candidate, requiredKey);
+            if (object.isPresent()) {
+                return object;
+            }
+        }
+        return Optional.empty();
+    }
+
+    /**
+     * The object starting at the brace, without trailing commas, or null if it is never closed
+     */
+    private static String balancedObject(String text, int start) {
+        StringBuilder object = new StringBuilder();
+        int depth = 0;
+        char quote = 0;
+        for (int i = start; i < text.length(); i++) {
+            char c = text.charAt(i);
+            if (quote != 0) {
+                object.append(c);
+                if (c == '\\' && i + 1 < text.length()) {
+                    object.append(text.charAt(++i));
+                } else if (c == quote) {
+                    quote = 0;
+                }
+                continue;
+            }
+            switch (c) {
+                case '"', '\'' -> quote = c;
+                case '{', '[' -> depth++;
+                case '}', ']' -> depth--;
+                case ',' -> {
+                    if (closesNext(text, i + 1)) {
+                        continue;
+                    }
+                }
+                default -> {
+                }
+            }
+            object.append(c);
+            if (depth == 0) {
+                return object.toString();
+            }
+        }
+        return null;
+    }
+
+    private static boolean closesNext(String text, int from) {
+        for (int i = from; i < text.length(); i++) {
+            char c = text.charAt(i);
+            if (!Character.isWhitespace(c)) {
+                return c == '}' || c == ']';
+            }
+        }
+        return false;
+    }
+}
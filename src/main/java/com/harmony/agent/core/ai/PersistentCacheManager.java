@@ -1,6 +1,8 @@
 package com.harmony.agent.core.ai;
 
 import com.google.common.cache.*;
+import com.harmony.agent.core.metrics.JfrEvents;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import java.io.*;
 import java.nio.file.*;
 import java.util.concurrent.TimeUnit;
@@ -87,11 +89,15 @@ public class PersistentCacheManager {
             return null;
         }
 
+        JfrEvents.CacheLookup event = new JfrEvents.CacheLookup();
+        event.begin();
+
         // 第1步：检查 L1 内存缓存 - 使用同步锁
         synchronized (l1Lock) {
             String cached = l1Cache.getIfPresent(key);
             if (cached != null) {
                 logger.fine("Cache L1 HIT: " + shortKey(key));
+                recordLookup(event, "l1_hit");
                 return cached;
             }
         }
@@ -99,6 +105,7 @@ public class PersistentCacheManager {
         // 第2步：检查 L2 磁盘缓存（如果启用）
         if (!persistent) {
             logger.fine("Cache L1 MISS (persistent disabled): " + shortKey(key));
+            recordLookup(event, "miss");
             return null;
         }
 
@@ -115,6 +122,7 @@ public class PersistentCacheManager {
                             l1Cache.put(key, cached);
                         }
                         logger.fine("Cache L2 HIT (promoted to L1): " + shortKey(key));
+                        recordLookup(event, "l2_hit");
                         return cached;
                     } else {
                         // 删除过期缓存
@@ -131,9 +139,16 @@ public class PersistentCacheManager {
         }
 
         logger.fine("Cache MISS: " + shortKey(key));
+        recordLookup(event, "miss");
         return null;
     }
 
+    private void recordLookup(JfrEvents.CacheLookup event, String result) {
+        event.finish(cacheType, result);
+        MetricsRegistry.global().counter("harmony_cache_lookups",
+            "Persistent cache lookups by tier result", "cache", cacheType, "result", result).inc();
+    }
+
     /**
      * 存储缓存值 (L1 + L2) - 线程安全
      *
@@ -169,6 +184,34 @@ public class PersistentCacheManager {
         }
     }
 
+    /**
+     * 删除缓存值 (L1 + L2) - 线程安全
+     *
+     * @param key 缓存键
+     */
+    public void remove(String key) {
+        if (key == null || key.isEmpty()) {
+            return;
+        }
+
+        synchronized (l1Lock) {
+            l1Cache.invalidate(key);
+        }
+
+        if (!persistent) {
+            return;
+        }
+
+        synchronized (l2Lock) {
+            try {
+                Files.deleteIfExists(getCacheFile(key));
+                logger.fine("Cache entry removed: " + shortKey(key));
+            } catch (IOException e) {
+                logger.warning("Failed to remove cache file: " + getCacheFile(key));
+            }
+        }
+    }
+
     /**
      * 清理所有过期缓存 - 线程安全
      */
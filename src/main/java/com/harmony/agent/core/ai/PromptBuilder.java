@@ -1,6 +1,7 @@
 package com.harmony.agent.core.ai;
 
 import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.parser.ProjectFacts;
 
 /**
  * Prompt Builder - Constructs high-quality prompts for AI analysis
@@ -8,6 +9,29 @@ import com.harmony.agent.core.model.SecurityIssue;
  */
 public class PromptBuilder {
 
+    /**
+     * Version of the issue validation prompt; bump it when the prompt changes so stored AI
+     * verdicts from the old prompt are not reused
+     */
+    public static final String VALIDATION_PROMPT_VERSION = "issue-validation-v2";
+
+    /**
+     * JSON schema of the issue validation answer, sent to providers that support
+     * schema-constrained output
+     */
+    public static final String VALIDATION_RESPONSE_SCHEMA = """
+        {
+          "type": "object",
+          "properties": {
+            "is_vulnerability": {"type": "boolean"},
+            "reason": {"type": "string"},
+            "suggested_severity": {"type": "string", "enum": ["Critical", "High", "Medium", "Low", "Info"]}
+          },
+          "required": ["is_vulnerability", "reason", "suggested_severity"],
+          "additionalProperties": false
+        }
+        """;
+
     /**
      * Build prompt for AI vulnerability validation
      * Analyzes whether a static analysis finding is a real vulnerability or false positive
@@ -18,6 +42,16 @@ public class PromptBuilder {
      * @return Formatted prompt for LLM
      */
     public static String buildIssueValidationPrompt(SecurityIssue issue, String codeSlice) {
+        return buildIssueValidationPrompt(issue, codeSlice, null);
+    }
+
+    /**
+     * Build prompt for AI vulnerability validation with whole-project facts (threading, entry points,
+     * allocator wrappers) that the function slice alone cannot show
+     *
+     * @param facts Project fact index (null = no project section)
+     */
+    public static String buildIssueValidationPrompt(SecurityIssue issue, String codeSlice, ProjectFacts facts) {
         return String.format("""
             You are a C/C++ static analysis and security expert with deep knowledge of concurrency issues.
             A tool (%s) found a *potential* security issue:
@@ -28,7 +62,7 @@ public class PromptBuilder {
             - Severity (Reported): %s
             - Category: %s
 
-            Below is the code context (the entire function) where the issue was found:
+            %sBelow is the code context (the entire function) where the issue was found:
             ```c
             %s
             ```
@@ -86,10 +120,22 @@ public class PromptBuilder {
             issue.getLocation().getLineNumber(),
             issue.getSeverity().getDisplayName(),
             issue.getCategory().name(),
+            projectSection(issue, facts),
             codeSlice
         );
     }
 
+    private static String projectSection(SecurityIssue issue, ProjectFacts facts) {
+        if (facts == null) {
+            return "";
+        }
+        StringBuilder section = new StringBuilder("Project facts (from a whole-project index):\n");
+        for (String line : facts.describe(issue.getLocation().getFilePath())) {
+            section.append("- ").append(line).append('\n');
+        }
+        return section.append('\n').toString();
+    }
+
     /**
      * Build prompt for Rust FFI migration analysis
      * Provides guidance on migrating C code to Rust with FFI
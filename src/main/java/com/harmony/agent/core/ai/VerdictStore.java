@@ -0,0 +1,470 @@
+package com.harmony.agent.core.ai;
+
+import com.google.common.hash.Hashing;
+import com.google.gson.Gson;
+import com.google.gson.JsonParseException;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.FileLock;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.AtomicMoveNotSupportedException;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.StandardOpenOption;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Optional;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.function.Supplier;
+import java.util.regex.Pattern;
+
+/**
+ * Durable triage verdict store, carried across scans
+ *
+ * Verdicts are keyed by a stable issue fingerprint: the rule plus a hash of the normalized
+ * function slice (line numbers and whitespace removed), so a finding keeps its verdict while
+ * unrelated code moves and loses it as soon as its own function changes. Entries never expire
+ * by age, only by code change: at the end of a scan, {@link Scan#evictUnseen()} drops the AI
+ * verdicts for each rule and function that received a new AI verdict but were not looked up
+ * during that scan (their code is gone), and compaction drops verdicts for files that no longer
+ * exist. Human verdicts are only removed with their file.
+ *
+ * AI verdicts are reused only for the model and prompt version that produced them; human
+ * verdicts always apply and are never overwritten by the AI.
+ *
+ * Storage is one append-only JSON-lines file (a verdict or a removal per line) shared by every
+ * process on the machine: the CLI, resident serve engines and {@code triage}. Each instance
+ * replays lines appended by others before answering, appends and compaction run under a file
+ * lock after catching up, and the file is rewritten atomically once superseded lines outnumber
+ * live ones. Within one process, use {@link #global()}.
+ */
+public class VerdictStore {
+
+    private static final Logger logger = LoggerFactory.getLogger(VerdictStore.class);
+
+    private static final String STORE_DIR =
+        System.getProperty("user.home") + "/.harmony_agent/verdicts";
+    private static final String LOG_FILE = "verdicts.jsonl";
+    private static final String LOCK_FILE = "verdicts.lock";
+    private static final int MIN_COMPACT_LINES = 64;
+
+    private static final Pattern LINE_NUMBER = Pattern.compile("^\\s*\\d+: ");
+    private static final Pattern WHITESPACE = Pattern.compile("\\s+");
+
+    // A FileLock is held per process, so threads (and instances) of one JVM serialize here first
+    private static final Map<Path, Object> PROCESS_LOCKS = new ConcurrentHashMap<>();
+
+    /**
+     * Who decided
+     */
+    public enum Source {
+        AI,
+        HUMAN
+    }
+
+    /**
+     * One triage verdict; location is file, rule and enclosing function
+     */
+    public record Verdict(String fingerprint, String location, String file, String rule,
+                          boolean vulnerability, String severity, String reason,
+                          Source source, String model, String promptVersion, long recordedAt) {
+    }
+
+    /** Log line: a recorded verdict, or the fingerprint of a removed one */
+    private record LogLine(Verdict verdict, String removed) {
+    }
+
+    private static final class Global {
+        static final VerdictStore INSTANCE = new VerdictStore();
+    }
+
+    private final Path logFile;
+    private final Path lockFile;
+    private final Gson gson = new Gson();
+    private final Map<String, Verdict> byFingerprint = new LinkedHashMap<>();
+    private final Map<String, Set<String>> fingerprintsByLocation = new HashMap<>();
+    private int logLines;
+    private long readOffset;  // Bytes of the log replayed so far
+    private Object fileKey;   // Identity of the replayed log file; changes when another process compacts
+
+    /**
+     * Use the default directory (~/.harmony_agent/verdicts)
+     */
+    public VerdictStore() {
+        this(Paths.get(STORE_DIR));
+    }
+
+    public VerdictStore(Path directory) {
+        this.logFile = directory.resolve(LOG_FILE);
+        this.lockFile = directory.resolve(LOCK_FILE);
+        try {
+            Files.createDirectories(directory);
+        } catch (IOException e) {
+            logger.warn("Cannot create verdict store directory {}: {}", directory, e.getMessage());
+        }
+        refresh();
+        logger.info("Verdict store: {} verdicts loaded from {}", byFingerprint.size(), logFile);
+    }
+
+    /**
+     * Process-wide store over the default directory, shared by all engines of this process
+     */
+    public static VerdictStore global() {
+        return Global.INSTANCE;
+    }
+
+    /**
+     * Stable fingerprint of a finding: rule plus normalized function slice
+     */
+    public static String fingerprint(String rule, String slice) {
+        return Hashing.sha256().hashString(rule + "\n" + normalizeSlice(slice), StandardCharsets.UTF_8).toString();
+    }
+
+    /**
+     * Drop the slice header and line-number gutter and collapse whitespace, keeping the issue marker
+     */
+    static String normalizeSlice(String slice) {
+        StringBuilder normalized = new StringBuilder();
+        for (String line : slice.split("\n")) {
+            if (line.startsWith("// File: ")) {
+                continue;
+            }
+            String code = WHITESPACE.matcher(LINE_NUMBER.matcher(line).replaceFirst("")).replaceAll(" ").trim();
+            if (!code.isEmpty()) {
+                normalized.append(code).append('\n');
+            }
+        }
+        return normalized.toString();
+    }
+
+    /**
+     * Verdict that applies to the fingerprint: a human verdict, or an AI verdict from the same
+     * model and prompt version
+     */
+    public synchronized Optional<Verdict> lookup(String fingerprint, String model, String promptVersion) {
+        refresh();
+        Verdict verdict = byFingerprint.get(fingerprint);
+        if (verdict == null) {
+            return Optional.empty();
+        }
+        if (verdict.source() == Source.HUMAN
+                || (verdict.model() != null && verdict.model().equals(model)
+                    && verdict.promptVersion() != null && verdict.promptVersion().equals(promptVersion))) {
+            return Optional.of(verdict);
+        }
+        return Optional.empty();
+    }
+
+    /**
+     * Any stored verdict for the fingerprint, regardless of model and prompt version
+     */
+    public synchronized Optional<Verdict> get(String fingerprint) {
+        refresh();
+        return Optional.ofNullable(byFingerprint.get(fingerprint));
+    }
+
+    /**
+     * Record a verdict and append it to the log
+     *
+     * @return false if the verdict was ignored (an AI verdict cannot replace a human one)
+     */
+    public synchronized boolean record(Verdict verdict) {
+        boolean recorded = underFileLock(() -> {
+            refresh();  // A human verdict appended by another process takes precedence too
+            Verdict existing = byFingerprint.get(verdict.fingerprint());
+            if (existing != null && existing.source() == Source.HUMAN && verdict.source() == Source.AI) {
+                return false;
+            }
+            apply(verdict);
+            append(gson.toJson(new LogLine(verdict, null)) + '\n', 1);
+            return true;
+        });
+        compactIfSuperseded();
+        return recorded;
+    }
+
+    /**
+     * Start tracking one scan's lookups for stale-verdict eviction
+     */
+    public Scan beginScan() {
+        return new Scan();
+    }
+
+    /**
+     * Lookups and verdicts of one scan. Concurrent scans (resident engines sharing the store)
+     * each keep their own seen set, so one scan ending cannot evict what another has yet to look up.
+     */
+    public final class Scan {
+        private final Set<String> seen = ConcurrentHashMap.newKeySet();
+        private final Set<String> changedLocations = ConcurrentHashMap.newKeySet();
+
+        private Scan() {
+        }
+
+        public Optional<Verdict> lookup(String fingerprint, String model, String promptVersion) {
+            seen.add(fingerprint);
+            return VerdictStore.this.lookup(fingerprint, model, promptVersion);
+        }
+
+        public boolean record(Verdict verdict) {
+            seen.add(verdict.fingerprint());
+            if (!VerdictStore.this.record(verdict)) {
+                return false;
+            }
+            if (verdict.source() == Source.AI && verdict.location() != null) {
+                changedLocations.add(verdict.location());
+            }
+            return true;
+        }
+
+        /**
+         * End of scan: drop AI verdicts this scan did not look up at the locations where it
+         * recorded a new AI verdict. Call only after every finding has been looked up, otherwise
+         * a sibling verdict that is still current would be dropped.
+         *
+         * @return number of verdicts removed
+         */
+        public int evictUnseen() {
+            return evict(changedLocations, seen);
+        }
+    }
+
+    private synchronized int evict(Set<String> locations, Set<String> seen) {
+        int evicted = underFileLock(() -> {
+            refresh();
+            StringBuilder lines = new StringBuilder();
+            int removed = 0;
+            for (String location : locations) {
+                for (String fingerprint : new ArrayList<>(fingerprintsByLocation.getOrDefault(location, Set.of()))) {
+                    if (byFingerprint.get(fingerprint).source() == Source.AI && !seen.contains(fingerprint)) {
+                        remove(fingerprint);
+                        lines.append(gson.toJson(new LogLine(null, fingerprint))).append('\n');
+                        removed++;
+                    }
+                }
+            }
+            if (removed > 0) {
+                append(lines.toString(), removed);
+            }
+            return removed;
+        });
+        if (evicted > 0) {
+            logger.debug("Verdict store evicted {} stale AI verdicts", evicted);
+            compactIfSuperseded();
+        }
+        return evicted;
+    }
+
+    /**
+     * Append lines to the log; the caller holds the file lock and has caught up with the file
+     */
+    private void append(String lines, int lineCount) {
+        try {
+            Files.writeString(logFile, lines, StandardCharsets.UTF_8,
+                StandardOpenOption.CREATE, StandardOpenOption.APPEND);
+            BasicFileAttributes attributes = Files.readAttributes(logFile, BasicFileAttributes.class);
+            readOffset = attributes.size();
+            fileKey = attributes.fileKey();
+            logLines += lineCount;
+        } catch (IOException e) {
+            logger.warn("Failed to persist verdict store {}: {}", logFile, e.getMessage());
+        }
+    }
+
+    private void compactIfSuperseded() {
+        if (logLines >= MIN_COMPACT_LINES && logLines > 2 * byFingerprint.size()) {
+            compact();
+        }
+    }
+
+    private void apply(Verdict verdict) {
+        Verdict previous = byFingerprint.put(verdict.fingerprint(), verdict);
+        if (previous != null && previous.location() != null) {
+            unindex(previous.location(), previous.fingerprint());
+        }
+        if (verdict.location() != null) {
+            fingerprintsByLocation.computeIfAbsent(verdict.location(), k -> new HashSet<>()).add(verdict.fingerprint());
+        }
+    }
+
+    private void remove(String fingerprint) {
+        Verdict removed = byFingerprint.remove(fingerprint);
+        if (removed != null && removed.location() != null) {
+            unindex(removed.location(), fingerprint);
+        }
+    }
+
+    private void unindex(String location, String fingerprint) {
+        Set<String> fingerprints = fingerprintsByLocation.get(location);
+        if (fingerprints != null) {
+            fingerprints.remove(fingerprint);
+            if (fingerprints.isEmpty()) {
+                fingerprintsByLocation.remove(location);
+            }
+        }
+    }
+
+    /**
+     * Replay lines other processes appended since the last read; start over when the file was
+     * replaced by a compaction elsewhere
+     */
+    private void refresh() {
+        BasicFileAttributes attributes;
+        try {
+            attributes = Files.readAttributes(logFile, BasicFileAttributes.class);
+        } catch (NoSuchFileException e) {
+            return;
+        } catch (IOException e) {
+            logger.warn("Failed to read verdict store {}: {}", logFile, e.getMessage());
+            return;
+        }
+        Object key = attributes.fileKey();
+        if ((key != null && !key.equals(fileKey)) || attributes.size() < readOffset) {
+            byFingerprint.clear();
+            fingerprintsByLocation.clear();
+            logLines = 0;
+            readOffset = 0;
+        }
+        fileKey = key;
+        if (attributes.size() > readOffset) {
+            replayFrom(readOffset);
+        }
+    }
+
+    private void replayFrom(long offset) {
+        byte[] bytes;
+        try (SeekableByteChannel channel = Files.newByteChannel(logFile, StandardOpenOption.READ)) {
+            channel.position(offset);
+            ByteBuffer buffer = ByteBuffer.allocate((int) Math.max(0, channel.size() - offset));
+            while (buffer.hasRemaining() && channel.read(buffer) > 0) {
+                // Fill the buffer
+            }
+            bytes = Arrays.copyOf(buffer.array(), buffer.position());
+        } catch (IOException e) {
+            logger.warn("Failed to read verdict store {}: {}", logFile, e.getMessage());
+            return;
+        }
+
+        // Only complete lines; a line still being written is picked up on the next refresh
+        int end = bytes.length;
+        while (end > 0 && bytes[end - 1] != '\n') {
+            end--;
+        }
+        for (String line : new String(bytes, 0, end, StandardCharsets.UTF_8).split("\n")) {
+            if (line.isBlank()) {
+                continue;
+            }
+            logLines++;
+            try {
+                LogLine entry = gson.fromJson(line, LogLine.class);
+                if (entry == null) {
+                    continue;
+                }
+                if (entry.removed() != null) {
+                    remove(entry.removed());
+                } else if (entry.verdict() != null && entry.verdict().fingerprint() != null
+                        && entry.verdict().source() != null) {
+                    apply(entry.verdict());
+                }
+            } catch (JsonParseException e) {
+                // A crash can leave a half-written line; skip it
+                logger.warn("Skipping corrupt line in verdict store {}", logFile);
+            }
+        }
+        readOffset = offset + end;
+    }
+
+    /**
+     * Run under the store's file lock (and this process's lock for it). Without a lock file the
+     * action still runs; appends of single short lines then remain whole on their own.
+     */
+    private <T> T underFileLock(Supplier<T> action) {
+        synchronized (PROCESS_LOCKS.computeIfAbsent(lockFile.toAbsolutePath().normalize(), k -> new Object())) {
+            FileChannel channel = null;
+            FileLock lock = null;
+            try {
+                channel = FileChannel.open(lockFile, StandardOpenOption.CREATE, StandardOpenOption.WRITE);
+                lock = channel.lock();
+            } catch (IOException e) {
+                logger.warn("Cannot lock verdict store {}: {}", lockFile, e.getMessage());
+            }
+            try {
+                return action.get();
+            } finally {
+                try {
+                    if (lock != null) {
+                        lock.release();
+                    }
+                    if (channel != null) {
+                        channel.close();
+                    }
+                } catch (IOException e) {
+                    logger.debug("Failed to release verdict store lock: {}", e.getMessage());
+                }
+            }
+        }
+    }
+
+    /**
+     * Rewrite the log with live verdicts only, dropping files that no longer exist. Runs under
+     * the file lock after replaying other processes' lines, so nothing they appended is lost;
+     * written to a temporary file first and moved into place atomically.
+     */
+    public synchronized void compact() {
+        underFileLock(() -> {
+            refresh();
+            for (Verdict verdict : new ArrayList<>(byFingerprint.values())) {
+                if (verdict.file() != null && !Files.exists(Paths.get(verdict.file()))) {
+                    remove(verdict.fingerprint());
+                }
+            }
+
+            StringBuilder content = new StringBuilder();
+            for (Verdict verdict : byFingerprint.values()) {
+                content.append(gson.toJson(new LogLine(verdict, null))).append('\n');
+            }
+            Path tmp = logFile.resolveSibling(LOG_FILE + ".tmp");
+            try {
+                Files.writeString(tmp, content.toString(), StandardCharsets.UTF_8);
+                try {
+                    Files.move(tmp, logFile, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+                } catch (AtomicMoveNotSupportedException e) {
+                    Files.move(tmp, logFile, StandardCopyOption.REPLACE_EXISTING);
+                }
+                BasicFileAttributes attributes = Files.readAttributes(logFile, BasicFileAttributes.class);
+                readOffset = attributes.size();
+                fileKey = attributes.fileKey();
+                logLines = byFingerprint.size();
+                logger.debug("Verdict store compacted to {} verdicts", logLines);
+            } catch (IOException e) {
+                logger.warn("Failed to compact verdict store {}: {}", logFile, e.getMessage());
+            }
+            return null;
+        });
+    }
+
+    public synchronized List<Verdict> getVerdicts() {
+        refresh();
+        return new ArrayList<>(byFingerprint.values());
+    }
+
+    public synchronized int size() {
+        refresh();
+        return byFingerprint.size();
+    }
+}
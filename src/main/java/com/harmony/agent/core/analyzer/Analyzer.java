@@ -2,6 +2,7 @@ package com.harmony.agent.core.analyzer;
 
 import com.harmony.agent.core.model.SecurityIssue;
 
+import java.io.IOException;
 import java.nio.file.Path;
 import java.util.List;
 
@@ -30,6 +31,19 @@ public interface Analyzer {
      */
     List<SecurityIssue> analyzeAll(List<Path> files) throws AnalyzerException;
 
+    /**
+     * Analyze multiple files, streaming results into the sink as they become available
+     * instead of materializing one combined list. Defaults to a single batch.
+     */
+    default void analyzeAll(List<Path> files, IssueSink sink) throws AnalyzerException {
+        List<SecurityIssue> issues = analyzeAll(files);
+        try {
+            sink.accept(issues);
+        } catch (IOException e) {
+            throw new AnalyzerException("Failed to collect " + getName() + " results", e);
+        }
+    }
+
     /**
      * Get analyzer version
      */
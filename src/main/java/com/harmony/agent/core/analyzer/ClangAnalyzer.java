@@ -5,6 +5,8 @@ import com.google.gson.JsonElement;
 import com.google.gson.JsonObject;
 import com.google.gson.JsonParser;
 import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.metrics.JfrEvents;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.core.model.CodeLocation;
 import com.harmony.agent.core.model.IssueCategory;
 import com.harmony.agent.core.model.IssueSeverity;
@@ -18,6 +20,7 @@ import java.io.InputStreamReader;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.util.ArrayList;
+import java.util.Collections;
 import java.util.List;
 import java.util.UUID;
 import java.util.concurrent.*;
@@ -106,45 +109,77 @@ public class ClangAnalyzer implements Analyzer {
 
     @Override
     public List<SecurityIssue> analyzeAll(List<Path> files) throws AnalyzerException {
+        // One buffer per file, merged once in file order
+        List<List<SecurityIssue>> perFile = new ArrayList<>(Collections.nCopies(files.size(), null));
+        analyzeFiles(files, perFile::set);
+
+        int total = 0;
+        for (List<SecurityIssue> issues : perFile) {
+            total += issues != null ? issues.size() : 0;
+        }
+        List<SecurityIssue> allIssues = new ArrayList<>(total);
+        for (List<SecurityIssue> issues : perFile) {
+            if (issues != null) {
+                allIssues.addAll(issues);
+            }
+        }
+        return allIssues;
+    }
+
+    @Override
+    public void analyzeAll(List<Path> files, IssueSink sink) throws AnalyzerException {
+        analyzeFiles(files, (index, issues) -> sink.accept(issues));
+    }
+
+    /**
+     * Run clang-tidy on every file and hand each file's issues to the handler on the calling thread
+     */
+    private void analyzeFiles(List<Path> files, FileResultHandler handler) throws AnalyzerException {
         if (files.isEmpty()) {
-            return new ArrayList<>();
+            return;
         }
 
         if (!isAvailable()) {
             throw new AnalyzerException("Clang-Tidy is not available. Please install clang-tidy.");
         }
 
-        // Use parallel execution if ExecutorService is provided
-        if (executorService != null) {
-            return analyzeParallel(files);
-        } else {
-            return analyzeSequential(files);
+        try {
+            // Use parallel execution if ExecutorService is provided
+            if (executorService != null) {
+                analyzeParallel(files, handler);
+            } else {
+                analyzeSequential(files, handler);
+            }
+        } catch (IOException e) {
+            throw new AnalyzerException("Failed to collect Clang-Tidy results", e);
         }
     }
 
     /**
      * Analyze files in parallel using ExecutorService
+     *
+     * Each task returns its own list; results are handed over as tasks complete, so nothing
+     * is shared between workers and no combined list is copied while it grows.
      */
-    private List<SecurityIssue> analyzeParallel(List<Path> files) throws AnalyzerException {
+    private void analyzeParallel(List<Path> files, FileResultHandler handler)
+            throws AnalyzerException, IOException {
         logger.info("Analyzing {} files with Clang-Tidy in parallel", files.size());
 
-        // Create analysis tasks for each file
-        List<Callable<List<SecurityIssue>>> tasks = new ArrayList<>();
-        for (Path file : files) {
-            tasks.add(() -> analyzeSingleFile(file));
+        CompletionService<FileResult> completion = new ExecutorCompletionService<>(executorService);
+        List<Future<FileResult>> futures = new ArrayList<>(files.size());
+        for (int i = 0; i < files.size(); i++) {
+            int index = i;
+            Path file = files.get(i);
+            futures.add(completion.submit(() -> new FileResult(index, analyzeSingleFile(file))));
         }
 
-        // Thread-safe list to collect results
-        List<SecurityIssue> allIssues = new CopyOnWriteArrayList<>();
-
+        int issueCount = 0;
         try {
-            // Submit all tasks and wait for completion
-            List<Future<List<SecurityIssue>>> futures = executorService.invokeAll(tasks);
-
-            // Collect results from all futures
-            for (Future<List<SecurityIssue>> future : futures) {
+            for (int i = 0; i < files.size(); i++) {
                 try {
-                    allIssues.addAll(future.get());
+                    FileResult result = completion.take().get();
+                    issueCount += result.issues().size();
+                    handler.onFile(result.index(), result.issues());
                 } catch (ExecutionException e) {
                     Throwable cause = e.getCause();
                     if (cause instanceof AnalyzerException) {
@@ -155,33 +190,41 @@ public class ClangAnalyzer implements Analyzer {
                 }
             }
         } catch (InterruptedException e) {
+            futures.forEach(future -> future.cancel(true));
             Thread.currentThread().interrupt();
             throw new AnalyzerException("Clang analysis was interrupted", e);
         }
 
-        logger.info("Parallel Clang analysis complete, found {} issues", allIssues.size());
-        return new ArrayList<>(allIssues);
+        logger.info("Parallel Clang analysis complete, found {} issues", issueCount);
     }
 
     /**
      * Analyze files sequentially (fallback when no ExecutorService)
      */
-    private List<SecurityIssue> analyzeSequential(List<Path> files) {
+    private void analyzeSequential(List<Path> files, FileResultHandler handler) throws IOException {
         logger.info("Analyzing {} files with Clang-Tidy sequentially", files.size());
 
-        List<SecurityIssue> allIssues = new ArrayList<>();
-        for (Path file : files) {
+        int issueCount = 0;
+        for (int i = 0; i < files.size(); i++) {
             try {
-                List<SecurityIssue> issues = analyzeSingleFile(file);
-                allIssues.addAll(issues);
+                List<SecurityIssue> issues = analyzeSingleFile(files.get(i));
+                issueCount += issues.size();
+                handler.onFile(i, issues);
             } catch (AnalyzerException e) {
-                logger.error("Failed to analyze file: {}", file, e);
+                logger.error("Failed to analyze file: {}", files.get(i), e);
                 // Continue with next file
             }
         }
 
-        logger.info("Sequential Clang analysis complete, found {} issues", allIssues.size());
-        return allIssues;
+        logger.info("Sequential Clang analysis complete, found {} issues", issueCount);
+    }
+
+    @FunctionalInterface
+    private interface FileResultHandler {
+        void onFile(int index, List<SecurityIssue> issues) throws IOException;
+    }
+
+    private record FileResult(int index, List<SecurityIssue> issues) {
     }
 
     /**
@@ -189,6 +232,17 @@ public class ClangAnalyzer implements Analyzer {
      * This is the core analysis logic extracted for parallel execution
      */
     private List<SecurityIssue> analyzeSingleFile(Path file) throws AnalyzerException {
+        JfrEvents.AnalyzerRun event = new JfrEvents.AnalyzerRun();
+        event.begin();
+        List<SecurityIssue> issues = runClangTidy(file);
+        event.finish(getName(), file.toString(), 1, issues.size());
+        return issues;
+    }
+
+    /**
+     * Run clang-tidy on one file and parse its output
+     */
+    private List<SecurityIssue> runClangTidy(Path file) throws AnalyzerException {
         if (!Files.exists(file)) {
             throw new AnalyzerException("File not found: " + file);
         }
@@ -202,6 +256,7 @@ public class ClangAnalyzer implements Analyzer {
             ProcessBuilder pb = new ProcessBuilder(command);
             pb.redirectErrorStream(true);
             Process process = pb.start();
+            MetricsRegistry.global().trackProcess(getName(), process);
 
             StringBuilder output = new StringBuilder();
             try (BufferedReader reader = new BufferedReader(
@@ -0,0 +1,18 @@
+package com.harmony.agent.core.analyzer;
+
+import com.harmony.agent.core.model.SecurityIssue;
+
+import java.io.IOException;
+import java.util.List;
+
+/**
+ * Receives analyzer results incrementally (e.g. one batch per analyzed file)
+ *
+ * Batches arrive in completion order. An analyzer calls its sink only from the thread that invoked
+ * {@link Analyzer#analyzeAll(List, IssueSink)}, but different analyzers may share one sink concurrently.
+ */
+@FunctionalInterface
+public interface IssueSink {
+
+    void accept(List<SecurityIssue> issues) throws IOException;
+}
@@ -1,5 +1,6 @@
 package com.harmony.agent.core.analyzer;
 
+import com.harmony.agent.core.metrics.JfrEvents;
 import com.harmony.agent.core.model.CodeLocation;
 import com.harmony.agent.core.model.IssueCategory;
 import com.harmony.agent.core.model.IssueSeverity;
@@ -45,6 +46,14 @@ public class RegexAnalyzer implements Analyzer {
 
     @Override
     public List<SecurityIssue> analyze(Path filePath) throws AnalyzerException {
+        JfrEvents.AnalyzerRun event = new JfrEvents.AnalyzerRun();
+        event.begin();
+        List<SecurityIssue> issues = scanFile(filePath);
+        event.finish(getName(), filePath.toString(), 1, issues.size());
+        return issues;
+    }
+
+    private List<SecurityIssue> scanFile(Path filePath) throws AnalyzerException {
         List<SecurityIssue> issues = new ArrayList<>();
 
         try {
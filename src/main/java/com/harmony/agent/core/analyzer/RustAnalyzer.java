@@ -1,10 +1,19 @@
 package com.harmony.agent.core.analyzer;
 
+import com.google.common.hash.Hasher;
+import com.google.common.hash.Hashing;
+import com.google.gson.Gson;
+import com.google.gson.GsonBuilder;
 import com.google.gson.JsonArray;
 import com.google.gson.JsonElement;
 import com.google.gson.JsonObject;
 import com.google.gson.JsonParser;
+import com.google.gson.JsonParseException;
+import com.google.gson.ToNumberPolicy;
+import com.google.gson.reflect.TypeToken;
 import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.ai.PersistentCacheManager;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.core.model.CodeLocation;
 import com.harmony.agent.core.model.IssueCategory;
 import com.harmony.agent.core.model.IssueSeverity;
@@ -13,36 +22,122 @@ import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
 import java.io.BufferedReader;
-import java.io.File;
 import java.io.IOException;
 import java.io.InputStreamReader;
+import java.lang.reflect.Type;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.FileVisitResult;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.Paths;
+import java.nio.file.SimpleFileVisitor;
+import java.nio.file.attribute.BasicFileAttributes;
 import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
 import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeSet;
 import java.util.UUID;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
 
 /**
  * Rust static analyzer integration
  * Uses cargo clippy for linting and cargo geiger for unsafe code scanning
+ *
+ * Files are grouped by Cargo workspace and member crate. Each workspace gets a single
+ * clippy run covering all its stale crates ({@code -p a -p b}), so cargo builds them in
+ * parallel against the workspace's one target dir. Clippy output is parsed as it streams
+ * and cached per crate, keyed by the source fingerprints of the crate and its path
+ * dependencies plus the Cargo.lock hash.
+ *
+ * Geiger unsafety counts of third-party packages are cached machine-wide per
+ * (name, version, source, features); first-party crates are counted in-process, so
+ * cargo geiger only runs when the lock file brings in a dependency version not seen before.
  */
 public class RustAnalyzer implements Analyzer {
 
     private static final Logger logger = LoggerFactory.getLogger(RustAnalyzer.class);
 
+    private static final Gson GSON = new GsonBuilder()
+        .setObjectToNumberStrategy(ToNumberPolicy.LONG_OR_DOUBLE)
+        .create();
+    private static final Type ISSUE_LIST = new TypeToken<List<SecurityIssue>>() { }.getType();
+    private static final String CLIPPY_CACHE_VERSION = "clippy-v1";
+    private static final String GEIGER_CACHE_VERSION = "geiger-v1";
+    private static final List<String> CLIPPY_LINT_ARGS = List.of("-W", "clippy::all");
+    private static final Pattern MANIFEST_PATH = Pattern.compile("\\bpath\\s*=\\s*[\"']([^\"']+)[\"']");
+
     private final String cargoPath;
     private final Path projectRoot;
+    private final PersistentCacheManager clippyCache;  // null = no result caching
+    private final PersistentCacheManager geigerCache;  // null = no result caching
+    private volatile String cargoVersion;
 
     public RustAnalyzer() {
-        ConfigManager configManager = ConfigManager.getInstance();
-        this.cargoPath = configManager.getConfig().getTools().getCargoPath();
-        this.projectRoot = null;  // Will be determined from file path
+        this(ConfigManager.getInstance().getConfig().getTools().getCargoPath(), null);
     }
 
     public RustAnalyzer(String cargoPath, Path projectRoot) {
+        this(cargoPath, projectRoot, openCache("clippy"), openCache("geiger"));
+    }
+
+    RustAnalyzer(String cargoPath, Path projectRoot,
+                 PersistentCacheManager clippyCache, PersistentCacheManager geigerCache) {
         this.cargoPath = cargoPath;
-        this.projectRoot = projectRoot;
+        this.projectRoot = projectRoot;  // Fallback when a file has no Cargo.toml above it
+        this.clippyCache = clippyCache;
+        this.geigerCache = geigerCache;
+    }
+
+    private static PersistentCacheManager openCache(String type) {
+        try {
+            return new PersistentCacheManager(type);
+        } catch (RuntimeException e) {
+            logger.warn("{} result cache disabled: {}", type, e.getMessage());
+            return null;
+        }
+    }
+
+    /**
+     * A workspace member (or standalone crate); packageName is null for a virtual manifest
+     */
+    private record CargoCrate(Path workspaceRoot, Path root, String packageName) {
+    }
+
+    /**
+     * Streamed clippy output attributed to the requested crates
+     */
+    private record ClippyRun(Map<CargoCrate, List<SecurityIssue>> issues, boolean succeeded) {
+    }
+
+    /**
+     * A package of the resolved dependency graph; source is null for path (first-party) crates
+     */
+    private record CargoPackage(String name, String version, String source, Path manifestPath,
+                                List<String> features) {
+        boolean isFirstParty() {
+            return source == null;
+        }
+    }
+
+    /**
+     * Unsafe usage of one package as reported by cargo geiger
+     */
+    private record GeigerCount(String name, String version, int unsafeCount, String manifestPath) {
+    }
+
+    /**
+     * Parsed cargo geiger output (null if unparseable) and whether geiger exited cleanly
+     */
+    private record GeigerScan(List<GeigerCount> counts, boolean succeeded) {
+    }
+
+    private record CargoOutput(int exitCode, String stdout, String stderr) {
     }
 
     @Override
@@ -93,28 +188,33 @@ public class RustAnalyzer implements Analyzer {
             throw new AnalyzerException("Cargo is not available. Please install Rust: https://rustup.rs/");
         }
 
-        // Find Cargo.toml root
-        Path cargoRoot = findCargoRoot(file);
-        if (cargoRoot == null) {
+        // Find the crate and its workspace
+        Path target = file.toAbsolutePath().normalize();
+        CargoCrate crate = crateOf(target, new HashMap<>());
+        if (crate == null) {
             throw new AnalyzerException("Could not find Cargo.toml for file: " + file);
         }
 
-        logger.info("Analyzing Rust project at: {}", cargoRoot);
+        logger.info("Analyzing Rust crate at: {}", crate.root());
 
         List<SecurityIssue> issues = new ArrayList<>();
 
-        // Run cargo clippy
+        // Run cargo clippy on the crate (cached), then keep this file's diagnostics
         try {
-            List<SecurityIssue> clippyIssues = runClippy(cargoRoot, file);
-            issues.addAll(clippyIssues);
-            logger.info("Clippy found {} issues", clippyIssues.size());
+            List<SecurityIssue> clippyIssues = clippy(crate.workspaceRoot(), List.of(crate)).get(crate);
+            for (SecurityIssue issue : clippyIssues) {
+                if (Paths.get(issue.getLocation().getFilePath()).equals(target)) {
+                    issues.add(issue);
+                }
+            }
+            logger.info("Clippy found {} issues in {}", issues.size(), file);
         } catch (Exception e) {
             logger.warn("Clippy analysis failed: {}", e.getMessage());
         }
 
         // Run cargo geiger (unsafe scanner)
         try {
-            List<SecurityIssue> geigerIssues = runGeiger(cargoRoot, file);
+            List<SecurityIssue> geigerIssues = runGeiger(crate.root());
             issues.addAll(geigerIssues);
             logger.info("Geiger found {} unsafe usage issues", geigerIssues.size());
         } catch (Exception e) {
@@ -134,71 +234,283 @@ public class RustAnalyzer implements Analyzer {
             throw new AnalyzerException("Cargo is not available. Please install Rust: https://rustup.rs/");
         }
 
-        // For Rust, we analyze the entire project at once (Cargo operates on the whole crate)
-        Path firstFile = files.get(0);
-        Path cargoRoot = findCargoRoot(firstFile);
-        if (cargoRoot == null) {
+        // Cargo operates on whole crates: group the files by workspace and member crate
+        Map<Path, CargoCrate> crateMemo = new HashMap<>();
+        Map<Path, Set<CargoCrate>> workspaces = new LinkedHashMap<>();
+        for (Path file : files) {
+            CargoCrate crate = crateOf(file.toAbsolutePath().normalize(), crateMemo);
+            if (crate == null) {
+                logger.debug("No Cargo.toml above {}, skipping", file);
+                continue;
+            }
+            workspaces.computeIfAbsent(crate.workspaceRoot(), k -> new LinkedHashSet<>()).add(crate);
+        }
+        if (workspaces.isEmpty()) {
             throw new AnalyzerException("Could not find Cargo.toml for files");
         }
 
-        logger.info("Analyzing Rust project in batch mode at: {}", cargoRoot);
-
         List<SecurityIssue> issues = new ArrayList<>();
+        for (Map.Entry<Path, Set<CargoCrate>> workspace : workspaces.entrySet()) {
+            Path cargoRoot = workspace.getKey();
+            logger.info("Analyzing Rust workspace in batch mode at: {} ({} crate(s))",
+                cargoRoot, workspace.getValue().size());
+
+            // Run cargo clippy once for all stale crates of the workspace
+            try {
+                clippy(cargoRoot, List.copyOf(workspace.getValue())).values().forEach(issues::addAll);
+            } catch (Exception e) {
+                logger.warn("Clippy batch analysis failed: {}", e.getMessage());
+            }
+
+            // Run cargo geiger for the workspace
+            try {
+                List<SecurityIssue> geigerIssues = runGeiger(cargoRoot);
+                issues.addAll(geigerIssues);
+            } catch (Exception e) {
+                logger.warn("Geiger batch analysis failed: {}", e.getMessage());
+            }
+        }
+
+        return issues;
+    }
+
+    /**
+     * Clippy results per crate: cache hits are served directly, the remaining crates of the
+     * workspace share one streamed clippy run whose per-crate results are then cached
+     */
+    private Map<CargoCrate, List<SecurityIssue>> clippy(Path workspaceRoot, List<CargoCrate> crates)
+            throws IOException, InterruptedException {
+        Map<CargoCrate, List<SecurityIssue>> results = new LinkedHashMap<>();
+        Map<CargoCrate, String> cacheKeys = new HashMap<>();
+        List<CargoCrate> stale = new ArrayList<>();
+        String lockHash = hashFile(workspaceRoot.resolve("Cargo.lock"));
+
+        for (CargoCrate crate : crates) {
+            String key = clippyCacheKey(crate, lockHash);
+            List<SecurityIssue> cached = key != null ? lookupClippy(key) : null;
+            MetricsRegistry.global().counter("harmony_clippy_cache", "Clippy crate results by cache outcome",
+                "result", cached != null ? "hit" : "miss").inc();
+            if (cached != null) {
+                logger.debug("Clippy cache hit for crate {}", crate.root());
+                results.put(crate, cached);
+            } else {
+                cacheKeys.put(crate, key);
+                stale.add(crate);
+            }
+        }
+
+        if (!stale.isEmpty()) {
+            ClippyRun run = runClippy(workspaceRoot, stale);
+            for (CargoCrate crate : stale) {
+                List<SecurityIssue> found = run.issues().getOrDefault(crate, new ArrayList<>());
+                results.put(crate, found);
+                // A failed build yields partial output; only clean runs are cached
+                String key = cacheKeys.get(crate);
+                if (run.succeeded() && key != null && clippyCache != null) {
+                    clippyCache.put(key, GSON.toJson(found, ISSUE_LIST));
+                }
+            }
+        }
+        logger.info("Clippy: {} crate(s) from cache, {} analyzed in {}",
+            crates.size() - stale.size(), stale.size(), workspaceRoot);
+        return results;
+    }
 
-        // Run cargo clippy for all files
+    private List<SecurityIssue> lookupClippy(String key) {
+        if (clippyCache == null) {
+            return null;
+        }
+        String json = clippyCache.get(key);
+        if (json == null) {
+            return null;
+        }
         try {
-            List<SecurityIssue> clippyIssues = runClippy(cargoRoot, null);
-            issues.addAll(clippyIssues);
-        } catch (Exception e) {
-            logger.warn("Clippy batch analysis failed: {}", e.getMessage());
+            return GSON.fromJson(json, ISSUE_LIST);
+        } catch (JsonParseException e) {
+            logger.debug("Ignoring corrupt clippy cache entry {}", key);
+            return null;
         }
+    }
 
-        // Run cargo geiger for all files
+    /**
+     * Cache key: toolchain, lint arguments, crate location, Cargo.lock, workspace manifest,
+     * clippy.toml and the source fingerprints of the crate and its path dependencies (an edit
+     * to a sibling crate changes what clippy reports here); null when the sources cannot be read
+     */
+    private String clippyCacheKey(CargoCrate crate, String lockHash) {
+        if (clippyCache == null) {
+            return null;
+        }
+        if (cargoVersion == null) {
+            cargoVersion = getVersion();
+        }
         try {
-            List<SecurityIssue> geigerIssues = runGeiger(cargoRoot, null);
-            issues.addAll(geigerIssues);
-        } catch (Exception e) {
-            logger.warn("Geiger batch analysis failed: {}", e.getMessage());
+            Path workspaceRoot = crate.workspaceRoot();
+            return Hashing.sha256().hashString(String.join("\n",
+                CLIPPY_CACHE_VERSION,
+                cargoVersion,
+                String.join(" ", CLIPPY_LINT_ARGS),
+                crate.root().toString(),
+                String.valueOf(crate.packageName()),
+                lockHash,
+                hashFile(workspaceRoot.resolve("Cargo.toml")),
+                hashFile(workspaceRoot.resolve("clippy.toml")),
+                hashFile(workspaceRoot.resolve(".clippy.toml")),
+                crateFingerprint(crate.root()),
+                pathDependencyFingerprint(crate)), StandardCharsets.UTF_8).toString();
+        } catch (IOException e) {
+            logger.debug("Cannot fingerprint crate {}: {}", crate.root(), e.getMessage());
+            return null;
         }
+    }
 
-        return issues;
+    /**
+     * Source fingerprint: the crate's sources hashed with relative paths in sorted order
+     */
+    static String crateFingerprint(Path crateRoot) throws IOException {
+        Hasher hasher = Hashing.sha256().newHasher();
+        for (Path source : crateSources(crateRoot)) {
+            hasher.putString(crateRoot.relativize(source).toString(), StandardCharsets.UTF_8)
+                .putByte((byte) 0)
+                .putBytes(Files.readAllBytes(source))
+                .putByte((byte) 0);
+        }
+        return hasher.hash().toString();
+    }
+
+    /**
+     * Fingerprints of the crate's path dependencies, transitively, in sorted order
+     */
+    private static String pathDependencyFingerprint(CargoCrate crate) throws IOException {
+        Hasher hasher = Hashing.sha256().newHasher();
+        for (Path dependency : pathDependencies(crate)) {
+            hasher.putString(dependency.toString(), StandardCharsets.UTF_8)
+                .putByte((byte) 0)
+                .putString(crateFingerprint(dependency), StandardCharsets.UTF_8)
+                .putByte((byte) 0);
+        }
+        return hasher.hash().toString();
+    }
+
+    /**
+     * Crate roots reachable through {@code path = "..."} entries of dependency and patch tables.
+     * The workspace manifest is read too, since members inherit its [workspace.dependencies];
+     * declaring more dependencies than the crate uses only costs a cache miss
+     */
+    private static Set<Path> pathDependencies(CargoCrate crate) throws IOException {
+        Set<Path> found = new TreeSet<>();
+        List<Path> pending = new ArrayList<>(List.of(crate.root(), crate.workspaceRoot()));
+        Set<Path> visited = new LinkedHashSet<>();
+        while (!pending.isEmpty()) {
+            Path root = pending.remove(pending.size() - 1).toAbsolutePath().normalize();
+            if (!visited.add(root)) {
+                continue;
+            }
+            for (Path dependency : manifestPathDependencies(root.resolve("Cargo.toml"))) {
+                if (Files.isRegularFile(dependency.resolve("Cargo.toml"))) {
+                    found.add(dependency);
+                    pending.add(dependency);
+                }
+            }
+        }
+        found.remove(crate.root().toAbsolutePath().normalize());
+        return found;
+    }
+
+    /**
+     * path = "..." values in the [*dependencies*] and [patch.*] sections of one manifest
+     */
+    private static List<Path> manifestPathDependencies(Path manifest) throws IOException {
+        List<Path> paths = new ArrayList<>();
+        if (!Files.isRegularFile(manifest)) {
+            return paths;
+        }
+        String section = "";
+        for (String raw : Files.readAllLines(manifest)) {
+            String line = raw.trim();
+            if (line.startsWith("[")) {
+                section = line;
+                continue;
+            }
+            if (!section.contains("dependencies") && !section.startsWith("[patch")) {
+                continue;
+            }
+            Matcher matcher = MANIFEST_PATH.matcher(line);
+            if (matcher.find()) {
+                paths.add(manifest.getParent().resolve(matcher.group(1)).toAbsolutePath().normalize());
+            }
+        }
+        return paths;
     }
 
     /**
-     * Run cargo clippy and parse output
+     * Cargo.toml and every .rs file under the crate, skipping target/, hidden directories
+     * and nested crates, in sorted order
      */
-    private List<SecurityIssue> runClippy(Path cargoRoot, Path specificFile) throws IOException, InterruptedException {
+    private static List<Path> crateSources(Path crateRoot) throws IOException {
+        List<Path> sources = new ArrayList<>();
+        Files.walkFileTree(crateRoot, new SimpleFileVisitor<Path>() {
+            @Override
+            public FileVisitResult preVisitDirectory(Path dir, BasicFileAttributes attrs) {
+                if (dir.equals(crateRoot)) {
+                    return FileVisitResult.CONTINUE;
+                }
+                String name = dir.getFileName().toString();
+                if (name.equals("target") || name.startsWith(".") || Files.exists(dir.resolve("Cargo.toml"))) {
+                    return FileVisitResult.SKIP_SUBTREE;
+                }
+                return FileVisitResult.CONTINUE;
+            }
+
+            @Override
+            public FileVisitResult visitFile(Path file, BasicFileAttributes attrs) {
+                String name = file.getFileName().toString();
+                if (name.endsWith(".rs") || name.equals("Cargo.toml")) {
+                    sources.add(file);
+                }
+                return FileVisitResult.CONTINUE;
+            }
+        });
+        Collections.sort(sources);
+        return sources;
+    }
+
+    private static String hashFile(Path file) throws IOException {
+        if (!Files.isRegularFile(file)) {
+            return "-";
+        }
+        return Hashing.sha256().hashBytes(Files.readAllBytes(file)).toString();
+    }
+
+    /**
+     * Run cargo clippy for the given crates of one workspace, parsing its JSON as it streams
+     */
+    private ClippyRun runClippy(Path workspaceRoot, List<CargoCrate> crates) throws IOException, InterruptedException {
         List<String> command = new ArrayList<>();
         command.add(cargoPath);
         command.add("clippy");
         command.add("--message-format=json");
+        if (crates.stream().anyMatch(crate -> crate.packageName() == null)) {
+            command.add("--workspace");  // Virtual manifest: no package to select
+        } else {
+            for (CargoCrate crate : crates) {
+                command.add("-p");
+                command.add(crate.packageName());
+            }
+        }
         command.add("--");
-        command.add("-W");
-        command.add("clippy::all");
+        command.addAll(CLIPPY_LINT_ARGS);
 
         ProcessBuilder pb = new ProcessBuilder(command);
-        pb.directory(cargoRoot.toFile());
+        pb.directory(workspaceRoot.toFile());
         pb.redirectErrorStream(false);
 
         Process process = pb.start();
+        MetricsRegistry.global().trackProcess(getName(), process);
 
-        StringBuilder output = new StringBuilder();
         StringBuilder errorOutput = new StringBuilder();
 
-        // Read stdout
-        Thread stdoutThread = new Thread(() -> {
-            try (BufferedReader reader = new BufferedReader(
-                new InputStreamReader(process.getInputStream()))) {
-                String line;
-                while ((line = reader.readLine()) != null) {
-                    output.append(line).append("\n");
-                }
-            } catch (IOException e) {
-                logger.error("Error reading Clippy stdout", e);
-            }
-        });
-
-        // Read stderr
+        // Read stderr (build progress) so the process never blocks on a full pipe
         Thread stderrThread = new Thread(() -> {
             try (BufferedReader reader = new BufferedReader(
                 new InputStreamReader(process.getErrorStream()))) {
@@ -210,33 +522,224 @@ public class RustAnalyzer implements Analyzer {
                 logger.error("Error reading Clippy stderr", e);
             }
         });
-
-        stdoutThread.start();
         stderrThread.start();
 
+        // Parse stdout line by line and attribute each diagnostic to its crate
+        Map<CargoCrate, List<SecurityIssue>> issues = new HashMap<>();
+        int parsed = 0;
+        try (BufferedReader reader = new BufferedReader(
+            new InputStreamReader(process.getInputStream()))) {
+            String line;
+            while ((line = reader.readLine()) != null) {
+                SecurityIssue issue = parseClippyLine(line, workspaceRoot);
+                if (issue == null) {
+                    continue;
+                }
+                CargoCrate owner = ownerOf(Paths.get(issue.getLocation().getFilePath()), crates);
+                if (owner != null) {
+                    issues.computeIfAbsent(owner, k -> new ArrayList<>()).add(issue);
+                    parsed++;
+                }
+            }
+        }
+
         int exitCode = process.waitFor();
-        stdoutThread.join();
         stderrThread.join();
 
         logger.debug("Clippy exit code: {}", exitCode);
+        if (exitCode != 0) {
+            logger.warn("Clippy returned non-zero exit code in {}. Stderr: {}", workspaceRoot, errorOutput);
+        }
+        logger.info("Parsed {} Clippy issues", parsed);
+
+        return new ClippyRun(issues, exitCode == 0);
+    }
+
+    /**
+     * Unsafe usage per package of the resolved graph. Third-party packages are served from the
+     * geiger cache, first-party crates are counted in-process; cargo geiger runs only for
+     * dependency versions that are not cached yet
+     */
+    private List<SecurityIssue> runGeiger(Path cargoRoot) throws IOException, InterruptedException {
+        List<CargoPackage> packages = cargoMetadata(cargoRoot);
+        if (packages == null) {
+            // No resolved graph to key the cache on: scan everything, uncached
+            List<GeigerCount> scanned = runGeigerScan(cargoRoot).counts();
+            List<SecurityIssue> issues = new ArrayList<>();
+            if (scanned != null) {
+                for (GeigerCount count : scanned) {
+                    if (count.unsafeCount() > 0) {
+                        issues.add(unsafeIssue(count.name(), count.unsafeCount(), count.manifestPath()));
+                    }
+                }
+            }
+            return issues;
+        }
+
+        Map<CargoPackage, Integer> counts = new LinkedHashMap<>();
+        List<CargoPackage> uncached = new ArrayList<>();
+        for (CargoPackage pkg : packages) {
+            if (pkg.isFirstParty()) {
+                counts.put(pkg, countUnsafe(pkg.manifestPath().getParent()));
+                continue;
+            }
+            Integer cached = lookupGeiger(pkg);
+            MetricsRegistry.global().counter("harmony_geiger_cache", "Geiger dependency results by cache outcome",
+                "result", cached != null ? "hit" : "miss").inc();
+            if (cached != null) {
+                counts.put(pkg, cached);
+            } else {
+                uncached.add(pkg);
+            }
+        }
+
+        if (uncached.isEmpty()) {
+            logger.info("Geiger: all {} dependencies cached, skipping cargo geiger in {}",
+                packages.size() - countFirstParty(packages), cargoRoot);
+        } else {
+            logger.info("Geiger: {} dependency version(s) not cached, running cargo geiger in {}",
+                uncached.size(), cargoRoot);
+            GeigerScan scan = runGeigerScan(cargoRoot);
+            if (scan.counts() != null) {
+                Map<String, Integer> byVersion = new HashMap<>();
+                for (GeigerCount count : scan.counts()) {
+                    byVersion.put(count.name() + "@" + count.version(), count.unsafeCount());
+                }
+                for (CargoPackage pkg : uncached) {
+                    // Packages geiger did not measure (e.g. proc-macros) are recorded as 0, not rescanned
+                    int unsafeCount = byVersion.getOrDefault(pkg.name() + "@" + pkg.version(), 0);
+                    counts.put(pkg, unsafeCount);
+                    // A failed run may have skipped packages; only clean runs are cached
+                    if (scan.succeeded() && geigerCache != null) {
+                        geigerCache.put(geigerCacheKey(pkg), String.valueOf(unsafeCount));
+                    }
+                }
+            }
+        }
+
+        List<SecurityIssue> issues = new ArrayList<>();
+        counts.forEach((pkg, unsafeCount) -> {
+            if (unsafeCount > 0) {
+                issues.add(unsafeIssue(pkg.name(), unsafeCount, pkg.manifestPath().toString()));
+            }
+        });
+        logger.info("Parsed {} Geiger unsafe issues", issues.size());
+        return issues;
+    }
+
+    private static long countFirstParty(List<CargoPackage> packages) {
+        return packages.stream().filter(CargoPackage::isFirstParty).count();
+    }
+
+    private Integer lookupGeiger(CargoPackage pkg) {
+        if (geigerCache == null) {
+            return null;
+        }
+        String cached = geigerCache.get(geigerCacheKey(pkg));
+        if (cached == null) {
+            return null;
+        }
+        try {
+            return Integer.parseInt(cached);
+        } catch (NumberFormatException e) {
+            logger.debug("Ignoring corrupt geiger cache entry for {}@{}", pkg.name(), pkg.version());
+            return null;
+        }
+    }
+
+    private static String geigerCacheKey(CargoPackage pkg) {
+        return Hashing.sha256().hashString(String.join("\n",
+            GEIGER_CACHE_VERSION,
+            pkg.name(),
+            pkg.version(),
+            pkg.source(),
+            String.join(",", pkg.features())), StandardCharsets.UTF_8).toString();
+    }
+
+    /**
+     * Resolved packages with their activated features (cargo metadata); null if cargo cannot resolve
+     */
+    private List<CargoPackage> cargoMetadata(Path cargoRoot) throws IOException, InterruptedException {
+        CargoOutput output = runCargo(cargoRoot, "metadata", "--format-version", "1");
+        if (output.exitCode() != 0) {
+            logger.warn("cargo metadata failed in {}: {}", cargoRoot, output.stderr());
+            return null;
+        }
+
+        try {
+            JsonObject root = JsonParser.parseString(output.stdout()).getAsJsonObject();
+            Map<String, JsonObject> byId = new HashMap<>();
+            for (JsonElement element : root.getAsJsonArray("packages")) {
+                JsonObject pkg = element.getAsJsonObject();
+                byId.put(pkg.get("id").getAsString(), pkg);
+            }
+
+            // Only packages in the resolved graph, with the features actually enabled
+            Map<String, List<String>> features = new LinkedHashMap<>();
+            if (root.has("resolve") && !root.get("resolve").isJsonNull()) {
+                for (JsonElement element : root.getAsJsonObject("resolve").getAsJsonArray("nodes")) {
+                    JsonObject node = element.getAsJsonObject();
+                    List<String> enabled = new ArrayList<>();
+                    if (node.has("features")) {
+                        node.getAsJsonArray("features").forEach(f -> enabled.add(f.getAsString()));
+                    }
+                    Collections.sort(enabled);
+                    features.put(node.get("id").getAsString(), enabled);
+                }
+            } else {
+                byId.keySet().forEach(id -> features.put(id, List.of()));
+            }
+
+            List<CargoPackage> packages = new ArrayList<>();
+            features.forEach((id, enabled) -> {
+                JsonObject pkg = byId.get(id);
+                if (pkg == null) {
+                    return;
+                }
+                JsonElement source = pkg.get("source");
+                packages.add(new CargoPackage(
+                    pkg.get("name").getAsString(),
+                    pkg.get("version").getAsString(),
+                    source == null || source.isJsonNull() ? null : source.getAsString(),
+                    Paths.get(pkg.get("manifest_path").getAsString()),
+                    enabled));
+            });
+            return packages;
+        } catch (RuntimeException e) {
+            logger.warn("Failed to parse cargo metadata output: {}", e.getMessage());
+            return null;
+        }
+    }
+
+    /**
+     * Run cargo geiger over the whole graph; counts are null if its output cannot be parsed
+     */
+    private GeigerScan runGeigerScan(Path cargoRoot) throws IOException, InterruptedException {
+        CargoOutput output = runCargo(cargoRoot, "geiger", "--output-format=Json");
+
+        logger.debug("Geiger exit code: {}", output.exitCode());
+
+        if (output.exitCode() != 0) {
+            logger.warn("Geiger returned non-zero exit code. Stderr: {}", output.stderr());
+        }
 
-        return parseClippyOutput(output.toString(), specificFile);
+        return new GeigerScan(parseGeigerOutput(output.stdout()), output.exitCode() == 0);
     }
 
     /**
-     * Run cargo geiger and parse output
+     * Run a cargo subcommand to completion, draining stdout and stderr concurrently
      */
-    private List<SecurityIssue> runGeiger(Path cargoRoot, Path specificFile) throws IOException, InterruptedException {
+    private CargoOutput runCargo(Path dir, String... args) throws IOException, InterruptedException {
         List<String> command = new ArrayList<>();
         command.add(cargoPath);
-        command.add("geiger");
-        command.add("--output-format=Json");
+        command.addAll(List.of(args));
 
         ProcessBuilder pb = new ProcessBuilder(command);
-        pb.directory(cargoRoot.toFile());
+        pb.directory(dir.toFile());
         pb.redirectErrorStream(false);
 
         Process process = pb.start();
+        MetricsRegistry.global().trackProcess(getName(), process);
 
         StringBuilder output = new StringBuilder();
         StringBuilder errorOutput = new StringBuilder();
@@ -250,7 +753,7 @@ public class RustAnalyzer implements Analyzer {
                     output.append(line).append("\n");
                 }
             } catch (IOException e) {
-                logger.error("Error reading Geiger stdout", e);
+                logger.error("Error reading cargo {} stdout", args[0], e);
             }
         });
 
@@ -263,7 +766,7 @@ public class RustAnalyzer implements Analyzer {
                     errorOutput.append(line).append("\n");
                 }
             } catch (IOException e) {
-                logger.error("Error reading Geiger stderr", e);
+                logger.error("Error reading cargo {} stderr", args[0], e);
             }
         });
 
@@ -274,66 +777,44 @@ public class RustAnalyzer implements Analyzer {
         stdoutThread.join();
         stderrThread.join();
 
-        logger.debug("Geiger exit code: {}", exitCode);
-
-        if (exitCode != 0) {
-            logger.warn("Geiger returned non-zero exit code. Stderr: {}", errorOutput);
-        }
-
-        return parseGeigerOutput(output.toString(), specificFile);
+        return new CargoOutput(exitCode, output.toString(), errorOutput.toString());
     }
 
     /**
-     * Parse cargo clippy JSON output
-     * Format: One JSON object per line, with "reason" field
+     * Parse one line of cargo clippy JSON output
+     * Format: One JSON object per line, with "reason" field; only compiler messages become issues
      */
-    private List<SecurityIssue> parseClippyOutput(String jsonOutput, Path specificFile) {
-        List<SecurityIssue> issues = new ArrayList<>();
+    private SecurityIssue parseClippyLine(String line, Path workspaceRoot) {
+        line = line.trim();
+        if (line.isEmpty() || line.charAt(0) != '{') {
+            return null;
+        }
 
         try {
-            String[] lines = jsonOutput.split("\n");
-
-            for (String line : lines) {
-                line = line.trim();
-                if (line.isEmpty()) continue;
+            JsonObject obj = JsonParser.parseString(line).getAsJsonObject();
 
-                try {
-                    JsonObject obj = JsonParser.parseString(line).getAsJsonObject();
-
-                    // Only process compiler messages
-                    if (!obj.has("reason") || !"compiler-message".equals(obj.get("reason").getAsString())) {
-                        continue;
-                    }
-
-                    JsonObject message = obj.getAsJsonObject("message");
-                    if (message == null) continue;
-
-                    // Parse the diagnostic message
-                    SecurityIssue issue = parseClippyMessage(message);
-                    if (issue != null) {
-                        // Filter by specific file if provided
-                        if (specificFile == null || issue.getLocation().getFilePath().equals(specificFile.toString())) {
-                            issues.add(issue);
-                        }
-                    }
+            // Only process compiler messages
+            if (!obj.has("reason") || !"compiler-message".equals(obj.get("reason").getAsString())) {
+                return null;
+            }
 
-                } catch (Exception e) {
-                    logger.debug("Failed to parse Clippy line: {}", e.getMessage());
-                }
+            JsonObject message = obj.getAsJsonObject("message");
+            if (message == null) {
+                return null;
             }
 
+            // Parse the diagnostic message
+            return parseClippyMessage(message, workspaceRoot);
         } catch (Exception e) {
-            logger.error("Failed to parse Clippy JSON output", e);
+            logger.debug("Failed to parse Clippy line: {}", e.getMessage());
+            return null;
         }
-
-        logger.info("Parsed {} Clippy issues", issues.size());
-        return issues;
     }
 
     /**
      * Parse a single Clippy diagnostic message
      */
-    private SecurityIssue parseClippyMessage(JsonObject message) {
+    private SecurityIssue parseClippyMessage(JsonObject message, Path workspaceRoot) {
         try {
             String messageText = message.get("message").getAsString();
             String level = message.has("level") ? message.get("level").getAsString() : "warning";
@@ -352,8 +833,9 @@ public class RustAnalyzer implements Analyzer {
                 return null;  // No location info
             }
 
-            JsonObject span = message.getAsJsonArray("spans").get(0).getAsJsonObject();
-            String filePath = span.get("file_name").getAsString();
+            JsonObject span = primarySpan(message.getAsJsonArray("spans"));
+            // file_name is relative to the workspace root (absolute for path dependencies outside it)
+            String filePath = workspaceRoot.resolve(span.get("file_name").getAsString()).normalize().toString();
             int lineStart = span.get("line_start").getAsInt();
             int columnStart = span.get("column_start").getAsInt();
 
@@ -392,12 +874,23 @@ public class RustAnalyzer implements Analyzer {
         }
     }
 
+    private static JsonObject primarySpan(JsonArray spans) {
+        for (JsonElement element : spans) {
+            JsonObject span = element.getAsJsonObject();
+            if (span.has("is_primary") && span.get("is_primary").getAsBoolean()) {
+                return span;
+            }
+        }
+        return spans.get(0).getAsJsonObject();
+    }
+
     /**
      * Parse cargo geiger JSON output
-     * Geiger reports unsafe code usage
+     * Geiger reports unsafe code usage per package; both the flat ({@code name}, {@code used.unsafe})
+     * and the nested ({@code package.id}, per-kind {@code unsafe_}) layouts are accepted
      */
-    private List<SecurityIssue> parseGeigerOutput(String jsonOutput, Path specificFile) {
-        List<SecurityIssue> issues = new ArrayList<>();
+    private List<GeigerCount> parseGeigerOutput(String jsonOutput) {
+        List<GeigerCount> counts = new ArrayList<>();
 
         try {
             JsonObject root = JsonParser.parseString(jsonOutput).getAsJsonObject();
@@ -405,58 +898,147 @@ public class RustAnalyzer implements Analyzer {
             // Geiger output has "packages" array
             if (!root.has("packages")) {
                 logger.debug("No packages found in Geiger output");
-                return issues;
+                return counts;
             }
 
-            JsonArray packages = root.getAsJsonArray("packages");
-
-            for (JsonElement pkgElement : packages) {
+            for (JsonElement pkgElement : root.getAsJsonArray("packages")) {
                 JsonObject pkg = pkgElement.getAsJsonObject();
 
                 // Get unsafe usage statistics
                 if (!pkg.has("unsafety")) continue;
 
-                JsonObject unsafety = pkg.getAsJsonObject("unsafety");
+                JsonObject id = pkg.has("package") && pkg.getAsJsonObject("package").has("id")
+                    ? pkg.getAsJsonObject("package").getAsJsonObject("id")
+                    : pkg;
+                String name = id.has("name") ? id.get("name").getAsString() : "unknown";
+                String version = id.has("version") ? id.get("version").getAsString() : "";
+                String manifestPath = pkg.has("manifest_path") ? pkg.get("manifest_path").getAsString() : "unknown";
 
-                // Check if there's unsafe code
-                int unsafeUsed = unsafety.has("used") && unsafety.getAsJsonObject("used").has("unsafe")
-                    ? unsafety.getAsJsonObject("used").get("unsafe").getAsInt()
-                    : 0;
+                counts.add(new GeigerCount(name, version, usedUnsafe(pkg.getAsJsonObject("unsafety")), manifestPath));
+            }
 
-                if (unsafeUsed > 0) {
-                    // Create an issue for unsafe usage
-                    String packageName = pkg.has("name") ? pkg.get("name").getAsString() : "unknown";
+        } catch (Exception e) {
+            logger.error("Failed to parse Geiger JSON output", e);
+            return null;
+        }
 
-                    // Try to get file location from package
-                    String filePath = "unknown";
-                    if (pkg.has("manifest_path")) {
-                        filePath = pkg.get("manifest_path").getAsString();
-                    }
+        return counts;
+    }
 
-                    CodeLocation location = new CodeLocation(filePath, 1, 1, null);
+    private static int usedUnsafe(JsonObject unsafety) {
+        if (!unsafety.has("used")) {
+            return 0;
+        }
+        JsonObject used = unsafety.getAsJsonObject("used");
+        if (used.has("unsafe")) {
+            return used.get("unsafe").getAsInt();
+        }
+        int total = 0;
+        for (Map.Entry<String, JsonElement> kind : used.entrySet()) {
+            if (kind.getValue().isJsonObject() && kind.getValue().getAsJsonObject().has("unsafe_")) {
+                total += kind.getValue().getAsJsonObject().get("unsafe_").getAsInt();
+            }
+        }
+        return total;
+    }
 
-                    SecurityIssue issue = new SecurityIssue.Builder()
-                        .id(UUID.randomUUID().toString())
-                        .title("Unsafe code detected")
-                        .description(String.format("Package '%s' contains %d unsafe usage(s)", packageName, unsafeUsed))
-                        .severity(IssueSeverity.HIGH)  // Unsafe code is high priority
-                        .category(IssueCategory.UNSAFE_CODE)
-                        .location(location)
-                        .analyzer(getName())
-                        .metadata("geiger_unsafe_count", unsafeUsed)
-                        .metadata("package", packageName)
-                        .build();
+    private SecurityIssue unsafeIssue(String packageName, int unsafeUsed, String manifestPath) {
+        CodeLocation location = new CodeLocation(manifestPath, 1, 1, null);
+
+        return new SecurityIssue.Builder()
+            .id(UUID.randomUUID().toString())
+            .title("Unsafe code detected")
+            .description(String.format("Package '%s' contains %d unsafe usage(s)", packageName, unsafeUsed))
+            .severity(IssueSeverity.HIGH)  // Unsafe code is high priority
+            .category(IssueCategory.UNSAFE_CODE)
+            .location(location)
+            .analyzer(getName())
+            .metadata("geiger_unsafe_count", unsafeUsed)
+            .metadata("package", packageName)
+            .build();
+    }
 
-                    issues.add(issue);
-                }
+    /**
+     * Unsafe blocks, functions, impls and traits in a first-party crate: occurrences of the
+     * unsafe keyword outside comments, string and char literals
+     */
+    static int countUnsafe(Path crateRoot) throws IOException {
+        int count = 0;
+        for (Path source : crateSources(crateRoot)) {
+            if (source.getFileName().toString().endsWith(".rs")) {
+                count += countUnsafeKeywords(Files.readString(source));
             }
-
-        } catch (Exception e) {
-            logger.error("Failed to parse Geiger JSON output", e);
         }
+        return count;
+    }
 
-        logger.info("Parsed {} Geiger unsafe issues", issues.size());
-        return issues;
+    static int countUnsafeKeywords(String code) {
+        int count = 0;
+        int n = code.length();
+        int i = 0;
+        while (i < n) {
+            char c = code.charAt(i);
+            if (code.startsWith("//", i)) {
+                int end = code.indexOf('\n', i);
+                i = end < 0 ? n : end + 1;
+            } else if (code.startsWith("/*", i)) {
+                // Block comments nest in Rust
+                int depth = 1;
+                i += 2;
+                while (i < n && depth > 0) {
+                    if (code.startsWith("/*", i)) {
+                        depth++;
+                        i += 2;
+                    } else if (code.startsWith("*/", i)) {
+                        depth--;
+                        i += 2;
+                    } else {
+                        i++;
+                    }
+                }
+            } else if (c == '"') {
+                i++;
+                while (i < n && code.charAt(i) != '"') {
+                    i += code.charAt(i) == '\\' ? 2 : 1;
+                }
+                i++;
+            } else if (c == '\'') {
+                if (i + 2 < n && code.charAt(i + 1) == '\\') {
+                    int end = code.indexOf('\'', i + 3);
+                    i = end < 0 ? n : end + 1;
+                } else if (i + 2 < n && code.charAt(i + 2) == '\'') {
+                    i += 3;
+                } else {
+                    i++;  // Lifetime
+                }
+            } else if (Character.isJavaIdentifierStart(c)) {
+                int start = i;
+                while (i < n && Character.isJavaIdentifierPart(code.charAt(i))) {
+                    i++;
+                }
+                String word = code.substring(start, i);
+                if (word.equals("unsafe")) {
+                    count++;
+                } else if ((word.equals("r") || word.equals("br")) && i < n
+                    && (code.charAt(i) == '"' || code.charAt(i) == '#')) {
+                    // Raw string r#"..."#: closes on a quote followed by the same number of hashes
+                    int hashes = 0;
+                    while (i < n && code.charAt(i) == '#') {
+                        hashes++;
+                        i++;
+                    }
+                    if (i >= n || code.charAt(i) != '"') {
+                        continue;  // Raw identifier r#name
+                    }
+                    String close = "\"" + "#".repeat(hashes);
+                    int end = code.indexOf(close, i + 1);
+                    i = end < 0 ? n : end + close.length();
+                }
+            } else {
+                i++;
+            }
+        }
+        return count;
     }
 
     /**
@@ -541,4 +1123,72 @@ public class RustAnalyzer implements Analyzer {
 
         return projectRoot;  // Fall back to provided project root
     }
+
+    /**
+     * Crate owning a file: nearest Cargo.toml, inside the nearest enclosing [workspace] (or itself)
+     */
+    private CargoCrate crateOf(Path file, Map<Path, CargoCrate> memo) {
+        Path crateRoot = findCargoRoot(file);
+        if (crateRoot == null) {
+            return null;
+        }
+        return memo.computeIfAbsent(crateRoot.toAbsolutePath().normalize(), root -> {
+            Path workspaceRoot = root;
+            for (Path dir = root; dir != null; dir = dir.getParent()) {
+                if (isWorkspaceManifest(dir.resolve("Cargo.toml"))) {
+                    workspaceRoot = dir;
+                    break;
+                }
+            }
+            return new CargoCrate(workspaceRoot, root, readPackageName(root.resolve("Cargo.toml")));
+        });
+    }
+
+    /**
+     * Crate whose root is the longest prefix of the file path
+     */
+    private static CargoCrate ownerOf(Path file, List<CargoCrate> crates) {
+        CargoCrate owner = null;
+        for (CargoCrate crate : crates) {
+            if (file.startsWith(crate.root())
+                && (owner == null || crate.root().getNameCount() > owner.root().getNameCount())) {
+                owner = crate;
+            }
+        }
+        return owner;
+    }
+
+    private static boolean isWorkspaceManifest(Path manifest) {
+        if (!Files.isRegularFile(manifest)) {
+            return false;
+        }
+        try {
+            return Files.readAllLines(manifest).stream().anyMatch(line -> line.trim().equals("[workspace]"));
+        } catch (IOException e) {
+            return false;
+        }
+    }
+
+    /**
+     * name = "..." from the [package] section; null for a virtual manifest
+     */
+    private static String readPackageName(Path manifest) {
+        try {
+            String section = "";
+            for (String raw : Files.readAllLines(manifest)) {
+                String line = raw.trim();
+                if (line.startsWith("[")) {
+                    section = line;
+                } else if (section.equals("[package]") && line.startsWith("name")) {
+                    int eq = line.indexOf('=');
+                    if (eq > 0 && line.substring(0, eq).trim().equals("name")) {
+                        return line.substring(eq + 1).trim().replace("\"", "").replace("'", "");
+                    }
+                }
+            }
+        } catch (IOException e) {
+            logger.debug("Failed to read {}: {}", manifest, e.getMessage());
+        }
+        return null;
+    }
 }
@@ -5,6 +5,7 @@ import com.google.gson.JsonElement;
 import com.google.gson.JsonObject;
 import com.google.gson.JsonParser;
 import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.core.model.CodeLocation;
 import com.harmony.agent.core.model.IssueCategory;
 import com.harmony.agent.core.model.IssueSeverity;
@@ -101,6 +102,7 @@ public class SemgrepAnalyzer implements Analyzer {
             ProcessBuilder pb = new ProcessBuilder(command);
             pb.redirectErrorStream(false);
             Process process = pb.start();
+            MetricsRegistry.global().trackProcess(getName(), process);
 
             StringBuilder output = new StringBuilder();
             StringBuilder errorOutput = new StringBuilder();
@@ -170,6 +172,7 @@ public class SemgrepAnalyzer implements Analyzer {
             ProcessBuilder pb = new ProcessBuilder(command);
             pb.redirectErrorStream(false);
             Process process = pb.start();
+            MetricsRegistry.global().trackProcess(getName(), process);
 
             StringBuilder output = new StringBuilder();
             StringBuilder errorOutput = new StringBuilder();
@@ -371,7 +374,7 @@ public class SemgrepAnalyzer implements Analyzer {
     /**
      * Map Semgrep severity to our severity levels
      */
-    private IssueSeverity mapSemgrepSeverity(String semgrepSeverity) {
+    static IssueSeverity mapSemgrepSeverity(String semgrepSeverity) {
         switch (semgrepSeverity.toUpperCase()) {
             case "ERROR":
                 return IssueSeverity.CRITICAL;
@@ -387,7 +390,7 @@ public class SemgrepAnalyzer implements Analyzer {
     /**
      * Determine issue category from check ID and message
      */
-    private IssueCategory determineCategory(String checkId, String message) {
+    static IssueCategory determineCategory(String checkId, String message) {
         String lower = checkId.toLowerCase() + " " + message.toLowerCase();
 
         // Memory issues
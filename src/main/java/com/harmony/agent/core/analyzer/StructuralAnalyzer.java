@@ -0,0 +1,243 @@
+package com.harmony.agent.core.analyzer;
+
+import com.harmony.agent.core.analyzer.pattern.PatternRule;
+import com.harmony.agent.core.analyzer.pattern.TokenPattern;
+import com.harmony.agent.core.analyzer.pattern.TokenStream;
+import com.harmony.agent.core.metrics.JfrEvents;
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.parser.CLexer;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.UUID;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReferenceArray;
+
+/**
+ * In-JVM structural matcher for the bundled Semgrep-style rule packs.
+ *
+ * Rules are loaded once from {@code rules/*.yml} on the classpath and matched over the
+ * {@link CLexer} token stream (see {@link TokenPattern} for the supported pattern subset),
+ * so quick scans and autofix re-checks need neither Python nor a process per batch.
+ * Findings mirror {@link SemgrepAnalyzer}: title is the rule id, with the same severity
+ * and category mapping. Files are matched in parallel when an executor is supplied.
+ */
+public class StructuralAnalyzer implements Analyzer {
+
+    private static final Logger logger = LoggerFactory.getLogger(StructuralAnalyzer.class);
+
+    public static final String NAME = "Semgrep (in-JVM)";
+
+    static final List<String> RULE_PACKS = List.of(
+        "buffer-overflow", "concurrency", "crypto", "injection", "memory-safety"
+    );
+
+    private final List<PatternRule> rules;
+    private final ExecutorService executorService;
+
+    /**
+     * Sequential matcher over the bundled rule packs
+     */
+    public StructuralAnalyzer() {
+        this(null);
+    }
+
+    /**
+     * @param executorService executor for parallel file matching (optional, sequential if null)
+     */
+    public StructuralAnalyzer(ExecutorService executorService) {
+        this(BundledRules.RULES, executorService);
+    }
+
+    public StructuralAnalyzer(List<PatternRule> rules, ExecutorService executorService) {
+        this.rules = List.copyOf(rules);
+        this.executorService = executorService;
+    }
+
+    /**
+     * Bundled rules are parsed once per JVM and shared; compiled patterns are immutable
+     */
+    private static final class BundledRules {
+        static final List<PatternRule> RULES = loadBundledRules();
+    }
+
+    private static List<PatternRule> loadBundledRules() {
+        List<PatternRule> rules = new ArrayList<>();
+        for (String pack : RULE_PACKS) {
+            String resource = "/rules/" + pack + ".yml";
+            try (InputStream in = StructuralAnalyzer.class.getResourceAsStream(resource)) {
+                if (in == null) {
+                    logger.warn("Bundled rule pack not found: {}", resource);
+                    continue;
+                }
+                rules.addAll(PatternRule.parse(new String(in.readAllBytes(), StandardCharsets.UTF_8)));
+            } catch (IOException | IllegalArgumentException e) {
+                logger.warn("Failed to load rule pack {}: {}", resource, e.getMessage());
+            }
+        }
+        logger.debug("Loaded {} structural rules from {} packs", rules.size(), RULE_PACKS.size());
+        return List.copyOf(rules);
+    }
+
+    @Override
+    public String getName() {
+        return NAME;
+    }
+
+    @Override
+    public String getVersion() {
+        return "1.0.0-builtin (" + rules.size() + " rules)";
+    }
+
+    @Override
+    public boolean isAvailable() {
+        return !rules.isEmpty();
+    }
+
+    public int getRuleCount() {
+        return rules.size();
+    }
+
+    @Override
+    public List<SecurityIssue> analyze(Path filePath) throws AnalyzerException {
+        try {
+            return scanFile(filePath);
+        } catch (IOException e) {
+            throw new AnalyzerException("Failed to read file: " + filePath, e);
+        }
+    }
+
+    @Override
+    public List<SecurityIssue> analyzeAll(List<Path> files) throws AnalyzerException {
+        AtomicReferenceArray<List<SecurityIssue>> results = new AtomicReferenceArray<>(files.size());
+        AtomicInteger next = new AtomicInteger();
+        Runnable worker = () -> {
+            for (int i = next.getAndIncrement(); i < files.size(); i = next.getAndIncrement()) {
+                try {
+                    results.set(i, scanFile(files.get(i)));
+                } catch (IOException e) {
+                    logger.warn("Skipping unreadable file {}: {}", files.get(i), e.getMessage());
+                }
+            }
+        };
+
+        List<Helper> helpers = new ArrayList<>();
+        if (executorService != null) {
+            int count = Math.min(files.size() - 1, Runtime.getRuntime().availableProcessors() - 1);
+            for (int i = 0; i < count; i++) {
+                helpers.add(new Helper(executorService, worker));
+            }
+        }
+        worker.run();
+        try {
+            for (Helper helper : helpers) {
+                helper.awaitIfStarted();
+            }
+        } catch (AnalyzerException e) {
+            next.set(files.size());  // remaining helpers stop taking files
+            helpers.forEach(Helper::cancel);
+            throw e;
+        }
+
+        List<SecurityIssue> issues = new ArrayList<>();
+        for (int i = 0; i < files.size(); i++) {
+            if (results.get(i) != null) {
+                issues.addAll(results.get(i));
+            }
+        }
+        logger.info("Found {} issues from {} in {} files", issues.size(), NAME, files.size());
+        return issues;
+    }
+
+    private List<SecurityIssue> scanFile(Path filePath) throws IOException {
+        JfrEvents.AnalyzerRun event = new JfrEvents.AnalyzerRun();
+        event.begin();
+
+        TokenStream stream = new TokenStream(Files.readString(filePath));
+        List<SecurityIssue> issues = new ArrayList<>();
+        for (PatternRule rule : rules) {
+            for (TokenPattern.Match match : rule.evaluate(stream)) {
+                issues.add(toIssue(rule, filePath, stream, match));
+            }
+        }
+
+        event.finish(getName(), filePath.toString(), 1, issues.size());
+        logger.debug("{} found {} issues in {}", NAME, issues.size(), filePath);
+        return issues;
+    }
+
+    private SecurityIssue toIssue(PatternRule rule, Path filePath, TokenStream stream, TokenPattern.Match match) {
+        CodeLocation location = new CodeLocation(
+            filePath.toString(),
+            stream.get(match.start()).getLine(),
+            stream.columnOf(match.start()),
+            stream.lineOf(match.start()).trim()
+        );
+
+        SecurityIssue.Builder builder = new SecurityIssue.Builder()
+            .id(UUID.randomUUID().toString())
+            .title(rule.getId())
+            .description(rule.getMessage())
+            .severity(SemgrepAnalyzer.mapSemgrepSeverity(rule.getSeverity()))
+            .category(SemgrepAnalyzer.determineCategory(rule.getId(), rule.getMessage()))
+            .location(location)
+            .analyzer(getName())
+            .metadata("check_id", rule.getId());
+        rule.getMetadata().forEach((key, value) -> builder.metadata("semgrep_" + key, value));
+        return builder.build();
+    }
+
+    /**
+     * A worker submitted to the shared executor. The calling thread drains the file queue
+     * itself, so a helper that has not started by then is abandoned rather than awaited:
+     * waiting on it could deadlock when every pool thread is blocked inside an analyzer.
+     * An abandoned helper's future is cancelled so it does not linger in the executor queue.
+     */
+    private static final class Helper {
+        private static final int QUEUED = 0;
+        private static final int RUNNING = 1;
+        private static final int ABANDONED = 2;
+
+        private final AtomicInteger state = new AtomicInteger(QUEUED);
+        private final Future<?> future;
+
+        Helper(ExecutorService executor, Runnable work) {
+            this.future = executor.submit(() -> {
+                if (state.compareAndSet(QUEUED, RUNNING)) {
+                    work.run();
+                }
+            });
+        }
+
+        void awaitIfStarted() throws AnalyzerException {
+            if (state.compareAndSet(QUEUED, ABANDONED)) {
+                future.cancel(true);
+                return;
+            }
+            try {
+                future.get();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                throw new AnalyzerException("Interrupted while matching structural rules", e);
+            } catch (ExecutionException e) {
+                throw new AnalyzerException("Structural matching failed", e.getCause());
+            }
+        }
+
+        void cancel() {
+            state.compareAndSet(QUEUED, ABANDONED);
+            future.cancel(true);
+        }
+    }
+}
@@ -0,0 +1,327 @@
+package com.harmony.agent.core.analyzer.pattern;
+
+import com.harmony.agent.core.analyzer.pattern.TokenPattern.Match;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import org.yaml.snakeyaml.Yaml;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.function.Predicate;
+import java.util.regex.Pattern;
+
+/**
+ * 一条 Semgrep 风格规则：id、消息、严重级别、元数据与匹配公式
+ *
+ * 支持的规则语法（内置规则包所用子集）：
+ * - pattern / patterns / pattern-either，可任意嵌套
+ * - pattern-not：剔除起点相同且元变量一致的匹配
+ * - pattern-inside / pattern-not-inside：保留 / 剔除落在该模式匹配区间内的匹配
+ * - metavariable-regex：元变量文本从开头匹配正则（与 Python re.match 一致）
+ * - metavariable-pattern：仅支持 pattern-regex（或由 pattern-regex 组成的 patterns）
+ *
+ * 其他键视为不支持，{@link #parse(String)} 跳过该规则并记录警告。
+ */
+public final class PatternRule {
+
+    private static final Logger logger = LoggerFactory.getLogger(PatternRule.class);
+
+    private final String id;
+    private final String message;
+    private final String severity;
+    private final Map<String, String> metadata;
+    private final Formula formula;
+
+    private PatternRule(String id, String message, String severity, Map<String, String> metadata, Formula formula) {
+        this.id = id;
+        this.message = message;
+        this.severity = severity;
+        this.metadata = metadata;
+        this.formula = formula;
+    }
+
+    public String getId() {
+        return id;
+    }
+
+    public String getMessage() {
+        return message;
+    }
+
+    /**
+     * Semgrep 严重级别原文（ERROR / WARNING / INFO）
+     */
+    public String getSeverity() {
+        return severity;
+    }
+
+    public Map<String, String> getMetadata() {
+        return metadata;
+    }
+
+    /**
+     * 在 Token 序列上求值，返回按起点升序、起点唯一的匹配
+     */
+    public List<Match> evaluate(TokenStream stream) {
+        Map<Integer, Match> byStart = new TreeMap<>();
+        for (Match match : formula.evaluate(stream)) {
+            byStart.putIfAbsent(match.start(), match);
+        }
+        return new ArrayList<>(byStart.values());
+    }
+
+    // ===== 加载 =====
+
+    /**
+     * 解析一个规则包（YAML 顶层为 rules 列表）。只保留适用于 C/C++ 的规则，
+     * 语法不受支持的规则被跳过并记录警告。
+     *
+     * @throws IllegalArgumentException YAML 顶层结构不是规则包
+     */
+    public static List<PatternRule> parse(String yaml) {
+        Object root = new Yaml().load(yaml);
+        if (!(root instanceof Map<?, ?> map) || !(map.get("rules") instanceof List<?> entries)) {
+            throw new IllegalArgumentException("Rule pack must contain a top-level 'rules' list");
+        }
+
+        List<PatternRule> rules = new ArrayList<>();
+        for (Object entry : entries) {
+            Map<?, ?> rule = asMap(entry, "rule");
+            String id = String.valueOf(rule.get("id"));
+            if (!appliesToC(rule.get("languages"))) {
+                continue;
+            }
+            try {
+                rules.add(new PatternRule(
+                    id,
+                    String.valueOf(rule.get("message")),
+                    rule.get("severity") == null ? "INFO" : String.valueOf(rule.get("severity")),
+                    stringMap(rule.get("metadata")),
+                    parseFormula(rule)));
+            } catch (IllegalArgumentException e) {
+                logger.warn("Skipping rule {}: {}", id, e.getMessage());
+            }
+        }
+        return rules;
+    }
+
+    private static boolean appliesToC(Object languages) {
+        if (!(languages instanceof List<?> list)) {
+            return true;
+        }
+        return list.stream().map(String::valueOf).anyMatch(lang -> lang.equals("c") || lang.equals("cpp"));
+    }
+
+    private static Map<String, String> stringMap(Object value) {
+        Map<String, String> result = new LinkedHashMap<>();
+        if (value instanceof Map<?, ?> map) {
+            map.forEach((key, item) -> result.put(String.valueOf(key), String.valueOf(item)));
+        }
+        return result;
+    }
+
+    private static Formula parseFormula(Map<?, ?> rule) {
+        for (String key : List.of("pattern", "patterns", "pattern-either")) {
+            if (rule.containsKey(key)) {
+                return parseOperator(key, rule.get(key));
+            }
+        }
+        throw new IllegalArgumentException("no pattern, patterns or pattern-either");
+    }
+
+    private static Formula parseOperator(String key, Object value) {
+        return switch (key) {
+            case "pattern" -> new Leaf(TokenPattern.compile(asString(value, key)));
+            case "pattern-either" -> {
+                List<Formula> alternatives = new ArrayList<>();
+                for (Object item : asList(value, key)) {
+                    Map.Entry<String, Object> entry = singleEntry(item);
+                    alternatives.add(parseOperator(entry.getKey(), entry.getValue()));
+                }
+                yield new Either(alternatives);
+            }
+            case "patterns" -> parseConjunction(asList(value, key));
+            default -> throw new IllegalArgumentException("unsupported operator '" + key + "'");
+        };
+    }
+
+    private static Formula parseConjunction(List<?> items) {
+        All all = new All(new ArrayList<>(), new ArrayList<>(), new ArrayList<>(), new ArrayList<>(), new ArrayList<>());
+        for (Object item : items) {
+            Map.Entry<String, Object> entry = singleEntry(item);
+            String key = entry.getKey();
+            Object value = entry.getValue();
+            switch (key) {
+                case "pattern", "patterns", "pattern-either" -> all.positives().add(parseOperator(key, value));
+                case "pattern-not" -> all.negatives().add(parseNested(value));
+                case "pattern-inside" -> all.insides().add(parseNested(value));
+                case "pattern-not-inside" -> all.notInsides().add(parseNested(value));
+                case "metavariable-regex" -> all.conditions().add(metavariableRegex(asMap(value, key)));
+                case "metavariable-pattern" -> all.conditions().add(metavariablePattern(asMap(value, key)));
+                default -> throw new IllegalArgumentException("unsupported operator '" + key + "'");
+            }
+        }
+        if (all.positives().isEmpty()) {
+            throw new IllegalArgumentException("patterns without a positive pattern");
+        }
+        return all;
+    }
+
+    /**
+     * pattern-not 等的取值：模式字符串，或嵌套的 { patterns | pattern-either } 映射
+     */
+    private static Formula parseNested(Object value) {
+        if (value instanceof Map<?, ?> map) {
+            return parseFormula(map);
+        }
+        return new Leaf(TokenPattern.compile(asString(value, "pattern")));
+    }
+
+    private static Predicate<Map<String, String>> metavariableRegex(Map<?, ?> spec) {
+        String name = asString(spec.get("metavariable"), "metavariable");
+        Pattern regex = Pattern.compile(asString(spec.get("regex"), "regex"));
+        return bindings -> bindings.containsKey(name) && regex.matcher(bindings.get(name)).lookingAt();
+    }
+
+    private static Predicate<Map<String, String>> metavariablePattern(Map<?, ?> spec) {
+        String name = asString(spec.get("metavariable"), "metavariable");
+        List<Pattern> regexes = new ArrayList<>();
+        if (spec.containsKey("pattern-regex")) {
+            regexes.add(Pattern.compile(asString(spec.get("pattern-regex"), "pattern-regex")));
+        } else if (spec.containsKey("patterns")) {
+            for (Object item : asList(spec.get("patterns"), "patterns")) {
+                Map.Entry<String, Object> entry = singleEntry(item);
+                if (!entry.getKey().equals("pattern-regex")) {
+                    throw new IllegalArgumentException("metavariable-pattern only supports pattern-regex, got '"
+                        + entry.getKey() + "'");
+                }
+                regexes.add(Pattern.compile(asString(entry.getValue(), "pattern-regex")));
+            }
+        } else {
+            throw new IllegalArgumentException("metavariable-pattern only supports pattern-regex");
+        }
+        return bindings -> bindings.containsKey(name)
+            && regexes.stream().allMatch(regex -> regex.matcher(bindings.get(name)).find());
+    }
+
+    private static Map.Entry<String, Object> singleEntry(Object item) {
+        Map<?, ?> map = asMap(item, "operator");
+        if (map.size() != 1) {
+            throw new IllegalArgumentException("expected a single operator, got " + map.keySet());
+        }
+        Map.Entry<?, ?> entry = map.entrySet().iterator().next();
+        return Map.entry(String.valueOf(entry.getKey()), entry.getValue());
+    }
+
+    private static Map<?, ?> asMap(Object value, String what) {
+        if (value instanceof Map<?, ?> map) {
+            return map;
+        }
+        throw new IllegalArgumentException(what + " must be a mapping");
+    }
+
+    private static List<?> asList(Object value, String what) {
+        if (value instanceof List<?> list) {
+            return list;
+        }
+        throw new IllegalArgumentException(what + " must be a list");
+    }
+
+    private static String asString(Object value, String what) {
+        if (value instanceof String text) {
+            return text;
+        }
+        throw new IllegalArgumentException(what + " must be a string");
+    }
+
+    // ===== 公式求值 =====
+
+    private sealed interface Formula permits Leaf, Either, All {
+        List<Match> evaluate(TokenStream stream);
+    }
+
+    private record Leaf(TokenPattern pattern) implements Formula {
+        @Override
+        public List<Match> evaluate(TokenStream stream) {
+            return pattern.findAll(stream);
+        }
+    }
+
+    private record Either(List<Formula> alternatives) implements Formula {
+        @Override
+        public List<Match> evaluate(TokenStream stream) {
+            List<Match> matches = new ArrayList<>();
+            for (Formula alternative : alternatives) {
+                matches.addAll(alternative.evaluate(stream));
+            }
+            return matches;
+        }
+    }
+
+    private record All(List<Formula> positives, List<Formula> negatives, List<Formula> insides,
+                       List<Formula> notInsides, List<Predicate<Map<String, String>>> conditions) implements Formula {
+        @Override
+        public List<Match> evaluate(TokenStream stream) {
+            List<Match> candidates = positives.get(0).evaluate(stream);
+            for (Formula positive : positives.subList(1, positives.size())) {
+                candidates = keepEnclosed(candidates, positive.evaluate(stream));
+            }
+            for (Formula inside : insides) {
+                candidates = keepEnclosed(candidates, inside.evaluate(stream));
+            }
+            for (Formula negative : negatives) {
+                List<Match> excluded = negative.evaluate(stream);
+                candidates = candidates.stream()
+                    .filter(match -> excluded.stream().noneMatch(other ->
+                        other.start() == match.start() && merge(match, other) != null))
+                    .toList();
+            }
+            for (Formula notInside : notInsides) {
+                List<Match> excluded = notInside.evaluate(stream);
+                candidates = candidates.stream()
+                    .filter(match -> excluded.stream().noneMatch(outer ->
+                        encloses(outer, match) && merge(match, outer) != null))
+                    .toList();
+            }
+            return candidates.stream()
+                .filter(match -> conditions.stream().allMatch(condition -> condition.test(match.bindings())))
+                .toList();
+        }
+
+        private static List<Match> keepEnclosed(List<Match> candidates, List<Match> outers) {
+            List<Match> kept = new ArrayList<>();
+            for (Match match : candidates) {
+                for (Match outer : outers) {
+                    Match merged = encloses(outer, match) ? merge(match, outer) : null;
+                    if (merged != null) {
+                        kept.add(merged);
+                        break;
+                    }
+                }
+            }
+            return kept;
+        }
+
+        private static boolean encloses(Match outer, Match inner) {
+            return outer.start() <= inner.start() && inner.end() <= outer.end();
+        }
+
+        /**
+         * 合并两次匹配的元变量绑定；同名元变量文本不一致时返回 null
+         */
+        private static Match merge(Match match, Match other) {
+            Map<String, String> bindings = new HashMap<>(match.bindings());
+            for (Map.Entry<String, String> entry : other.bindings().entrySet()) {
+                String existing = bindings.putIfAbsent(entry.getKey(), entry.getValue());
+                if (existing != null && !existing.equals(entry.getValue())) {
+                    return null;
+                }
+            }
+            return new Match(match.start(), match.end(), bindings);
+        }
+    }
+}
@@ -0,0 +1,284 @@
+package com.harmony.agent.core.analyzer.pattern;
+
+import com.harmony.agent.core.parser.CLexer;
+import com.harmony.agent.core.parser.CLexer.Token;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.regex.Pattern;
+
+/**
+ * Semgrep 风格的 C/C++ 结构模式（内置规则包所用子集）
+ *
+ * 模式与源码都由 {@link CLexer} 切分为 Token，再逐 Token 回溯匹配：
+ * - $X：元变量，绑定一段括号平衡的表达式（不跨越顶层 ; { } , 和赋值运算符），
+ *   同名元变量再次出现时必须与首次绑定的 Token 文本一致
+ * - ...：省略号。语句位置（模式开头或 ; { } 之后）可跨越多条语句并深入嵌套块，但不会跳出当前块；
+ *   表达式位置（如参数列表、赋值右侧）只在当前括号内且不跨越 ;。后接右括号时要求括号平衡
+ * - "..."：任意字符串字面量；字符串模式中的 ... 匹配任意字符
+ * - 其余 Token 按文本精确匹配
+ *
+ * 省略号与元变量均为惰性匹配（优先最短），每个起点只报告第一个成功的匹配。
+ * 编译后的模式不可变，可被多个线程同时使用。
+ */
+public final class TokenPattern {
+
+    private static final Pattern METAVARIABLE = Pattern.compile("\\$[A-Z_][A-Z0-9_]*");
+    private static final Set<String> OPENERS = Set.of("(", "[", "{");
+    private static final Set<String> CLOSERS = Set.of(")", "]", "}");
+    private static final Set<String> STATEMENT_BREAKS = Set.of(";", "{", "}");
+    private static final Set<String> ASSIGNMENTS = Set.of(
+        "=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<=", ">>="
+    );
+
+    /** 元变量最多绑定的 Token 数，限制回溯规模 */
+    private static final int MAX_METAVARIABLE_TOKENS = 64;
+    /** 省略号最多跨越的 Token 数，避免文件级模式在大文件上退化为平方复杂度 */
+    private static final int MAX_ELLIPSIS_TOKENS = 4096;
+
+    private enum Kind {
+        LITERAL,
+        METAVARIABLE,
+        ELLIPSIS,
+        STRING
+    }
+
+    private record Element(Kind kind, String text, boolean statementLevel, Pattern string) {
+    }
+
+    /**
+     * 一次匹配：[start, end) 为源码 Token 下标区间，bindings 为元变量到 Token 文本（空格连接）的绑定
+     */
+    public record Match(int start, int end, Map<String, String> bindings) {
+    }
+
+    private final String source;
+    private final List<Element> elements;
+    private final Set<String> requiredTokens;
+    private final boolean statementPattern;
+
+    private TokenPattern(String source, List<Element> elements, Set<String> requiredTokens, boolean statementPattern) {
+        this.source = source;
+        this.elements = elements;
+        this.requiredTokens = requiredTokens;
+        this.statementPattern = statementPattern;
+    }
+
+    /**
+     * 编译模式文本
+     *
+     * @throws IllegalArgumentException 模式为空或包含预处理指令
+     */
+    public static TokenPattern compile(String pattern) {
+        List<Element> elements = new ArrayList<>();
+        Set<String> required = new LinkedHashSet<>();
+        boolean statement = false;
+
+        for (Token token : CLexer.tokenize(pattern)) {
+            String text = token.getText();
+            Element previous = elements.isEmpty() ? null : elements.get(elements.size() - 1);
+
+            if (token.getKind() == CLexer.Kind.PREPROCESSOR) {
+                throw new IllegalArgumentException("Preprocessor directives are not supported in patterns: " + text);
+            } else if (token.isIdentifier() && METAVARIABLE.matcher(text).matches()) {
+                elements.add(new Element(Kind.METAVARIABLE, text, false, null));
+            } else if (token.is("...")) {
+                boolean statementLevel = previous == null
+                    || (previous.kind() == Kind.LITERAL && STATEMENT_BREAKS.contains(previous.text()));
+                elements.add(new Element(Kind.ELLIPSIS, text, statementLevel, null));
+            } else if (token.getKind() == CLexer.Kind.STRING) {
+                elements.add(new Element(Kind.STRING, text, false, stringPattern(text)));
+            } else {
+                elements.add(new Element(Kind.LITERAL, text, false, null));
+                if (token.isIdentifier()) {
+                    required.add(text);
+                }
+                statement |= token.is(";");
+            }
+        }
+
+        if (elements.isEmpty()) {
+            throw new IllegalArgumentException("Empty pattern");
+        }
+        return new TokenPattern(pattern, List.copyOf(elements), required, statement);
+    }
+
+    /**
+     * 字符串模式转为对字面量内容的正则："..." 内的 ... 匹配任意字符，其余字符按原样匹配
+     */
+    private static Pattern stringPattern(String literal) {
+        String[] parts = literalContent(literal).split("\\.\\.\\.", -1);
+        StringBuilder regex = new StringBuilder();
+        for (int i = 0; i < parts.length; i++) {
+            if (i > 0) {
+                regex.append(".*");
+            }
+            if (!parts[i].isEmpty()) {
+                regex.append(Pattern.quote(parts[i]));
+            }
+        }
+        return Pattern.compile(regex.toString(), Pattern.DOTALL);
+    }
+
+    private static String literalContent(String literal) {
+        int open = literal.indexOf('"');
+        int close = literal.lastIndexOf('"');
+        return open >= 0 && close > open ? literal.substring(open + 1, close) : literal;
+    }
+
+    /**
+     * 在整个 Token 序列中查找所有匹配（按起点升序）
+     */
+    public List<Match> findAll(TokenStream stream) {
+        for (String token : requiredTokens) {
+            if (!stream.contains(token)) {
+                return List.of();
+            }
+        }
+
+        List<Match> matches = new ArrayList<>();
+        Element first = elements.get(0);
+        if (first.kind() == Kind.LITERAL) {
+            for (int start : stream.positionsOf(first.text())) {
+                tryAt(stream, start, matches);
+            }
+            return matches;
+        }
+
+        for (int start = 0; start < stream.size(); start++) {
+            if (first.kind() == Kind.STRING && stream.get(start).getKind() != CLexer.Kind.STRING) {
+                continue;
+            }
+            if (statementPattern && first.kind() == Kind.METAVARIABLE && !stream.isStatementStart(start)) {
+                continue;
+            }
+            tryAt(stream, start, matches);
+        }
+        return matches;
+    }
+
+    private void tryAt(TokenStream stream, int start, List<Match> matches) {
+        Attempt attempt = new Attempt(stream);
+        if (attempt.match(0, start) && attempt.end > start) {
+            matches.add(new Match(start, attempt.end, attempt.bindingTexts()));
+        }
+    }
+
+    @Override
+    public String toString() {
+        return source.strip();
+    }
+
+    /**
+     * 单个起点上的回溯匹配状态
+     */
+    private final class Attempt {
+        private final TokenStream stream;
+        private final Map<String, List<String>> bindings = new HashMap<>();
+        private int end;
+
+        Attempt(TokenStream stream) {
+            this.stream = stream;
+        }
+
+        boolean match(int elementIndex, int tokenIndex) {
+            if (elementIndex == elements.size()) {
+                end = tokenIndex;
+                return true;
+            }
+            Element element = elements.get(elementIndex);
+            return switch (element.kind()) {
+                case LITERAL -> tokenIndex < stream.size()
+                    && stream.get(tokenIndex).is(element.text())
+                    && match(elementIndex + 1, tokenIndex + 1);
+                case STRING -> tokenIndex < stream.size()
+                    && stream.get(tokenIndex).getKind() == CLexer.Kind.STRING
+                    && element.string().matcher(literalContent(stream.get(tokenIndex).getText())).matches()
+                    && match(elementIndex + 1, tokenIndex + 1);
+                case METAVARIABLE -> matchMetavariable(element.text(), elementIndex, tokenIndex);
+                case ELLIPSIS -> matchEllipsis(element, elementIndex, tokenIndex);
+            };
+        }
+
+        private boolean matchMetavariable(String name, int elementIndex, int tokenIndex) {
+            List<String> bound = bindings.get(name);
+            if (bound != null) {
+                if (tokenIndex + bound.size() > stream.size()) {
+                    return false;
+                }
+                for (int k = 0; k < bound.size(); k++) {
+                    if (!stream.get(tokenIndex + k).is(bound.get(k))) {
+                        return false;
+                    }
+                }
+                return match(elementIndex + 1, tokenIndex + bound.size());
+            }
+
+            int depth = 0;
+            int limit = Math.min(stream.size(), tokenIndex + MAX_METAVARIABLE_TOKENS);
+            for (int last = tokenIndex; last < limit; last++) {
+                String text = stream.get(last).getText();
+                if (depth == 0 && (STATEMENT_BREAKS.contains(text) || text.equals(",") || ASSIGNMENTS.contains(text))) {
+                    return false;
+                }
+                if (OPENERS.contains(text)) {
+                    depth++;
+                } else if (CLOSERS.contains(text) && --depth < 0) {
+                    return false;
+                }
+                if (depth == 0) {
+                    bindings.put(name, texts(tokenIndex, last + 1));
+                    if (match(elementIndex + 1, last + 1)) {
+                        return true;
+                    }
+                    bindings.remove(name);
+                }
+            }
+            return false;
+        }
+
+        private boolean matchEllipsis(Element ellipsis, int elementIndex, int tokenIndex) {
+            boolean closerNext = elementIndex + 1 < elements.size()
+                && elements.get(elementIndex + 1).kind() == Kind.LITERAL
+                && CLOSERS.contains(elements.get(elementIndex + 1).text());
+            int limit = Math.min(stream.size(), tokenIndex + MAX_ELLIPSIS_TOKENS);
+            int depth = 0;
+            for (int next = tokenIndex; ; next++) {
+                if ((depth == 0 || (ellipsis.statementLevel() && !closerNext)) && match(elementIndex + 1, next)) {
+                    return true;
+                }
+                if (next >= limit) {
+                    return false;
+                }
+                String text = stream.get(next).getText();
+                if (!ellipsis.statementLevel() && depth == 0 && STATEMENT_BREAKS.contains(text)) {
+                    return false;
+                }
+                if (OPENERS.contains(text)) {
+                    depth++;
+                } else if (CLOSERS.contains(text) && --depth < 0) {
+                    return false;
+                }
+            }
+        }
+
+        private List<String> texts(int from, int to) {
+            List<String> texts = new ArrayList<>(to - from);
+            for (int i = from; i < to; i++) {
+                texts.add(stream.get(i).getText());
+            }
+            return texts;
+        }
+
+        Map<String, String> bindingTexts() {
+            Map<String, String> texts = new LinkedHashMap<>();
+            bindings.forEach((name, tokens) -> texts.put(name, String.join(" ", tokens)));
+            return texts;
+        }
+    }
+}
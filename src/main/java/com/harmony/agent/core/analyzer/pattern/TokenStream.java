@@ -0,0 +1,91 @@
+package com.harmony.agent.core.analyzer.pattern;
+
+import com.harmony.agent.core.parser.CLexer;
+import com.harmony.agent.core.parser.CLexer.Token;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * 结构匹配使用的源码 Token 序列
+ *
+ * 由 {@link CLexer} 切分并去掉预处理指令；同时建立 Token 文本到下标的索引，
+ * 模式以字面 Token 开头时只需从这些位置尝试匹配。构造后只读，可跨线程共享。
+ */
+public final class TokenStream {
+
+    private static final int[] NONE = new int[0];
+    private static final Set<String> STATEMENT_BOUNDARIES = Set.of(";", "{", "}", ")", ":", "else");
+
+    private final String text;
+    private final List<Token> tokens;
+    private final Map<String, int[]> positions;
+
+    public TokenStream(String text) {
+        this.text = text;
+        this.tokens = new ArrayList<>();
+        for (Token token : CLexer.tokenize(text)) {
+            if (token.getKind() != CLexer.Kind.PREPROCESSOR) {
+                tokens.add(token);
+            }
+        }
+
+        Map<String, List<Integer>> index = new HashMap<>();
+        for (int i = 0; i < tokens.size(); i++) {
+            index.computeIfAbsent(tokens.get(i).getText(), k -> new ArrayList<>()).add(i);
+        }
+        this.positions = new HashMap<>(index.size() * 2);
+        index.forEach((key, list) -> positions.put(key, list.stream().mapToInt(Integer::intValue).toArray()));
+    }
+
+    public String getText() {
+        return text;
+    }
+
+    public int size() {
+        return tokens.size();
+    }
+
+    public Token get(int index) {
+        return tokens.get(index);
+    }
+
+    /**
+     * 文本等于 tokenText 的所有 Token 下标（升序）
+     */
+    public int[] positionsOf(String tokenText) {
+        return positions.getOrDefault(tokenText, NONE);
+    }
+
+    public boolean contains(String tokenText) {
+        return positions.containsKey(tokenText);
+    }
+
+    /**
+     * 第 index 个 Token 是否可能是语句起点（文件开头，或前一个 Token 为 ; { } ) : else）
+     */
+    public boolean isStatementStart(int index) {
+        return index == 0 || STATEMENT_BOUNDARIES.contains(tokens.get(index - 1).getText());
+    }
+
+    /**
+     * 第 index 个 Token 的列号（1-based）
+     */
+    public int columnOf(int index) {
+        int start = tokens.get(index).getStart();
+        return start - text.lastIndexOf('\n', start - 1);
+    }
+
+    /**
+     * 第 index 个 Token 所在的整行源码（不含换行符）
+     */
+    public String lineOf(int index) {
+        int start = tokens.get(index).getStart();
+        int lineStart = text.lastIndexOf('\n', start - 1) + 1;
+        int lineEnd = text.indexOf('\n', start);
+        return text.substring(lineStart, lineEnd < 0 ? text.length() : lineEnd);
+    }
+}
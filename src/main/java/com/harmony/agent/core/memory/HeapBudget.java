@@ -0,0 +1,100 @@
+package com.harmony.agent.core.memory;
+
+import java.util.Locale;
+
+/**
+ * 堆内存预算（--heap-budget）
+ *
+ * 大规模扫描时，缓存与中间缓冲按预算定容，超出部分溢写到磁盘：
+ * - CodeSlicer 文件缓存：预算的 5%，按每文件约 64KB 估算条数
+ * - 分析器原始问题缓冲：预算的 10%，按每条约 2KB 估算，超出后写入临时文件（{@link IssueSpillBuffer}）
+ *
+ * {@link #UNLIMITED} 保持原有行为（缓存不限容、不溢写）。
+ */
+public final class HeapBudget {
+
+    public static final HeapBudget UNLIMITED = new HeapBudget(0);
+
+    static final long BYTES_PER_CACHED_FILE = 64 * 1024;
+    static final long BYTES_PER_ISSUE = 2 * 1024;
+    private static final int MIN_CACHED_FILES = 16;
+    private static final int MIN_BUFFERED_ISSUES = 1000;
+
+    private final long bytes;
+
+    private HeapBudget(long bytes) {
+        this.bytes = bytes;
+    }
+
+    public static HeapBudget ofBytes(long bytes) {
+        if (bytes <= 0) {
+            throw new IllegalArgumentException("Heap budget must be positive: " + bytes);
+        }
+        return new HeapBudget(bytes);
+    }
+
+    /**
+     * 解析 "2g"、"512m"、"1536k"、纯字节数，或 "auto"（取 JVM 最大堆 -Xmx）
+     */
+    public static HeapBudget parse(String spec) {
+        String value = spec.trim().toLowerCase(Locale.ROOT);
+        if (value.equals("auto")) {
+            return ofBytes(Runtime.getRuntime().maxMemory());
+        }
+        long multiplier = 1;
+        char unit = value.isEmpty() ? ' ' : value.charAt(value.length() - 1);
+        switch (unit) {
+            case 'k' -> multiplier = 1024L;
+            case 'm' -> multiplier = 1024L * 1024;
+            case 'g' -> multiplier = 1024L * 1024 * 1024;
+            default -> {
+            }
+        }
+        String digits = multiplier == 1 ? value : value.substring(0, value.length() - 1);
+        try {
+            return ofBytes(Long.parseLong(digits) * multiplier);
+        } catch (NumberFormatException e) {
+            throw new IllegalArgumentException("Invalid heap budget '" + spec + "' (expected e.g. 2g, 512m, auto)");
+        }
+    }
+
+    public boolean isLimited() {
+        return bytes > 0;
+    }
+
+    public long getBytes() {
+        return bytes;
+    }
+
+    /**
+     * 预算是否超过 JVM 实际可用的最大堆（此时预算无法兑现，应调大 -Xmx）
+     */
+    public boolean exceedsMaxHeap() {
+        return isLimited() && bytes > Runtime.getRuntime().maxMemory();
+    }
+
+    /**
+     * CodeSlicer 文件缓存上限；0 表示不限
+     */
+    public int sliceCacheFiles() {
+        if (!isLimited()) {
+            return 0;
+        }
+        return (int) Math.max(MIN_CACHED_FILES, Math.min(Integer.MAX_VALUE, bytes / 20 / BYTES_PER_CACHED_FILE));
+    }
+
+    /**
+     * 内存中保留的原始问题条数，超出后溢写；不限时为 Integer.MAX_VALUE
+     */
+    public int issueBufferSize() {
+        if (!isLimited()) {
+            return Integer.MAX_VALUE;
+        }
+        return (int) Math.max(MIN_BUFFERED_ISSUES, Math.min(Integer.MAX_VALUE, bytes / 10 / BYTES_PER_ISSUE));
+    }
+
+    @Override
+    public String toString() {
+        return isLimited() ? (bytes / (1024 * 1024)) + "MB" : "unlimited";
+    }
+}
@@ -0,0 +1,102 @@
+package com.harmony.agent.core.memory;
+
+import com.google.gson.Gson;
+import com.google.gson.GsonBuilder;
+import com.google.gson.ToNumberPolicy;
+import com.harmony.agent.core.model.SecurityIssue;
+
+import java.io.BufferedReader;
+import java.io.BufferedWriter;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.List;
+import java.util.function.Consumer;
+
+/**
+ * 分析器原始问题的缓冲区（线程安全）
+ *
+ * 前 {@code memoryLimit} 条保存在内存中，之后的问题以 JSON Lines 追加到临时文件，
+ * {@link #drain(Consumer)} 按添加顺序回放（先内存、后磁盘）。关闭时删除临时文件；
+ * 关闭后的添加被忽略（超时后仍在运行的分析器线程不会再创建临时文件）。
+ */
+public class IssueSpillBuffer implements AutoCloseable {
+
+    private static final Gson GSON = new GsonBuilder()
+        .setObjectToNumberStrategy(ToNumberPolicy.LONG_OR_DOUBLE)
+        .create();
+
+    private final int memoryLimit;
+    private final List<SecurityIssue> inMemory = new ArrayList<>();
+    private Path spillFile;
+    private BufferedWriter spillWriter;
+    private int spilledCount;
+    private boolean closed;
+
+    public IssueSpillBuffer(int memoryLimit) {
+        this.memoryLimit = memoryLimit;
+    }
+
+    public synchronized void addAll(Collection<SecurityIssue> issues) throws IOException {
+        if (closed) {
+            return;
+        }
+        for (SecurityIssue issue : issues) {
+            if (inMemory.size() < memoryLimit) {
+                inMemory.add(issue);
+            } else {
+                spill(issue);
+            }
+        }
+    }
+
+    private void spill(SecurityIssue issue) throws IOException {
+        if (spillWriter == null) {
+            spillFile = Files.createTempFile("harmony-issues-", ".jsonl");
+            spillWriter = Files.newBufferedWriter(spillFile, StandardCharsets.UTF_8);
+        }
+        spillWriter.write(GSON.toJson(issue));
+        spillWriter.newLine();
+        spilledCount++;
+    }
+
+    /**
+     * 按添加顺序逐条回放所有问题
+     */
+    public synchronized void drain(Consumer<SecurityIssue> consumer) throws IOException {
+        inMemory.forEach(consumer);
+        if (spillWriter == null) {
+            return;
+        }
+        spillWriter.flush();
+        try (BufferedReader reader = Files.newBufferedReader(spillFile, StandardCharsets.UTF_8)) {
+            String line;
+            while ((line = reader.readLine()) != null) {
+                consumer.accept(GSON.fromJson(line, SecurityIssue.class));
+            }
+        }
+    }
+
+    public synchronized int size() {
+        return inMemory.size() + spilledCount;
+    }
+
+    public synchronized int getSpilledCount() {
+        return spilledCount;
+    }
+
+    @Override
+    public synchronized void close() throws IOException {
+        closed = true;
+        inMemory.clear();
+        if (spillWriter != null) {
+            spillWriter.close();
+            Files.deleteIfExists(spillFile);
+            spillWriter = null;
+            spillFile = null;
+        }
+    }
+}
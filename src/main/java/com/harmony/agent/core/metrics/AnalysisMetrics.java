@@ -0,0 +1,279 @@
+package com.harmony.agent.core.metrics;
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.lang.management.MemoryType;
+import java.lang.management.OperatingSystemMXBean;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * 单次分析的性能指标收集器（线程安全）
+ *
+ * 记录三类数据，最终以扁平键写入 ScanResult.statistics（进而进入 JSON 报告）：
+ * - 阶段：phase_&lt;name&gt;_wall_ms / phase_&lt;name&gt;_cpu_ms（CPU 为进程级，包含该阶段内的并发工作）
+ *   以及 phase_&lt;name&gt;_peak_heap_mb（阶段开始时重置各堆内存池峰值，结束时汇总；同样为进程级）
+ * - 分析器：analyzer_&lt;name&gt;_ms / _files / _issues / _files_per_sec
+ * - 计数与累计耗时：如 ai_requests、ai_prompt_tokens、slicing_ms（多线程累加）
+ *
+ * 阶段按首次记录的顺序输出。
+ */
+public class AnalysisMetrics {
+
+    public static final String PHASE_SCAN = "scan";
+    public static final String PHASE_ANALYSIS = "analysis";
+    public static final String PHASE_DEDUP = "dedup";
+    public static final String PHASE_AI_VALIDATION = "ai_validation";
+    public static final String PHASE_REPORTING = "reporting";
+
+    private static final List<String> PHASE_ORDER = List.of(
+        PHASE_SCAN, PHASE_ANALYSIS, PHASE_DEDUP, PHASE_AI_VALIDATION, PHASE_REPORTING);
+
+    private final Map<String, PhaseStats> phases = new LinkedHashMap<>();
+    private final Map<String, AnalyzerStats> analyzers = new LinkedHashMap<>();
+    private final Map<String, LongAdder> counters = new ConcurrentHashMap<>();
+    private final Map<String, LongAdder> durations = new ConcurrentHashMap<>();
+    private volatile IssueTracer tracer = IssueTracer.DISABLED;
+
+    /**
+     * 开始计时一个阶段，关闭返回的 Timer 时记录
+     */
+    public Timer time(String phase) {
+        resetPeakHeap();
+        return new Timer(phase, System.nanoTime(), processCpuNanos());
+    }
+
+    /**
+     * 记录一次分析器批量执行；同一分析器多次执行（如每个 Cargo workspace 一次）时累加
+     */
+    public synchronized void recordAnalyzer(String analyzer, int files, int issues, long wallNanos) {
+        analyzers.merge(key(analyzer), new AnalyzerStats(files, issues, wallNanos), AnalyzerStats::plus);
+    }
+
+    /**
+     * 计数器累加
+     */
+    public void increment(String counter, long delta) {
+        counters.computeIfAbsent(counter, k -> new LongAdder()).add(delta);
+    }
+
+    /**
+     * 累计耗时（可由多个线程并发调用），输出为 &lt;name&gt;_ms
+     */
+    public void addDuration(String name, long nanos) {
+        durations.computeIfAbsent(name, k -> new LongAdder()).add(nanos);
+    }
+
+    /**
+     * 本次分析的问题追踪器（默认禁用）
+     */
+    public IssueTracer getTracer() {
+        return tracer;
+    }
+
+    public void setTracer(IssueTracer tracer) {
+        this.tracer = tracer != null ? tracer : IssueTracer.DISABLED;
+    }
+
+    public long getCounter(String counter) {
+        LongAdder adder = counters.get(counter);
+        return adder != null ? adder.sum() : 0L;
+    }
+
+    public synchronized long getPhaseWallMs(String phase) {
+        PhaseStats stats = phases.get(phase);
+        return stats != null ? stats.wallNanos / 1_000_000 : 0L;
+    }
+
+    /**
+     * 导出为扁平统计项
+     */
+    public synchronized Map<String, Object> toStatistics() {
+        Map<String, Object> statistics = new LinkedHashMap<>();
+
+        for (Map.Entry<String, PhaseStats> entry : phases.entrySet()) {
+            PhaseStats stats = entry.getValue();
+            statistics.put("phase_" + entry.getKey() + "_wall_ms", stats.wallNanos / 1_000_000);
+            if (stats.cpuNanos >= 0) {
+                statistics.put("phase_" + entry.getKey() + "_cpu_ms", stats.cpuNanos / 1_000_000);
+            }
+            if (stats.peakHeapBytes > 0) {
+                statistics.put("phase_" + entry.getKey() + "_peak_heap_mb", stats.peakHeapBytes / (1024 * 1024));
+            }
+        }
+
+        for (Map.Entry<String, AnalyzerStats> entry : analyzers.entrySet()) {
+            AnalyzerStats stats = entry.getValue();
+            String prefix = "analyzer_" + entry.getKey();
+            long ms = stats.wallNanos / 1_000_000;
+            statistics.put(prefix + "_ms", ms);
+            statistics.put(prefix + "_files", stats.files);
+            statistics.put(prefix + "_issues", stats.issues);
+            statistics.put(prefix + "_files_per_sec", round(stats.files * 1000.0 / Math.max(ms, 1)));
+        }
+
+        durations.forEach((name, nanos) -> statistics.put(name + "_ms", nanos.sum() / 1_000_000));
+        counters.forEach((name, value) -> statistics.put(name, value.sum()));
+
+        long hits = getCounter("ai_cache_hits");
+        long lookups = hits + getCounter("ai_cache_misses");
+        if (lookups > 0) {
+            statistics.put("ai_cache_hit_ratio", round((double) hits / lookups));
+        }
+        return statistics;
+    }
+
+    /**
+     * 从统计项生成一行阶段耗时摘要，例如 "scan 120ms · analysis 3.4s · ai_validation 12.1s"
+     */
+    public static String formatPhaseSummary(Map<String, Object> statistics) {
+        List<String> parts = new ArrayList<>();
+        for (String phase : phaseOrder(statistics)) {
+            if (statistics.get("phase_" + phase + "_wall_ms") instanceof Number ms) {
+                parts.add(phase + " " + formatMillis(ms.longValue()));
+            }
+        }
+        return String.join(" · ", parts);
+    }
+
+    /**
+     * 从统计项生成一行阶段堆峰值摘要，例如 "scan 96MB · analysis 1.2GB"；没有数据时返回空串
+     */
+    public static String formatHeapSummary(Map<String, Object> statistics) {
+        List<String> parts = new ArrayList<>();
+        for (String phase : phaseOrder(statistics)) {
+            if (statistics.get("phase_" + phase + "_peak_heap_mb") instanceof Number mb) {
+                parts.add(phase + " " + (mb.longValue() < 1024 ? mb.longValue() + "MB"
+                    : String.format(Locale.ROOT, "%.1fGB", mb.longValue() / 1024.0)));
+            }
+        }
+        return String.join(" · ", parts);
+    }
+
+    /**
+     * 从统计项生成一行 AI 调用摘要；未启用 AI 时返回 null
+     */
+    public static String formatAiSummary(Map<String, Object> statistics) {
+        if (!statistics.containsKey("ai_requests") && !statistics.containsKey("ai_cache_hits")) {
+            return null;
+        }
+        long tokens = number(statistics, "ai_prompt_tokens") + number(statistics, "ai_completion_tokens");
+        Object ratio = statistics.get("ai_cache_hit_ratio");
+        return String.format(Locale.ROOT, "%d requests · %d tokens · cache hit %s · %d retries · %d filtered",
+            number(statistics, "ai_requests"), tokens,
+            ratio instanceof Number r ? Math.round(r.doubleValue() * 100) + "%" : "n/a",
+            number(statistics, "ai_retries"), number(statistics, "ai_filtered_count"));
+    }
+
+    /**
+     * ScanResult 的统计项无序，按标准阶段顺序输出，其余阶段追加在后
+     */
+    private static List<String> phaseOrder(Map<String, Object> statistics) {
+        List<String> order = new ArrayList<>(PHASE_ORDER);
+        statistics.keySet().stream()
+            .filter(key -> key.startsWith("phase_") && key.endsWith("_wall_ms"))
+            .map(key -> key.substring("phase_".length(), key.length() - "_wall_ms".length()))
+            .filter(phase -> !order.contains(phase))
+            .sorted()
+            .forEach(order::add);
+        return order;
+    }
+
+    private static long number(Map<String, Object> statistics, String key) {
+        Object value = statistics.get(key);
+        return value instanceof Number n ? n.longValue() : 0L;
+    }
+
+    private static String formatMillis(long ms) {
+        return ms < 1000 ? ms + "ms" : String.format(Locale.ROOT, "%.1fs", ms / 1000.0);
+    }
+
+    private static double round(double value) {
+        return Math.round(value * 100.0) / 100.0;
+    }
+
+    /**
+     * 分析器名规范化为统计键：Clang-Tidy -> clang_tidy
+     */
+    static String key(String name) {
+        return name.toLowerCase(Locale.ROOT).replaceAll("[^a-z0-9]+", "_").replaceAll("^_|_$", "");
+    }
+
+    private static long processCpuNanos() {
+        OperatingSystemMXBean os = ManagementFactory.getOperatingSystemMXBean();
+        if (os instanceof com.sun.management.OperatingSystemMXBean sunOs) {
+            return sunOs.getProcessCpuTime();
+        }
+        return -1;
+    }
+
+    private static void resetPeakHeap() {
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            if (pool.getType() == MemoryType.HEAP && pool.isValid()) {
+                pool.resetPeakUsage();
+            }
+        }
+    }
+
+    private static long peakHeapBytes() {
+        long total = 0;
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            if (pool.getType() == MemoryType.HEAP && pool.isValid() && pool.getPeakUsage() != null) {
+                total += pool.getPeakUsage().getUsed();
+            }
+        }
+        return total;
+    }
+
+    private synchronized void recordPhase(String phase, long wallNanos, long cpuNanos, long peakHeapBytes) {
+        PhaseStats stats = phases.computeIfAbsent(phase, k -> new PhaseStats());
+        stats.wallNanos += wallNanos;
+        if (cpuNanos >= 0) {
+            stats.cpuNanos = Math.max(stats.cpuNanos, 0) + cpuNanos;
+        }
+        stats.peakHeapBytes = Math.max(stats.peakHeapBytes, peakHeapBytes);
+    }
+
+    /**
+     * 阶段计时器
+     */
+    public final class Timer implements AutoCloseable {
+        private final String phase;
+        private final long startNanos;
+        private final long startCpuNanos;
+        private boolean closed;
+
+        private Timer(String phase, long startNanos, long startCpuNanos) {
+            this.phase = phase;
+            this.startNanos = startNanos;
+            this.startCpuNanos = startCpuNanos;
+        }
+
+        @Override
+        public void close() {
+            if (closed) {
+                return;
+            }
+            closed = true;
+            long cpu = startCpuNanos >= 0 ? processCpuNanos() - startCpuNanos : -1;
+            recordPhase(phase, System.nanoTime() - startNanos, cpu, peakHeapBytes());
+        }
+    }
+
+    private static final class PhaseStats {
+        long wallNanos;
+        long cpuNanos = -1;
+        long peakHeapBytes;
+    }
+
+    private record AnalyzerStats(int files, int issues, long wallNanos) {
+        AnalyzerStats plus(AnalyzerStats other) {
+            return new AnalyzerStats(files + other.files, issues + other.issues, wallNanos + other.wallNanos);
+        }
+    }
+}
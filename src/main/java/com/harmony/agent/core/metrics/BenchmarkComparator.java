@@ -0,0 +1,311 @@
+package com.harmony.agent.core.metrics;
+
+import com.google.gson.JsonArray;
+import com.google.gson.JsonElement;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParser;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.regex.Pattern;
+import java.util.stream.Collectors;
+import java.util.stream.Stream;
+
+/**
+ * 基准结果对比（bench compare 的回归门禁）
+ *
+ * 读取 JMH JSON（-rf json）和离线 E2E 基准报告，按指标汇总样本：
+ * - JMH：primaryMetric.rawData 中每个 fork 的每次迭代都是一个样本；thrpt 越大越好，其余模式越小越好
+ * - E2E：每个报告文件是一个样本（多次运行传入多个文件或目录）；phases.* 与 memory.* 越小越好，吞吐越大越好
+ *
+ * 每个指标用 Welch t 检验计算均值变化的 95% 置信区间。变化显著（区间不含 0）且均值变化超过阈值时
+ * 判定为回归或改进；任一侧少于 2 个样本时无法给出区间，标记为样本不足，不参与门禁。
+ */
+public class BenchmarkComparator {
+
+    public static final double DEFAULT_THRESHOLD_PCT = 5.0;
+
+    /** 双侧 95% t 分位数，自由度 1..30 */
+    private static final double[] T_975 = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    public enum Direction { LOWER_IS_BETTER, HIGHER_IS_BETTER }
+
+    public enum Verdict { REGRESSION, IMPROVEMENT, UNCHANGED, INSUFFICIENT_DATA }
+
+    /**
+     * 单个指标的全部样本
+     */
+    public record Metric(String name, String unit, Direction direction, List<Double> samples) {
+    }
+
+    /**
+     * 单个指标的对比结果；变化百分比均为相对基线均值，正数表示数值变大
+     */
+    public record Comparison(String metric, String unit, Direction direction,
+                             int baselineCount, double baselineMean,
+                             int candidateCount, double candidateMean,
+                             double changePct, double ciLowPct, double ciHighPct,
+                             double thresholdPct, Verdict verdict) {
+    }
+
+    /**
+     * 一侧（基线或候选）的结果集合
+     */
+    public static class ResultSet {
+        private final Map<String, Metric> metrics = new LinkedHashMap<>();
+
+        public void add(String name, String unit, Direction direction, double value) {
+            metrics.computeIfAbsent(name, n -> new Metric(n, unit, direction, new ArrayList<>()))
+                .samples().add(value);
+        }
+
+        public Metric get(String name) {
+            return metrics.get(name);
+        }
+
+        public Collection<Metric> metrics() {
+            return metrics.values();
+        }
+
+        public boolean isEmpty() {
+            return metrics.isEmpty();
+        }
+    }
+
+    private final double defaultThresholdPct;
+    private final Map<Pattern, Double> thresholds = new LinkedHashMap<>();
+
+    public BenchmarkComparator() {
+        this(DEFAULT_THRESHOLD_PCT);
+    }
+
+    public BenchmarkComparator(double defaultThresholdPct) {
+        this.defaultThresholdPct = defaultThresholdPct;
+    }
+
+    /**
+     * 为匹配 glob 模式（* 任意字符）的指标单独设置阈值，先注册的优先
+     */
+    public BenchmarkComparator threshold(String metricGlob, double pct) {
+        String regex = Arrays.stream(metricGlob.split("\\*", -1))
+            .map(Pattern::quote)
+            .collect(Collectors.joining(".*"));
+        thresholds.put(Pattern.compile(regex), pct);
+        return this;
+    }
+
+    public double thresholdFor(String metric) {
+        for (Map.Entry<Pattern, Double> entry : thresholds.entrySet()) {
+            if (entry.getKey().matcher(metric).matches()) {
+                return entry.getValue();
+            }
+        }
+        return defaultThresholdPct;
+    }
+
+    /**
+     * 对比两侧都存在的指标（按基线中的顺序）
+     */
+    public List<Comparison> compare(ResultSet baseline, ResultSet candidate) {
+        List<Comparison> comparisons = new ArrayList<>();
+        for (Metric base : baseline.metrics()) {
+            Metric cand = candidate.get(base.name());
+            if (cand != null) {
+                comparisons.add(compare(base, cand, thresholdFor(base.name())));
+            }
+        }
+        return comparisons;
+    }
+
+    static Comparison compare(Metric baseline, Metric candidate, double thresholdPct) {
+        List<Double> a = baseline.samples();
+        List<Double> b = candidate.samples();
+        double meanA = mean(a);
+        double meanB = mean(b);
+        double changePct = meanA != 0 ? (meanB - meanA) / Math.abs(meanA) * 100 : Double.NaN;
+
+        if (a.size() < 2 || b.size() < 2 || Double.isNaN(changePct)) {
+            return new Comparison(baseline.name(), baseline.unit(), baseline.direction(),
+                a.size(), meanA, b.size(), meanB, changePct, Double.NaN, Double.NaN,
+                thresholdPct, Verdict.INSUFFICIENT_DATA);
+        }
+
+        // Welch t 检验：方差不必相等，自由度按 Welch–Satterthwaite 估计
+        double varA = variance(a, meanA) / a.size();
+        double varB = variance(b, meanB) / b.size();
+        double se = Math.sqrt(varA + varB);
+        double df = se > 0
+            ? Math.pow(varA + varB, 2)
+                / (varA * varA / (a.size() - 1) + varB * varB / (b.size() - 1))
+            : a.size() + b.size() - 2;
+        double margin = tCritical95(df) * se;
+        double diff = meanB - meanA;
+        double ciLowPct = (diff - margin) / Math.abs(meanA) * 100;
+        double ciHighPct = (diff + margin) / Math.abs(meanA) * 100;
+
+        // 统一换算为"变差"方向：正数表示性能变差
+        boolean lowerBetter = baseline.direction() == Direction.LOWER_IS_BETTER;
+        double worsePct = lowerBetter ? changePct : -changePct;
+        double worseLow = lowerBetter ? ciLowPct : -ciHighPct;
+        double worseHigh = lowerBetter ? ciHighPct : -ciLowPct;
+
+        Verdict verdict = Verdict.UNCHANGED;
+        if (worseLow > 0 && worsePct > thresholdPct) {
+            verdict = Verdict.REGRESSION;
+        } else if (worseHigh < 0 && -worsePct > thresholdPct) {
+            verdict = Verdict.IMPROVEMENT;
+        }
+        return new Comparison(baseline.name(), baseline.unit(), baseline.direction(),
+            a.size(), meanA, b.size(), meanB, changePct, ciLowPct, ciHighPct, thresholdPct, verdict);
+    }
+
+    /**
+     * 双侧 95% t 分位数；自由度 &gt; 30 时用 Cornish-Fisher 展开逼近
+     */
+    static double tCritical95(double df) {
+        if (df < 1) {
+            return T_975[0];
+        }
+        if (df <= T_975.length) {
+            return T_975[(int) Math.floor(df) - 1];
+        }
+        double z = 1.959964;
+        double z3 = z * z * z;
+        double z5 = z3 * z * z;
+        return z + (z3 + z) / (4 * df) + (5 * z5 + 16 * z3 + 3 * z) / (96 * df * df);
+    }
+
+    private static double mean(List<Double> values) {
+        double sum = 0;
+        for (double v : values) {
+            sum += v;
+        }
+        return values.isEmpty() ? Double.NaN : sum / values.size();
+    }
+
+    private static double variance(List<Double> values, double mean) {
+        double sum = 0;
+        for (double v : values) {
+            sum += (v - mean) * (v - mean);
+        }
+        return sum / (values.size() - 1);
+    }
+
+    // ---- 结果加载 ----
+
+    /**
+     * 加载若干文件或目录（目录中的 *.json）为一个结果集合，自动识别 JMH 与 E2E 格式
+     */
+    public static ResultSet load(List<Path> paths) throws IOException {
+        ResultSet set = new ResultSet();
+        for (Path path : paths) {
+            if (Files.isDirectory(path)) {
+                try (Stream<Path> files = Files.list(path)) {
+                    for (Path file : files.filter(p -> p.toString().endsWith(".json")).sorted().toList()) {
+                        loadFile(file, set);
+                    }
+                }
+            } else {
+                loadFile(path, set);
+            }
+        }
+        return set;
+    }
+
+    static void loadFile(Path file, ResultSet set) throws IOException {
+        JsonElement root;
+        try {
+            root = JsonParser.parseString(Files.readString(file));
+        } catch (RuntimeException e) {
+            throw new IOException("Invalid benchmark result " + file + ": " + e.getMessage(), e);
+        }
+        if (root.isJsonArray()) {
+            addJmh(root.getAsJsonArray(), set);
+        } else if (root.isJsonObject() && root.getAsJsonObject().has("phases")) {
+            addE2E(root.getAsJsonObject(), set);
+        } else {
+            throw new IOException("Unrecognized benchmark result format: " + file);
+        }
+    }
+
+    private static void addJmh(JsonArray results, ResultSet set) {
+        for (JsonElement element : results) {
+            JsonObject result = element.getAsJsonObject();
+            JsonObject primary = result.getAsJsonObject("primaryMetric");
+            if (primary == null) {
+                continue;
+            }
+            String name = jmhName(result);
+            String unit = primary.has("scoreUnit") ? primary.get("scoreUnit").getAsString() : "";
+            Direction direction = "thrpt".equals(result.get("mode").getAsString())
+                ? Direction.HIGHER_IS_BETTER : Direction.LOWER_IS_BETTER;
+
+            JsonArray rawData = primary.getAsJsonArray("rawData");
+            if (rawData != null && rawData.size() > 0) {
+                for (JsonElement fork : rawData) {
+                    for (JsonElement iteration : fork.getAsJsonArray()) {
+                        set.add(name, unit, direction, iteration.getAsDouble());
+                    }
+                }
+            } else {
+                set.add(name, unit, direction, primary.get("score").getAsDouble());
+            }
+        }
+    }
+
+    /**
+     * JMH 指标名：类名.方法名[参数]，如 RegexAnalyzerBenchmark.analyze[lines=2000]
+     */
+    private static String jmhName(JsonObject result) {
+        String benchmark = result.get("benchmark").getAsString();
+        String[] parts = benchmark.split("\\.");
+        StringBuilder name = new StringBuilder("jmh.");
+        name.append(parts.length >= 2 ? parts[parts.length - 2] + "." + parts[parts.length - 1] : benchmark);
+        JsonObject params = result.getAsJsonObject("params");
+        if (params != null && params.size() > 0) {
+            List<String> kv = new ArrayList<>();
+            params.entrySet().forEach(e -> kv.add(e.getKey() + "=" + e.getValue().getAsString()));
+            name.append('[').append(String.join(",", kv)).append(']');
+        }
+        return name.toString();
+    }
+
+    private static void addE2E(JsonObject report, ResultSet set) {
+        JsonObject phases = report.getAsJsonObject("phases");
+        phases.entrySet().forEach(e ->
+            set.add("e2e.phases." + e.getKey(), "ms", Direction.LOWER_IS_BETTER, e.getValue().getAsDouble()));
+
+        JsonObject throughput = report.getAsJsonObject("throughput");
+        if (throughput != null) {
+            for (String key : List.of("files_per_sec", "lines_per_sec")) {
+                if (throughput.has(key)) {
+                    set.add("e2e.throughput." + key, "1/s", Direction.HIGHER_IS_BETTER,
+                        throughput.get(key).getAsDouble());
+                }
+            }
+        }
+
+        JsonObject memory = report.getAsJsonObject("memory");
+        if (memory != null) {
+            if (memory.has("peak_rss_kb") && memory.get("peak_rss_kb").getAsLong() >= 0) {
+                set.add("e2e.memory.peak_rss_kb", "kB", Direction.LOWER_IS_BETTER,
+                    memory.get("peak_rss_kb").getAsDouble());
+            }
+            if (memory.has("peak_heap_mb")) {
+                set.add("e2e.memory.peak_heap_mb", "MB", Direction.LOWER_IS_BETTER,
+                    memory.get("peak_heap_mb").getAsDouble());
+            }
+        }
+    }
+}
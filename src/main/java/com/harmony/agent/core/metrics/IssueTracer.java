@@ -0,0 +1,262 @@
+package com.harmony.agent.core.metrics;
+
+import com.google.gson.Gson;
+import com.google.gson.GsonBuilder;
+import com.google.gson.JsonArray;
+import com.google.gson.JsonObject;
+
+import java.io.IOException;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * 单个问题生命周期的轻量级追踪（analyzer 产出 → 去重 → 切片 → 缓存 → LLM → 判定 → 报告）
+ *
+ * 每个问题占 Chrome trace 中的一行（tid），引擎级步骤（分析器批次、报告）在 "engine" 行。
+ * {@link #writeChromeTrace(Path)} 输出 trace-event JSON，可用 chrome://tracing 或 Perfetto 打开。
+ *
+ * 未启用时 {@link #DISABLED} 的所有方法都是空操作。下游组件（如 AI 缓存客户端）无法拿到 tracer 时，
+ * 通过 {@link #activate(String)} 绑定到当前线程，再用 {@link #currentSpan(String)} 记录子步骤。
+ */
+public final class IssueTracer {
+
+    public static final IssueTracer DISABLED = new IssueTracer(false);
+
+    static final String ENGINE_TRACK = "engine";
+
+    private static final ThreadLocal<Scope> CURRENT = new ThreadLocal<>();
+    private static final Span NOOP_SPAN = new Span(null, null, null, 0);
+
+    private final boolean enabled;
+    private final long originNanos = System.nanoTime();
+    private final ConcurrentLinkedQueue<JsonObject> events = new ConcurrentLinkedQueue<>();
+    private final Map<String, Integer> tracks = new ConcurrentHashMap<>();
+    private final AtomicInteger nextTrack = new AtomicInteger();
+
+    private IssueTracer(boolean enabled) {
+        this.enabled = enabled;
+    }
+
+    /**
+     * 创建一个启用的 tracer（每次分析一个）
+     */
+    public static IssueTracer create() {
+        return new IssueTracer(true);
+    }
+
+    public boolean isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * 开始问题上的一个区间，关闭时记录
+     */
+    public Span span(String issueId, String name) {
+        return enabled ? new Span(this, issueId, name, System.nanoTime()) : NOOP_SPAN;
+    }
+
+    /**
+     * 从过去某一时刻（System.nanoTime）开始的区间，如排队等待
+     */
+    public Span span(String issueId, String name, long startNanos) {
+        return enabled ? new Span(this, issueId, name, startNanos) : NOOP_SPAN;
+    }
+
+    /**
+     * 引擎级区间（分析器批次、报告生成）
+     */
+    public Span engineSpan(String name) {
+        return span(ENGINE_TRACK, name);
+    }
+
+    /**
+     * 记录问题上的瞬时事件（产出、去重结果、判定等），参数以 key, value 交替传入
+     */
+    public void instant(String issueId, String name, Object... keyValues) {
+        if (!enabled) {
+            return;
+        }
+        Map<String, Object> args = new LinkedHashMap<>();
+        for (int i = 0; i + 1 < keyValues.length; i += 2) {
+            args.put(String.valueOf(keyValues[i]), keyValues[i + 1]);
+        }
+        JsonObject event = event(issueId, name, "i", System.nanoTime());
+        event.addProperty("s", "t");
+        event.add("args", toJson(args));
+        events.add(event);
+    }
+
+    /**
+     * 将问题绑定到当前线程，直到返回的 Scope 关闭
+     */
+    public Scope activate(String issueId) {
+        Scope scope = new Scope(this, issueId, CURRENT.get());
+        if (enabled) {
+            CURRENT.set(scope);
+        }
+        return scope;
+    }
+
+    /**
+     * 在当前线程绑定的问题上开始一个区间；未绑定时返回空操作 Span
+     */
+    public static Span currentSpan(String name) {
+        Scope scope = CURRENT.get();
+        return scope != null ? scope.tracer.span(scope.issueId, name) : NOOP_SPAN;
+    }
+
+    public int getEventCount() {
+        return events.size();
+    }
+
+    /**
+     * 输出 Chrome trace-event JSON
+     */
+    public void writeChromeTrace(Path output) throws IOException {
+        JsonArray traceEvents = new JsonArray();
+        List<Map.Entry<String, Integer>> trackList = new ArrayList<>(tracks.entrySet());
+        for (Map.Entry<String, Integer> track : trackList) {
+            JsonObject meta = new JsonObject();
+            meta.addProperty("name", "thread_name");
+            meta.addProperty("ph", "M");
+            meta.addProperty("pid", 1);
+            meta.addProperty("tid", track.getValue());
+            JsonObject args = new JsonObject();
+            args.addProperty("name", track.getKey());
+            meta.add("args", args);
+            traceEvents.add(meta);
+        }
+        events.forEach(traceEvents::add);
+
+        JsonObject root = new JsonObject();
+        root.add("traceEvents", traceEvents);
+        root.addProperty("displayTimeUnit", "ms");
+
+        Path parent = output.toAbsolutePath().getParent();
+        if (parent != null) {
+            Files.createDirectories(parent);
+        }
+        Gson gson = new GsonBuilder().create();
+        try (Writer writer = Files.newBufferedWriter(output, StandardCharsets.UTF_8)) {
+            gson.toJson(root, writer);
+        }
+    }
+
+    private JsonObject event(String issueId, String name, String phase, long startNanos) {
+        JsonObject event = new JsonObject();
+        event.addProperty("name", name);
+        event.addProperty("cat", ENGINE_TRACK.equals(issueId) ? "engine" : "issue");
+        event.addProperty("ph", phase);
+        event.addProperty("ts", (startNanos - originNanos) / 1000);
+        event.addProperty("pid", 1);
+        event.addProperty("tid", track(issueId));
+        return event;
+    }
+
+    private int track(String issueId) {
+        String key = issueId != null ? issueId : "unknown";
+        return tracks.computeIfAbsent(key, k -> ENGINE_TRACK.equals(k) ? 0 : nextTrack.incrementAndGet());
+    }
+
+    private void complete(Span span, long endNanos) {
+        JsonObject event = event(span.issueId, span.name, "X", span.startNanos);
+        event.addProperty("dur", (endNanos - span.startNanos) / 1000);
+        Map<String, Object> args = span.args != null ? span.args : new LinkedHashMap<>();
+        args.put("thread", Thread.currentThread().getName());
+        event.add("args", toJson(args));
+        events.add(event);
+    }
+
+    private static JsonObject toJson(Map<String, Object> args) {
+        JsonObject json = new JsonObject();
+        if (args != null) {
+            args.forEach((key, value) -> {
+                if (value instanceof Number number) {
+                    json.addProperty(key, number);
+                } else if (value instanceof Boolean bool) {
+                    json.addProperty(key, bool);
+                } else if (value != null) {
+                    json.addProperty(key, String.valueOf(value));
+                }
+            });
+        }
+        return json;
+    }
+
+    /**
+     * 追踪区间；关闭时写入一个 "X"（complete）事件
+     */
+    public static final class Span implements AutoCloseable {
+        private final IssueTracer tracer;
+        private final String issueId;
+        private final String name;
+        private final long startNanos;
+        private Map<String, Object> args;
+        private boolean closed;
+
+        private Span(IssueTracer tracer, String issueId, String name, long startNanos) {
+            this.tracer = tracer;
+            this.issueId = issueId;
+            this.name = name;
+            this.startNanos = startNanos;
+        }
+
+        /**
+         * 附加参数（如 result=miss、verdict=rejected）
+         */
+        public Span arg(String key, Object value) {
+            if (tracer != null) {
+                if (args == null) {
+                    args = new LinkedHashMap<>();
+                }
+                args.put(key, value);
+            }
+            return this;
+        }
+
+        @Override
+        public void close() {
+            if (tracer == null || closed) {
+                return;
+            }
+            closed = true;
+            tracer.complete(this, System.nanoTime());
+        }
+    }
+
+    /**
+     * 线程绑定范围；关闭时恢复之前的绑定
+     */
+    public static final class Scope implements AutoCloseable {
+        private final IssueTracer tracer;
+        private final String issueId;
+        private final Scope previous;
+
+        private Scope(IssueTracer tracer, String issueId, Scope previous) {
+            this.tracer = tracer;
+            this.issueId = issueId;
+            this.previous = previous;
+        }
+
+        @Override
+        public void close() {
+            if (!tracer.enabled) {
+                return;
+            }
+            if (previous != null) {
+                CURRENT.set(previous);
+            } else {
+                CURRENT.remove();
+            }
+        }
+    }
+}
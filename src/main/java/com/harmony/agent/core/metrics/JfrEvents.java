@@ -0,0 +1,204 @@
+package com.harmony.agent.core.metrics;
+
+import jdk.jfr.Category;
+import jdk.jfr.DataAmount;
+import jdk.jfr.Description;
+import jdk.jfr.Event;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+import jdk.jfr.StackTrace;
+
+import java.util.List;
+
+/**
+ * Java Flight Recorder 自定义事件
+ *
+ * 未开启录制时 shouldCommit() 直接返回 false，埋点开销可忽略；通过 --profile（见 {@link ProfileRecorder}）
+ * 或 -XX:StartFlightRecording 录制后，可在 JDK Mission Control 的 "HarmonyAgent" 分类下查看。
+ *
+ * 用法：创建事件 → begin() → 执行操作 → finish(...)（内部 end + shouldCommit + commit）。
+ */
+public final class JfrEvents {
+
+    private static final String CATEGORY = "HarmonyAgent";
+
+    /**
+     * 全部事件类型（供录制时显式启用）
+     */
+    public static final List<Class<? extends Event>> ALL = List.of(
+        AnalyzerRun.class, ProcessRun.class, LlmRequest.class,
+        RateLimitWait.class, CacheLookup.class, ReportWrite.class);
+
+    private JfrEvents() {
+    }
+
+    @Name("com.harmony.agent.AnalyzerRun")
+    @Label("Analyzer Run")
+    @Description("One analyzer invocation over a file or a batch of files")
+    @Category({CATEGORY, "Analyzer"})
+    public static final class AnalyzerRun extends Event {
+        @Label("Analyzer")
+        String analyzer;
+
+        @Label("Target")
+        String target;
+
+        @Label("Files")
+        int files;
+
+        @Label("Issues")
+        int issues;
+
+        public void finish(String analyzer, String target, int files, int issues) {
+            end();
+            if (shouldCommit()) {
+                this.analyzer = analyzer;
+                this.target = target;
+                this.files = files;
+                this.issues = issues;
+                commit();
+            }
+        }
+    }
+
+    @Name("com.harmony.agent.ProcessRun")
+    @Label("Analyzer Process")
+    @Description("External tool process from spawn to exit")
+    @Category({CATEGORY, "Analyzer"})
+    @StackTrace(false)
+    public static final class ProcessRun extends Event {
+        @Label("Analyzer")
+        String analyzer;
+
+        @Label("Command")
+        String command;
+
+        @Label("PID")
+        long pid;
+
+        @Label("Exit Code")
+        int exitCode;
+
+        public void finish(String analyzer, Process process) {
+            end();
+            if (shouldCommit()) {
+                this.analyzer = analyzer;
+                this.command = process.info().commandLine().orElse("");
+                this.pid = process.pid();
+                this.exitCode = process.exitValue();
+                commit();
+            }
+        }
+    }
+
+    @Name("com.harmony.agent.LlmRequest")
+    @Label("LLM Request")
+    @Description("LLM HTTP request, excluding rate-limiter wait")
+    @Category({CATEGORY, "LLM"})
+    public static final class LlmRequest extends Event {
+        @Label("Provider")
+        String provider;
+
+        @Label("Model")
+        String model;
+
+        @Label("Prompt Tokens")
+        int promptTokens;
+
+        @Label("Completion Tokens")
+        int completionTokens;
+
+        @Label("Success")
+        boolean success;
+
+        public void finish(String provider, String model, int promptTokens, int completionTokens, boolean success) {
+            end();
+            if (shouldCommit()) {
+                this.provider = provider;
+                this.model = model;
+                this.promptTokens = promptTokens;
+                this.completionTokens = completionTokens;
+                this.success = success;
+                commit();
+            }
+        }
+    }
+
+    @Name("com.harmony.agent.RateLimitWait")
+    @Label("Rate Limit Wait")
+    @Description("Time blocked in the shared LLM rate limiter")
+    @Category({CATEGORY, "LLM"})
+    public static final class RateLimitWait extends Event {
+        @Label("Provider")
+        String provider;
+
+        @Label("Mode")
+        String mode;
+
+        @Label("Permits")
+        int permits;
+
+        public void finish(String provider, String mode, int permits) {
+            end();
+            if (shouldCommit()) {
+                this.provider = provider;
+                this.mode = mode;
+                this.permits = permits;
+                commit();
+            }
+        }
+    }
+
+    @Name("com.harmony.agent.CacheLookup")
+    @Label("Cache Lookup")
+    @Description("PersistentCacheManager lookup and the tier that answered it")
+    @Category({CATEGORY, "Cache"})
+    @StackTrace(false)
+    public static final class CacheLookup extends Event {
+        @Label("Cache")
+        String cache;
+
+        @Label("Result")
+        @Description("l1_hit, l2_hit or miss")
+        String result;
+
+        public void finish(String cache, String result) {
+            end();
+            if (shouldCommit()) {
+                this.cache = cache;
+                this.result = result;
+                commit();
+            }
+        }
+    }
+
+    @Name("com.harmony.agent.ReportWrite")
+    @Label("Report Write")
+    @Description("HTML template rendering or JSON serialization of a scan result")
+    @Category({CATEGORY, "Report"})
+    public static final class ReportWrite extends Event {
+        @Label("Format")
+        String format;
+
+        @Label("Path")
+        String path;
+
+        @Label("Issues")
+        int issues;
+
+        @Label("Size")
+        @DataAmount
+        long bytes;
+
+        public void finish(String format, String path, int issues, long bytes) {
+            end();
+            if (shouldCommit()) {
+                this.format = format;
+                this.path = path;
+                this.issues = issues;
+                this.bytes = bytes;
+                commit();
+            }
+        }
+    }
+}
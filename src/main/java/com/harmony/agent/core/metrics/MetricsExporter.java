@@ -0,0 +1,115 @@
+package com.harmony.agent.core.metrics;
+
+import com.sun.net.httpserver.HttpExchange;
+import com.sun.net.httpserver.HttpServer;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 指标导出端
+ *
+ * - HTTP：在 127.0.0.1:&lt;port&gt;/metrics 提供 OpenMetrics 文本，供 Prometheus 抓取
+ * - textfile：定期写入 *.prom 文件（先写临时文件再原子替换），供 node_exporter textfile collector 读取
+ */
+public class MetricsExporter implements AutoCloseable {
+
+    private static final Logger logger = LoggerFactory.getLogger(MetricsExporter.class);
+
+    public static final String CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    public static final int DEFAULT_TEXTFILE_INTERVAL_SECONDS = 15;
+
+    private final MetricsRegistry registry;
+    private final HttpServer httpServer;
+    private final ScheduledExecutorService scheduler;
+    private final Path textfile;
+
+    private MetricsExporter(MetricsRegistry registry, HttpServer httpServer,
+                            ScheduledExecutorService scheduler, Path textfile) {
+        this.registry = registry;
+        this.httpServer = httpServer;
+        this.scheduler = scheduler;
+        this.textfile = textfile;
+    }
+
+    /**
+     * 在本机回环地址启动 /metrics 端点（port 为 0 时随机分配）
+     */
+    public static MetricsExporter startHttp(MetricsRegistry registry, int port) throws IOException {
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), port), 0);
+        server.createContext("/metrics", exchange -> handle(exchange, registry));
+        server.setExecutor(null);
+        server.start();
+        logger.info("Metrics endpoint listening on http://127.0.0.1:{}/metrics", server.getAddress().getPort());
+        return new MetricsExporter(registry, server, null, null);
+    }
+
+    /**
+     * 每隔 intervalSeconds 将指标写入 textfile；关闭时再写一次最终值
+     */
+    public static MetricsExporter startTextfile(MetricsRegistry registry, Path textfile, int intervalSeconds)
+            throws IOException {
+        Path parent = textfile.toAbsolutePath().getParent();
+        if (parent != null) {
+            Files.createDirectories(parent);
+        }
+        ScheduledExecutorService scheduler = Executors.newSingleThreadScheduledExecutor(r -> {
+            Thread thread = new Thread(r, "metrics-textfile");
+            thread.setDaemon(true);
+            return thread;
+        });
+        MetricsExporter exporter = new MetricsExporter(registry, null, scheduler, textfile);
+        exporter.writeTextfile();
+        scheduler.scheduleAtFixedRate(exporter::writeTextfile, intervalSeconds, intervalSeconds, TimeUnit.SECONDS);
+        logger.info("Writing metrics to {} every {}s", textfile, intervalSeconds);
+        return exporter;
+    }
+
+    /**
+     * 用于 AgentServer 等已有 HTTP 服务挂载 /metrics
+     */
+    public static void handle(HttpExchange exchange, MetricsRegistry registry) throws IOException {
+        byte[] bytes = registry.render().getBytes(StandardCharsets.UTF_8);
+        exchange.getResponseHeaders().set("Content-Type", CONTENT_TYPE);
+        exchange.sendResponseHeaders(200, bytes.length);
+        try (OutputStream out = exchange.getResponseBody()) {
+            out.write(bytes);
+        }
+    }
+
+    public int getPort() {
+        return httpServer != null ? httpServer.getAddress().getPort() : -1;
+    }
+
+    void writeTextfile() {
+        Path tmp = textfile.resolveSibling(textfile.getFileName() + ".tmp");
+        try {
+            Files.writeString(tmp, registry.render(), StandardCharsets.UTF_8);
+            Files.move(tmp, textfile, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+        } catch (IOException e) {
+            logger.warn("Failed to write metrics textfile {}: {}", textfile, e.getMessage());
+        }
+    }
+
+    @Override
+    public void close() {
+        if (httpServer != null) {
+            httpServer.stop(0);
+        }
+        if (scheduler != null) {
+            scheduler.shutdownNow();
+            writeTextfile();
+        }
+    }
+}
@@ -0,0 +1,251 @@
+package com.harmony.agent.core.metrics;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.atomic.DoubleAdder;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * 进程级运行指标注册表（无第三方依赖，线程安全）
+ *
+ * 面向 serve / interactive 等常驻模式，提供 counter / gauge / summary 三类带标签的指标，
+ * 由 {@link #render()} 输出 OpenMetrics 文本格式，供 {@link MetricsExporter} 通过 HTTP 或 textfile 导出。
+ *
+ * 指标在首次使用时创建；相同名称 + 标签返回同一实例，调用方可缓存到静态字段以避免重复查找。
+ * 标签以 key, value 交替传入，例如 {@code counter("harmony_llm_requests", "...", "provider", "openai")}。
+ */
+public final class MetricsRegistry {
+
+    private static final MetricsRegistry GLOBAL = new MetricsRegistry();
+
+    private final Map<String, Family> families = new LinkedHashMap<>();
+
+    /**
+     * 全局注册表（各模块埋点与导出端共用）
+     */
+    public static MetricsRegistry global() {
+        return GLOBAL;
+    }
+
+    /**
+     * 单调递增计数器；输出时追加 _total 后缀
+     */
+    public Counter counter(String name, String help, String... labels) {
+        return (Counter) family(name, help, Type.COUNTER).child(labels);
+    }
+
+    /**
+     * 可增可减的瞬时值（队列深度、在途请求数等）
+     */
+    public Gauge gauge(String name, String help, String... labels) {
+        return (Gauge) family(name, help, Type.GAUGE).child(labels);
+    }
+
+    /**
+     * 只记录次数与总和的摘要（不计算分位数），输出 _count / _sum
+     */
+    public Summary summary(String name, String help, String... labels) {
+        return (Summary) family(name, help, Type.SUMMARY).child(labels);
+    }
+
+    /**
+     * 跟踪分析器子进程：启动时 +1，进程退出时 -1，并在退出时提交 JFR ProcessRun 事件
+     */
+    public void trackProcess(String analyzer, Process process) {
+        Gauge children = gauge("harmony_analyzer_child_processes",
+            "Running child processes per analyzer", "analyzer", AnalysisMetrics.key(analyzer));
+        JfrEvents.ProcessRun event = new JfrEvents.ProcessRun();
+        event.begin();
+        children.inc();
+        process.onExit().thenRun(() -> {
+            children.dec();
+            event.finish(analyzer, process);
+        });
+    }
+
+    /**
+     * 以 OpenMetrics 文本格式输出全部指标（以 # EOF 结尾）
+     */
+    public String render() {
+        StringBuilder out = new StringBuilder();
+        List<Family> snapshot;
+        synchronized (families) {
+            snapshot = new ArrayList<>(families.values());
+        }
+        for (Family family : snapshot) {
+            family.render(out);
+        }
+        out.append("# EOF\n");
+        return out.toString();
+    }
+
+    private Family family(String name, String help, Type type) {
+        synchronized (families) {
+            Family family = families.computeIfAbsent(name, n -> new Family(n, help, type));
+            if (family.type != type) {
+                throw new IllegalArgumentException("Metric " + name + " already registered as " + family.type);
+            }
+            return family;
+        }
+    }
+
+    /**
+     * 标签转义：反斜杠、双引号、换行
+     */
+    static String escape(String value) {
+        return value.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    }
+
+    static String formatValue(double value) {
+        if (value == Math.rint(value) && !Double.isInfinite(value) && Math.abs(value) < 1e15) {
+            return Long.toString((long) value);
+        }
+        return Double.toString(value);
+    }
+
+    private enum Type {
+        COUNTER("counter"), GAUGE("gauge"), SUMMARY("summary");
+
+        private final String text;
+
+        Type(String text) {
+            this.text = text;
+        }
+    }
+
+    private static final class Family {
+        private final String name;
+        private final String help;
+        private final Type type;
+        private final Map<String, Object> children = new LinkedHashMap<>();
+
+        private Family(String name, String help, Type type) {
+            this.name = name;
+            this.help = help;
+            this.type = type;
+        }
+
+        private synchronized Object child(String... labels) {
+            if (labels.length % 2 != 0) {
+                throw new IllegalArgumentException("Labels must be key/value pairs: " + name);
+            }
+            return children.computeIfAbsent(labelString(labels), k -> switch (type) {
+                case COUNTER -> new Counter();
+                case GAUGE -> new Gauge();
+                case SUMMARY -> new Summary();
+            });
+        }
+
+        private void render(StringBuilder out) {
+            Map<String, Object> snapshot;
+            synchronized (this) {
+                snapshot = new LinkedHashMap<>(children);
+            }
+            out.append("# TYPE ").append(name).append(' ').append(type.text).append('\n');
+            out.append("# HELP ").append(name).append(' ').append(help).append('\n');
+            snapshot.forEach((labels, metric) -> {
+                if (metric instanceof Counter counter) {
+                    sample(out, name + "_total", labels, counter.get());
+                } else if (metric instanceof Gauge gauge) {
+                    sample(out, name, labels, gauge.get());
+                } else if (metric instanceof Summary summary) {
+                    sample(out, name + "_count", labels, summary.getCount());
+                    sample(out, name + "_sum", labels, summary.getSum());
+                }
+            });
+        }
+
+        private static void sample(StringBuilder out, String name, String labels, double value) {
+            out.append(name).append(labels).append(' ').append(formatValue(value)).append('\n');
+        }
+
+        private static String labelString(String... labels) {
+            if (labels.length == 0) {
+                return "";
+            }
+            StringBuilder sb = new StringBuilder("{");
+            for (int i = 0; i < labels.length; i += 2) {
+                if (i > 0) {
+                    sb.append(',');
+                }
+                sb.append(labels[i]).append("=\"").append(escape(String.valueOf(labels[i + 1]))).append('"');
+            }
+            return sb.append('}').toString();
+        }
+    }
+
+    /**
+     * 计数器
+     */
+    public static final class Counter {
+        private final DoubleAdder value = new DoubleAdder();
+
+        public void inc() {
+            value.add(1);
+        }
+
+        public void inc(double delta) {
+            if (delta < 0) {
+                throw new IllegalArgumentException("Counter cannot decrease");
+            }
+            value.add(delta);
+        }
+
+        public double get() {
+            return value.sum();
+        }
+    }
+
+    /**
+     * 瞬时值
+     */
+    public static final class Gauge {
+        private final DoubleAdder value = new DoubleAdder();
+
+        public void inc() {
+            value.add(1);
+        }
+
+        public void dec() {
+            value.add(-1);
+        }
+
+        public void add(double delta) {
+            value.add(delta);
+        }
+
+        public double get() {
+            return value.sum();
+        }
+    }
+
+    /**
+     * 次数 + 总和
+     */
+    public static final class Summary {
+        private final LongAdder count = new LongAdder();
+        private final DoubleAdder sum = new DoubleAdder();
+
+        public void observe(double value) {
+            count.increment();
+            sum.add(value);
+        }
+
+        /**
+         * 记录从 startNanos（System.nanoTime）到现在经过的秒数
+         */
+        public void observeSince(long startNanos) {
+            observe((System.nanoTime() - startNanos) / 1e9);
+        }
+
+        public long getCount() {
+            return count.sum();
+        }
+
+        public double getSum() {
+            return sum.sum();
+        }
+    }
+}
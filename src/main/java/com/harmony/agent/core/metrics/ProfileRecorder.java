@@ -0,0 +1,99 @@
+package com.harmony.agent.core.metrics;
+
+import jdk.jfr.Configuration;
+import jdk.jfr.Event;
+import jdk.jfr.Recording;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.text.ParseException;
+import java.time.LocalDateTime;
+import java.time.format.DateTimeFormatter;
+
+/**
+ * --profile 的 JFR 录制
+ *
+ * 使用 JDK 内置 "profile" 配置（CPU 采样、分配、锁、I/O）并启用 {@link JfrEvents} 中的自定义事件。
+ * 录制文件在 {@link #stop()} 或 JVM 退出（如 serve 模式 Ctrl+C）时写出。
+ */
+public final class ProfileRecorder {
+
+    private static final Logger logger = LoggerFactory.getLogger(ProfileRecorder.class);
+
+    private static Recording recording;
+    private static Path destination;
+
+    private ProfileRecorder() {
+    }
+
+    /**
+     * 默认文件名：当前目录下 harmony-agent-&lt;时间戳&gt;.jfr
+     */
+    public static Path defaultPath() {
+        return Paths.get("harmony-agent-"
+            + LocalDateTime.now().format(DateTimeFormatter.ofPattern("yyyyMMdd-HHmmss")) + ".jfr");
+    }
+
+    /**
+     * 开始录制（重复调用返回已有录制的目标文件）
+     */
+    public static synchronized Path start(Path output) throws IOException {
+        if (recording != null) {
+            return destination;
+        }
+
+        Configuration configuration;
+        try {
+            configuration = Configuration.getConfiguration("profile");
+        } catch (ParseException e) {
+            throw new IOException("Failed to load JFR profile configuration", e);
+        }
+
+        Path target = output.toAbsolutePath();
+        if (target.getParent() != null) {
+            Files.createDirectories(target.getParent());
+        }
+
+        Recording newRecording = new Recording(configuration);
+        newRecording.setName("harmony-agent");
+        for (Class<? extends Event> eventType : JfrEvents.ALL) {
+            newRecording.enable(eventType).withoutThreshold();
+        }
+        newRecording.setDestination(target);
+        newRecording.setDumpOnExit(true);
+        newRecording.start();
+
+        recording = newRecording;
+        destination = target;
+        logger.info("JFR recording started: {}", target);
+        return target;
+    }
+
+    /**
+     * 停止录制并写出文件；未录制时返回 null
+     */
+    public static synchronized Path stop() {
+        if (recording == null) {
+            return null;
+        }
+        Path written = destination;
+        try {
+            recording.stop();
+            recording.close();
+            logger.info("JFR recording written: {}", written);
+        } catch (IllegalStateException e) {
+            logger.warn("Failed to stop JFR recording: {}", e.getMessage());
+        }
+        recording = null;
+        destination = null;
+        return written;
+    }
+
+    public static synchronized boolean isRecording() {
+        return recording != null;
+    }
+}
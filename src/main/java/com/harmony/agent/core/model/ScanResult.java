@@ -123,6 +123,21 @@ public class ScanResult {
         );
     }
 
+    /**
+     * Create a builder pre-populated with this result (same scan id)
+     */
+    public Builder toBuilder() {
+        Builder builder = new Builder()
+            .scanId(scanId)
+            .sourcePath(sourcePath)
+            .startTime(startTime)
+            .endTime(endTime)
+            .addIssues(issues);
+        statistics.forEach(builder::addStatistic);
+        analyzersUsed.forEach(builder::addAnalyzer);
+        return builder;
+    }
+
     /**
      * Builder for ScanResult
      */
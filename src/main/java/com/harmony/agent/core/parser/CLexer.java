@@ -0,0 +1,389 @@
+package com.harmony.agent.core.parser;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Set;
+
+/**
+ * C/C++ 流式词法分析器
+ *
+ * 单遍扫描源码，按需产出 Token：
+ * - 跳过注释和空白
+ * - 字符串/字符字面量作为整体（支持转义和原始字符串 R"(...)"）
+ * - 预处理指令整行作为一个 PREPROCESSOR Token（支持行尾续行）
+ * - 多字符运算符（&& || -> :: ... 等）合并为一个 PUNCT Token
+ *
+ * 不做宏展开和语义分析，面向评分、结构提取和模式匹配等轻量场景。
+ */
+public class CLexer {
+
+    /**
+     * Token 类型
+     */
+    public enum Kind {
+        IDENTIFIER,
+        NUMBER,
+        STRING,
+        CHAR,
+        PUNCT,
+        PREPROCESSOR
+    }
+
+    /**
+     * 词法单元
+     */
+    public static final class Token {
+        private final Kind kind;
+        private final String text;
+        private final int line;
+        private final int start;
+        private final int end;
+
+        public Token(Kind kind, String text, int line, int start, int end) {
+            this.kind = kind;
+            this.text = text;
+            this.line = line;
+            this.start = start;
+            this.end = end;
+        }
+
+        public Kind getKind() { return kind; }
+        public String getText() { return text; }
+        /** 起始行号（1-based） */
+        public int getLine() { return line; }
+        /** 起始偏移（包含） */
+        public int getStart() { return start; }
+        /** 结束偏移（不包含） */
+        public int getEnd() { return end; }
+
+        public boolean is(String s) {
+            return text.equals(s);
+        }
+
+        public boolean isIdentifier() {
+            return kind == Kind.IDENTIFIER;
+        }
+
+        @Override
+        public String toString() {
+            return kind + "(" + text + ")@" + line;
+        }
+    }
+
+    private static final Set<String> THREE_CHAR_PUNCT = Set.of("...", "<<=", ">>=", "->*");
+    private static final Set<String> TWO_CHAR_PUNCT = Set.of(
+        "&&", "||", "->", "::", "++", "--", "<<", ">>", "==", "!=", "<=", ">=",
+        "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", ".*", "##"
+    );
+
+    private final CharSequence src;
+    private final int length;
+    private int pos;
+    private int line;
+    private boolean lineStart;
+
+    public CLexer(CharSequence src) {
+        this(src, 0, 1);
+    }
+
+    /**
+     * 从指定偏移和行号开始扫描（用于局部重新词法分析）
+     */
+    public CLexer(CharSequence src, int offset, int line) {
+        this(src, offset, line, atLineStart(src, offset));
+    }
+
+    /**
+     * 从指定偏移和行号开始扫描，并显式给出该位置是否处于行首（# 是否可开始预处理指令）。
+     * 增量重新切分时由上一次结果决定：例如行首注释之后的 # 仍是预处理指令。
+     */
+    public CLexer(CharSequence src, int offset, int line, boolean lineStart) {
+        this.src = src;
+        this.length = src.length();
+        this.pos = offset;
+        this.line = line;
+        this.lineStart = lineStart;
+    }
+
+    /**
+     * offset 之前到行首是否只有空白（决定 # 是否为预处理指令）
+     */
+    private static boolean atLineStart(CharSequence src, int offset) {
+        for (int i = offset - 1; i >= 0; i--) {
+            char c = src.charAt(i);
+            if (c == '\n') {
+                return true;
+            }
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\f') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * 一次性切分全部 Token
+     */
+    public static List<Token> tokenize(CharSequence src) {
+        List<Token> tokens = new ArrayList<>();
+        CLexer lexer = new CLexer(src);
+        Token token;
+        while ((token = lexer.next()) != null) {
+            tokens.add(token);
+        }
+        return tokens;
+    }
+
+    /**
+     * 当前所在行号（扫描结束后即为总行数）
+     */
+    public int getLine() {
+        return line;
+    }
+
+    /**
+     * 当前偏移
+     */
+    public int getPosition() {
+        return pos;
+    }
+
+    /**
+     * 读取下一个 Token
+     *
+     * @return 下一个 Token，到达末尾返回 null
+     */
+    public Token next() {
+        skipWhitespaceAndComments();
+        if (pos >= length) {
+            return null;
+        }
+
+        char c = src.charAt(pos);
+        int start = pos;
+        int startLine = line;
+
+        if (c == '#' && lineStart) {
+            return readPreprocessor(start, startLine);
+        }
+        lineStart = false;
+
+        if (isIdentStart(c)) {
+            // 字符串前缀：L"" u8"" R"()" 等
+            int identEnd = pos;
+            while (identEnd < length && isIdentPart(src.charAt(identEnd))) {
+                identEnd++;
+            }
+            if (identEnd < length && isStringPrefix(start, identEnd)) {
+                char q = src.charAt(identEnd);
+                if (q == '"' || q == '\'') {
+                    boolean raw = src.charAt(identEnd - 1) == 'R' && q == '"';
+                    pos = identEnd;
+                    return raw ? readRawString(start, startLine) : readQuoted(start, startLine, q);
+                }
+            }
+            pos = identEnd;
+            return new Token(Kind.IDENTIFIER, src.subSequence(start, pos).toString(), startLine, start, pos);
+        }
+
+        if (isDigit(c) || (c == '.' && pos + 1 < length && isDigit(src.charAt(pos + 1)))) {
+            return readNumber(start, startLine);
+        }
+
+        if (c == '"' || c == '\'') {
+            return readQuoted(start, startLine, c);
+        }
+
+        return readPunct(start, startLine);
+    }
+
+    private void skipWhitespaceAndComments() {
+        while (pos < length) {
+            char c = src.charAt(pos);
+            if (c == '\n') {
+                line++;
+                pos++;
+                lineStart = true;
+            } else if (c == ' ' || c == '\t' || c == '\r' || c == '\f') {
+                pos++;
+            } else if (c == '\\' && pos + 1 < length && src.charAt(pos + 1) == '\n') {
+                // 续行
+                pos += 2;
+                line++;
+            } else if (c == '/' && pos + 1 < length && src.charAt(pos + 1) == '/') {
+                while (pos < length && src.charAt(pos) != '\n') {
+                    pos++;
+                }
+            } else if (c == '/' && pos + 1 < length && src.charAt(pos + 1) == '*') {
+                pos += 2;
+                while (pos < length && !(src.charAt(pos) == '*' && pos + 1 < length && src.charAt(pos + 1) == '/')) {
+                    if (src.charAt(pos) == '\n') {
+                        line++;
+                    }
+                    pos++;
+                }
+                pos = Math.min(length, pos + 2);
+            } else {
+                return;
+            }
+        }
+    }
+
+    private Token readPreprocessor(int start, int startLine) {
+        StringBuilder text = new StringBuilder();
+        while (pos < length) {
+            char c = src.charAt(pos);
+            if (c == '\n') {
+                break;
+            }
+            if (c == '\\' && pos + 1 < length && src.charAt(pos + 1) == '\n') {
+                pos += 2;
+                line++;
+                text.append(' ');
+                continue;
+            }
+            if (c == '/' && pos + 1 < length && src.charAt(pos + 1) == '*') {
+                // 指令中的块注释，可能跨行
+                pos += 2;
+                while (pos < length && !(src.charAt(pos) == '*' && pos + 1 < length && src.charAt(pos + 1) == '/')) {
+                    if (src.charAt(pos) == '\n') {
+                        line++;
+                    }
+                    pos++;
+                }
+                pos = Math.min(length, pos + 2);
+                text.append(' ');
+                continue;
+            }
+            if (c == '/' && pos + 1 < length && src.charAt(pos + 1) == '/') {
+                while (pos < length && src.charAt(pos) != '\n') {
+                    pos++;
+                }
+                break;
+            }
+            text.append(c);
+            pos++;
+        }
+        lineStart = false;
+        return new Token(Kind.PREPROCESSOR, text.toString().trim(), startLine, start, pos);
+    }
+
+    private Token readQuoted(int start, int startLine, char quote) {
+        pos++;  // 起始引号
+        while (pos < length) {
+            char c = src.charAt(pos);
+            if (c == '\\' && pos + 1 < length) {
+                if (src.charAt(pos + 1) == '\n') {
+                    line++;
+                }
+                pos += 2;
+                continue;
+            }
+            if (c == '\n') {
+                // 未闭合的字面量，在行尾结束
+                break;
+            }
+            pos++;
+            if (c == quote) {
+                break;
+            }
+        }
+        Kind kind = quote == '"' ? Kind.STRING : Kind.CHAR;
+        return new Token(kind, src.subSequence(start, pos).toString(), startLine, start, pos);
+    }
+
+    private Token readRawString(int start, int startLine) {
+        // R"delim( ... )delim"
+        int open = pos + 1;
+        int paren = open;
+        while (paren < length && src.charAt(paren) != '(' && src.charAt(paren) != '\n' && paren - open <= 16) {
+            paren++;
+        }
+        if (paren >= length || src.charAt(paren) != '(') {
+            return readQuoted(start, startLine, '"');
+        }
+        String terminator = ")" + src.subSequence(open, paren) + "\"";
+        pos = paren + 1;
+        while (pos < length && !regionMatches(pos, terminator)) {
+            if (src.charAt(pos) == '\n') {
+                line++;
+            }
+            pos++;
+        }
+        pos = Math.min(length, pos + terminator.length());
+        return new Token(Kind.STRING, src.subSequence(start, pos).toString(), startLine, start, pos);
+    }
+
+    private Token readNumber(int start, int startLine) {
+        while (pos < length) {
+            char c = src.charAt(pos);
+            if (isIdentPart(c) || c == '.' || c == '\'') {
+                pos++;
+            } else if ((c == '+' || c == '-') && pos > start) {
+                char prev = Character.toLowerCase(src.charAt(pos - 1));
+                if (prev == 'e' || prev == 'p') {
+                    pos++;
+                } else {
+                    break;
+                }
+            } else {
+                break;
+            }
+        }
+        return new Token(Kind.NUMBER, src.subSequence(start, pos).toString(), startLine, start, pos);
+    }
+
+    private Token readPunct(int start, int startLine) {
+        if (pos + 3 <= length) {
+            String three = src.subSequence(pos, pos + 3).toString();
+            if (THREE_CHAR_PUNCT.contains(three)) {
+                pos += 3;
+                return new Token(Kind.PUNCT, three, startLine, start, pos);
+            }
+        }
+        if (pos + 2 <= length) {
+            String two = src.subSequence(pos, pos + 2).toString();
+            if (TWO_CHAR_PUNCT.contains(two)) {
+                pos += 2;
+                return new Token(Kind.PUNCT, two, startLine, start, pos);
+            }
+        }
+        pos++;
+        return new Token(Kind.PUNCT, String.valueOf(src.charAt(start)), startLine, start, pos);
+    }
+
+    private boolean isStringPrefix(int start, int end) {
+        int len = end - start;
+        if (len > 3) {
+            return false;
+        }
+        String prefix = src.subSequence(start, end).toString();
+        return prefix.equals("L") || prefix.equals("u") || prefix.equals("U") || prefix.equals("u8")
+            || prefix.equals("R") || prefix.equals("LR") || prefix.equals("uR") || prefix.equals("UR")
+            || prefix.equals("u8R");
+    }
+
+    private boolean regionMatches(int offset, String s) {
+        if (offset + s.length() > length) {
+            return false;
+        }
+        for (int i = 0; i < s.length(); i++) {
+            if (src.charAt(offset + i) != s.charAt(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private static boolean isIdentStart(char c) {
+        return Character.isLetter(c) || c == '_' || c == '$';
+    }
+
+    private static boolean isIdentPart(char c) {
+        return Character.isLetterOrDigit(c) || c == '_' || c == '$';
+    }
+
+    private static boolean isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+}
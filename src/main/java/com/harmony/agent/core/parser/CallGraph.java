@@ -0,0 +1,452 @@
+package com.harmony.agent.core.parser;
+
+import com.google.common.hash.Hashing;
+import com.google.gson.Gson;
+import com.google.gson.JsonParseException;
+import com.harmony.agent.core.ai.PersistentCacheManager;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeMap;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.stream.Collectors;
+
+/**
+ * 项目级近似调用图（函数定义 + 调用点，按函数名解析）
+ *
+ * - 每个文件独立提取定义与调用点，并行构建；提取结果按路径、大小和修改时间写入扫描缓存，
+ *   未改动的文件下次扫描（包括增量扫描）无需重新解析
+ * - 调用按名字解析：同文件内有同名定义时只连到它，否则连到所有非 static 同名定义；
+ *   函数名作为实参或赋值右值出现（回调）也算一条边
+ * - 入口：非测试文件中的 main / wmain / WinMain；没有入口的项目（库）以非测试文件中的
+ *   非 static 函数作为导出 API
+ * - 测试目录（test / tests / unittest）和 test_xxx / xxx_test 文件中的函数不作为入口，
+ *   只被测试调用的代码因此视为不可达
+ *
+ * 供 AI 验证按可达性排序问题，以及为代码切片提供一跳调用者上下文。
+ */
+public final class CallGraph {
+
+    private static final Logger logger = LoggerFactory.getLogger(CallGraph.class);
+
+    /** 缓存格式版本：提取规则变化时递增 */
+    static final String CACHE_VERSION = "callgraph-v1";
+
+    private static final Gson GSON = new Gson();
+    private static final Set<String> ENTRY_POINTS = Set.of("main", "wmain", "WinMain", "wWinMain");
+    private static final Set<String> NOT_CALLS = Set.of(
+        "if", "while", "for", "switch", "return", "sizeof", "alignof", "_Alignof", "decltype", "typeof",
+        "__typeof__", "__attribute__", "defined", "catch", "static_assert", "_Static_assert", "do", "else"
+    );
+    private static final Set<String> TEST_DIRECTORIES = Set.of("test", "tests", "unittest", "unittests", "testing");
+
+    /** 判断 static 时向前回看的 Token 上限 */
+    private static final int MAX_SIGNATURE_TOKENS = 64;
+
+    /**
+     * 问题位置的可达性
+     */
+    public enum Reachability {
+        /** 位于从入口可达的函数中 */
+        REACHABLE,
+        /** 不在任何已索引的函数中（全局作用域、未索引的文件） */
+        UNKNOWN,
+        /** 位于从入口不可达的函数中（死代码或只被测试调用） */
+        UNREACHABLE
+    }
+
+    /**
+     * 调用点（行号 1-based）
+     */
+    public record CallSite(Path file, String caller, int line) {
+    }
+
+    /** 单个文件的提取结果（持久化格式） */
+    record FileSummary(List<Definition> definitions) {
+    }
+
+    /** 函数定义：简单名、行范围、是否 static、函数体内的调用 / 引用 */
+    record Definition(String name, int startLine, int endLine, boolean local, List<Call> calls) {
+    }
+
+    record Call(String name, int line) {
+    }
+
+    private record Indexed(Path file, FileSummary summary) {
+    }
+
+    private final List<Path> nodeFiles = new ArrayList<>();
+    private final List<Definition> nodes = new ArrayList<>();
+    private final Map<Path, List<Integer>> nodesByFile = new HashMap<>();
+    private final List<List<CallSite>> callers = new ArrayList<>();
+    private final int[] depth;
+    private final int fileCount;
+    private final int cachedFileCount;
+    private int edgeCount;
+    private int rootCount;
+    private int reachableCount;
+
+    private CallGraph(Map<Path, FileSummary> summaries, int cachedFileCount) {
+        this.fileCount = summaries.size();
+        this.cachedFileCount = cachedFileCount;
+        Path projectRoot = commonParent(summaries.keySet());
+        for (Map.Entry<Path, FileSummary> entry : summaries.entrySet()) {
+            for (Definition definition : entry.getValue().definitions()) {
+                nodesByFile.computeIfAbsent(entry.getKey(), k -> new ArrayList<>()).add(nodes.size());
+                nodeFiles.add(entry.getKey());
+                nodes.add(definition);
+                callers.add(new ArrayList<>());
+            }
+        }
+        this.depth = new int[nodes.size()];
+        Arrays.fill(depth, -1);
+        propagate(link(), projectRoot);
+    }
+
+    /**
+     * 并行提取各文件的定义与调用点并构建调用图
+     *
+     * @param files 参与分析的 C/C++ 文件
+     * @param models 结构模型缓存（缓存未命中的文件从这里解析）
+     * @param cache 按文件持久化的提取结果（可为 null）
+     */
+    public static CallGraph build(Collection<Path> files, SourceModelCache models, PersistentCacheManager cache) {
+        AtomicInteger cached = new AtomicInteger();
+        Map<Path, FileSummary> summaries = files.parallelStream()
+            .map(CallGraph::normalize)
+            .distinct()
+            .map(file -> new Indexed(file, summarize(file, models, cache, cached)))
+            .filter(indexed -> indexed.summary() != null)
+            .collect(Collectors.toMap(Indexed::file, Indexed::summary, (a, b) -> a, TreeMap::new));
+
+        CallGraph graph = new CallGraph(summaries, cached.get());
+        logger.info("Call graph: {} files ({} from cache), {} functions, {} edges, {} entry points, {} reachable",
+            graph.fileCount, graph.cachedFileCount, graph.nodes.size(), graph.edgeCount, graph.rootCount,
+            graph.reachableCount);
+        return graph;
+    }
+
+    private static FileSummary summarize(Path file, SourceModelCache models, PersistentCacheManager cache,
+                                         AtomicInteger cached) {
+        String key;
+        try {
+            key = cache != null ? cacheKey(file) : null;
+        } catch (IOException e) {
+            logger.debug("Skipping unreadable file in call graph: {}", file);
+            return null;
+        }
+        if (key != null) {
+            String json = cache.get(key);
+            if (json != null) {
+                try {
+                    FileSummary summary = GSON.fromJson(json, FileSummary.class);
+                    if (summary != null && summary.definitions() != null) {
+                        cached.incrementAndGet();
+                        return summary;
+                    }
+                } catch (JsonParseException e) {
+                    logger.debug("Ignoring corrupt call graph cache entry for {}", file);
+                }
+            }
+        }
+
+        SourceModel model;
+        try {
+            model = models.get(file);
+        } catch (IOException e) {
+            logger.debug("Skipping unreadable file in call graph: {}", file);
+            return null;
+        }
+        FileSummary summary = extract(model);
+        if (key != null) {
+            cache.put(key, GSON.toJson(summary));
+        }
+        return summary;
+    }
+
+    private static String cacheKey(Path file) throws IOException {
+        BasicFileAttributes attributes = Files.readAttributes(file, BasicFileAttributes.class);
+        return Hashing.sha256().hashString(String.join("\n",
+            CACHE_VERSION,
+            file.toString(),
+            String.valueOf(attributes.size()),
+            String.valueOf(attributes.lastModifiedTime().toMillis())), StandardCharsets.UTF_8).toString();
+    }
+
+    /**
+     * 从结构模型中提取函数定义及函数体内的调用点
+     */
+    static FileSummary extract(SourceModel model) {
+        List<Definition> definitions = new ArrayList<>();
+        int count = model.getTokenCount();
+        for (SourceModel.Function function : model.getFunctions()) {
+            int end = function.closeBrace() >= 0 ? function.closeBrace() : count;
+            Set<Call> calls = new LinkedHashSet<>();
+            for (int i = function.openBrace() + 1; i < end; i++) {
+                if (model.getTokenKind(i) != CLexer.Kind.IDENTIFIER || NOT_CALLS.contains(model.getTokenText(i))) {
+                    continue;
+                }
+                if (isCall(model, i, count) || isReference(model, i, count)) {
+                    calls.add(new Call(model.getTokenText(i), model.getTokenLine(i)));
+                }
+            }
+            definitions.add(new Definition(simpleName(function.name()), function.startLine(), function.endLine(),
+                isStatic(model, function.openBrace()), new ArrayList<>(calls)));
+        }
+        return new FileSummary(definitions);
+    }
+
+    private static boolean isCall(SourceModel model, int i, int count) {
+        return i + 1 < count && model.getTokenText(i + 1).equals("(");
+    }
+
+    /**
+     * 函数名作为实参或赋值右值（回调注册、函数指针表）
+     */
+    private static boolean isReference(SourceModel model, int i, int count) {
+        if (i + 1 >= count) {
+            return false;
+        }
+        String previous = model.getTokenText(i - 1);
+        String next = model.getTokenText(i + 1);
+        return (previous.equals(",") || previous.equals("(") || previous.equals("=") || previous.equals("&"))
+            && (next.equals(",") || next.equals(")") || next.equals(";"));
+    }
+
+    /**
+     * 从函数体左大括号向前回看到上一条声明的边界，签名中出现 static 即为文件内函数
+     */
+    private static boolean isStatic(SourceModel model, int openBrace) {
+        for (int i = openBrace - 1; i >= Math.max(0, openBrace - MAX_SIGNATURE_TOKENS); i--) {
+            if (model.getTokenKind(i) == CLexer.Kind.PREPROCESSOR) {
+                return false;
+            }
+            String text = model.getTokenText(i);
+            if (text.equals(";") || text.equals("}") || text.equals("{")) {
+                return false;
+            }
+            if (text.equals("static")) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * 按名字解析调用，建立邻接表和反向调用点
+     */
+    private List<List<Integer>> link() {
+        Map<String, List<Integer>> byName = new HashMap<>();
+        for (int id = 0; id < nodes.size(); id++) {
+            byName.computeIfAbsent(nodes.get(id).name(), k -> new ArrayList<>()).add(id);
+        }
+
+        List<List<Integer>> edges = new ArrayList<>(nodes.size());
+        for (int id = 0; id < nodes.size(); id++) {
+            Path file = nodeFiles.get(id);
+            Definition caller = nodes.get(id);
+            Set<Integer> targets = new LinkedHashSet<>();
+            for (Call call : caller.calls()) {
+                for (int target : resolve(byName.get(call.name()), file)) {
+                    targets.add(target);
+                    callers.get(target).add(new CallSite(file, caller.name(), call.line()));
+                }
+            }
+            edges.add(new ArrayList<>(targets));
+            edgeCount += targets.size();
+        }
+        return edges;
+    }
+
+    private List<Integer> resolve(List<Integer> candidates, Path callerFile) {
+        if (candidates == null) {
+            return Collections.emptyList();
+        }
+        List<Integer> sameFile = new ArrayList<>();
+        List<Integer> global = new ArrayList<>();
+        for (int candidate : candidates) {
+            if (nodeFiles.get(candidate).equals(callerFile)) {
+                sameFile.add(candidate);
+            } else if (!nodes.get(candidate).local()) {
+                global.add(candidate);
+            }
+        }
+        return sameFile.isEmpty() ? global : sameFile;
+    }
+
+    /**
+     * 从入口做广度优先遍历，记录每个函数到最近入口的调用深度
+     */
+    private void propagate(List<List<Integer>> edges, Path projectRoot) {
+        List<Integer> roots = new ArrayList<>();
+        for (int id = 0; id < nodes.size(); id++) {
+            if (ENTRY_POINTS.contains(nodes.get(id).name()) && !isTestFile(nodeFiles.get(id), projectRoot)) {
+                roots.add(id);
+            }
+        }
+        if (roots.isEmpty()) {
+            for (int id = 0; id < nodes.size(); id++) {
+                if (!nodes.get(id).local() && !isTestFile(nodeFiles.get(id), projectRoot)) {
+                    roots.add(id);
+                }
+            }
+        }
+        rootCount = roots.size();
+
+        ArrayDeque<Integer> queue = new ArrayDeque<>();
+        for (int root : roots) {
+            depth[root] = 0;
+            queue.add(root);
+        }
+        while (!queue.isEmpty()) {
+            int id = queue.poll();
+            reachableCount++;
+            for (int target : edges.get(id)) {
+                if (depth[target] < 0) {
+                    depth[target] = depth[id] + 1;
+                    queue.add(target);
+                }
+            }
+        }
+    }
+
+    static boolean isTestFile(Path file, Path projectRoot) {
+        Path relative = projectRoot != null && file.startsWith(projectRoot) ? projectRoot.relativize(file) : file;
+        Path parent = relative.getParent();
+        if (parent != null) {
+            for (Path part : parent) {
+                if (TEST_DIRECTORIES.contains(part.toString().toLowerCase(Locale.ROOT))) {
+                    return true;
+                }
+            }
+        }
+        String name = relative.getFileName().toString().toLowerCase(Locale.ROOT);
+        int dot = name.lastIndexOf('.');
+        String stem = dot > 0 ? name.substring(0, dot) : name;
+        return stem.startsWith("test_") || stem.endsWith("_test") || stem.endsWith("_tests")
+            || stem.endsWith("_unittest");
+    }
+
+    private static Path commonParent(Collection<Path> files) {
+        Path common = null;
+        for (Path file : files) {
+            Path parent = file.getParent();
+            if (common == null) {
+                common = parent;
+            } else {
+                while (common != null && (parent == null || !parent.startsWith(common))) {
+                    common = common.getParent();
+                }
+            }
+        }
+        return common;
+    }
+
+    private static String simpleName(String name) {
+        int separator = name.lastIndexOf("::");
+        return separator >= 0 ? name.substring(separator + 2) : name;
+    }
+
+    private static Path normalize(Path file) {
+        return file.toAbsolutePath().normalize();
+    }
+
+    // ===== 查询 =====
+
+    /**
+     * 包含该行的函数（多个重叠时取范围最小的）；-1 表示不在任何已索引的函数中
+     */
+    private int nodeAt(String file, int line) {
+        List<Integer> candidates = nodesByFile.get(normalize(Paths.get(file)));
+        if (candidates == null) {
+            return -1;
+        }
+        int best = -1;
+        for (int id : candidates) {
+            Definition definition = nodes.get(id);
+            if (line >= definition.startLine() && line <= definition.endLine() && (best < 0
+                    || definition.endLine() - definition.startLine()
+                    < nodes.get(best).endLine() - nodes.get(best).startLine())) {
+                best = id;
+            }
+        }
+        return best;
+    }
+
+    public Reachability reachability(String file, int line) {
+        int id = nodeAt(file, line);
+        if (id < 0) {
+            return Reachability.UNKNOWN;
+        }
+        return depth[id] >= 0 ? Reachability.REACHABLE : Reachability.UNREACHABLE;
+    }
+
+    /**
+     * 从最近入口到包含该行的函数的调用深度（入口本身为 0）；不可达或未知时为 -1
+     */
+    public int depth(String file, int line) {
+        int id = nodeAt(file, line);
+        return id >= 0 ? depth[id] : -1;
+    }
+
+    /**
+     * 包含该行的函数的直接调用点（一跳），可达的调用者在前
+     */
+    public List<CallSite> callersOf(String file, int line) {
+        int id = nodeAt(file, line);
+        if (id < 0) {
+            return Collections.emptyList();
+        }
+        List<CallSite> sites = new ArrayList<>(callers.get(id));
+        sites.sort((a, b) -> Integer.compare(callerRank(a), callerRank(b)));
+        return sites;
+    }
+
+    private int callerRank(CallSite site) {
+        int id = nodeAt(site.file().toString(), site.line());
+        return id >= 0 && depth[id] >= 0 ? depth[id] : Integer.MAX_VALUE;
+    }
+
+    public int getFileCount() {
+        return fileCount;
+    }
+
+    public int getCachedFileCount() {
+        return cachedFileCount;
+    }
+
+    public int getFunctionCount() {
+        return nodes.size();
+    }
+
+    public int getEdgeCount() {
+        return edgeCount;
+    }
+
+    public int getReachableCount() {
+        return reachableCount;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("CallGraph{files=%d, functions=%d, edges=%d, reachable=%d}",
+            fileCount, nodes.size(), edgeCount, reachableCount);
+    }
+}
@@ -148,6 +148,21 @@ public class CompileCommandsParser {
             .orElse(null);
     }
 
+    /**
+     * 按源文件绝对路径索引编译命令
+     *
+     * @return 源文件绝对路径 -> 编译命令(同一文件多条命令时取第一条)
+     */
+    public Map<Path, CompileCommand> getCommandsBySourceFile() {
+        Map<Path, CompileCommand> index = new HashMap<>();
+        for (CompileCommand cmd : commands) {
+            if (cmd.file != null && cmd.directory != null) {
+                index.putIfAbsent(resolvePath(cmd.directory, cmd.file), cmd);
+            }
+        }
+        return index;
+    }
+
     /**
      * 解析路径(相对->绝对)
      *
@@ -270,6 +285,40 @@ public class CompileCommandsParser {
             return null;
         }
 
+        /**
+         * 获取输出文件
+         * 优先使用output字段,否则从-o选项提取
+         */
+        public String getOutputFile() {
+            if (output != null && !output.isEmpty()) {
+                return output;
+            }
+
+            List<String> args = getArgumentsList();
+            for (int i = 0; i < args.size(); i++) {
+                String arg = args.get(i);
+                if (arg.equals("-o") && i + 1 < args.size()) {
+                    return args.get(i + 1);
+                } else if (arg.startsWith("-o") && arg.length() > 2) {
+                    return arg.substring(2);
+                }
+            }
+
+            return null;
+        }
+
+        /**
+         * 是否以多线程方式编译或链接(-pthread、-lpthread、-fopenmp)
+         */
+        public boolean isThreaded() {
+            for (String arg : getArgumentsList()) {
+                if (arg.equals("-pthread") || arg.equals("-lpthread") || arg.equals("-fopenmp")) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         /**
          * 获取参数列表
          * 优先使用arguments字段,否则解析command字符串
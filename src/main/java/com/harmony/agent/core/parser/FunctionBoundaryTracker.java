@@ -0,0 +1,194 @@
+package com.harmony.agent.core.parser;
+
+import com.harmony.agent.core.parser.CLexer.Kind;
+import com.harmony.agent.core.parser.CLexer.Token;
+
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.Set;
+
+/**
+ * 基于 Token 流的函数边界识别
+ *
+ * 逐个接收 {@link CLexer} 产出的 Token，识别形如 {@code name(...) [限定符] {}} 的函数定义。
+ * 兼容 C++ 的限定名（Foo::bar）、构造函数初始化列表和 namespace/class/extern "C" 块内的定义。
+ * 这是启发式识别，不展开宏；足以支撑评分、切片和结构索引。
+ */
+public class FunctionBoundaryTracker {
+
+    /**
+     * 每个 Token 处理后的边界事件
+     */
+    public enum Event {
+        NONE,
+        FUNCTION_START,
+        FUNCTION_END
+    }
+
+    private static final Set<String> NON_FUNCTION_KEYWORDS = Set.of(
+        "if", "for", "while", "switch", "return", "sizeof", "catch", "do", "else",
+        "alignof", "decltype", "typeof", "__attribute__", "__declspec", "defined"
+    );
+
+    // 大括号栈：true 表示该层是函数体
+    private final Deque<Boolean> braceStack = new ArrayDeque<>();
+
+    private int parenDepth;
+    private Token previous;
+    private Token beforePrevious;
+    private Token thirdPrevious;
+
+    // 候选函数签名
+    private String candidateName;
+    private Token candidateToken;
+    private boolean signatureClosed;
+
+    // 当前函数
+    private int functionBraceLevel = -1;
+    private String functionName;
+    private Token functionNameToken;
+    private Token functionOpenBrace;
+
+    /**
+     * 处理一个 Token
+     */
+    public Event accept(Token token) {
+        try {
+            return handle(token);
+        } finally {
+            if (token.getKind() != Kind.PREPROCESSOR) {
+                thirdPrevious = beforePrevious;
+                beforePrevious = previous;
+                previous = token;
+            }
+        }
+    }
+
+    private Event handle(Token token) {
+        if (token.getKind() == Kind.PREPROCESSOR) {
+            return Event.NONE;
+        }
+        String text = token.getText();
+
+        if (token.getKind() == Kind.PUNCT) {
+            switch (text) {
+                case "(" -> {
+                    if (!isInFunction() && parenDepth == 0 && !signatureClosed
+                            && previous != null && previous.isIdentifier()
+                            && !NON_FUNCTION_KEYWORDS.contains(previous.getText())) {
+                        candidateToken = previous;
+                        candidateName = qualifiedName();
+                    }
+                    parenDepth++;
+                }
+                case ")" -> {
+                    if (parenDepth > 0) {
+                        parenDepth--;
+                    }
+                    if (parenDepth == 0 && candidateName != null) {
+                        signatureClosed = true;
+                    }
+                }
+                case ";" -> {
+                    if (parenDepth == 0) {
+                        resetCandidate();
+                    }
+                }
+                case "=" -> {
+                    // 初始化器（int a[] = {...}）不是函数；= default/= delete 也不产生函数体
+                    if (parenDepth == 0 && !isInFunction()) {
+                        resetCandidate();
+                    }
+                }
+                case "{" -> {
+                    boolean startsFunction = !isInFunction() && signatureClosed && parenDepth == 0;
+                    braceStack.push(startsFunction);
+                    if (startsFunction) {
+                        functionBraceLevel = braceStack.size();
+                        functionName = candidateName;
+                        functionNameToken = candidateToken;
+                        functionOpenBrace = token;
+                        resetCandidate();
+                        return Event.FUNCTION_START;
+                    }
+                    if (!isInFunction()) {
+                        resetCandidate();
+                    }
+                }
+                case "}" -> {
+                    if (!braceStack.isEmpty()) {
+                        boolean wasFunction = braceStack.pop();
+                        if (wasFunction) {
+                            functionBraceLevel = -1;
+                            resetCandidate();
+                            return Event.FUNCTION_END;
+                        }
+                    }
+                    if (!isInFunction()) {
+                        resetCandidate();
+                    }
+                }
+                default -> {
+                }
+            }
+        }
+        return Event.NONE;
+    }
+
+    private String qualifiedName() {
+        String name = previous.getText();
+        if (beforePrevious != null && beforePrevious.is("::")
+                && thirdPrevious != null && thirdPrevious.isIdentifier()) {
+            return thirdPrevious.getText() + "::" + name;
+        }
+        return name;
+    }
+
+    private void resetCandidate() {
+        candidateName = null;
+        candidateToken = null;
+        signatureClosed = false;
+    }
+
+    /**
+     * 是否位于函数体内
+     */
+    public boolean isInFunction() {
+        return functionBraceLevel > 0;
+    }
+
+    /**
+     * 当前大括号深度（全局）
+     */
+    public int getBraceDepth() {
+        return braceStack.size();
+    }
+
+    /**
+     * 函数体内的嵌套深度（函数体本身为 1），不在函数内时为 0
+     */
+    public int getFunctionNesting() {
+        return isInFunction() ? braceStack.size() - functionBraceLevel + 1 : 0;
+    }
+
+    /**
+     * 当前（或刚结束的）函数名，C++ 成员函数为 Class::method 形式
+     */
+    public String getFunctionName() {
+        return functionName;
+    }
+
+    /**
+     * 当前（或刚结束的）函数名 Token
+     */
+    public Token getFunctionNameToken() {
+        return functionNameToken;
+    }
+
+    /**
+     * 当前（或刚结束的）函数体左大括号
+     */
+    public Token getFunctionOpenBrace() {
+        return functionOpenBrace;
+    }
+}
@@ -0,0 +1,257 @@
+package com.harmony.agent.core.parser;
+
+import com.harmony.agent.core.parser.CompileCommandsParser.CompileCommand;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeSet;
+import java.util.regex.Pattern;
+
+/**
+ * 项目级事实索引（每次扫描构建一次，之后 O(1) 查询）
+ *
+ * 记录：
+ * - 哪些文件创建线程（pthread_create、std::thread、thrd_create、OpenMP parallel 等）
+ * - 哪些文件与线程相关（包含线程头文件，或编译命令带 -pthread / -lpthread / -fopenmp）
+ * - 自定义分配 / 释放包装函数（函数体很短且调用 malloc 族并 return / 调用 free）
+ * - 入口点（定义 main 的文件）
+ *
+ * 供预过滤和提示词构建查询，取代按代码切片逐问题搜索线程关键字。
+ */
+public final class ProjectFacts {
+
+    private static final Logger logger = LoggerFactory.getLogger(ProjectFacts.class);
+
+    private static final Set<String> THREAD_CREATORS = Set.of(
+        "pthread_create", "thrd_create", "CreateThread", "_beginthread", "_beginthreadex",
+        "g_thread_new", "uv_thread_create"
+    );
+    private static final Set<String> STD_THREAD_TYPES = Set.of("thread", "jthread", "async");
+    private static final Pattern OMP_PARALLEL = Pattern.compile("#\\s*pragma\\s+omp\\s+parallel\\b.*");
+    private static final Pattern THREAD_INCLUDE = Pattern.compile(
+        "#\\s*include\\s*[<\"](pthread\\.h|thread|threads\\.h|omp\\.h)[>\"].*");
+    private static final Set<String> ENTRY_POINTS = Set.of("main", "wmain", "WinMain", "wWinMain");
+    private static final Set<String> ALLOCATORS = Set.of("malloc", "calloc", "realloc", "strdup", "strndup");
+
+    /** 包装函数的函数体 Token 上限：超过则视为普通业务函数 */
+    private static final int WRAPPER_MAX_TOKENS = 80;
+
+    private final int fileCount;
+    private final Set<Path> threadCreatingFiles;
+    private final Set<Path> threadAwareFiles;
+    private final Set<String> allocatorWrappers;
+    private final Set<String> deallocatorWrappers;
+    private final Set<Path> entryPointFiles;
+
+    private ProjectFacts(int fileCount, Set<Path> threadCreatingFiles, Set<Path> threadAwareFiles,
+                         Set<String> allocatorWrappers, Set<String> deallocatorWrappers, Set<Path> entryPointFiles) {
+        this.fileCount = fileCount;
+        this.threadCreatingFiles = Collections.unmodifiableSet(threadCreatingFiles);
+        this.threadAwareFiles = Collections.unmodifiableSet(threadAwareFiles);
+        this.allocatorWrappers = Collections.unmodifiableSet(allocatorWrappers);
+        this.deallocatorWrappers = Collections.unmodifiableSet(deallocatorWrappers);
+        this.entryPointFiles = Collections.unmodifiableSet(entryPointFiles);
+    }
+
+    /**
+     * 扫描文件列表构建索引；模型取自共享缓存，后续切片可直接复用
+     *
+     * @param files 参与分析的 C/C++ 文件
+     * @param compileCommands compile_commands.json（可为 null）
+     * @param models 结构模型缓存
+     */
+    public static ProjectFacts build(Collection<Path> files, CompileCommandsParser compileCommands,
+                                     SourceModelCache models) {
+        Set<Path> threadCreating = new TreeSet<>();
+        Set<Path> threadAware = new HashSet<>();
+        Set<String> allocators = new TreeSet<>();
+        Set<String> deallocators = new TreeSet<>();
+        Set<Path> entryPoints = new TreeSet<>();
+
+        if (compileCommands != null) {
+            for (Map.Entry<Path, CompileCommand> entry : compileCommands.getCommandsBySourceFile().entrySet()) {
+                if (entry.getValue().isThreaded()) {
+                    threadAware.add(normalize(entry.getKey()));
+                }
+            }
+        }
+
+        int indexed = 0;
+        for (Path file : files) {
+            Path key = normalize(file);
+            SourceModel model;
+            try {
+                model = models.get(key);
+            } catch (IOException e) {
+                logger.debug("Skipping unreadable file in fact index: {}", file);
+                continue;
+            }
+            indexed++;
+            scanTokens(model, key, threadCreating, threadAware);
+            for (SourceModel.Function function : model.getFunctions()) {
+                String name = simpleName(function.name());
+                if (ENTRY_POINTS.contains(name)) {
+                    entryPoints.add(key);
+                } else {
+                    classifyWrapper(model, function, name, allocators, deallocators);
+                }
+            }
+        }
+        threadAware.addAll(threadCreating);
+
+        ProjectFacts facts = new ProjectFacts(indexed, threadCreating, threadAware, allocators, deallocators,
+            entryPoints);
+        logger.info("Fact index: {} files, {} create threads, {} allocator / {} deallocator wrappers, {} entry points",
+            indexed, threadCreating.size(), allocators.size(), deallocators.size(), entryPoints.size());
+        return facts;
+    }
+
+    private static void scanTokens(SourceModel model, Path file, Set<Path> threadCreating, Set<Path> threadAware) {
+        int count = model.getTokenCount();
+        for (int i = 0; i < count; i++) {
+            String text = model.getTokenText(i);
+            if (model.getTokenKind(i) == CLexer.Kind.PREPROCESSOR) {
+                if (THREAD_INCLUDE.matcher(text).matches()) {
+                    threadAware.add(file);
+                } else if (OMP_PARALLEL.matcher(text).matches()) {
+                    threadCreating.add(file);
+                }
+                continue;
+            }
+            if (THREAD_CREATORS.contains(text) && i + 1 < count && model.getTokenText(i + 1).equals("(")) {
+                threadCreating.add(file);
+            } else if (STD_THREAD_TYPES.contains(text) && i >= 2 && model.getTokenText(i - 1).equals("::")
+                    && model.getTokenText(i - 2).equals("std") && i + 1 < count
+                    && !model.getTokenText(i + 1).equals("::")) {
+                // std::thread t(...) / std::thread(...) / std::async(...)；std::thread::id 等不算
+                threadCreating.add(file);
+            }
+        }
+    }
+
+    private static void classifyWrapper(SourceModel model, SourceModel.Function function, String name,
+                                        Set<String> allocators, Set<String> deallocators) {
+        if (function.closeBrace() < 0 || function.closeBrace() - function.openBrace() > WRAPPER_MAX_TOKENS) {
+            return;
+        }
+        boolean allocates = false;
+        boolean frees = false;
+        boolean returns = false;
+        for (int i = function.openBrace() + 1; i < function.closeBrace(); i++) {
+            String text = model.getTokenText(i);
+            boolean call = model.getTokenText(i + 1).equals("(");
+            if (call && ALLOCATORS.contains(text)) {
+                allocates = true;
+            } else if (call && text.equals("free")) {
+                frees = true;
+            } else if (text.equals("return") && !model.getTokenText(i + 1).equals(";")) {
+                returns = true;
+            }
+        }
+        if (allocates && returns) {
+            allocators.add(name);
+        } else if (frees && !allocates) {
+            deallocators.add(name);
+        }
+    }
+
+    private static String simpleName(String name) {
+        int separator = name.lastIndexOf("::");
+        return separator >= 0 ? name.substring(separator + 2) : name;
+    }
+
+    private static Path normalize(Path file) {
+        return file.toAbsolutePath().normalize();
+    }
+
+    // ===== 查询 =====
+
+    /**
+     * 项目中是否有任何文件创建线程
+     */
+    public boolean createsThreads() {
+        return !threadCreatingFiles.isEmpty();
+    }
+
+    public Set<Path> getThreadCreatingFiles() {
+        return threadCreatingFiles;
+    }
+
+    /**
+     * 文件是否与线程相关：创建线程、包含线程头文件或以 -pthread 等编译
+     */
+    public boolean isThreadAware(String file) {
+        return threadAwareFiles.contains(normalize(Paths.get(file)));
+    }
+
+    public boolean isAllocatorWrapper(String function) {
+        return allocatorWrappers.contains(function);
+    }
+
+    public boolean isDeallocatorWrapper(String function) {
+        return deallocatorWrappers.contains(function);
+    }
+
+    public Set<String> getAllocatorWrappers() {
+        return allocatorWrappers;
+    }
+
+    public Set<String> getDeallocatorWrappers() {
+        return deallocatorWrappers;
+    }
+
+    public Set<Path> getEntryPointFiles() {
+        return entryPointFiles;
+    }
+
+    public int getFileCount() {
+        return fileCount;
+    }
+
+    /**
+     * 供提示词使用的项目背景（英文，每条一行）
+     */
+    public List<String> describe(String file) {
+        List<String> lines = new ArrayList<>();
+        if (createsThreads()) {
+            lines.add("Threads: created in " + threadCreatingFiles.size() + " file(s), e.g. "
+                + sample(threadCreatingFiles) + "; this file is "
+                + (isThreadAware(file) ? "" : "not ") + "thread-aware");
+        } else {
+            lines.add("Threads: none of the " + fileCount
+                + " indexed files creates a thread (no pthread_create, std::thread, thrd_create or OpenMP)");
+        }
+        if (!entryPointFiles.isEmpty()) {
+            lines.add("Entry points: main() in " + sample(entryPointFiles));
+        }
+        if (!allocatorWrappers.isEmpty()) {
+            lines.add("Allocator wrappers: " + String.join(", ", allocatorWrappers));
+        }
+        if (!deallocatorWrappers.isEmpty()) {
+            lines.add("Deallocator wrappers: " + String.join(", ", deallocatorWrappers));
+        }
+        return lines;
+    }
+
+    private static String sample(Set<Path> files) {
+        List<String> names = new ArrayList<>();
+        for (Path file : files) {
+            if (names.size() == 3) {
+                names.add("...");
+                break;
+            }
+            names.add(String.valueOf(file.getFileName()));
+        }
+        return String.join(", ", names);
+    }
+}
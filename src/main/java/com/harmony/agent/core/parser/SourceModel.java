@@ -0,0 +1,522 @@
+package com.harmony.agent.core.parser;
+
+import com.harmony.agent.core.parser.CLexer.Token;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Optional;
+
+/**
+ * 单个 C/C++ 文件的结构模型：Token 序列、括号配对树与函数范围
+ *
+ * 模型不可变，编辑通过 {@link #applyEdit} / {@link #withText} 产生新模型，只重做编辑点附近的工作：
+ * - Token：从编辑点前一个 Token 处重新切分，直到新 Token 与平移后的旧 Token 在位置、行号和文本上重合，
+ *   其后的旧 Token 只做偏移/行号平移
+ * - 括号配对：编辑区域内的括号序列不变时按下标平移，否则在 Token 序列上重新配对（不重新词法分析）
+ * - 函数范围：编辑落在某个函数体内且括号序列不变时平移复用，否则用 {@link FunctionBoundaryTracker} 重新识别
+ *
+ * Token 以列式数组保存，平移只是整数加法；{@link #getToken(int)} 按需构造 Token 对象。
+ */
+public final class SourceModel {
+
+    private static final CLexer.Kind[] KINDS = CLexer.Kind.values();
+    private static final byte PUNCT = (byte) CLexer.Kind.PUNCT.ordinal();
+    private static final byte PREPROCESSOR = (byte) CLexer.Kind.PREPROCESSOR.ordinal();
+
+    /**
+     * 函数范围（行号 1-based，闭区间）；openBrace/closeBrace 为函数体大括号的 Token 下标，
+     * closeBrace 为 -1 表示文件在函数体内截断
+     */
+    public record Function(String name, int startLine, int endLine, int openBrace, int closeBrace) {
+
+        public boolean contains(int line) {
+            return line >= startLine && line <= endLine;
+        }
+    }
+
+    private final String text;
+    private final int count;
+    private final byte[] kinds;
+    private final String[] texts;
+    private final int[] starts;
+    private final int[] ends;
+    private final int[] lines;
+    private final int[] partners;
+    private final List<Function> functions;
+    private final int lineCount;
+    private final int relexedTokens;
+    private final boolean structureReused;
+    private volatile List<String> lineList;
+
+    private SourceModel(String text, int lineCount, TokenBuffer tokens, int[] partners, List<Function> functions,
+                        int relexedTokens) {
+        this.text = text;
+        this.count = tokens.size;
+        this.kinds = Arrays.copyOf(tokens.kinds, count);
+        this.texts = Arrays.copyOf(tokens.texts, count);
+        this.starts = Arrays.copyOf(tokens.starts, count);
+        this.ends = Arrays.copyOf(tokens.ends, count);
+        this.lines = Arrays.copyOf(tokens.lines, count);
+        this.partners = partners != null ? partners : matchBrackets(kinds, texts, count);
+        this.lineCount = lineCount;
+        this.relexedTokens = relexedTokens;
+        this.structureReused = functions != null;
+        this.functions = functions != null ? functions : detectFunctions();
+    }
+
+    /**
+     * 完整解析源码
+     */
+    public static SourceModel parse(String text) {
+        TokenBuffer tokens = new TokenBuffer(Math.max(16, text.length() / 4));
+        CLexer lexer = new CLexer(text);
+        Token token;
+        while ((token = lexer.next()) != null) {
+            tokens.add(token);
+        }
+        return new SourceModel(text, countNewlines(text, 0, text.length()) + 1, tokens, null, null, tokens.size);
+    }
+
+    /**
+     * 应用一次编辑：把 [offset, offset + removedLength) 替换为 inserted
+     */
+    public SourceModel applyEdit(int offset, int removedLength, String inserted) {
+        if (offset < 0 || removedLength < 0 || offset + removedLength > text.length()) {
+            throw new IndexOutOfBoundsException("Edit [" + offset + ", " + (offset + removedLength)
+                + ") outside text of length " + text.length());
+        }
+        if (removedLength == 0 && inserted.isEmpty()) {
+            return this;
+        }
+
+        String newText = text.substring(0, offset) + inserted + text.substring(offset + removedLength);
+        int editEnd = offset + removedLength;
+        int insertedEnd = offset + inserted.length();
+        int delta = inserted.length() - removedLength;
+        int lineDelta = countNewlines(inserted, 0, inserted.length()) - countNewlines(text, offset, editEnd);
+
+        // 从编辑点前一个 Token 开始重新切分：相邻 Token 可能合并（- 与 > 变为 ->）
+        int touched = firstEndingAtOrAfter(offset);
+        int restart = Math.max(0, touched - 1);
+        CLexer lexer = touched == 0
+            ? new CLexer(newText)
+            : new CLexer(newText, starts[restart], lines[restart], kinds[restart] == PREPROCESSOR);
+
+        TokenBuffer tokens = new TokenBuffer(count + 16);
+        tokens.addShifted(this, 0, restart, 0, 0);
+
+        int candidate = firstStartingAtOrAfter(editEnd);
+        int resume = count;
+        int relexed = 0;
+        Token token;
+        while ((token = lexer.next()) != null) {
+            relexed++;
+            if (token.getStart() >= insertedEnd) {
+                while (candidate < count && starts[candidate] + delta < token.getStart()) {
+                    candidate++;
+                }
+                if (candidate < count && sameShifted(candidate, token, delta, lineDelta)) {
+                    resume = candidate;
+                    break;
+                }
+            }
+            tokens.add(token);
+        }
+        int middleEnd = tokens.size;
+        tokens.addShifted(this, resume, count - resume, delta, lineDelta);
+
+        int shift = middleEnd - resume;
+        boolean sameBrackets = sameBracketSequence(restart, resume, tokens, middleEnd);
+        int[] newPartners = sameBrackets ? remapPartners(restart, resume, tokens, middleEnd) : null;
+
+        List<Function> newFunctions = null;
+        Function enclosing = sameBrackets ? enclosingFunction(restart, resume) : null;
+        if (enclosing != null) {
+            newFunctions = new ArrayList<>(functions.size());
+            for (Function function : functions) {
+                if (function == enclosing) {
+                    newFunctions.add(new Function(function.name(), function.startLine(),
+                        function.endLine() + lineDelta, function.openBrace(), function.closeBrace() + shift));
+                } else if (function.openBrace() >= resume) {
+                    newFunctions.add(new Function(function.name(), function.startLine() + lineDelta,
+                        function.endLine() + lineDelta, function.openBrace() + shift,
+                        function.closeBrace() < 0 ? -1 : function.closeBrace() + shift));
+                } else {
+                    newFunctions.add(function);
+                }
+            }
+            newFunctions = List.copyOf(newFunctions);
+        }
+
+        return new SourceModel(newText, lineCount + lineDelta, tokens, newPartners, newFunctions, relexed);
+    }
+
+    /**
+     * 按新旧全文的公共前后缀推导单次编辑并增量应用（编辑器保存、autofix 落盘等只知道新内容的场景）
+     */
+    public SourceModel withText(String newText) {
+        if (newText.equals(text)) {
+            return this;
+        }
+        int max = Math.min(text.length(), newText.length());
+        int prefix = 0;
+        while (prefix < max && text.charAt(prefix) == newText.charAt(prefix)) {
+            prefix++;
+        }
+        int suffix = 0;
+        while (suffix < max - prefix
+                && text.charAt(text.length() - 1 - suffix) == newText.charAt(newText.length() - 1 - suffix)) {
+            suffix++;
+        }
+        return applyEdit(prefix, text.length() - prefix - suffix,
+            newText.substring(prefix, newText.length() - suffix));
+    }
+
+    // ===== 查询 =====
+
+    public String getText() {
+        return text;
+    }
+
+    public int getTokenCount() {
+        return count;
+    }
+
+    public Token getToken(int index) {
+        return new Token(KINDS[kinds[index]], texts[index], lines[index], starts[index], ends[index]);
+    }
+
+    /**
+     * 第 index 个 Token 的文本（不构造 Token 对象，供逐 Token 扫描的分析使用）
+     */
+    public String getTokenText(int index) {
+        return texts[index];
+    }
+
+    public CLexer.Kind getTokenKind(int index) {
+        return KINDS[kinds[index]];
+    }
+
+    public int getTokenLine(int index) {
+        return lines[index];
+    }
+
+    /**
+     * 全部 Token（按需构造，供需要 List 的调用方使用）
+     */
+    public List<Token> getTokens() {
+        List<Token> tokens = new ArrayList<>(count);
+        for (int i = 0; i < count; i++) {
+            tokens.add(getToken(i));
+        }
+        return tokens;
+    }
+
+    /**
+     * 与第 index 个 Token 配对的括号下标；不是括号或未配对时返回 -1
+     */
+    public int getMatchingBracket(int index) {
+        return partners[index];
+    }
+
+    public List<Function> getFunctions() {
+        return functions;
+    }
+
+    /**
+     * 包含指定行（1-based）的函数
+     */
+    public Optional<Function> functionAt(int line) {
+        int low = 0;
+        int high = functions.size() - 1;
+        while (low <= high) {
+            int mid = (low + high) >>> 1;
+            Function function = functions.get(mid);
+            if (line < function.startLine()) {
+                high = mid - 1;
+            } else if (line > function.endLine()) {
+                low = mid + 1;
+            } else {
+                return Optional.of(function);
+            }
+        }
+        return Optional.empty();
+    }
+
+    /**
+     * 行数（换行符个数 + 1）
+     */
+    public int getLineCount() {
+        return lineCount;
+    }
+
+    /**
+     * 按行切分的源码，与 Files.readAllLines 一致（去掉行尾 \r，末尾换行不产生空行）
+     */
+    public List<String> getLines() {
+        List<String> result = lineList;
+        if (result == null) {
+            List<String> split = new ArrayList<>(lineCount);
+            int lineStart = 0;
+            while (lineStart < text.length()) {
+                int newline = text.indexOf('\n', lineStart);
+                int lineEnd = newline < 0 ? text.length() : newline;
+                int contentEnd = lineEnd > lineStart && text.charAt(lineEnd - 1) == '\r' ? lineEnd - 1 : lineEnd;
+                split.add(text.substring(lineStart, contentEnd));
+                lineStart = lineEnd + 1;
+            }
+            result = Collections.unmodifiableList(split);
+            lineList = result;
+        }
+        return result;
+    }
+
+    /**
+     * 构建本模型时实际词法分析的 Token 数（完整解析时等于 Token 总数）
+     */
+    public int getRelexedTokenCount() {
+        return relexedTokens;
+    }
+
+    /**
+     * 函数范围是否由上一版本平移复用（未重新运行函数边界识别）
+     */
+    public boolean isStructureReused() {
+        return structureReused;
+    }
+
+    // ===== 增量更新辅助 =====
+
+    private boolean sameShifted(int index, Token token, int delta, int lineDelta) {
+        return starts[index] + delta == token.getStart()
+            && ends[index] + delta == token.getEnd()
+            && lines[index] + lineDelta == token.getLine()
+            && kinds[index] == token.getKind().ordinal()
+            && texts[index].equals(token.getText());
+    }
+
+    private int firstEndingAtOrAfter(int offset) {
+        int low = 0;
+        int high = count;
+        while (low < high) {
+            int mid = (low + high) >>> 1;
+            if (ends[mid] < offset) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    private int firstStartingAtOrAfter(int offset) {
+        int low = 0;
+        int high = count;
+        while (low < high) {
+            int mid = (low + high) >>> 1;
+            if (starts[mid] < offset) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * 旧区间 [from, to) 与新区间 [from, newTo) 的括号序列是否相同
+     */
+    private boolean sameBracketSequence(int from, int to, TokenBuffer tokens, int newTo) {
+        int i = from;
+        int k = from;
+        while (true) {
+            while (i < to && !isBracket(kinds[i], texts[i])) {
+                i++;
+            }
+            while (k < newTo && !isBracket(tokens.kinds[k], tokens.texts[k])) {
+                k++;
+            }
+            if (i == to || k == newTo) {
+                return i == to && k == newTo;
+            }
+            if (!texts[i].equals(tokens.texts[k])) {
+                return false;
+            }
+            i++;
+            k++;
+        }
+    }
+
+    /**
+     * 括号序列不变时，把旧配对表按下标映射到新 Token 序列
+     */
+    private int[] remapPartners(int from, int to, TokenBuffer tokens, int newTo) {
+        int shift = newTo - to;
+        int[] regionMap = new int[to - from];
+        Arrays.fill(regionMap, -1);
+        int k = from;
+        for (int i = from; i < to; i++) {
+            if (isBracket(kinds[i], texts[i])) {
+                while (!isBracket(tokens.kinds[k], tokens.texts[k])) {
+                    k++;
+                }
+                regionMap[i - from] = k++;
+            }
+        }
+
+        int[] result = new int[tokens.size];
+        Arrays.fill(result, from, newTo, -1);
+        for (int i = 0; i < count; i++) {
+            int target = i < from ? i : i >= to ? i + shift : regionMap[i - from];
+            if (target < 0) {
+                continue;
+            }
+            int partner = partners[i];
+            result[target] = partner < 0 ? -1
+                : partner < from ? partner
+                : partner >= to ? partner + shift
+                : regionMap[partner - from];
+        }
+        return result;
+    }
+
+    private Function enclosingFunction(int from, int to) {
+        for (Function function : functions) {
+            if (function.openBrace() < from && function.closeBrace() >= to) {
+                return function;
+            }
+        }
+        return null;
+    }
+
+    private static boolean isBracket(byte kind, String text) {
+        if (kind != PUNCT || text.length() != 1) {
+            return false;
+        }
+        char c = text.charAt(0);
+        return c == '(' || c == ')' || c == '[' || c == ']' || c == '{' || c == '}';
+    }
+
+    private static int[] matchBrackets(byte[] kinds, String[] texts, int count) {
+        int[] partners = new int[count];
+        Arrays.fill(partners, -1);
+        int[] stack = new int[16];
+        int depth = 0;
+        for (int i = 0; i < count; i++) {
+            if (!isBracket(kinds[i], texts[i])) {
+                continue;
+            }
+            char c = texts[i].charAt(0);
+            if (c == '(' || c == '[' || c == '{') {
+                if (depth == stack.length) {
+                    stack = Arrays.copyOf(stack, depth * 2);
+                }
+                stack[depth++] = i;
+            } else if (depth > 0 && texts[stack[depth - 1]].charAt(0) == opener(c)) {
+                int open = stack[--depth];
+                partners[open] = i;
+                partners[i] = open;
+            }
+        }
+        return partners;
+    }
+
+    private static char opener(char closer) {
+        return closer == ')' ? '(' : closer == ']' ? '[' : '{';
+    }
+
+    private List<Function> detectFunctions() {
+        FunctionBoundaryTracker tracker = new FunctionBoundaryTracker();
+        List<Function> result = new ArrayList<>();
+        String name = null;
+        int startLine = 0;
+        int open = -1;
+        for (int i = 0; i < count; i++) {
+            Token token = getToken(i);
+            switch (tracker.accept(token)) {
+                case FUNCTION_START -> {
+                    Token nameToken = tracker.getFunctionNameToken();
+                    name = tracker.getFunctionName();
+                    startLine = nameToken != null ? nameToken.getLine() : token.getLine();
+                    open = i;
+                }
+                case FUNCTION_END -> {
+                    result.add(new Function(name, startLine, lines[i], open, i));
+                    open = -1;
+                }
+                default -> {
+                }
+            }
+        }
+        if (open >= 0) {
+            result.add(new Function(name, startLine, lineCount, open, -1));
+        }
+        return List.copyOf(result);
+    }
+
+    private static int countNewlines(CharSequence s, int from, int to) {
+        int newlines = 0;
+        for (int i = from; i < to; i++) {
+            if (s.charAt(i) == '\n') {
+                newlines++;
+            }
+        }
+        return newlines;
+    }
+
+    /**
+     * 可增长的列式 Token 缓冲
+     */
+    private static final class TokenBuffer {
+        byte[] kinds;
+        String[] texts;
+        int[] starts;
+        int[] ends;
+        int[] lines;
+        int size;
+
+        TokenBuffer(int capacity) {
+            kinds = new byte[capacity];
+            texts = new String[capacity];
+            starts = new int[capacity];
+            ends = new int[capacity];
+            lines = new int[capacity];
+        }
+
+        void add(Token token) {
+            ensure(size + 1);
+            kinds[size] = (byte) token.getKind().ordinal();
+            texts[size] = token.getText();
+            starts[size] = token.getStart();
+            ends[size] = token.getEnd();
+            lines[size] = token.getLine();
+            size++;
+        }
+
+        void addShifted(SourceModel from, int index, int length, int offsetDelta, int lineDelta) {
+            ensure(size + length);
+            System.arraycopy(from.kinds, index, kinds, size, length);
+            System.arraycopy(from.texts, index, texts, size, length);
+            for (int i = 0; i < length; i++) {
+                starts[size + i] = from.starts[index + i] + offsetDelta;
+                ends[size + i] = from.ends[index + i] + offsetDelta;
+                lines[size + i] = from.lines[index + i] + lineDelta;
+            }
+            size += length;
+        }
+
+        private void ensure(int capacity) {
+            if (capacity <= kinds.length) {
+                return;
+            }
+            int grown = Math.max(capacity, kinds.length * 2);
+            kinds = Arrays.copyOf(kinds, grown);
+            texts = Arrays.copyOf(texts, grown);
+            starts = Arrays.copyOf(starts, grown);
+            ends = Arrays.copyOf(ends, grown);
+            lines = Arrays.copyOf(lines, grown);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+package com.harmony.agent.core.parser;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.nio.file.attribute.FileTime;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * 按文件缓存 {@link SourceModel}（线程安全）
+ *
+ * 切片、评分、结构匹配等共享同一份模型。文件变化（修改时间或大小不同）或调用方给出新内容时，
+ * 用 {@link SourceModel#withText} 在旧模型上增量更新，而不是整文件重新解析。
+ * 可按条数限容（最近最少使用者先淘汰），0 表示不限。
+ */
+public class SourceModelCache {
+
+    /** 共享实例默认保留的文件数，堆预算模式下由 CodeSlicer 按预算重设 */
+    private static final int DEFAULT_GLOBAL_ENTRIES = 256;
+    private static final SourceModelCache GLOBAL = new SourceModelCache(DEFAULT_GLOBAL_ENTRIES);
+
+    private record Entry(SourceModel model, FileTime modified, long size) {
+    }
+
+    private final Map<Path, Entry> entries = new LinkedHashMap<>(16, 0.75f, true) {
+        @Override
+        protected boolean removeEldestEntry(Map.Entry<Path, Entry> eldest) {
+            return maxEntries > 0 && size() > maxEntries;
+        }
+    };
+    private volatile int maxEntries; // 0 = unbounded
+
+    private final AtomicLong fullParses = new AtomicLong();
+    private final AtomicLong incrementalUpdates = new AtomicLong();
+
+    public SourceModelCache() {
+        this(0);
+    }
+
+    public SourceModelCache(int maxEntries) {
+        this.maxEntries = Math.max(0, maxEntries);
+    }
+
+    /**
+     * 进程内共享实例
+     */
+    public static SourceModelCache global() {
+        return GLOBAL;
+    }
+
+    /**
+     * 读取文件的结构模型；文件自上次读取后有变化时在旧模型上增量更新
+     */
+    public SourceModel get(Path file) throws IOException {
+        Path key = file.toAbsolutePath().normalize();
+        BasicFileAttributes attributes = Files.readAttributes(key, BasicFileAttributes.class);
+        Entry entry;
+        synchronized (entries) {
+            entry = entries.get(key);
+        }
+        if (entry != null && attributes.lastModifiedTime().equals(entry.modified())
+                && attributes.size() == entry.size()) {
+            return entry.model();
+        }
+        return store(key, entry, Files.readString(key), attributes);
+    }
+
+    /**
+     * 调用方已知文件新内容时（编辑器、autofix 落盘）直接增量更新，不依赖修改时间的精度
+     */
+    public SourceModel update(Path file, String newText) {
+        Path key = file.toAbsolutePath().normalize();
+        BasicFileAttributes attributes;
+        try {
+            attributes = Files.readAttributes(key, BasicFileAttributes.class);
+        } catch (IOException e) {
+            attributes = null;  // 下次 get() 时重新校验
+        }
+        Entry entry;
+        synchronized (entries) {
+            entry = entries.get(key);
+        }
+        return store(key, entry, newText, attributes);
+    }
+
+    private SourceModel store(Path key, Entry previous, String text, BasicFileAttributes attributes) {
+        SourceModel model;
+        if (previous == null) {
+            model = SourceModel.parse(text);
+            fullParses.incrementAndGet();
+        } else {
+            model = previous.model().withText(text);
+            incrementalUpdates.incrementAndGet();
+        }
+        Entry entry = attributes == null
+            ? new Entry(model, null, -1)
+            : new Entry(model, attributes.lastModifiedTime(), attributes.size());
+        synchronized (entries) {
+            entries.put(key, entry);
+        }
+        return model;
+    }
+
+    public void invalidate(Path file) {
+        synchronized (entries) {
+            entries.remove(file.toAbsolutePath().normalize());
+        }
+    }
+
+    public void clear() {
+        synchronized (entries) {
+            entries.clear();
+        }
+    }
+
+    /**
+     * 限定缓存条数（最近最少使用者先淘汰）；0 = 不限
+     */
+    public void setMaxEntries(int maxEntries) {
+        this.maxEntries = Math.max(0, maxEntries);
+        synchronized (entries) {
+            if (this.maxEntries > 0) {
+                Iterator<Path> eldest = entries.keySet().iterator();
+                while (entries.size() > this.maxEntries && eldest.hasNext()) {
+                    eldest.next();
+                    eldest.remove();
+                }
+            }
+        }
+    }
+
+    public int size() {
+        synchronized (entries) {
+            return entries.size();
+        }
+    }
+
+    /**
+     * 完整解析次数
+     */
+    public long getFullParseCount() {
+        return fullParses.get();
+    }
+
+    /**
+     * 在旧模型上增量更新的次数
+     */
+    public long getIncrementalUpdateCount() {
+        return incrementalUpdates.get();
+    }
+}
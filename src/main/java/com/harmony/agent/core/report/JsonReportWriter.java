@@ -2,6 +2,7 @@ package com.harmony.agent.core.report;
 
 import com.google.gson.Gson;
 import com.google.gson.GsonBuilder;
+import com.harmony.agent.core.metrics.JfrEvents;
 import com.harmony.agent.core.model.ScanResult;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -40,12 +41,15 @@ public class JsonReportWriter {
     public void write(ScanResult result, Path outputFile) throws IOException {
         logger.info("Writing JSON report to: {}", outputFile);
 
+        JfrEvents.ReportWrite event = new JfrEvents.ReportWrite();
+        event.begin();
         try (FileWriter writer = new FileWriter(outputFile.toFile())) {
             gson.toJson(result, writer);
             writer.flush();
         }
 
         long fileSize = outputFile.toFile().length();
+        event.finish("json", outputFile.toString(), result.getTotalIssueCount(), fileSize);
         logger.info("JSON report written successfully: {} bytes", fileSize);
         
         if (fileSize == 0) {
@@ -1,5 +1,6 @@
 package com.harmony.agent.core.report;
 
+import com.harmony.agent.core.metrics.JfrEvents;
 import com.harmony.agent.core.model.ScanResult;
 import freemarker.template.Configuration;
 import freemarker.template.Template;
@@ -53,6 +54,9 @@ public class ReportGenerator {
     public void generate(ScanResult result, Path outputFile) throws IOException, TemplateException {
         logger.info("Generating HTML report at: {}", outputFile);
 
+        JfrEvents.ReportWrite event = new JfrEvents.ReportWrite();
+        event.begin();
+
         // 1. Create data model for template
         Map<String, Object> dataModel = createDataModel(result);
 
@@ -63,6 +67,7 @@ public class ReportGenerator {
         try (Writer fileWriter = new FileWriter(outputFile.toFile())) {
             template.process(dataModel, fileWriter);
         }
+        event.finish("html", outputFile.toString(), result.getTotalIssueCount(), outputFile.toFile().length());
 
         logger.info("Report generated successfully: {} issues, {} bytes",
             result.getTotalIssueCount(),
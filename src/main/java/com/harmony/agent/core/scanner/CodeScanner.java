@@ -197,6 +197,152 @@ public class CodeScanner {
         }
     }
 
+    /**
+     * Mixed-language scan: one walk of the tree, with C/C++ and Rust detected per subtree
+     *
+     * Unlike {@link #scanAll()}, the root marker file does not decide the language. C/C++ files
+     * are taken from compile_commands.json when one was given, otherwise from the walk. Each Rust file
+     * is grouped under its Cargo workspace root, or under its crate root when it has no workspace.
+     * Rust files outside any crate are skipped.
+     */
+    public SourceSet scanMixed() throws IOException {
+        if (!Files.exists(basePath)) {
+            throw new IOException("Path does not exist: " + basePath);
+        }
+        if (Files.isRegularFile(basePath)) {
+            return partition(List.of(basePath));
+        }
+
+        logger.info("Starting mixed-language scan of: {}", basePath);
+        List<Path> files = new ArrayList<>();
+        Files.walkFileTree(basePath, new SimpleFileVisitor<Path>() {
+            @Override
+            public FileVisitResult preVisitDirectory(Path dir, BasicFileAttributes attrs) {
+                if (shouldIgnore(dir)) {
+                    logger.debug("Ignoring directory: {}", dir);
+                    return FileVisitResult.SKIP_SUBTREE;
+                }
+                return FileVisitResult.CONTINUE;
+            }
+
+            @Override
+            public FileVisitResult visitFile(Path file, BasicFileAttributes attrs) {
+                if (languageOf(file) != ProjectType.UNKNOWN && !shouldIgnore(file)) {
+                    files.add(file);
+                }
+                return FileVisitResult.CONTINUE;
+            }
+
+            @Override
+            public FileVisitResult visitFileFailed(Path file, IOException exc) {
+                logger.warn("Failed to visit file: {}", file, exc);
+                return FileVisitResult.CONTINUE;
+            }
+        });
+
+        if (compileCommandsParser != null) {
+            // compile_commands.json is authoritative for C/C++; the walk still supplies Rust crates
+            files.removeIf(file -> languageOf(file) == ProjectType.C_CPP);
+            files.addAll(compileCommandsParser.getSourceFiles());
+        }
+        return partition(files);
+    }
+
+    /**
+     * Mixed-language variant of {@link #scanIncremental()}
+     */
+    public SourceSet scanMixedIncremental() throws IOException {
+        if (!isGitRepository()) {
+            logger.warn("Not a git repository, falling back to full mixed-language scan");
+            return scanMixed();
+        }
+        try {
+            List<Path> changed = getGitChangedFiles().stream()
+                .filter(path -> languageOf(path) != ProjectType.UNKNOWN)
+                .filter(path -> !shouldIgnore(path))
+                .collect(Collectors.toList());
+            return partition(changed);
+        } catch (IOException e) {
+            logger.error("Failed to get git changes, falling back to full mixed-language scan", e);
+            return scanMixed();
+        }
+    }
+
+    private SourceSet partition(List<Path> files) {
+        SourceSet sources = new SourceSet();
+        Map<Path, Optional<Path>> workspaceCache = new HashMap<>();
+        for (Path file : files) {
+            ProjectType language = languageOf(file);
+            if (language == ProjectType.C_CPP) {
+                sources.cFiles.add(file);
+            } else if (language == ProjectType.RUST) {
+                Optional<Path> workspace = cargoWorkspace(file.toAbsolutePath().getParent(), workspaceCache);
+                if (workspace.isPresent()) {
+                    sources.rustWorkspaces.computeIfAbsent(workspace.get(), k -> new ArrayList<>()).add(file);
+                } else {
+                    logger.debug("Skipping Rust file outside any Cargo crate: {}", file);
+                }
+            }
+        }
+        logger.info("Mixed-language scan: {} C/C++ files, {} Rust files in {} Cargo workspace(s)",
+            sources.cFiles.size(), sources.getRustFileCount(), sources.rustWorkspaces.size());
+        return sources;
+    }
+
+    /**
+     * Language of a single file in mixed mode (C/C++ or Rust; anything else is UNKNOWN)
+     */
+    private static ProjectType languageOf(Path file) {
+        String fileName = file.getFileName().toString().toLowerCase();
+        if (RUST_EXTENSIONS.stream().anyMatch(fileName::endsWith)) {
+            return ProjectType.RUST;
+        }
+        if (C_CPP_EXTENSIONS.stream().anyMatch(fileName::endsWith)) {
+            return ProjectType.C_CPP;
+        }
+        return ProjectType.UNKNOWN;
+    }
+
+    /**
+     * Cargo root that owns a directory: the enclosing [workspace] manifest if there is one,
+     * otherwise the nearest Cargo.toml. Results are memoized per directory for the scan.
+     */
+    private Optional<Path> cargoWorkspace(Path dir, Map<Path, Optional<Path>> cache) {
+        if (dir == null) {
+            return Optional.empty();
+        }
+        Optional<Path> cached = cache.get(dir);
+        if (cached != null) {
+            return cached;
+        }
+
+        Optional<Path> enclosing = cargoWorkspace(dir.getParent(), cache);
+        Optional<Path> result;
+        if (enclosing.isPresent() && isCargoWorkspace(enclosing.get())) {
+            result = enclosing;
+        } else if (Files.isRegularFile(dir.resolve("Cargo.toml"))) {
+            result = Optional.of(dir);
+        } else {
+            result = enclosing;
+        }
+        cache.put(dir, result);
+        return result;
+    }
+
+    private static boolean isCargoWorkspace(Path cargoRoot) {
+        try (BufferedReader reader = Files.newBufferedReader(cargoRoot.resolve("Cargo.toml"))) {
+            String line;
+            while ((line = reader.readLine()) != null) {
+                if (line.trim().equals("[workspace]")) {
+                    return true;
+                }
+            }
+        } catch (IOException e) {
+            logger.debug("Failed to read {}/Cargo.toml: {}", cargoRoot, e.getMessage());
+        }
+        return false;
+    }
+
     /**
      * Check if file is a supported file based on project type
      */
@@ -377,6 +523,13 @@ public class CodeScanner {
         return projectType;
     }
 
+    /**
+     * Get the compile_commands.json parser (null when file discovery uses the filesystem)
+     */
+    public CompileCommandsParser getCompileCommands() {
+        return compileCommandsParser;
+    }
+
     /**
      * Get statistics about the codebase
      */
@@ -415,6 +568,32 @@ public class CodeScanner {
         }
     }
 
+    /**
+     * Result of a mixed-language scan: C/C++ files plus Rust files grouped by Cargo workspace root
+     */
+    public static class SourceSet {
+        private final List<Path> cFiles = new ArrayList<>();
+        private final Map<Path, List<Path>> rustWorkspaces = new LinkedHashMap<>();
+
+        public List<Path> getCFiles() {
+            return cFiles;
+        }
+
+        public Map<Path, List<Path>> getRustWorkspaces() {
+            return rustWorkspaces;
+        }
+
+        public int getRustFileCount() {
+            return rustWorkspaces.values().stream().mapToInt(List::size).sum();
+        }
+
+        public List<Path> getAllFiles() {
+            List<Path> all = new ArrayList<>(cFiles);
+            rustWorkspaces.values().forEach(all::addAll);
+            return all;
+        }
+    }
+
     /**
      * Scan statistics
      */
@@ -160,6 +160,37 @@ public class UnifiedIssueStore {
                      .collect(Collectors.toList());
     }
 
+    /**
+     * 获取已索引的文件路径
+     *
+     * @return 至少有一个问题的文件路径集合
+     */
+    public Set<String> getIndexedFiles() {
+        return new HashSet<>(fileIndex.keySet());
+    }
+
+    /**
+     * 按文件分组导出全部问题（基于文件索引，不遍历问题表）
+     *
+     * 用于 StrategicAnalysisCommand：直接基于已有分析结果进行评分和分诊
+     *
+     * @return 文件路径 -> 问题列表
+     */
+    public synchronized Map<String, List<SecurityIssue>> getIssuesByFileIndex() {
+        Map<String, List<SecurityIssue>> result = new HashMap<>(fileIndex.size() * 2);
+        for (Map.Entry<String, List<String>> entry : fileIndex.entrySet()) {
+            List<SecurityIssue> fileIssues = new ArrayList<>(entry.getValue().size());
+            for (String hash : entry.getValue()) {
+                SecurityIssue issue = issues.get(hash);
+                if (issue != null) {
+                    fileIssues.add(issue);
+                }
+            }
+            result.put(entry.getKey(), fileIssues);
+        }
+        return result;
+    }
+
     /**
      * 按行号范围查询问题
      *
@@ -215,6 +215,14 @@ public class LLMClient {
      * Check if LLM is configured and available
      */
     public boolean isAvailable() {
+        return hasConfiguredProvider(configManager);
+    }
+
+    /**
+     * Check whether any LLM API key is configured, without building the orchestrator
+     * (used for cheap status display before the client is created)
+     */
+    public static boolean hasConfiguredProvider(ConfigManager configManager) {
         // Check environment variables first
         String openaiKey = System.getenv("OPENAI_API_KEY");
         String claudeKey = System.getenv("CLAUDE_API_KEY");
@@ -12,6 +12,8 @@ public class LLMRequest {
     private final double temperature;
     private final int maxTokens;
     private final boolean stream;
+    private final String jsonSchemaName;
+    private final String jsonSchema;
 
     private LLMRequest(Builder builder) {
         this.messages = builder.messages;
@@ -19,6 +21,8 @@ public class LLMRequest {
         this.temperature = builder.temperature;
         this.maxTokens = builder.maxTokens;
         this.stream = builder.stream;
+        this.jsonSchemaName = builder.jsonSchemaName;
+        this.jsonSchema = builder.jsonSchema;
     }
 
     public List<Message> getMessages() {
@@ -41,12 +45,32 @@ public class LLMRequest {
         return stream;
     }
 
+    /**
+     * Name of the JSON schema the response must follow, or null for free-form output
+     */
+    public String getJsonSchemaName() {
+        return jsonSchemaName;
+    }
+
+    /**
+     * JSON schema (as JSON text) the response must follow, or null for free-form output
+     */
+    public String getJsonSchema() {
+        return jsonSchema;
+    }
+
+    public boolean hasJsonSchema() {
+        return jsonSchema != null;
+    }
+
     public static class Builder {
         private List<Message> messages = new ArrayList<>();
         private String model = "gpt-3.5-turbo";
         private double temperature = 0.7;
         private int maxTokens = 2000;
         private boolean stream = false;
+        private String jsonSchemaName;
+        private String jsonSchema;
 
         public Builder messages(List<Message> messages) {
             this.messages = new ArrayList<>(messages);
@@ -88,6 +112,16 @@ public class LLMRequest {
             return this;
         }
 
+        /**
+         * Ask for a response matching the schema; providers that support structured output
+         * constrain generation to it, others ignore it
+         */
+        public Builder jsonSchema(String name, String schema) {
+            this.jsonSchemaName = name;
+            this.jsonSchema = schema;
+            return this;
+        }
+
         public LLMRequest build() {
             return new LLMRequest(this);
         }
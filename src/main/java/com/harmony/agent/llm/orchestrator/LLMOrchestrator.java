@@ -24,11 +24,12 @@ import java.util.Map;
  */
 public class LLMOrchestrator {
     private static final Logger logger = LoggerFactory.getLogger(LLMOrchestrator.class);
+    private static final long MCP_TOOLS_WAIT_MS = 3_000;
 
     private final ProviderFactory providerFactory;
     private final RoleFactory roleFactory;
     private final Map<String, RoleConfig> roleConfigs;
-    private final AIMemoryManager aiMemoryManager;
+    private volatile AIMemoryManager aiMemoryManager;  // 首次使用时创建（打开持久化缓存目录）
     private final List<ToolDefinition> toolDefinitions;
     private final MCPClientManager mcpClientManager;
     private ToolConfirmationCallback confirmationCallback;  // 工具执行确认回调
@@ -37,21 +38,17 @@ public class LLMOrchestrator {
         this.providerFactory = providerFactory;
         this.roleFactory = roleFactory;
         this.roleConfigs = new HashMap<>();
-        this.aiMemoryManager = new AIMemoryManager();
         this.toolDefinitions = new ArrayList<>();
         this.mcpClientManager = new MCPClientManager();
 
         // 初始化工具定义
         initializeToolDefinitions();
 
-        // 尝试加载 MCP 配置
+        // 尝试加载 MCP 配置（后台连接，不阻塞启动）
         initializeMCPClients();
 
-        int totalTools = toolDefinitions.size() + mcpClientManager.getAllMcpTools().size();
-        logger.info("LLMOrchestrator initialized: {} 本地工具 + {} MCP 工具 = {} 总工具",
-            toolDefinitions.size(),
-            mcpClientManager.getAllMcpTools().size(),
-            totalTools);
+        logger.info("LLMOrchestrator initialized: {} 本地工具 (MCP 工具后台加载中)",
+            toolDefinitions.size());
     }
 
     /**
@@ -65,15 +62,14 @@ public class LLMOrchestrator {
 
     /**
      * 初始化 MCP 客户端
-     * 尝试从 mcp-config.json 加载配置并连接到 MCP 服务
+     * 尝试从 mcp-config.json 加载配置，在后台并行连接到 MCP 服务
      * 如果配置文件不存在或连接失败，记录警告但继续运行
      */
     private void initializeMCPClients() {
         String configPath = "mcp-config.json";
         try {
-            mcpClientManager.loadFromConfig(configPath);
-            logger.info("✅ MCP 客户端已初始化");
-            logger.info(mcpClientManager.getStatistics());
+            mcpClientManager.connectInBackground(configPath)
+                .thenRun(() -> logger.info(mcpClientManager.getStatistics()));
         } catch (java.io.FileNotFoundException e) {
             logger.info("ℹ️ MCP 配置文件不存在: {} (将仅使用本地工具)", configPath);
         } catch (Exception e) {
@@ -588,6 +584,10 @@ public class LLMOrchestrator {
      * @return 工具定义列表，用于声明给 LLM
      */
     public List<ToolDefinition> getToolDefinitions() {
+        // 首次对话时 MCP 服务可能仍在连接，短暂等待以便工具完整声明
+        if (mcpClientManager.isConnecting()) {
+            mcpClientManager.awaitConnections(MCP_TOOLS_WAIT_MS);
+        }
         List<ToolDefinition> allTools = new ArrayList<>(toolDefinitions);
         // 添加 MCP 工具定义
         allTools.addAll(mcpClientManager.getAllMcpTools().values());
@@ -627,7 +627,7 @@ public class LLMOrchestrator {
             }
 
             // 将结果存入 AI 记忆
-            aiMemoryManager.rememberToolResult(call.getName(), toolResult);
+            getAIMemoryManager().rememberToolResult(call.getName(), toolResult);
 
             // 添加到结果集
             if (results.length() > 0) {
@@ -783,7 +783,7 @@ public class LLMOrchestrator {
             // 使用 Java NIO 读取文件
             String content = java.nio.file.Files.readString(java.nio.file.Paths.get(path));
             // 存储文件内容到记忆，用于后续 Prompt 注入
-            aiMemoryManager.rememberFile(path, content);
+            getAIMemoryManager().rememberFile(path, content);
             logger.info("✅ 成功读取文件: {}", path);
             return content;
         } catch (java.nio.file.NoSuchFileException e) {
@@ -861,7 +861,7 @@ public class LLMOrchestrator {
                 });
 
             // 存储搜索结果到记忆
-            aiMemoryManager.rememberSearchResult(keyword, results.toString());
+            getAIMemoryManager().rememberSearchResult(keyword, results.toString());
             logger.info("✅ 搜索完成: {} 在 {}", keyword, directory);
             return results.toString();
         } catch (Exception e) {
@@ -949,7 +949,7 @@ public class LLMOrchestrator {
             }
 
             // 存储 grep 结果到记忆
-            aiMemoryManager.rememberSearchResult(pattern + ":" + filepath, result.toString());
+            getAIMemoryManager().rememberSearchResult(pattern + ":" + filepath, result.toString());
             logger.info("✅ Grep 搜索完成: {} 在 {}", pattern, filepath);
             return result.toString();
         } catch (Exception e) {
@@ -1705,7 +1705,17 @@ public class LLMOrchestrator {
      * Get AI Memory Manager for storing/retrieving memories
      */
     public AIMemoryManager getAIMemoryManager() {
-        return aiMemoryManager;
+        AIMemoryManager manager = aiMemoryManager;
+        if (manager == null) {
+            synchronized (this) {
+                manager = aiMemoryManager;
+                if (manager == null) {
+                    manager = new AIMemoryManager();
+                    aiMemoryManager = manager;
+                }
+            }
+        }
+        return manager;
     }
 
     /**
@@ -1,12 +1,20 @@
 package com.harmony.agent.llm.provider;
 
 import com.google.common.util.concurrent.RateLimiter;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParser;
+import com.harmony.agent.core.metrics.JfrEvents;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.llm.model.LLMRequest;
 import com.harmony.agent.llm.model.LLMResponse;
 import com.harmony.agent.llm.model.Message;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.regex.Pattern;
+
 /**
  * Base implementation for LLM providers
  * Provides common functionality for all providers including rate limiting
@@ -22,6 +30,13 @@ public abstract class BaseLLMProvider implements LLMProvider {
     private static String rateLimitMode = "qps";
     private static boolean rateLimiterEnabled = false;
 
+    // Error body naming the structured output parameters; a bare 400 can be any bad request
+    private static final Pattern STRUCTURED_OUTPUT_REJECTED =
+        Pattern.compile("response_format|json_schema", Pattern.CASE_INSENSITIVE);
+
+    // Models whose endpoint rejected response_format; their requests go out without it
+    private final Set<String> structuredOutputRejected = ConcurrentHashMap.newKeySet();
+
     protected BaseLLMProvider(String apiKey, String baseUrl) {
         this.apiKey = apiKey;
         this.baseUrl = baseUrl;
@@ -98,6 +113,46 @@ public abstract class BaseLLMProvider implements LLMProvider {
         return false;
     }
 
+    /**
+     * OpenAI-compatible response_format for a request carrying a JSON schema
+     *
+     * @param request LLM request
+     * @param schemaSupported true to send the schema itself (json_schema, strict), false to only
+     *                        request JSON mode (json_object) and rely on the prompt for the shape
+     * @return response_format object, or null if the request has no schema or the model rejected it
+     */
+    protected JsonObject responseFormat(LLMRequest request, boolean schemaSupported) {
+        if (!request.hasJsonSchema() || structuredOutputRejected.contains(request.getModel())) {
+            return null;
+        }
+        JsonObject format = new JsonObject();
+        if (!schemaSupported) {
+            format.addProperty("type", "json_object");
+            return format;
+        }
+        JsonObject jsonSchema = new JsonObject();
+        jsonSchema.addProperty("name", request.getJsonSchemaName() != null ? request.getJsonSchemaName() : "response");
+        jsonSchema.addProperty("strict", true);
+        jsonSchema.add("schema", JsonParser.parseString(request.getJsonSchema()));
+        format.addProperty("type", "json_schema");
+        format.add("json_schema", jsonSchema);
+        return format;
+    }
+
+    /**
+     * A schema-constrained request failed with an error naming response_format or json_schema,
+     * so the model does not support it; remember that so the retry (and later requests) go out
+     * as plain text. Other failures (context length, bad parameters) are returned as they are.
+     */
+    private boolean rejectedStructuredOutput(LLMRequest request, LLMResponse response) {
+        if (!request.hasJsonSchema() || response == null || response.isSuccess()
+                || response.getErrorMessage() == null
+                || !STRUCTURED_OUTPUT_REJECTED.matcher(response.getErrorMessage()).find()) {
+            return false;
+        }
+        return structuredOutputRejected.add(request.getModel());
+    }
+
     /**
      * Send HTTP request to LLM API
      * @param request LLM request
@@ -119,28 +174,78 @@ public abstract class BaseLLMProvider implements LLMProvider {
                 .build();
         }
 
-        // Apply rate limiting
-        if (rateLimiterEnabled && rateLimiter != null) {
-            if ("tpm".equalsIgnoreCase(rateLimitMode)) {
-                // TPM mode: acquire permits based on estimated tokens
-                int estimatedTokens = estimateTokens(request);
-                logger.debug("Acquiring {} tokens from rate limiter (estimated)", estimatedTokens);
-                rateLimiter.acquire(estimatedTokens);
-            } else {
-                // QPS mode: acquire 1 permit per request
-                logger.debug("Acquiring 1 permit from rate limiter (QPS mode)");
-                rateLimiter.acquire();
-            }
-        }
+        MetricsRegistry metrics = MetricsRegistry.global();
+        String provider = getProviderName();
 
+        // Apply rate limiting
+        acquireRateLimit(request, metrics, provider);
+
+        MetricsRegistry.Gauge inFlight = metrics.gauge("harmony_llm_requests_in_flight",
+            "LLM HTTP requests currently in flight", "provider", provider);
+        JfrEvents.LlmRequest requestEvent = new JfrEvents.LlmRequest();
+        requestEvent.begin();
+        long start = System.nanoTime();
+        inFlight.inc();
+        LLMResponse response;
         try {
-            logger.debug("Sending request to {} with model {}", getProviderName(), request.getModel());
-            return sendHttpRequest(request);
+            logger.debug("Sending request to {} with model {}", provider, request.getModel());
+            response = sendHttpRequest(request);
+            if (rejectedStructuredOutput(request, response)) {
+                logger.warn("{} rejected response_format for model {}, retrying without structured output",
+                    provider, request.getModel());
+                metrics.counter("harmony_llm_structured_output_fallbacks",
+                    "Requests resent without response_format after the model rejected it",
+                    "provider", provider).inc();
+                // The retry is another request against the shared quota
+                acquireRateLimit(request, metrics, provider);
+                response = sendHttpRequest(request);
+            }
         } catch (Exception e) {
-            logger.error("Failed to send request to " + getProviderName(), e);
-            return LLMResponse.builder()
+            logger.error("Failed to send request to " + provider, e);
+            response = LLMResponse.builder()
                 .errorMessage("Failed to send request: " + e.getMessage())
                 .build();
+        } finally {
+            inFlight.dec();
+        }
+
+        boolean success = response != null && response.isSuccess();
+        requestEvent.finish(provider, request.getModel(),
+            response != null ? response.getPromptTokens() : 0,
+            response != null ? response.getCompletionTokens() : 0, success);
+
+        metrics.summary("harmony_llm_request_duration_seconds",
+            "LLM HTTP request latency", "provider", provider).observeSince(start);
+        metrics.counter("harmony_llm_requests", "LLM requests by outcome",
+            "provider", provider, "outcome", success ? "success" : "error").inc();
+        return response;
+    }
+
+    /**
+     * Block on the shared rate limiter before one HTTP request (1 permit in QPS mode,
+     * the estimated token count in TPM mode)
+     */
+    private void acquireRateLimit(LLMRequest request, MetricsRegistry metrics, String provider) {
+        if (!rateLimiterEnabled || rateLimiter == null) {
+            return;
+        }
+        JfrEvents.RateLimitWait waitEvent = new JfrEvents.RateLimitWait();
+        waitEvent.begin();
+        double waitedSeconds;
+        int permits;
+        if ("tpm".equalsIgnoreCase(rateLimitMode)) {
+            // TPM mode: acquire permits based on estimated tokens
+            permits = estimateTokens(request);
+            logger.debug("Acquiring {} tokens from rate limiter (estimated)", permits);
+            waitedSeconds = rateLimiter.acquire(permits);
+        } else {
+            // QPS mode: acquire 1 permit per request
+            permits = 1;
+            logger.debug("Acquiring 1 permit from rate limiter (QPS mode)");
+            waitedSeconds = rateLimiter.acquire();
         }
+        waitEvent.finish(provider, rateLimitMode, permits);
+        metrics.summary("harmony_llm_rate_limiter_wait_seconds",
+            "Time spent waiting for the LLM rate limiter", "provider", provider).observe(waitedSeconds);
     }
 }
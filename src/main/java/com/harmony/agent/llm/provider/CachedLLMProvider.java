@@ -117,8 +117,10 @@ public class CachedLLMProvider implements LLMProvider {
      * 不考虑的因素：
      * - maxTokens：不影响 LLM 的核心输出逻辑
      * - stream：与结果无关
+     *
+     * 包级可见：供 benchmarks 模块直接测量
      */
-    private String generateCacheKey(LLMRequest request) {
+    String generateCacheKey(LLMRequest request) {
         StringBuilder keyContent = new StringBuilder();
 
         // Model
@@ -139,6 +141,11 @@ public class CachedLLMProvider implements LLMProvider {
             .toList();
         keyContent.append("user=").append(hashMessages(userMessages));
 
+        // Response schema (只在有 schema 时加入，保持旧缓存键不变)
+        if (request.hasJsonSchema()) {
+            keyContent.append("|schema=").append(hashSHA256(request.getJsonSchema()));
+        }
+
         // SHA-256 哈希
         return hashSHA256(keyContent.toString());
     }
@@ -90,6 +90,12 @@ public class NHHProvider extends BaseLLMProvider {
             }
             requestBody.add("messages", messagesArray);
 
+            // Structured output: constrain generation to the request schema
+            JsonObject responseFormat = responseFormat(request, true);
+            if (responseFormat != null) {
+                requestBody.add("response_format", responseFormat);
+            }
+
             // Build HTTP request
             String url = baseUrl.endsWith("/v1") ? baseUrl + "/chat/completions" : baseUrl + "/v1/chat/completions";
             RequestBody body = RequestBody.create(gson.toJson(requestBody), JSON);
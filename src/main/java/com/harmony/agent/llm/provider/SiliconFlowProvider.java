@@ -96,6 +96,12 @@ public class SiliconFlowProvider extends BaseLLMProvider {
             }
             requestBody.add("messages", messagesArray);
 
+            // SiliconFlow only guarantees JSON mode; the prompt carries the shape
+            JsonObject responseFormat = responseFormat(request, false);
+            if (responseFormat != null) {
+                requestBody.add("response_format", responseFormat);
+            }
+
             // Build HTTP request
             String url = baseUrl + "/chat/completions";
             RequestBody body = RequestBody.create(gson.toJson(requestBody), JSON);
@@ -2,6 +2,7 @@ package com.harmony.agent.mcp;
 
 import com.google.gson.Gson;
 import com.google.gson.JsonObject;
+import com.harmony.agent.core.metrics.MetricsRegistry;
 import com.harmony.agent.llm.model.ToolDefinition;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -208,6 +209,26 @@ public class MCPClient {
      * 调用远程工具
      */
     public synchronized String callTool(String toolName, Map<String, Object> arguments) throws Exception {
+        MetricsRegistry metrics = MetricsRegistry.global();
+        MetricsRegistry.Gauge inFlight = metrics.gauge("harmony_mcp_calls_in_flight",
+            "MCP tool calls currently in flight", "service", serviceName);
+        long start = System.nanoTime();
+        String outcome = "error";
+        inFlight.inc();
+        try {
+            String result = invokeTool(toolName, arguments);
+            outcome = "success";
+            return result;
+        } finally {
+            inFlight.dec();
+            metrics.summary("harmony_mcp_call_duration_seconds",
+                "MCP tool call latency", "service", serviceName).observeSince(start);
+            metrics.counter("harmony_mcp_calls", "MCP tool calls by outcome",
+                "service", serviceName, "outcome", outcome).inc();
+        }
+    }
+
+    private String invokeTool(String toolName, Map<String, Object> arguments) throws Exception {
         if (!initialized) {
             throw new IllegalStateException("MCP 客户端未初始化，请先调用 connect()");
         }
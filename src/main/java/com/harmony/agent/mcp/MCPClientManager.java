@@ -1,7 +1,6 @@
 package com.harmony.agent.mcp;
 
 import com.google.gson.Gson;
-import com.google.gson.JsonArray;
 import com.google.gson.JsonObject;
 import com.harmony.agent.llm.model.ToolDefinition;
 import org.slf4j.Logger;
@@ -12,6 +11,14 @@ import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
 import java.nio.file.Paths;
 import java.util.*;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
 
 /**
  * MCP 客户端管理器
@@ -34,16 +41,131 @@ public class MCPClientManager {
     private static final Logger logger = LoggerFactory.getLogger(MCPClientManager.class);
     private static final Gson gson = new Gson();
 
-    private final Map<String, MCPClient> clients = new HashMap<>();
-    private final Map<String, ToolDefinition> allMcpTools = new HashMap<>();
-    private final List<String> clientOrder = new ArrayList<>(); // 记录客户端加载顺序，用于工具冲突检测
+    /**
+     * 调用尚未就绪的工具时等待后台连接的最长时间
+     */
+    private static final long TOOL_CALL_WAIT_MS = 10_000;
+
+    private final Map<String, MCPClient> clients = new ConcurrentHashMap<>();
+    private final Map<String, ToolDefinition> allMcpTools = new ConcurrentHashMap<>();
+    private final List<String> clientOrder = new CopyOnWriteArrayList<>(); // 记录客户端加载顺序，用于工具冲突检测
+
+    private volatile CompletableFuture<Void> pendingConnections = CompletableFuture.completedFuture(null);
 
     /**
-     * 从 JSON 配置文件初始化所有 MCP 客户端
+     * disconnectAll 之后置位：此后才完成连接的客户端不再注册，而是立即断开
+     */
+    private volatile boolean closed;
+
+    /**
+     * 从 JSON 配置文件初始化所有 MCP 客户端（同步连接）
      *
      * @param configPath 配置文件路径
      */
     public void loadFromConfig(String configPath) throws Exception {
+        for (JsonObject serverObj : readServerConfigs(configPath)) {
+            initializeClient(serverObj);
+        }
+
+        logger.info("✅ 已加载 {} 个 MCP 服务，共 {} 个工具",
+            clients.size(), allMcpTools.size());
+    }
+
+    /**
+     * 在后台并行连接配置中的所有 MCP 服务，立即返回
+     *
+     * 配置文件本身同步读取（缺失或格式错误时立即抛出），连接在守护线程上进行；
+     * 单个服务连接失败只记录警告，不影响其他服务。
+     * 工具在各自服务连接成功后陆续可见，调用未就绪的工具时会等待连接完成。
+     *
+     * @param configPath 配置文件路径
+     * @return 所有连接尝试结束时完成的 Future
+     */
+    public CompletableFuture<Void> connectInBackground(String configPath) throws Exception {
+        List<JsonObject> servers = readServerConfigs(configPath);
+        if (servers.isEmpty()) {
+            return pendingConnections;
+        }
+
+        ExecutorService connector = Executors.newFixedThreadPool(Math.min(servers.size(), 8), r -> {
+            Thread thread = new Thread(r, "mcp-connect");
+            thread.setDaemon(true);
+            return thread;
+        });
+
+        List<CompletableFuture<Void>> futures = new ArrayList<>();
+        for (JsonObject serverObj : servers) {
+            futures.add(CompletableFuture.runAsync(() -> {
+                try {
+                    initializeClient(serverObj);
+                } catch (Exception e) {
+                    // initializeClient 已记录错误
+                }
+            }, connector));
+        }
+
+        pendingConnections = CompletableFuture.allOf(futures.toArray(new CompletableFuture[0]))
+            .whenComplete((ignored, error) -> {
+                connector.shutdown();
+                restoreConfigOrder(servers);
+                logger.info("✅ 后台连接完成: {} 个 MCP 服务，共 {} 个工具",
+                    clients.size(), allMcpTools.size());
+            });
+        logger.info("🔌 正在后台连接 {} 个 MCP 服务", servers.size());
+        return pendingConnections;
+    }
+
+    /**
+     * 是否仍有后台连接未完成
+     */
+    public boolean isConnecting() {
+        return !pendingConnections.isDone();
+    }
+
+    /**
+     * 等待后台连接完成
+     *
+     * @return 在超时前全部完成返回 true
+     */
+    public boolean awaitConnections(long timeoutMillis) {
+        try {
+            pendingConnections.get(timeoutMillis, TimeUnit.MILLISECONDS);
+            return true;
+        } catch (TimeoutException e) {
+            return false;
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return false;
+        } catch (ExecutionException e) {
+            return true;
+        }
+    }
+
+    /**
+     * 并行连接完成顺序不确定：按配置顺序重建工具索引，保证工具冲突时的优先级与同步加载一致
+     */
+    private synchronized void restoreConfigOrder(List<JsonObject> servers) {
+        List<String> ordered = new ArrayList<>();
+        for (JsonObject server : servers) {
+            String name = server.get("name").getAsString();
+            if (clients.containsKey(name)) {
+                ordered.add(name);
+            }
+        }
+        clientOrder.clear();
+        clientOrder.addAll(ordered);
+
+        Map<String, ToolDefinition> tools = new LinkedHashMap<>();
+        for (String name : ordered) {
+            for (var tool : clients.get(name).getTools().values()) {
+                tools.putIfAbsent(tool.getName(), tool);
+            }
+        }
+        allMcpTools.keySet().retainAll(tools.keySet());
+        allMcpTools.putAll(tools);
+    }
+
+    private List<JsonObject> readServerConfigs(String configPath) throws Exception {
         logger.info("📋 加载 MCP 配置文件: {}", configPath);
 
         File configFile = new File(configPath);
@@ -58,15 +180,11 @@ public class MCPClientManager {
             throw new IllegalArgumentException("配置文件缺少 'mcpServers' 字段");
         }
 
-        JsonArray serversArray = config.getAsJsonArray("mcpServers");
-
-        for (var serverElement : serversArray) {
-            var serverObj = serverElement.getAsJsonObject();
-            initializeClient(serverObj);
+        List<JsonObject> servers = new ArrayList<>();
+        for (var serverElement : config.getAsJsonArray("mcpServers")) {
+            servers.add(serverElement.getAsJsonObject());
         }
-
-        logger.info("✅ 已加载 {} 个 MCP 服务，共 {} 个工具",
-            clients.size(), allMcpTools.size());
+        return servers;
     }
 
     /**
@@ -98,21 +216,29 @@ public class MCPClientManager {
         }
 
         try {
-            // 连接到 MCP 服务
+            // 连接到 MCP 服务（后台模式下多个服务并行连接）
             client.connect();
 
-            // 注册客户端和其工具
-            clients.put(serverName, client);
-            clientOrder.add(serverName);
-
-            // 将该客户端的工具添加到全局工具映射，并检测冲突
-            for (var tool : client.getTools().values()) {
-                if (allMcpTools.containsKey(tool.getName())) {
-                    logger.warn("⚠️ 工具冲突: {} (来自 {} 和 {})",
-                        tool.getName(), serverName,
-                        findToolOwner(tool.getName()));
-                } else {
-                    allMcpTools.put(tool.getName(), tool);
+            // 注册客户端和其工具（串行化，保证冲突检测一致）
+            synchronized (this) {
+                if (closed) {
+                    // 连接期间管理器已关闭：断开刚建立的连接，避免 stdio 服务进程残留
+                    logger.info("关闭后完成连接，立即断开: {}", serverName);
+                    disconnectQuietly(client);
+                    return;
+                }
+                clients.put(serverName, client);
+                clientOrder.add(serverName);
+
+                // 将该客户端的工具添加到全局工具映射，并检测冲突
+                for (var tool : client.getTools().values()) {
+                    if (allMcpTools.containsKey(tool.getName())) {
+                        logger.warn("⚠️ 工具冲突: {} (来自 {} 和 {})",
+                            tool.getName(), serverName,
+                            findToolOwner(tool.getName()));
+                    } else {
+                        allMcpTools.put(tool.getName(), tool);
+                    }
                 }
             }
 
@@ -160,6 +286,9 @@ public class MCPClientManager {
      * @return 工具执行结果
      */
     public String callMcpTool(String toolName, Map<String, Object> arguments) throws Exception {
+        if (!isMcpTool(toolName) && isConnecting()) {
+            awaitConnections(TOOL_CALL_WAIT_MS);
+        }
         if (!isMcpTool(toolName)) {
             throw new IllegalArgumentException("工具不是 MCP 工具: " + toolName);
         }
@@ -194,26 +323,38 @@ public class MCPClientManager {
      * 断开所有 MCP 连接
      */
     public void disconnectAll() {
-        for (MCPClient client : clients.values()) {
-            try {
-                client.disconnect();
-            } catch (Exception e) {
-                logger.warn("⚠️ 断开连接时出错: {}", e.getMessage());
-            }
+        pendingConnections.cancel(false);
+        List<MCPClient> connected;
+        synchronized (this) {
+            // 取消不会中断已在进行的连接；由 closed 标记让它们完成后自行断开
+            closed = true;
+            connected = new ArrayList<>(clients.values());
+            clients.clear();
+            allMcpTools.clear();
+            clientOrder.clear();
+        }
+        for (MCPClient client : connected) {
+            disconnectQuietly(client);
         }
-        clients.clear();
-        allMcpTools.clear();
-        clientOrder.clear();
         logger.info("✅ 所有 MCP 连接已断开");
     }
 
+    private static void disconnectQuietly(MCPClient client) {
+        try {
+            client.disconnect();
+        } catch (Exception e) {
+            logger.warn("⚠️ 断开连接时出错: {}", e.getMessage());
+        }
+    }
+
     /**
      * 获取统计信息
      */
     public String getStatistics() {
         StringBuilder sb = new StringBuilder();
         sb.append("MCP 客户端统计:\n");
-        sb.append("  - 已连接客户端: ").append(clients.size()).append("\n");
+        sb.append("  - 已连接客户端: ").append(clients.size())
+            .append(isConnecting() ? " (后台连接中)" : "").append("\n");
         sb.append("  - 总工具数: ").append(allMcpTools.size()).append("\n");
 
         for (String clientName : clientOrder) {
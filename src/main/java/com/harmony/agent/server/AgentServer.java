@@ -0,0 +1,332 @@
+package com.harmony.agent.server;
+
+import com.google.gson.Gson;
+import com.google.gson.JsonElement;
+import com.google.gson.JsonNull;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParseException;
+import com.google.gson.JsonParser;
+import com.harmony.agent.core.metrics.MetricsExporter;
+import com.harmony.agent.core.metrics.MetricsRegistry;
+import com.sun.net.httpserver.Headers;
+import com.sun.net.httpserver.HttpExchange;
+import com.sun.net.httpserver.HttpServer;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.attribute.PosixFilePermissions;
+import java.security.MessageDigest;
+import java.security.SecureRandom;
+import java.util.HexFormat;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * 常驻服务模式的 HTTP 入口
+ *
+ * 仅监听本机回环地址，提供 JSON-RPC 2.0 接口：
+ * - POST /rpc      {"jsonrpc":"2.0","id":1,"method":"analyze","params":{...}}
+ * - GET  /health   存活检查
+ * - GET  /metrics  OpenMetrics 格式的运行指标（见 {@link MetricsRegistry}）
+ *
+ * 方法：analyze / query / fix / fix.apply / status / shutdown（参数见 {@link AgentService}）
+ * 请求由固定大小的线程池并发处理。
+ *
+ * /rpc 只接受本机客户端：启动时生成随机令牌写入 ~/.harmony-agent/server-&lt;port&gt;.token（仅属主可读），
+ * 请求须在 {@value #TOKEN_HEADER} 头中携带；带 Origin 头（浏览器跨域请求）、Content-Type 不是
+ * application/json 或 Host 不是 127.0.0.1 / localhost（DNS rebinding）的请求一律拒绝。
+ */
+public class AgentServer {
+
+    private static final Logger logger = LoggerFactory.getLogger(AgentServer.class);
+
+    public static final int DEFAULT_PORT = 7878;
+    public static final String TOKEN_HEADER = "X-Harmony-Token";
+    static final Path DEFAULT_TOKEN_DIR = Paths.get(System.getProperty("user.home"), ".harmony-agent");
+
+    /**
+     * 单个 RPC 方法
+     */
+    @FunctionalInterface
+    interface RpcMethod {
+        JsonElement invoke(JsonObject params) throws Exception;
+    }
+
+    private final AgentService service;
+    private final HttpServer httpServer;
+    private final ExecutorService workers;
+    private final Map<String, RpcMethod> methods = new LinkedHashMap<>();
+    private final CountDownLatch stopped = new CountDownLatch(1);
+    private final Gson gson = new Gson();
+    private final String token;
+    private final Path tokenFile;
+
+    /**
+     * @param service 常驻业务实现
+     * @param port 监听端口（0 表示随机端口）
+     * @param threads 请求处理线程数
+     */
+    public AgentServer(AgentService service, int port, int threads) throws IOException {
+        this(service, port, threads, DEFAULT_TOKEN_DIR);
+    }
+
+    AgentServer(AgentService service, int port, int threads, Path tokenDir) throws IOException {
+        this.service = service;
+        this.httpServer = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), port), 0);
+        this.token = newToken();
+        this.tokenFile = tokenFile(tokenDir, getPort());
+        writeTokenFile(tokenFile, token);
+        this.workers = Executors.newFixedThreadPool(Math.max(1, threads), r -> {
+            Thread thread = new Thread(r, "agent-server-worker");
+            thread.setDaemon(true);
+            return thread;
+        });
+
+        methods.put("analyze", service::analyze);
+        methods.put("query", service::query);
+        methods.put("fix", service::fix);
+        methods.put("fix.apply", service::applyFix);
+        methods.put("status", params -> service.status());
+        methods.put("shutdown", params -> {
+            // 先返回响应，再异步停止
+            Thread stopper = new Thread(this::stop, "agent-server-stop");
+            stopper.setDaemon(true);
+            stopper.start();
+            JsonObject response = new JsonObject();
+            response.addProperty("stopping", true);
+            return response;
+        });
+
+        httpServer.createContext("/rpc", this::handleRpc);
+        httpServer.createContext("/health", this::handleHealth);
+        httpServer.createContext("/metrics", exchange -> MetricsExporter.handle(exchange, MetricsRegistry.global()));
+        httpServer.setExecutor(workers);
+    }
+
+    public void start() {
+        httpServer.start();
+        logger.info("Agent server listening on http://127.0.0.1:{}/rpc", getPort());
+    }
+
+    public int getPort() {
+        return httpServer.getAddress().getPort();
+    }
+
+    /**
+     * 本服务的访问令牌文件
+     */
+    public Path getTokenFile() {
+        return tokenFile;
+    }
+
+    /**
+     * 阻塞直到服务停止
+     */
+    public void awaitShutdown() throws InterruptedException {
+        stopped.await();
+    }
+
+    /**
+     * 停止服务（可重复调用）
+     */
+    public synchronized void stop() {
+        if (stopped.getCount() == 0) {
+            return;
+        }
+        logger.info("Stopping agent server...");
+        httpServer.stop(1);
+        workers.shutdown();
+        try {
+            if (!workers.awaitTermination(10, TimeUnit.SECONDS)) {
+                workers.shutdownNow();
+            }
+        } catch (InterruptedException e) {
+            workers.shutdownNow();
+            Thread.currentThread().interrupt();
+        }
+        service.close();
+        try {
+            Files.deleteIfExists(tokenFile);
+        } catch (IOException e) {
+            logger.warn("Failed to delete server token file {}: {}", tokenFile, e.getMessage());
+        }
+        stopped.countDown();
+    }
+
+    private void handleHealth(HttpExchange exchange) throws IOException {
+        send(exchange, 200, "{\"status\":\"ok\"}");
+    }
+
+    private void handleRpc(HttpExchange exchange) throws IOException {
+        if (!"POST".equalsIgnoreCase(exchange.getRequestMethod())) {
+            send(exchange, 405, "{\"error\":\"POST required\"}");
+            return;
+        }
+        Headers headers = exchange.getRequestHeaders();
+        String rejection = rejectReason(headers);
+        if (rejection != null) {
+            logger.warn("Rejected RPC request from {}: {}", exchange.getRemoteAddress(), rejection);
+            send(exchange, 403, gson.toJson(Map.of("error", rejection)));
+            return;
+        }
+        if (!hasValidToken(headers)) {
+            logger.warn("Rejected RPC request from {}: missing or invalid token", exchange.getRemoteAddress());
+            send(exchange, 401, gson.toJson(Map.of("error", "Missing or invalid " + TOKEN_HEADER)));
+            return;
+        }
+
+        String body;
+        try (InputStream in = exchange.getRequestBody()) {
+            body = new String(in.readAllBytes(), StandardCharsets.UTF_8);
+        }
+        send(exchange, 200, gson.toJson(dispatch(body)));
+    }
+
+    /**
+     * 检查请求来源；可接受时返回 null，否则返回拒绝原因
+     */
+    static String rejectReason(Headers headers) {
+        if (headers.containsKey("Origin")) {
+            return "Cross-origin requests are not allowed";
+        }
+        String host = headers.getFirst("Host");
+        if (host == null || !isLoopbackHost(host)) {
+            return "Host must be 127.0.0.1 or localhost";
+        }
+        String contentType = headers.getFirst("Content-Type");
+        if (contentType == null
+                || !contentType.split(";", 2)[0].trim().equalsIgnoreCase("application/json")) {
+            return "Content-Type must be application/json";
+        }
+        return null;
+    }
+
+    private boolean hasValidToken(Headers headers) {
+        String presented = headers.getFirst(TOKEN_HEADER);
+        return presented != null && MessageDigest.isEqual(
+            presented.getBytes(StandardCharsets.UTF_8), token.getBytes(StandardCharsets.UTF_8));
+    }
+
+    private static boolean isLoopbackHost(String host) {
+        String name = host.trim().toLowerCase();
+        int colon = name.lastIndexOf(':');
+        if (colon > 0 && name.indexOf(':') == colon) {
+            name = name.substring(0, colon);  // host:port（IPv6 字面量不含端口时有多个冒号）
+        }
+        return name.equals("127.0.0.1") || name.equals("localhost");
+    }
+
+    /**
+     * 端口对应的令牌文件（客户端按服务地址的端口查找）
+     */
+    static Path tokenFile(Path tokenDir, int port) {
+        return tokenDir.resolve("server-" + port + ".token");
+    }
+
+    private static String newToken() {
+        byte[] bytes = new byte[32];
+        new SecureRandom().nextBytes(bytes);
+        return HexFormat.of().formatHex(bytes);
+    }
+
+    /**
+     * 写入令牌文件；支持 POSIX 权限的文件系统上创建时即为 0600
+     */
+    private static void writeTokenFile(Path file, String token) throws IOException {
+        Files.createDirectories(file.getParent());
+        Files.deleteIfExists(file);
+        if (file.getFileSystem().supportedFileAttributeViews().contains("posix")) {
+            Files.createFile(file, PosixFilePermissions.asFileAttribute(PosixFilePermissions.fromString("rw-------")));
+        } else {
+            Files.createFile(file);
+        }
+        Files.writeString(file, token, StandardCharsets.UTF_8);
+    }
+
+    /**
+     * 处理一条 JSON-RPC 请求文本，返回响应对象
+     */
+    JsonObject dispatch(String body) {
+        JsonElement id = JsonNull.INSTANCE;
+        try {
+            JsonElement parsed;
+            try {
+                parsed = JsonParser.parseString(body);
+            } catch (JsonParseException e) {
+                throw new RpcException(RpcException.PARSE_ERROR, "Parse error: " + e.getMessage());
+            }
+            if (!parsed.isJsonObject()) {
+                throw new RpcException(RpcException.INVALID_REQUEST, "Request must be a JSON object");
+            }
+
+            JsonObject request = parsed.getAsJsonObject();
+            if (request.has("id")) {
+                id = request.get("id");
+            }
+            if (!request.has("method") || !request.get("method").isJsonPrimitive()) {
+                throw new RpcException(RpcException.INVALID_REQUEST, "Missing method");
+            }
+
+            String methodName = request.get("method").getAsString();
+            RpcMethod method = methods.get(methodName);
+            if (method == null) {
+                throw new RpcException(RpcException.METHOD_NOT_FOUND, "Method not found: " + methodName);
+            }
+
+            JsonObject params = request.has("params") && request.get("params").isJsonObject()
+                ? request.getAsJsonObject("params") : new JsonObject();
+
+            long start = System.nanoTime();
+            JsonElement result = method.invoke(params);
+            logger.debug("RPC {} completed in {} ms", methodName, (System.nanoTime() - start) / 1_000_000);
+
+            JsonObject response = envelope(id);
+            response.add("result", result != null ? result : JsonNull.INSTANCE);
+            return response;
+
+        } catch (RpcException e) {
+            return error(id, e.getCode(), e.getMessage());
+        } catch (Exception e) {
+            logger.error("RPC request failed", e);
+            return error(id, RpcException.INTERNAL_ERROR, e.getMessage() != null ? e.getMessage() : e.toString());
+        }
+    }
+
+    private static JsonObject envelope(JsonElement id) {
+        JsonObject response = new JsonObject();
+        response.addProperty("jsonrpc", "2.0");
+        response.add("id", id);
+        return response;
+    }
+
+    private static JsonObject error(JsonElement id, int code, String message) {
+        JsonObject error = new JsonObject();
+        error.addProperty("code", code);
+        error.addProperty("message", message);
+        JsonObject response = envelope(id);
+        response.add("error", error);
+        return response;
+    }
+
+    private static void send(HttpExchange exchange, int status, String json) throws IOException {
+        byte[] bytes = json.getBytes(StandardCharsets.UTF_8);
+        exchange.getResponseHeaders().set("Content-Type", "application/json; charset=utf-8");
+        exchange.sendResponseHeaders(status, bytes.length);
+        try (OutputStream out = exchange.getResponseBody()) {
+            out.write(bytes);
+        }
+    }
+}
@@ -0,0 +1,402 @@
+package com.harmony.agent.server;
+
+import com.google.gson.JsonArray;
+import com.google.gson.JsonElement;
+import com.google.gson.JsonObject;
+import com.harmony.agent.autofix.AppliedChange;
+import com.harmony.agent.autofix.AutoFixOrchestrator;
+import com.harmony.agent.autofix.ChangeManager;
+import com.harmony.agent.autofix.CodeValidator;
+import com.harmony.agent.autofix.PendingChange;
+import com.harmony.agent.config.AppConfig;
+import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.AnalysisEngine;
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.ScanResult;
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.store.UnifiedIssueStore;
+import com.harmony.agent.llm.LLMClient;
+import com.harmony.agent.tools.ToolExecutor;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.File;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.time.Instant;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.Supplier;
+import java.util.stream.Collectors;
+import java.util.stream.Stream;
+
+/**
+ * 常驻服务的业务实现
+ *
+ * 在请求之间保持以下状态：
+ * - 按（路径, 级别, compile_commands, AI, 增量）缓存的 AnalysisEngine（工具探测、线程池、AI 决策引擎只初始化一次），
+ *   最多保留 maxEngines 个，超出时按 LRU 淘汰并关闭其线程池
+ * - 会话级 UnifiedIssueStore（analyze 结果写入，query / fix 读取）
+ * - 延迟创建的 AutoFixOrchestrator 和待应用的修复
+ *
+ * 同一引擎上的分析串行执行（扫描器的增量状态不是线程安全的），不同项目可并发分析。
+ */
+public class AgentService {
+
+    private static final Logger logger = LoggerFactory.getLogger(AgentService.class);
+
+    private static final int DEFAULT_QUERY_LIMIT = 100;
+    public static final int DEFAULT_MAX_ENGINES = 8;
+
+    private final UnifiedIssueStore store;
+    private final int maxEngines;
+    // 访问顺序的 LRU，所有访问在 synchronized (engines) 中进行
+    private final LinkedHashMap<String, AnalysisEngine> engines = new LinkedHashMap<>(16, 0.75f, true);
+    private final Map<String, PendingChange> pendingChanges = new ConcurrentHashMap<>();
+    private final Instant startedAt = Instant.now();
+    private final AtomicLong analyzeCount = new AtomicLong();
+    private final AtomicLong warmHits = new AtomicLong();
+
+    private volatile AutoFixOrchestrator autoFixOrchestrator;
+
+    public AgentService(UnifiedIssueStore store) {
+        this(store, DEFAULT_MAX_ENGINES);
+    }
+
+    /**
+     * @param store 会话级问题存储
+     * @param maxEngines 常驻引擎上限（每个引擎持有自己的线程池）
+     */
+    public AgentService(UnifiedIssueStore store, int maxEngines) {
+        this.store = store != null ? store : new UnifiedIssueStore();
+        this.maxEngines = Math.max(1, maxEngines);
+    }
+
+    public UnifiedIssueStore getStore() {
+        return store;
+    }
+
+    /**
+     * analyze {path, level?, compileCommands?, ai?, incremental?, limit?}
+     */
+    public JsonObject analyze(JsonObject params) throws Exception {
+        String sourcePath = requireString(params, "path");
+        Path path = Paths.get(sourcePath).toAbsolutePath().normalize();
+        if (!Files.exists(path)) {
+            throw new RpcException(RpcException.INVALID_PARAMS, "Source path does not exist: " + sourcePath);
+        }
+
+        AppConfig.AnalysisConfig defaults = ConfigManager.getInstance().getConfig().getAnalysis();
+        String level = optString(params, "level", defaults.getLevel());
+        String compileCommands = optString(params, "compileCommands", null);
+        boolean ai = optBoolean(params, "ai", false);
+        boolean incremental = optBoolean(params, "incremental", defaults.isIncremental());
+
+        String key = String.join("|", path.toString(), level, String.valueOf(compileCommands),
+            String.valueOf(ai), String.valueOf(incremental));
+
+        boolean[] created = {false};
+        Supplier<AnalysisEngine> factory = () -> {
+            created[0] = true;
+            logger.info("Creating analysis engine for {}", key);
+            return new AnalysisEngine(path.toString(), new AnalysisEngine.AnalysisConfig(
+                level, incremental, defaults.isParallel(), defaults.getMaxThreads(),
+                defaults.getTimeout(), compileCommands, ai));
+        };
+        analyzeCount.incrementAndGet();
+
+        ScanResult result = null;
+        while (result == null) {
+            AnalysisEngine engine = acquireEngine(key, factory);
+            synchronized (engine) {
+                // 等锁期间引擎可能已被淘汰并关闭，此时换用新引擎
+                if (isCurrentEngine(key, engine)) {
+                    result = engine.analyzeWithStore(store);
+                }
+            }
+        }
+        if (!created[0]) {
+            warmHits.incrementAndGet();
+        }
+
+        JsonObject response = new JsonObject();
+        response.addProperty("scanId", result.getScanId());
+        response.addProperty("sourcePath", result.getSourcePath());
+        response.addProperty("durationMs", result.getDuration().toMillis());
+        response.addProperty("warm", !created[0]);
+        response.addProperty("totalFiles", ((Number) result.getStatistics().getOrDefault("total_files", 0)).intValue());
+        response.addProperty("totalIssues", result.getTotalIssueCount());
+        response.addProperty("hasCriticalIssues", result.hasCriticalIssues());
+        response.add("bySeverity", severityCounts(result.getIssueCountBySeverity()));
+
+        JsonArray analyzers = new JsonArray();
+        result.getAnalyzersUsed().forEach(analyzers::add);
+        response.add("analyzers", analyzers);
+        response.add("issues", toJson(result.getIssues(), optInt(params, "limit", Integer.MAX_VALUE)));
+        return response;
+    }
+
+    /**
+     * query {path?, file?, severity?, category?, limit?}
+     */
+    public JsonObject query(JsonObject params) throws RpcException {
+        Stream<SecurityIssue> issues;
+        String file = optString(params, "file", null);
+        if (file != null) {
+            issues = store.getIssuesByFile(file).stream();
+        } else {
+            issues = store.getAllIssues().stream();
+        }
+
+        String pathPrefix = optString(params, "path", null);
+        if (pathPrefix != null) {
+            Path prefix = Paths.get(pathPrefix).toAbsolutePath().normalize();
+            issues = issues.filter(issue -> Paths.get(issue.getLocation().getFilePath())
+                .toAbsolutePath().normalize().startsWith(prefix));
+        }
+
+        String severity = optString(params, "severity", null);
+        if (severity != null) {
+            IssueSeverity minimum = parseEnum(IssueSeverity.class, severity, "severity");
+            // 返回不低于指定级别的问题
+            issues = issues.filter(issue -> issue.getSeverity().getLevel() >= minimum.getLevel());
+        }
+
+        String category = optString(params, "category", null);
+        if (category != null) {
+            IssueCategory wanted = parseEnum(IssueCategory.class, category, "category");
+            issues = issues.filter(issue -> issue.getCategory() == wanted);
+        }
+
+        List<SecurityIssue> matched = issues
+            .sorted((a, b) -> Integer.compare(b.getSeverity().getLevel(), a.getSeverity().getLevel()))
+            .collect(Collectors.toList());
+
+        JsonObject response = new JsonObject();
+        response.addProperty("total", matched.size());
+        response.add("issues", toJson(matched, optInt(params, "limit", DEFAULT_QUERY_LIMIT)));
+        return response;
+    }
+
+    /**
+     * fix {issueId, maxRetries?} - 生成修复但不写入文件，返回 changeId 供 fix.apply 使用
+     */
+    public JsonObject fix(JsonObject params) throws Exception {
+        String issueId = requireString(params, "issueId");
+        SecurityIssue issue = store.getAllIssues().stream()
+            .filter(i -> issueId.equals(i.getId()) || issueId.equals(i.getHash()))
+            .findFirst()
+            .orElseThrow(() -> new RpcException(RpcException.INVALID_PARAMS, "Unknown issue: " + issueId));
+
+        PendingChange change = getAutoFixOrchestrator()
+            .generateFixWithStore(issue, store, optInt(params, "maxRetries", 3));
+        pendingChanges.put(change.getId(), change);
+
+        JsonObject response = new JsonObject();
+        response.addProperty("changeId", change.getId());
+        response.addProperty("file", change.getFilePath().toString());
+        response.addProperty("startLine", change.getStartLine());
+        response.addProperty("endLine", change.getEndLine());
+        response.addProperty("oldCode", change.getOldCode());
+        response.addProperty("newCode", change.getNewCode());
+        JsonArray plan = new JsonArray();
+        if (change.getFixPlan() != null) {
+            change.getFixPlan().forEach(plan::add);
+        }
+        response.add("fixPlan", plan);
+        return response;
+    }
+
+    /**
+     * fix.apply {changeId}
+     */
+    public JsonObject applyFix(JsonObject params) throws Exception {
+        String changeId = requireString(params, "changeId");
+        PendingChange change = pendingChanges.remove(changeId);
+        if (change == null) {
+            throw new RpcException(RpcException.INVALID_PARAMS, "Unknown or already applied change: " + changeId);
+        }
+
+        ChangeManager changeManager = new ChangeManager();
+        changeManager.setPendingChange(change);
+        AppliedChange applied = changeManager.acceptPendingChange();
+
+        JsonObject response = new JsonObject();
+        response.addProperty("changeId", changeId);
+        response.addProperty("file", change.getFilePath().toString());
+        response.addProperty("applied", applied != null);
+        return response;
+    }
+
+    /**
+     * status - 服务状态与常驻资源概况
+     */
+    public JsonObject status() {
+        JsonObject response = new JsonObject();
+        response.addProperty("startedAt", startedAt.toString());
+        response.addProperty("uptimeMs", System.currentTimeMillis() - startedAt.toEpochMilli());
+        synchronized (engines) {
+            response.addProperty("engines", engines.size());
+        }
+        response.addProperty("maxEngines", maxEngines);
+        response.addProperty("analyzeRequests", analyzeCount.get());
+        response.addProperty("warmHits", warmHits.get());
+        response.addProperty("storedIssues", store.getTotalIssueCount());
+        response.addProperty("pendingChanges", pendingChanges.size());
+        response.addProperty("heapUsedMb",
+            (Runtime.getRuntime().totalMemory() - Runtime.getRuntime().freeMemory()) / (1024 * 1024));
+        return response;
+    }
+
+    /**
+     * 释放常驻引擎
+     */
+    public void close() {
+        List<AnalysisEngine> resident;
+        synchronized (engines) {
+            resident = new ArrayList<>(engines.values());
+            engines.clear();
+        }
+        resident.forEach(AnalysisEngine::shutdown);
+    }
+
+    /**
+     * 取得（必要时创建）键对应的引擎；引擎在锁外创建，插入后按 LRU 淘汰超出上限的引擎
+     */
+    private AnalysisEngine acquireEngine(String key, Supplier<AnalysisEngine> factory) {
+        synchronized (engines) {
+            AnalysisEngine engine = engines.get(key);
+            if (engine != null) {
+                return engine;
+            }
+        }
+
+        AnalysisEngine created = factory.get();
+        List<AnalysisEngine> evicted = new ArrayList<>();
+        AnalysisEngine engine;
+        synchronized (engines) {
+            engine = engines.putIfAbsent(key, created);
+            if (engine == null) {
+                engine = created;
+                Iterator<Map.Entry<String, AnalysisEngine>> eldest = engines.entrySet().iterator();
+                while (engines.size() > maxEngines && eldest.hasNext()) {
+                    Map.Entry<String, AnalysisEngine> entry = eldest.next();
+                    if (!entry.getKey().equals(key)) {
+                        logger.info("Evicting least recently used analysis engine for {}", entry.getKey());
+                        evicted.add(entry.getValue());
+                        eldest.remove();
+                    }
+                }
+            } else {
+                evicted.add(created);  // 并发请求已创建了同一引擎
+            }
+        }
+        evicted.forEach(AgentService::shutdownEvicted);
+        return engine;
+    }
+
+    private boolean isCurrentEngine(String key, AnalysisEngine engine) {
+        synchronized (engines) {
+            return engines.get(key) == engine;
+        }
+    }
+
+    /**
+     * 在后台关闭被淘汰的引擎：等待其上正在进行的分析结束，不阻塞当前请求
+     */
+    private static void shutdownEvicted(AnalysisEngine engine) {
+        Thread stopper = new Thread(() -> {
+            synchronized (engine) {
+                engine.shutdown();
+            }
+        }, "agent-engine-evict");
+        stopper.setDaemon(true);
+        stopper.start();
+    }
+
+    private AutoFixOrchestrator getAutoFixOrchestrator() {
+        if (autoFixOrchestrator == null) {
+            synchronized (this) {
+                if (autoFixOrchestrator == null) {
+                    File workDir = new File(System.getProperty("user.dir"));
+                    LLMClient llmClient = new LLMClient(ConfigManager.getInstance());
+                    CodeValidator validator = new CodeValidator(new ToolExecutor(workDir), workDir);
+                    autoFixOrchestrator = new AutoFixOrchestrator(llmClient, validator);
+                }
+            }
+        }
+        return autoFixOrchestrator;
+    }
+
+    static JsonObject toJson(SecurityIssue issue) {
+        JsonObject json = new JsonObject();
+        json.addProperty("id", issue.getId());
+        json.addProperty("hash", issue.getHash());
+        json.addProperty("title", issue.getTitle());
+        json.addProperty("description", issue.getDescription());
+        json.addProperty("severity", issue.getSeverity().name());
+        json.addProperty("category", issue.getCategory().name());
+        json.addProperty("analyzer", issue.getAnalyzer());
+
+        CodeLocation location = issue.getLocation();
+        if (location != null) {
+            json.addProperty("file", location.getFilePath());
+            json.addProperty("line", location.getLineNumber());
+            json.addProperty("column", location.getColumnNumber());
+        }
+        return json;
+    }
+
+    private static JsonArray toJson(List<SecurityIssue> issues, int limit) {
+        JsonArray array = new JsonArray();
+        issues.stream().limit(Math.max(0, limit)).forEach(issue -> array.add(toJson(issue)));
+        return array;
+    }
+
+    private static JsonObject severityCounts(Map<IssueSeverity, Long> counts) {
+        JsonObject json = new JsonObject();
+        for (IssueSeverity severity : IssueSeverity.values()) {
+            json.addProperty(severity.name(), counts.getOrDefault(severity, 0L));
+        }
+        return json;
+    }
+
+    private static String requireString(JsonObject params, String name) throws RpcException {
+        String value = optString(params, name, null);
+        if (value == null || value.isBlank()) {
+            throw new RpcException(RpcException.INVALID_PARAMS, "Missing parameter: " + name);
+        }
+        return value;
+    }
+
+    private static String optString(JsonObject params, String name, String defaultValue) {
+        JsonElement value = params != null ? params.get(name) : null;
+        return value != null && !value.isJsonNull() ? value.getAsString() : defaultValue;
+    }
+
+    private static boolean optBoolean(JsonObject params, String name, boolean defaultValue) {
+        JsonElement value = params != null ? params.get(name) : null;
+        return value != null && !value.isJsonNull() ? value.getAsBoolean() : defaultValue;
+    }
+
+    private static int optInt(JsonObject params, String name, int defaultValue) {
+        JsonElement value = params != null ? params.get(name) : null;
+        return value != null && !value.isJsonNull() ? value.getAsInt() : defaultValue;
+    }
+
+    private static <E extends Enum<E>> E parseEnum(Class<E> type, String value, String name) throws RpcException {
+        try {
+            return Enum.valueOf(type, value.trim().toUpperCase());
+        } catch (IllegalArgumentException e) {
+            throw new RpcException(RpcException.INVALID_PARAMS, "Invalid " + name + ": " + value);
+        }
+    }
+}
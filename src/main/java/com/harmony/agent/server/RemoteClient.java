@@ -0,0 +1,245 @@
+package com.harmony.agent.server;
+
+import com.google.gson.Gson;
+import com.google.gson.GsonBuilder;
+import com.google.gson.JsonElement;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParser;
+
+import java.io.IOException;
+import java.io.PrintStream;
+import java.net.URI;
+import java.net.http.HttpClient;
+import java.net.http.HttpRequest;
+import java.net.http.HttpResponse;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.time.Duration;
+import java.util.Arrays;
+import java.util.Set;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * 常驻服务的瘦客户端
+ *
+ * 由 Main 在 --remote 时直接调用，不初始化 picocli、配置、LLM 提供者或分析工具，
+ * 只把命令翻译为一次 JSON-RPC 调用并打印结果 JSON。
+ * 访问令牌从服务端写入的 ~/.harmony-agent/server-&lt;port&gt;.token 读取。
+ *
+ * 用法：
+ *   harmony-agent --remote[=URL] analyze &lt;path&gt; [-l level] [--compile-commands file] [--ai] [--incremental]
+ *   harmony-agent --remote[=URL] query [path] [--file f] [--severity s] [--category c] [--limit n]
+ *   harmony-agent --remote[=URL] fix &lt;issueId&gt;
+ *   harmony-agent --remote[=URL] apply &lt;changeId&gt;
+ *   harmony-agent --remote[=URL] status | shutdown
+ * 其余命令（suggest、refactor、review 等）只能在本地运行，带 --remote 时报错退出。
+ */
+public class RemoteClient {
+
+    public static final String REMOTE_FLAG = "--remote";
+    public static final String SERVER_ENV = "HARMONY_AGENT_SERVER";
+
+    private static final AtomicLong REQUEST_IDS = new AtomicLong();
+    private static final String REMOTE_COMMANDS = "analyze, query, fix, apply, status, shutdown";
+    // 本地 CLI 的全局选项，在瘦客户端中没有意义
+    private static final Set<String> LOCAL_OPTIONS = Set.of("-v", "--verbose", "--no-color");
+
+    private final URI rpcUri;
+    private final Path tokenFile;
+    private final HttpClient httpClient;
+    private final Gson gson = new GsonBuilder().setPrettyPrinting().create();
+
+    public RemoteClient(String baseUrl) {
+        this(baseUrl, AgentServer.DEFAULT_TOKEN_DIR);
+    }
+
+    RemoteClient(String baseUrl, Path tokenDir) {
+        String base = baseUrl.endsWith("/") ? baseUrl.substring(0, baseUrl.length() - 1) : baseUrl;
+        this.rpcUri = URI.create(base + "/rpc");
+        int port = rpcUri.getPort() != -1 ? rpcUri.getPort() : AgentServer.DEFAULT_PORT;
+        this.tokenFile = AgentServer.tokenFile(tokenDir, port);
+        this.httpClient = HttpClient.newBuilder()
+            .connectTimeout(Duration.ofSeconds(2))
+            .build();
+    }
+
+    /**
+     * 命令行中 --remote[=URL] 的位置（可出现在子命令前后），不存在时返回 -1
+     */
+    public static int remoteFlagIndex(String[] args) {
+        for (int i = 0; i < args.length; i++) {
+            if (args[i].equals(REMOTE_FLAG) || args[i].startsWith(REMOTE_FLAG + "=")) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * 默认服务地址：环境变量 HARMONY_AGENT_SERVER，否则 http://127.0.0.1:7878
+     */
+    public static String defaultServerUrl() {
+        String env = System.getenv(SERVER_ENV);
+        return env != null && !env.isBlank() ? env : "http://127.0.0.1:" + AgentServer.DEFAULT_PORT;
+    }
+
+    /**
+     * 发送一次 JSON-RPC 调用，返回 result；服务端错误抛出 RpcException
+     */
+    public JsonElement call(String method, JsonObject params) throws IOException, InterruptedException, RpcException {
+        JsonObject request = new JsonObject();
+        request.addProperty("jsonrpc", "2.0");
+        request.addProperty("id", REQUEST_IDS.incrementAndGet());
+        request.addProperty("method", method);
+        request.add("params", params != null ? params : new JsonObject());
+
+        HttpRequest.Builder builder = HttpRequest.newBuilder(rpcUri)
+            .header("Content-Type", "application/json")
+            .POST(HttpRequest.BodyPublishers.ofString(gson.toJson(request)));
+        String token = readToken();
+        if (token != null) {
+            builder.header(AgentServer.TOKEN_HEADER, token);
+        }
+
+        HttpResponse<String> response = httpClient.send(builder.build(), HttpResponse.BodyHandlers.ofString());
+        if (response.statusCode() == 401) {
+            throw new IOException("Server rejected the access token - is " + tokenFile
+                + " from the running server? (restart it with: harmony-agent serve)");
+        }
+        if (response.statusCode() != 200) {
+            throw new IOException("HTTP " + response.statusCode() + ": " + response.body());
+        }
+        JsonObject body = JsonParser.parseString(response.body()).getAsJsonObject();
+        if (body.has("error") && body.get("error").isJsonObject()) {
+            JsonObject error = body.getAsJsonObject("error");
+            throw new RpcException(error.get("code").getAsInt(), error.get("message").getAsString());
+        }
+        return body.get("result");
+    }
+
+    /**
+     * 读取服务端令牌；文件不存在时返回 null（服务端会以 401 拒绝）
+     */
+    private String readToken() throws IOException {
+        if (!Files.exists(tokenFile)) {
+            return null;
+        }
+        return Files.readString(tokenFile, StandardCharsets.UTF_8).trim();
+    }
+
+    /**
+     * 执行命令行并返回退出码（与本地命令一致：0 成功，1 失败，2 存在严重问题）
+     */
+    public int run(String[] args, PrintStream out, PrintStream err) {
+        int start = 0;
+        while (start < args.length && LOCAL_OPTIONS.contains(args[start])) {
+            start++;
+        }
+        args = Arrays.copyOfRange(args, start, args.length);
+        if (args.length == 0) {
+            err.println("Usage: harmony-agent --remote[=URL] <" + REMOTE_COMMANDS.replace(", ", "|") + "> [args]");
+            return 1;
+        }
+
+        String command = args[0];
+        String[] rest = Arrays.copyOfRange(args, 1, args.length);
+
+        try {
+            JsonObject params = new JsonObject();
+            String method;
+            switch (command) {
+                case "analyze" -> {
+                    method = "analyze";
+                    parseAnalyzeArgs(rest, params);
+                }
+                case "query" -> {
+                    method = "query";
+                    parseQueryArgs(rest, params);
+                }
+                case "fix" -> {
+                    method = "fix";
+                    params.addProperty("issueId", requireArg(rest, "issueId"));
+                }
+                case "apply" -> {
+                    method = "fix.apply";
+                    params.addProperty("changeId", requireArg(rest, "changeId"));
+                }
+                case "status", "shutdown" -> method = command;
+                default -> {
+                    err.println("❌ '" + command + "' is not available with " + REMOTE_FLAG
+                        + " (the server supports: " + REMOTE_COMMANDS + "); run it without " + REMOTE_FLAG);
+                    return 1;
+                }
+            }
+
+            JsonElement result = call(method, params);
+            out.println(gson.toJson(result));
+
+            if ("analyze".equals(method) && result.isJsonObject()
+                    && result.getAsJsonObject().get("hasCriticalIssues").getAsBoolean()) {
+                return 2;
+            }
+            return 0;
+
+        } catch (java.net.ConnectException e) {
+            err.println("❌ Cannot connect to agent server at " + rpcUri + " - start it with: harmony-agent serve");
+            return 1;
+        } catch (RpcException e) {
+            err.println("❌ Error: " + e.getMessage());
+            return 1;
+        } catch (IllegalArgumentException e) {
+            err.println("❌ " + e.getMessage());
+            return 1;
+        } catch (IOException e) {
+            err.println("❌ Request failed: " + e.getMessage());
+            return 1;
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return 1;
+        }
+    }
+
+    private static void parseAnalyzeArgs(String[] args, JsonObject params) {
+        for (int i = 0; i < args.length; i++) {
+            switch (args[i]) {
+                case "-l", "--level" -> params.addProperty("level", value(args, ++i));
+                case "--compile-commands" -> params.addProperty("compileCommands",
+                    Paths.get(value(args, ++i)).toAbsolutePath().toString());
+                case "--ai" -> params.addProperty("ai", true);
+                case "--incremental" -> params.addProperty("incremental", true);
+                default -> params.addProperty("path", Paths.get(args[i]).toAbsolutePath().toString());
+            }
+        }
+        if (!params.has("path")) {
+            throw new IllegalArgumentException("Missing source path");
+        }
+    }
+
+    private static void parseQueryArgs(String[] args, JsonObject params) {
+        for (int i = 0; i < args.length; i++) {
+            switch (args[i]) {
+                case "--file" -> params.addProperty("file", Paths.get(value(args, ++i)).toAbsolutePath().toString());
+                case "--severity" -> params.addProperty("severity", value(args, ++i));
+                case "--category" -> params.addProperty("category", value(args, ++i));
+                case "--limit" -> params.addProperty("limit", Integer.parseInt(value(args, ++i)));
+                default -> params.addProperty("path", Paths.get(args[i]).toAbsolutePath().toString());
+            }
+        }
+    }
+
+    private static String value(String[] args, int index) {
+        if (index >= args.length) {
+            throw new IllegalArgumentException("Missing value for " + args[index - 1]);
+        }
+        return args[index];
+    }
+
+    private static String requireArg(String[] args, String name) {
+        if (args.length == 0) {
+            throw new IllegalArgumentException("Missing " + name);
+        }
+        return args[0];
+    }
+}
@@ -0,0 +1,24 @@
+package com.harmony.agent.server;
+
+/**
+ * JSON-RPC 错误（携带标准错误码）
+ */
+public class RpcException extends Exception {
+
+    public static final int PARSE_ERROR = -32700;
+    public static final int INVALID_REQUEST = -32600;
+    public static final int METHOD_NOT_FOUND = -32601;
+    public static final int INVALID_PARAMS = -32602;
+    public static final int INTERNAL_ERROR = -32603;
+
+    private final int code;
+
+    public RpcException(int code, String message) {
+        super(message);
+        this.code = code;
+    }
+
+    public int getCode() {
+        return code;
+    }
+}
@@ -0,0 +1,106 @@
+package com.harmony.agent.strategic;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * 单个源文件的结构化度量结果（按函数统计）
+ * 由 {@link CodeMetricsAnalyzer} 一次词法扫描产出，可按内容哈希缓存
+ */
+public class CodeMetrics {
+
+    private final int lineCount;
+    private final List<FunctionMetrics> functions;
+
+    public CodeMetrics(int lineCount, List<FunctionMetrics> functions) {
+        this.lineCount = lineCount;
+        this.functions = functions != null ? functions : new ArrayList<>();
+    }
+
+    public int getLineCount() { return lineCount; }
+    public List<FunctionMetrics> getFunctions() { return functions; }
+
+    public int getFunctionCount() {
+        return functions.size();
+    }
+
+    public int getMaxCyclomaticComplexity() {
+        return functions.stream().mapToInt(FunctionMetrics::getCyclomaticComplexity).max().orElse(0);
+    }
+
+    public int getMaxNestingDepth() {
+        return functions.stream().mapToInt(FunctionMetrics::getMaxNestingDepth).max().orElse(0);
+    }
+
+    public int getTotalGotoCount() {
+        return functions.stream().mapToInt(FunctionMetrics::getGotoCount).sum();
+    }
+
+    public int getTotalLongjmpCount() {
+        return functions.stream().mapToInt(FunctionMetrics::getLongjmpCount).sum();
+    }
+
+    public int getTotalUnsafeCallCount() {
+        return functions.stream().mapToInt(FunctionMetrics::getUnsafeCallCount).sum();
+    }
+
+    @Override
+    public String toString() {
+        return String.format("CodeMetrics{lines=%d, functions=%d, maxCC=%d, maxNesting=%d, goto=%d, longjmp=%d, unsafeCalls=%d}",
+            lineCount, getFunctionCount(), getMaxCyclomaticComplexity(), getMaxNestingDepth(),
+            getTotalGotoCount(), getTotalLongjmpCount(), getTotalUnsafeCallCount());
+    }
+
+    /**
+     * 单个函数的度量
+     */
+    public static class FunctionMetrics {
+        private final String name;
+        private final int startLine;
+        private final int endLine;
+        private final int cyclomaticComplexity;
+        private final int maxNestingDepth;
+        private final int gotoCount;
+        private final int longjmpCount;
+        private final int unsafeCallCount;
+
+        public FunctionMetrics(String name, int startLine, int endLine, int cyclomaticComplexity,
+                               int maxNestingDepth, int gotoCount, int longjmpCount, int unsafeCallCount) {
+            this.name = name;
+            this.startLine = startLine;
+            this.endLine = endLine;
+            this.cyclomaticComplexity = cyclomaticComplexity;
+            this.maxNestingDepth = maxNestingDepth;
+            this.gotoCount = gotoCount;
+            this.longjmpCount = longjmpCount;
+            this.unsafeCallCount = unsafeCallCount;
+        }
+
+        public String getName() { return name; }
+        public int getStartLine() { return startLine; }
+        public int getEndLine() { return endLine; }
+        public int getCyclomaticComplexity() { return cyclomaticComplexity; }
+        public int getMaxNestingDepth() { return maxNestingDepth; }
+        public int getGotoCount() { return gotoCount; }
+        public int getLongjmpCount() { return longjmpCount; }
+        public int getUnsafeCallCount() { return unsafeCallCount; }
+
+        public int getLineCount() {
+            return endLine - startLine + 1;
+        }
+
+        /**
+         * 不安全调用密度（每百行）
+         */
+        public double getUnsafeCallDensity() {
+            return unsafeCallCount * 100.0 / Math.max(1, getLineCount());
+        }
+
+        @Override
+        public String toString() {
+            return String.format("%s[%d-%d] cc=%d nesting=%d goto=%d longjmp=%d unsafe=%d",
+                name, startLine, endLine, cyclomaticComplexity, maxNestingDepth,
+                gotoCount, longjmpCount, unsafeCallCount);
+        }
+    }
+}
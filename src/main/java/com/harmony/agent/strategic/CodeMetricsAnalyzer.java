@@ -0,0 +1,161 @@
+package com.harmony.agent.strategic;
+
+import com.harmony.agent.core.parser.CLexer;
+import com.harmony.agent.core.parser.CLexer.Token;
+import com.harmony.agent.core.parser.FunctionBoundaryTracker;
+import com.harmony.agent.core.parser.SourceModel;
+import com.harmony.agent.strategic.CodeMetrics.FunctionMetrics;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Set;
+import java.util.function.IntSupplier;
+import java.util.function.Supplier;
+
+/**
+ * 单遍流式代码度量
+ *
+ * 对一个 C/C++ 源文件只做一次词法扫描，同时统计每个函数的：
+ * - 圈复杂度（1 + 分支关键字 + && / || / ?）
+ * - 最大嵌套深度
+ * - goto、setjmp/longjmp 使用次数
+ * - 不安全库函数调用次数
+ *
+ * 注释和字符串中的内容不会被误计。
+ */
+public class CodeMetricsAnalyzer {
+
+    private static final Set<String> BRANCH_KEYWORDS = Set.of(
+        "if", "for", "while", "case", "catch"
+    );
+
+    private static final Set<String> BRANCH_OPERATORS = Set.of("&&", "||", "?");
+
+    private static final Set<String> LONGJMP_CALLS = Set.of(
+        "setjmp", "longjmp", "_setjmp", "_longjmp", "sigsetjmp", "siglongjmp"
+    );
+
+    /**
+     * 不安全（无边界检查或易误用）的 C 库函数
+     */
+    public static final Set<String> UNSAFE_CALLS = Set.of(
+        "strcpy", "strcat", "sprintf", "vsprintf", "gets", "scanf", "sscanf", "fscanf",
+        "strncpy", "strncat", "memcpy", "memmove", "alloca", "system", "popen",
+        "wcscpy", "wcscat", "realpath", "getwd", "strtok"
+    );
+
+    /**
+     * 分析源码文本
+     */
+    public CodeMetrics analyze(CharSequence source) {
+        CLexer lexer = new CLexer(source);
+        return analyze(lexer::next, lexer::getLine, countLines(source));
+    }
+
+    /**
+     * 基于已缓存的结构模型计算度量（不重新词法分析），编辑后的重复评分只需增量更新模型
+     */
+    public CodeMetrics analyze(SourceModel model) {
+        int[] next = {0};
+        return analyze(() -> next[0] < model.getTokenCount() ? model.getToken(next[0]++) : null,
+            model::getLineCount, model.getLines().size());
+    }
+
+    private CodeMetrics analyze(Supplier<Token> tokens, IntSupplier lastLine, int lineCount) {
+        FunctionBoundaryTracker tracker = new FunctionBoundaryTracker();
+        List<FunctionMetrics> functions = new ArrayList<>();
+
+        FunctionAccumulator current = null;
+        Token previous = null;
+        Token token;
+
+        while ((token = tokens.get()) != null) {
+            FunctionBoundaryTracker.Event event = tracker.accept(token);
+
+            if (event == FunctionBoundaryTracker.Event.FUNCTION_START) {
+                Token nameToken = tracker.getFunctionNameToken();
+                current = new FunctionAccumulator(tracker.getFunctionName(),
+                    nameToken != null ? nameToken.getLine() : token.getLine());
+            } else if (event == FunctionBoundaryTracker.Event.FUNCTION_END) {
+                if (current != null) {
+                    functions.add(current.finish(token.getLine()));
+                }
+                current = null;
+            } else if (current != null) {
+                current.accept(token, previous, tracker.getFunctionNesting());
+            }
+
+            if (token.getKind() != CLexer.Kind.PREPROCESSOR) {
+                previous = token;
+            }
+        }
+
+        // 文件在函数体内截断
+        if (current != null) {
+            functions.add(current.finish(lastLine.getAsInt()));
+        }
+
+        return new CodeMetrics(lineCount, functions);
+    }
+
+    private static int countLines(CharSequence source) {
+        if (source.length() == 0) {
+            return 0;
+        }
+        int lines = 1;
+        for (int i = 0; i < source.length(); i++) {
+            if (source.charAt(i) == '\n') {
+                lines++;
+            }
+        }
+        // 末尾换行不额外计一行（与 readAllLines 一致）
+        return source.charAt(source.length() - 1) == '\n' ? lines - 1 : lines;
+    }
+
+    /**
+     * 单个函数的度量累加器
+     */
+    private static class FunctionAccumulator {
+        private final String name;
+        private final int startLine;
+        private int complexity = 1;
+        private int maxNesting = 1;
+        private int gotoCount;
+        private int longjmpCount;
+        private int unsafeCalls;
+
+        FunctionAccumulator(String name, int startLine) {
+            this.name = name;
+            this.startLine = startLine;
+        }
+
+        void accept(Token token, Token previous, int nesting) {
+            maxNesting = Math.max(maxNesting, nesting);
+            String text = token.getText();
+
+            if (token.isIdentifier()) {
+                if (BRANCH_KEYWORDS.contains(text)) {
+                    complexity++;
+                } else if ("goto".equals(text)) {
+                    gotoCount++;
+                }
+            } else if (token.getKind() == CLexer.Kind.PUNCT) {
+                if (BRANCH_OPERATORS.contains(text)) {
+                    complexity++;
+                } else if ("(".equals(text) && previous != null && previous.isIdentifier()) {
+                    String callee = previous.getText();
+                    if (LONGJMP_CALLS.contains(callee)) {
+                        longjmpCount++;
+                    } else if (UNSAFE_CALLS.contains(callee)) {
+                        unsafeCalls++;
+                    }
+                }
+            }
+        }
+
+        FunctionMetrics finish(int endLine) {
+            return new FunctionMetrics(name, startLine, Math.max(startLine, endLine), complexity,
+                maxNesting, gotoCount, longjmpCount, unsafeCalls);
+        }
+    }
+}
@@ -0,0 +1,145 @@
+package com.harmony.agent.strategic;
+
+import com.harmony.agent.core.parser.CompileCommandsParser;
+import com.harmony.agent.core.parser.CompileCommandsParser.CompileCommand;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * 将源文件映射到分诊模块
+ *
+ * 支持三种粒度：
+ * - FILE: 每个文件一个模块（原有行为）
+ * - DIRECTORY: 按相对项目根目录的所在目录分组
+ * - TARGET: 按 compile_commands.json 中的构建目标分组（CMake 的 CMakeFiles/&lt;target&gt;.dir），
+ *   无法识别目标的文件退回到目录分组
+ */
+public class ModuleResolver {
+
+    private static final Logger logger = LoggerFactory.getLogger(ModuleResolver.class);
+
+    private static final Pattern CMAKE_TARGET = Pattern.compile("CMakeFiles[/\\\\]([^/\\\\]+)\\.dir[/\\\\]");
+
+    /**
+     * 模块粒度
+     */
+    public enum Granularity {
+        FILE,
+        DIRECTORY,
+        TARGET
+    }
+
+    private final Path root;
+    private final Granularity granularity;
+    private final Map<Path, String> targetByFile;
+
+    private ModuleResolver(Path root, Granularity granularity, Map<Path, String> targetByFile) {
+        this.root = root;
+        this.granularity = granularity;
+        this.targetByFile = targetByFile;
+    }
+
+    /**
+     * 创建解析器
+     *
+     * @param root 项目根目录（单文件时取其所在目录）
+     * @param granularity 模块粒度；TARGET 需要根目录或 build/ 下存在 compile_commands.json
+     */
+    public static ModuleResolver create(Path root, Granularity granularity) {
+        Path base = root.toAbsolutePath().normalize();
+        if (Files.isRegularFile(base) && base.getParent() != null) {
+            base = base.getParent();
+        }
+
+        Map<Path, String> targets = new HashMap<>();
+        if (granularity == Granularity.TARGET) {
+            targets = loadTargets(base);
+            if (targets.isEmpty()) {
+                logger.warn("No build targets found in compile_commands.json under {}, grouping by directory", base);
+            }
+        }
+        return new ModuleResolver(base, granularity, targets);
+    }
+
+    public Granularity getGranularity() {
+        return granularity;
+    }
+
+    /**
+     * 解析文件所属模块名
+     */
+    public String resolve(String filePath) {
+        Path file = Paths.get(filePath).toAbsolutePath().normalize();
+
+        if (granularity == Granularity.FILE) {
+            return relativize(file);
+        }
+
+        if (granularity == Granularity.TARGET) {
+            String target = targetByFile.get(file);
+            if (target != null) {
+                return target;
+            }
+        }
+
+        Path dir = file.getParent();
+        if (dir == null) {
+            return ".";
+        }
+        String relative = relativize(dir);
+        return relative.isEmpty() ? "." : relative;
+    }
+
+    private String relativize(Path path) {
+        if (path.startsWith(root)) {
+            return root.relativize(path).toString().replace('\\', '/');
+        }
+        return path.toString();
+    }
+
+    private static Map<Path, String> loadTargets(Path base) {
+        Map<Path, String> targets = new HashMap<>();
+        for (Path candidate : new Path[] {
+                base.resolve("compile_commands.json"),
+                base.resolve("build").resolve("compile_commands.json")}) {
+            if (!Files.isRegularFile(candidate)) {
+                continue;
+            }
+            try {
+                CompileCommandsParser parser = new CompileCommandsParser(candidate);
+                for (Map.Entry<Path, CompileCommand> entry : parser.getCommandsBySourceFile().entrySet()) {
+                    String target = extractTarget(entry.getValue().getOutputFile());
+                    if (target != null) {
+                        targets.put(entry.getKey(), target);
+                    }
+                }
+                logger.info("Resolved build targets for {} files from {}", targets.size(), candidate);
+                break;
+            } catch (IOException e) {
+                logger.warn("Failed to load {}: {}", candidate, e.getMessage());
+            }
+        }
+        return targets;
+    }
+
+    /**
+     * 从目标文件路径提取构建目标名
+     * 例如 CMakeFiles/bz2.dir/src/blocksort.c.o → bz2
+     */
+    static String extractTarget(String outputFile) {
+        if (outputFile == null) {
+            return null;
+        }
+        Matcher matcher = CMAKE_TARGET.matcher(outputFile);
+        return matcher.find() ? matcher.group(1) : null;
+    }
+}
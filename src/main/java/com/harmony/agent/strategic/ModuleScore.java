@@ -0,0 +1,87 @@
+package com.harmony.agent.strategic;
+
+import com.harmony.agent.strategic.SecurityScoringService.SecurityScore;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * 模块级安全评分（目录或构建目标下所有文件评分的聚合）
+ *
+ * 模块分数 = (按行数加权的平均分 + 最低文件分) / 2，
+ * 避免单个高危文件被大量干净文件稀释。
+ */
+public class ModuleScore extends SecurityScore {
+
+    private final String module;
+    private final List<SecurityScore> fileScores;
+
+    public ModuleScore(String module, int score, int criticalCount, int highCount, int mediumCount,
+                       int lowCount, int complexityPenalty, List<SecurityScore> fileScores) {
+        super(module, score, SecurityScoringService.determineRiskLevel(score),
+            criticalCount, highCount, mediumCount, lowCount, complexityPenalty);
+        this.module = module;
+        this.fileScores = fileScores;
+    }
+
+    @Override
+    public String getModuleName() {
+        return module;
+    }
+
+    @Override
+    public String getFileName() {
+        return module;
+    }
+
+    public List<SecurityScore> getFileScores() {
+        return Collections.unmodifiableList(fileScores);
+    }
+
+    /**
+     * 按模块聚合文件评分（模块顺序与首次出现顺序一致）
+     */
+    public static List<SecurityScore> aggregate(List<SecurityScore> fileScores, ModuleResolver resolver) {
+        if (resolver.getGranularity() == ModuleResolver.Granularity.FILE) {
+            return fileScores;
+        }
+
+        Map<String, List<SecurityScore>> byModule = new LinkedHashMap<>();
+        for (SecurityScore score : fileScores) {
+            if ("FILE_NOT_FOUND".equals(score.getRiskLevel()) || "CALCULATION_ERROR".equals(score.getRiskLevel())) {
+                continue;
+            }
+            byModule.computeIfAbsent(resolver.resolve(score.getFilePath()), k -> new ArrayList<>()).add(score);
+        }
+
+        List<SecurityScore> modules = new ArrayList<>(byModule.size());
+        byModule.forEach((module, scores) -> modules.add(of(module, scores)));
+        return modules;
+    }
+
+    private static ModuleScore of(String module, List<SecurityScore> scores) {
+        long weightedSum = 0;
+        long totalWeight = 0;
+        int minScore = 100;
+        int critical = 0, high = 0, medium = 0, low = 0, maxPenalty = 0;
+
+        for (SecurityScore score : scores) {
+            int weight = score.getMetrics() != null ? Math.max(1, score.getMetrics().getLineCount()) : 1;
+            weightedSum += (long) score.getScore() * weight;
+            totalWeight += weight;
+            minScore = Math.min(minScore, score.getScore());
+            critical += score.getCriticalCount();
+            high += score.getHighCount();
+            medium += score.getMediumCount();
+            low += score.getLowCount();
+            maxPenalty = Math.max(maxPenalty, score.getComplexityPenalty());
+        }
+
+        int weightedAverage = totalWeight > 0 ? (int) Math.round((double) weightedSum / totalWeight) : 100;
+        int moduleScore = (weightedAverage + minScore) / 2;
+        return new ModuleScore(module, moduleScore, critical, high, medium, low, maxPenalty, scores);
+    }
+}
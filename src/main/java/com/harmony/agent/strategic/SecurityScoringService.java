@@ -1,23 +1,72 @@
 package com.harmony.agent.strategic;
 
+import com.google.common.hash.Hashing;
+import com.google.gson.Gson;
+import com.google.gson.JsonParseException;
+import com.harmony.agent.core.ai.PersistentCacheManager;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.parser.SourceModel;
+import com.harmony.agent.core.parser.SourceModelCache;
+import com.harmony.agent.core.store.UnifiedIssueStore;
 import com.harmony.agent.tools.result.AnalysisResult;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
 import java.io.File;
 import java.io.IOException;
+import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
+import java.nio.file.InvalidPathException;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Collections;
 import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.stream.Collectors;
 
 /**
  * T1.1 Security Scoring Service
  * 计算代码模块的安全评分 (0-100分)
+ *
+ * 复杂度惩罚基于 {@link CodeMetricsAnalyzer} 的单遍词法度量（按函数统计），
+ * 度量结果按文件内容 SHA-256 缓存（内存 + PersistentCacheManager 磁盘层），
+ * 项目级评分通过 {@link #calculateScores} 并行执行。
  */
 public class SecurityScoringService {
     
     private static final Logger logger = LoggerFactory.getLogger(SecurityScoringService.class);
+
+    private static final String METRICS_CACHE_PREFIX = "metrics:v1:";
+    private static final int MAX_COMPLEXITY_PENALTY = 15;
+
+    private final CodeMetricsAnalyzer metricsAnalyzer = new CodeMetricsAnalyzer();
+    private final Map<String, CodeMetrics> metricsCache = new ConcurrentHashMap<>();
+    private final PersistentCacheManager persistentCache;
+    private final Gson gson = new Gson();
+
+    public SecurityScoringService() {
+        this(createPersistentCache());
+    }
+
+    /**
+     * @param persistentCache 度量结果的磁盘缓存，为 null 时只使用内存缓存
+     */
+    public SecurityScoringService(PersistentCacheManager persistentCache) {
+        this.persistentCache = persistentCache;
+    }
+
+    private static PersistentCacheManager createPersistentCache() {
+        try {
+            return new PersistentCacheManager("strategic-metrics", true);
+        } catch (RuntimeException e) {
+            logger.warn("Metrics disk cache unavailable, using memory only: {}", e.getMessage());
+            return null;
+        }
+    }
     
     // 基础分数
     private static final int BASE_SCORE = 100;
@@ -43,6 +92,76 @@ public class SecurityScoringService {
      * 计算单个文件的安全评分
      */
     public SecurityScore calculateScore(String filePath, AnalysisResult analysisResult) {
+        return calculateScore(filePath, indexBugsByFileName(analysisResult));
+    }
+
+    /**
+     * 并行计算多个文件的安全评分（结果顺序与输入一致）
+     * 问题列表只建立一次按文件名的索引，每个文件只读取和扫描一次
+     */
+    public List<SecurityScore> calculateScores(List<String> filePaths, AnalysisResult analysisResult) {
+        Map<String, List<AnalysisResult.Bug>> bugIndex = indexBugsByFileName(analysisResult);
+        long start = System.currentTimeMillis();
+
+        List<SecurityScore> scores = filePaths.parallelStream()
+            .map(filePath -> calculateScore(filePath, bugIndex))
+            .collect(Collectors.toList());
+
+        logger.info("Scored {} files in {} ms", scores.size(), System.currentTimeMillis() - start);
+        return scores;
+    }
+
+    /**
+     * 基于统一问题存储并行计算文件评分（不重新运行任何分析工具）
+     * 存储中的路径与输入路径统一按绝对规范化路径匹配
+     */
+    public List<SecurityScore> calculateScores(List<String> filePaths, UnifiedIssueStore store) {
+        Map<String, List<SecurityIssue>> issueIndex = new HashMap<>();
+        if (store != null) {
+            store.getIssuesByFileIndex().forEach((path, issues) ->
+                issueIndex.merge(normalizePath(path), issues, (a, b) -> {
+                    List<SecurityIssue> merged = new ArrayList<>(a);
+                    merged.addAll(b);
+                    return merged;
+                }));
+        }
+        long start = System.currentTimeMillis();
+
+        List<SecurityScore> scores = filePaths.parallelStream()
+            .map(filePath -> calculateIssueScore(filePath,
+                issueIndex.getOrDefault(normalizePath(filePath), Collections.emptyList())))
+            .collect(Collectors.toList());
+
+        logger.info("Scored {} files from issue store in {} ms", scores.size(),
+            System.currentTimeMillis() - start);
+        return scores;
+    }
+
+    /**
+     * 基于统一问题存储中的问题计算单个文件评分
+     */
+    public SecurityScore calculateIssueScore(String filePath, List<SecurityIssue> issues) {
+        List<Finding> findings = new ArrayList<>(issues.size());
+        for (SecurityIssue issue : issues) {
+            if (issue.getSeverity() == IssueSeverity.INFO) {
+                continue;
+            }
+            findings.add(new Finding(issue.getSeverity().name(), mapCategoryToVulnerability(issue.getCategory())));
+        }
+        return scoreFile(filePath, findings);
+    }
+
+    private SecurityScore calculateScore(String filePath, Map<String, List<AnalysisResult.Bug>> bugIndex) {
+        String fileName = new File(filePath).getName();
+        List<Finding> findings = new ArrayList<>();
+        for (AnalysisResult.Bug bug : bugIndex.getOrDefault(fileName, Collections.emptyList())) {
+            findings.add(new Finding(mapPriorityToSeverity(bug.getPriority()),
+                mapBugTypeToVulnerability(bug.getType())));
+        }
+        return scoreFile(filePath, findings);
+    }
+
+    private SecurityScore scoreFile(String filePath, List<Finding> findings) {
         try {
             File file = new File(filePath);
             if (!file.exists()) {
@@ -57,23 +176,16 @@ public class SecurityScoringService {
             int mediumCount = 0;
             int lowCount = 0;
             
-            // 统计该文件的问题
-            List<AnalysisResult.Bug> fileBugs = analysisResult.getBugs().stream()
-                .filter(bug -> bug.getFile().equals(filePath) || bug.getFile().endsWith(file.getName()))
-                .toList();
-            
-            for (AnalysisResult.Bug bug : fileBugs) {
-                String severity = mapPriorityToSeverity(bug.getPriority());
-                int deduction = SEVERITY_WEIGHTS.getOrDefault(severity, 5);
+            for (Finding finding : findings) {
+                int deduction = SEVERITY_WEIGHTS.getOrDefault(finding.severity, 5);
                 
                 // 根据漏洞类型调整扣分
-                String vulnType = mapBugTypeToVulnerability(bug.getType());
-                double multiplier = VULNERABILITY_TYPE_WEIGHTS.getOrDefault(vulnType, 1.0);
+                double multiplier = VULNERABILITY_TYPE_WEIGHTS.getOrDefault(finding.vulnerabilityType, 1.0);
                 
                 score -= (int) (deduction * multiplier);
                 
                 // 统计数量
-                switch (severity) {
+                switch (finding.severity) {
                     case "CRITICAL" -> criticalCount++;
                     case "HIGH" -> highCount++;
                     case "MEDIUM" -> mediumCount++;
@@ -82,7 +194,8 @@ public class SecurityScoringService {
             }
             
             // 代码复杂度惩罚
-            int complexityPenalty = calculateComplexityPenalty(file);
+            CodeMetrics metrics = computeMetrics(file);
+            int complexityPenalty = metrics != null ? calculateComplexityPenalty(metrics) : 0;
             score -= complexityPenalty;
             
             // 确保分数在0-100范围内
@@ -91,7 +204,7 @@ public class SecurityScoringService {
             String riskLevel = determineRiskLevel(score);
             
             return new SecurityScore(filePath, score, riskLevel, 
-                criticalCount, highCount, mediumCount, lowCount, complexityPenalty);
+                criticalCount, highCount, mediumCount, lowCount, complexityPenalty, metrics);
             
         } catch (Exception e) {
             logger.error("Failed to calculate security score for {}: {}", filePath, e.getMessage());
@@ -99,6 +212,31 @@ public class SecurityScoringService {
         }
     }
     
+    /**
+     * 将问题类别映射到漏洞类型
+     */
+    private String mapCategoryToVulnerability(IssueCategory category) {
+        if (category == null) {
+            return "OTHER";
+        }
+        return switch (category) {
+            case BUFFER_OVERFLOW -> "BUFFER_OVERFLOW";
+            case MEMORY_LEAK -> "MEMORY_LEAK";
+            case NULL_DEREFERENCE, NULL_POINTER -> "NULL_POINTER";
+            case RESOURCE_LEAK, FD_LEAK -> "RESOURCE_LEAK";
+            case CODE_SMELL -> "DEAD_CODE";
+            default -> "OTHER";
+        };
+    }
+
+    private static String normalizePath(String path) {
+        try {
+            return Paths.get(path).toAbsolutePath().normalize().toString();
+        } catch (InvalidPathException e) {
+            return path;
+        }
+    }
+    
     /**
      * 将SpotBugs优先级映射到严重性级别
      */
@@ -130,44 +268,107 @@ public class SecurityScoringService {
     }
     
     /**
-     * 计算代码复杂度惩罚
+     * 按文件名（不含目录）索引问题列表
+     * 分析工具报告的路径可能是相对或绝对路径，统一按文件名匹配
      */
-    private int calculateComplexityPenalty(File file) {
-        try {
-            List<String> lines = Files.readAllLines(file.toPath());
-            int lineCount = lines.size();
-            
-            // 基于行数的简单复杂度评估
-            if (lineCount > 1000) {
-                return 10; // 大文件惩罚
-            } else if (lineCount > 500) {
-                return 5;
-            }
-            
-            // 检查复杂的控制结构
-            int complexityScore = 0;
-            for (String line : lines) {
-                String trimmed = line.trim();
-                if (trimmed.contains("goto") || trimmed.contains("setjmp") || trimmed.contains("longjmp")) {
-                    complexityScore += 3; // 危险的控制流
-                }
-                if (trimmed.matches(".*\\bif\\s*\\(.*&&.*\\|\\|.*\\).*")) {
-                    complexityScore += 1; // 复杂条件
-                }
+    private Map<String, List<AnalysisResult.Bug>> indexBugsByFileName(AnalysisResult analysisResult) {
+        Map<String, List<AnalysisResult.Bug>> index = new HashMap<>();
+        if (analysisResult == null) {
+            return index;
+        }
+        for (AnalysisResult.Bug bug : analysisResult.getBugs()) {
+            if (bug.getFile() == null) {
+                continue;
             }
-            
-            return Math.min(15, complexityScore); // 最多扣15分
-            
+            String name = new File(bug.getFile()).getName();
+            index.computeIfAbsent(name, k -> new ArrayList<>()).add(bug);
+        }
+        return index;
+    }
+
+    /**
+     * 计算文件度量（按内容哈希缓存）
+     */
+    public CodeMetrics computeMetrics(File file) {
+        byte[] content;
+        try {
+            content = Files.readAllBytes(file.toPath());
         } catch (IOException e) {
             logger.warn("Failed to read file for complexity analysis: {}", file.getPath());
-            return 0;
+            return null;
+        }
+
+        String hash = Hashing.sha256().hashBytes(content).toString();
+        CodeMetrics cached = metricsCache.get(hash);
+        if (cached != null) {
+            return cached;
+        }
+
+        String cacheKey = METRICS_CACHE_PREFIX + hash;
+        if (persistentCache != null) {
+            String json = persistentCache.get(cacheKey);
+            if (json != null) {
+                try {
+                    CodeMetrics metrics = gson.fromJson(json, CodeMetrics.class);
+                    metricsCache.put(hash, metrics);
+                    return metrics;
+                } catch (JsonParseException e) {
+                    logger.debug("Ignoring corrupt metrics cache entry for {}", file.getPath());
+                }
+            }
+        }
+
+        // 经共享结构模型计算：同一文件小幅修改后只增量重新词法分析编辑区域
+        SourceModel model = SourceModelCache.global().update(file.toPath(), new String(content, StandardCharsets.UTF_8));
+        CodeMetrics metrics = metricsAnalyzer.analyze(model);
+        metricsCache.put(hash, metrics);
+        if (persistentCache != null) {
+            persistentCache.put(cacheKey, gson.toJson(metrics));
         }
+        return metrics;
+    }
+
+    /**
+     * 计算代码复杂度惩罚（最多扣 15 分）
+     * - 大文件：>500 行扣 5 分，>1000 行扣 10 分
+     * - 每个函数：圈复杂度 >10 扣 1 分、>20 再扣 2 分；嵌套深度 >4 扣 1 分
+     * - goto / setjmp / longjmp：每处扣 3 分（危险的控制流）
+     * - 不安全库函数：密度超过每百行 5 次的函数扣 1 分
+     */
+    int calculateComplexityPenalty(CodeMetrics metrics) {
+        int penalty = 0;
+
+        if (metrics.getLineCount() > 1000) {
+            penalty += 10;
+        } else if (metrics.getLineCount() > 500) {
+            penalty += 5;
+        }
+
+        for (CodeMetrics.FunctionMetrics function : metrics.getFunctions()) {
+            if (function.getCyclomaticComplexity() > 20) {
+                penalty += 3;
+            } else if (function.getCyclomaticComplexity() > 10) {
+                penalty += 1;
+            }
+            if (function.getMaxNestingDepth() > 4) {
+                penalty += 1;
+            }
+            penalty += 3 * (function.getGotoCount() + function.getLongjmpCount());
+            if (function.getUnsafeCallDensity() > 5.0) {
+                penalty += 1;
+            }
+            if (penalty >= MAX_COMPLEXITY_PENALTY) {
+                break;
+            }
+        }
+
+        return Math.min(MAX_COMPLEXITY_PENALTY, penalty);
     }
     
     /**
      * 根据分数确定风险级别
      */
-    private String determineRiskLevel(int score) {
+    static String determineRiskLevel(int score) {
         if (score >= 80) {
             return "LOW_RISK";
         } else if (score >= 60) {
@@ -179,6 +380,19 @@ public class SecurityScoringService {
         }
     }
     
+    /**
+     * 单个待扣分的问题（严重级别 + 漏洞类型）
+     */
+    private static class Finding {
+        final String severity;
+        final String vulnerabilityType;
+
+        Finding(String severity, String vulnerabilityType) {
+            this.severity = severity;
+            this.vulnerabilityType = vulnerabilityType;
+        }
+    }
+
     /**
      * 安全评分结果
      */
@@ -191,6 +405,7 @@ public class SecurityScoringService {
         private final int mediumCount;
         private final int lowCount;
         private final int complexityPenalty;
+        private final CodeMetrics metrics;
         
         public SecurityScore(String filePath, int score, String riskLevel) {
             this(filePath, score, riskLevel, 0, 0, 0, 0, 0);
@@ -199,6 +414,13 @@ public class SecurityScoringService {
         public SecurityScore(String filePath, int score, String riskLevel, 
                            int criticalCount, int highCount, int mediumCount, int lowCount, 
                            int complexityPenalty) {
+            this(filePath, score, riskLevel, criticalCount, highCount, mediumCount, lowCount,
+                complexityPenalty, null);
+        }
+        
+        public SecurityScore(String filePath, int score, String riskLevel, 
+                           int criticalCount, int highCount, int mediumCount, int lowCount, 
+                           int complexityPenalty, CodeMetrics metrics) {
             this.filePath = filePath;
             this.score = score;
             this.riskLevel = riskLevel;
@@ -207,6 +429,7 @@ public class SecurityScoringService {
             this.mediumCount = mediumCount;
             this.lowCount = lowCount;
             this.complexityPenalty = complexityPenalty;
+            this.metrics = metrics;
         }
         
         // Getters
@@ -218,15 +441,24 @@ public class SecurityScoringService {
         public int getMediumCount() { return mediumCount; }
         public int getLowCount() { return lowCount; }
         public int getComplexityPenalty() { return complexityPenalty; }
+        /** 文件度量，读取失败时为 null */
+        public CodeMetrics getMetrics() { return metrics; }
         public int getTotalIssues() { return criticalCount + highCount + mediumCount + lowCount; }
         
         public String getFileName() {
             return new File(filePath).getName();
         }
+
+        /**
+         * 分诊时使用的模块名（单文件评分即文件名）
+         */
+        public String getModuleName() {
+            return getFileName();
+        }
         
         @Override
         public String toString() {
-            return String.format("%s: %d/100 (%s)", getFileName(), score, riskLevel);
+            return String.format("%s: %d/100 (%s)", getModuleName(), score, riskLevel);
         }
     }
 }
\ No newline at end of file
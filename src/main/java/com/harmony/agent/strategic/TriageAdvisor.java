@@ -24,7 +24,7 @@ public class TriageAdvisor {
      * 为单个模块提供分诊建议
      */
     public TriageRecommendation recommend(SecurityScore score) {
-        String module = score.getFileName();
+        String module = score.getModuleName();
         int securityScore = score.getScore();
         
         RecommendationType recommendation;
@@ -80,6 +80,16 @@ public class TriageAdvisor {
             .toList();
     }
     
+    /**
+     * 按模块（目录或构建目标）聚合文件评分后给出分诊建议
+     */
+    public List<TriageRecommendation> recommendBatch(List<SecurityScore> fileScores, ModuleResolver resolver) {
+        List<SecurityScore> moduleScores = ModuleScore.aggregate(fileScores, resolver);
+        logger.info("Aggregated {} file scores into {} modules ({})",
+            fileScores.size(), moduleScores.size(), resolver.getGranularity());
+        return recommendBatch(moduleScores);
+    }
+    
     /**
      * 生成战略摘要
      */
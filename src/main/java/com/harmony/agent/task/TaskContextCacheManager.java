@@ -1,48 +1,54 @@
 package com.harmony.agent.task;
 
-import com.harmony.agent.core.ai.PersistentCacheManager;
-import com.google.gson.Gson;
-import com.google.gson.GsonBuilder;
+import com.harmony.agent.task.TaskEventLog.Event;
+import com.harmony.agent.task.TaskEventLog.EventType;
+import com.harmony.agent.task.TaskEventLog.ResultRecord;
+import com.harmony.agent.task.TaskEventLog.SessionSnapshot;
+import com.harmony.agent.task.TaskEventLog.TaskRecord;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import java.time.Instant;
 import java.time.LocalDateTime;
+import java.time.ZoneId;
 import java.util.*;
 import java.util.stream.Collectors;
 
 /**
  * 任务上下文缓存管理器
  * 管理 TodoList 的完整上下文缓存（需求、分析结果、任务列表、执行结果）
- * 支持上下文快速恢复和增量更新
+ *
+ * 持久化方式：每个会话一个追加写事件日志 + 周期快照（见 {@link TaskEventLog}）
+ * - 每次状态变化只追加一个事件，写入成本 O(事件)
+ * - 读取直接访问内存中的会话状态
+ * - 崩溃后通过 {@link #recoverSession(String)} 读取快照并重放日志尾部
  */
 public class TaskContextCacheManager {
     private static final Logger logger = LoggerFactory.getLogger(TaskContextCacheManager.class);
 
-    private final PersistentCacheManager cache;
-    private final Gson gson;
+    private final TaskEventLog eventLog;
     private String currentSessionId;  // 当前会话 ID，用于关联缓存数据
 
-    // 缓存键前缀
-    private static final String PREFIX_REQUIREMENT = "task-ctx:requirement:";
-    private static final String PREFIX_ANALYSIS = "task-ctx:analysis:";
-    private static final String PREFIX_TASKS = "task-ctx:tasks:";
-    private static final String PREFIX_TASK_RESULT = "task-ctx:result:";
-    private static final String PREFIX_SESSION = "task-ctx:session:";
-    private static final String PREFIX_CONTEXT = "task-ctx:context:";
+    // 当前会话的内存状态（与快照同构）
+    private SessionSnapshot state;
+    private long lastSeq;
+    private int eventsSinceSnapshot;
 
     public TaskContextCacheManager() {
-        // 使用 "task-context" 作为缓存类型，启用持久化
-        this.cache = new PersistentCacheManager("task-context", true);
-        this.gson = new GsonBuilder().setPrettyPrinting().create();
-        this.currentSessionId = UUID.randomUUID().toString();
+        this(new TaskEventLog());
+    }
+
+    public TaskContextCacheManager(TaskEventLog eventLog) {
+        this.eventLog = eventLog;
+        resetState(UUID.randomUUID().toString());
         logger.info("TaskContextCacheManager initialized with session ID: {}", currentSessionId);
     }
 
     /**
      * 生成新的会话 ID（用于隔离不同的 TodoList 上下文）
      */
-    public String generateNewSession() {
-        this.currentSessionId = UUID.randomUUID().toString();
+    public synchronized String generateNewSession() {
+        resetState(UUID.randomUUID().toString());
         logger.info("新的任务会话已创建: {}", currentSessionId);
         return currentSessionId;
     }
@@ -50,10 +56,38 @@ public class TaskContextCacheManager {
     /**
      * 获取当前会话 ID
      */
-    public String getCurrentSessionId() {
+    public synchronized String getCurrentSessionId() {
         return currentSessionId;
     }
 
+    /**
+     * 从磁盘恢复指定会话（快照 + 日志尾部重放），并切换为当前会话
+     *
+     * @return 会话存在并恢复成功返回 true
+     */
+    public synchronized boolean recoverSession(String sessionId) {
+        TaskEventLog.Recovery recovery = eventLog.recover(sessionId);
+        if (recovery == null) {
+            logger.warn("未找到可恢复的任务会话: {}", sessionId);
+            return false;
+        }
+
+        resetState(sessionId);
+        if (recovery.snapshot != null) {
+            state = recovery.snapshot;
+            lastSeq = recovery.snapshot.lastSeq;
+        }
+        for (Event event : recovery.tail) {
+            apply(event);
+            lastSeq = event.seq;
+        }
+        eventsSinceSnapshot = recovery.tail.size();
+
+        logger.info("✅ 任务会话已恢复: {} (快照: {}, 重放事件: {})",
+            sessionId, recovery.snapshot != null ? "有" : "无", recovery.tail.size());
+        return true;
+    }
+
     /**
      * 缓存原始需求
      */
@@ -61,8 +95,9 @@ public class TaskContextCacheManager {
         if (requirement == null || requirement.isEmpty()) {
             return;
         }
-        String key = PREFIX_REQUIREMENT + currentSessionId;
-        cache.put(key, requirement);
+        Event event = newEvent(EventType.REQUIREMENT);
+        event.text = requirement;
+        record(event);
         logger.info("📝 缓存需求: {} (session: {})",
             truncateForLog(requirement), currentSessionId);
     }
@@ -70,9 +105,8 @@ public class TaskContextCacheManager {
     /**
      * 获取缓存的需求
      */
-    public String getCachedRequirement() {
-        String key = PREFIX_REQUIREMENT + currentSessionId;
-        return cache.get(key);
+    public synchronized String getCachedRequirement() {
+        return state.requirement;
     }
 
     /**
@@ -82,8 +116,9 @@ public class TaskContextCacheManager {
         if (analysisResult == null || analysisResult.isEmpty()) {
             return;
         }
-        String key = PREFIX_ANALYSIS + currentSessionId;
-        cache.put(key, analysisResult);
+        Event event = newEvent(EventType.ANALYSIS);
+        event.text = analysisResult;
+        record(event);
         logger.info("📊 缓存分析结果: {} (session: {})",
             truncateForLog(analysisResult), currentSessionId);
     }
@@ -91,21 +126,20 @@ public class TaskContextCacheManager {
     /**
      * 获取缓存的分析结果
      */
-    public String getCachedAnalysisResult() {
-        String key = PREFIX_ANALYSIS + currentSessionId;
-        return cache.get(key);
+    public synchronized String getCachedAnalysisResult() {
+        return state.analysisResult;
     }
 
     /**
-     * 缓存任务列表（JSON格式）
+     * 缓存任务列表（计划生成时记录一次，之后通过任务事件增量更新）
      */
     public void cacheTaskList(List<Task> tasks) {
         if (tasks == null || tasks.isEmpty()) {
             return;
         }
-        String key = PREFIX_TASKS + currentSessionId;
-        String tasksJson = gson.toJson(tasks);
-        cache.put(key, tasksJson);
+        Event event = newEvent(EventType.PLAN);
+        event.tasks = tasks.stream().map(TaskRecord::from).collect(Collectors.toList());
+        record(event);
         logger.info("✅ 缓存任务列表: {} 个任务 (session: {})",
             tasks.size(), currentSessionId);
     }
@@ -113,31 +147,40 @@ public class TaskContextCacheManager {
     /**
      * 获取缓存的任务列表
      */
-    public List<Task> getCachedTaskList() {
-        String key = PREFIX_TASKS + currentSessionId;
-        String tasksJson = cache.get(key);
-        if (tasksJson == null) {
-            return new ArrayList<>();
-        }
-        try {
-            Task[] tasksArray = gson.fromJson(tasksJson, Task[].class);
-            return tasksArray != null ? Arrays.asList(tasksArray) : new ArrayList<>();
-        } catch (Exception e) {
-            logger.warn("❌ 无法反序列化缓存的任务列表", e);
-            return new ArrayList<>();
-        }
+    public synchronized List<Task> getCachedTaskList() {
+        return state.tasks.stream().map(TaskRecord::toTask).collect(Collectors.toList());
+    }
+
+    /**
+     * 记录任务开始执行
+     */
+    public void recordTaskStarted(int taskId) {
+        Event event = newEvent(EventType.TASK_STARTED);
+        event.taskId = taskId;
+        record(event);
+        logger.debug("▶️ 任务#{} 开始 (session: {})", taskId, currentSessionId);
+    }
+
+    /**
+     * 记录任务被跳过
+     */
+    public void recordTaskSkipped(int taskId) {
+        Event event = newEvent(EventType.TASK_SKIPPED);
+        event.taskId = taskId;
+        record(event);
+        logger.debug("⏭️ 任务#{} 跳过 (session: {})", taskId, currentSessionId);
     }
 
     /**
-     * 缓存单个任务执行结果
+     * 缓存单个任务执行结果（成功的结果同时将任务标记为已完成）
      */
     public void cacheTaskResult(int taskId, String description, String output, boolean success) {
-        String key = PREFIX_TASK_RESULT + currentSessionId + ":" + taskId;
-        TaskResultCache result = new TaskResultCache(
-            taskId, description, output, success, LocalDateTime.now()
-        );
-        String resultJson = gson.toJson(result);
-        cache.put(key, resultJson);
+        Event event = newEvent(EventType.TASK_RESULT);
+        event.taskId = taskId;
+        event.key = description;
+        event.text = output;
+        event.success = success;
+        record(event);
         logger.info("💾 缓存任务结果: 任务#{} (success={}) (session: {})",
             taskId, success, currentSessionId);
     }
@@ -145,81 +188,117 @@ public class TaskContextCacheManager {
     /**
      * 获取缓存的任务执行结果
      */
-    public TaskResultCache getCachedTaskResult(int taskId) {
-        String key = PREFIX_TASK_RESULT + currentSessionId + ":" + taskId;
-        String resultJson = cache.get(key);
-        if (resultJson == null) {
-            return null;
-        }
-        try {
-            return gson.fromJson(resultJson, TaskResultCache.class);
-        } catch (Exception e) {
-            logger.warn("❌ 无法反序列化任务结果 #{}", taskId, e);
-            return null;
-        }
+    public synchronized TaskResultCache getCachedTaskResult(int taskId) {
+        ResultRecord record = state.results.get(taskId);
+        return record != null ? toResultCache(record) : null;
     }
 
     /**
-     * 获取所有已缓存的任务结果
+     * 获取所有已缓存的任务结果（按记录顺序）
      */
-    public List<TaskResultCache> getAllCachedTaskResults() {
-        // 简化实现：遍历缓存中的所有任务结果
-        // 在实际应用中可能需要更复杂的检索逻辑
+    public synchronized List<TaskResultCache> getAllCachedTaskResults() {
         List<TaskResultCache> results = new ArrayList<>();
+        for (ResultRecord record : state.results.values()) {
+            results.add(toResultCache(record));
+        }
+        return results;
+    }
 
-        // 这里是一个占位符，真实实现需要遍历 PersistentCacheManager
-        // 获取所有 PREFIX_TASK_RESULT 前缀的键
-        logger.debug("正在检索所有任务结果...");
+    /**
+     * 记录关键决策
+     */
+    public void recordDecision(String decision, String reasoning) {
+        if (decision == null) {
+            return;
+        }
+        Event event = newEvent(EventType.DECISION);
+        event.key = decision;
+        event.text = reasoning;
+        record(event);
+    }
 
-        return results;
+    /**
+     * 记录约束
+     */
+    public void recordConstraint(String constraint) {
+        if (constraint == null) {
+            return;
+        }
+        Event event = newEvent(EventType.CONSTRAINT);
+        event.text = constraint;
+        record(event);
+    }
+
+    /**
+     * 记录风险
+     */
+    public void recordRisk(String risk) {
+        if (risk == null) {
+            return;
+        }
+        Event event = newEvent(EventType.RISK);
+        event.text = risk;
+        record(event);
     }
 
     /**
      * 缓存完整的执行上下文信息
+     * 只追加与当前会话状态相比新增的部分
      */
     public void cacheExecutionContext(TaskExecutionContext context) {
         if (context == null) {
             return;
         }
-        String key = PREFIX_CONTEXT + currentSessionId;
-        ExecutionContextCache contextCache = new ExecutionContextCache(
-            context.getOriginalRequirement(),
-            context.getAnalysisResult(),
-            context.getDecisions(),
-            context.getConstraints(),
-            context.getRisks(),
-            LocalDateTime.now()
-        );
-        String contextJson = gson.toJson(contextCache);
-        cache.put(key, contextJson);
+        Map<String, String> knownDecisions;
+        Set<String> knownConstraints;
+        Set<String> knownRisks;
+        String knownAnalysis;
+        synchronized (this) {
+            knownDecisions = new HashMap<>(state.decisions);
+            knownConstraints = new HashSet<>(state.constraints);
+            knownRisks = new HashSet<>(state.risks);
+            knownAnalysis = state.analysisResult;
+        }
+
+        if (context.getAnalysisResult() != null
+                && !context.getAnalysisResult().equals(knownAnalysis)) {
+            cacheAnalysisResult(context.getAnalysisResult());
+        }
+        context.getDecisions().forEach((decision, reasoning) -> {
+            if (!Objects.equals(knownDecisions.get(decision), reasoning)) {
+                recordDecision(decision, reasoning);
+            }
+        });
+        context.getConstraints().stream()
+            .filter(c -> !knownConstraints.contains(c))
+            .forEach(this::recordConstraint);
+        context.getRisks().stream()
+            .filter(r -> !knownRisks.contains(r))
+            .forEach(this::recordRisk);
         logger.info("🔄 缓存执行上下文 (session: {})", currentSessionId);
     }
 
     /**
-     * 从缓存恢复执行上下文
+     * 从缓存恢复执行上下文（恢复后的上下文继续写入当前会话）
      */
     public TaskExecutionContext recoverExecutionContext() {
-        String key = PREFIX_CONTEXT + currentSessionId;
-        String contextJson = cache.get(key);
-        if (contextJson == null) {
-            return null;
+        SessionSnapshot current;
+        synchronized (this) {
+            if (state.requirement == null) {
+                return null;
+            }
+            current = state;
         }
-        try {
-            ExecutionContextCache cached = gson.fromJson(contextJson, ExecutionContextCache.class);
-            TaskExecutionContext context = new TaskExecutionContext(cached.originalRequirement);
-            context.setAnalysisResult(cached.analysisResult);
-
-            // 恢复决策和约束
-            cached.decisions.forEach(context::addDecision);
-            cached.constraints.forEach(context::addConstraint);
-            cached.risks.forEach(context::addRisk);
-
-            logger.info("✅ 从缓存恢复执行上下文 (session: {})", currentSessionId);
-            return context;
-        } catch (Exception e) {
-            logger.warn("❌ 无法从缓存恢复执行上下文", e);
-            return null;
+        TaskExecutionContext context = new TaskExecutionContext(current.requirement, this);
+        Map<Integer, TaskExecutionContext.TaskResult> results = new LinkedHashMap<>();
+        synchronized (this) {
+            current.results.forEach((taskId, record) -> results.put(taskId,
+                new TaskExecutionContext.TaskResult(record.description, record.output, record.success)));
+            context.restore(current.analysisResult, new LinkedHashMap<>(current.decisions),
+                new ArrayList<>(current.constraints), new ArrayList<>(current.risks), results);
         }
+        logger.info("✅ 从缓存恢复执行上下文 (session: {})", currentSessionId);
+        return context;
     }
 
     /**
@@ -294,6 +373,10 @@ public class TaskContextCacheManager {
         stats.append("  ├─ 已完成: ").append(completedTasks).append("\n");
         stats.append("  ├─ 进行中: ").append(inProgressTasks).append("\n");
         stats.append("  └─ 待处理: ").append(pendingTasks).append("\n");
+        synchronized (this) {
+            stats.append("✓ 事件日志: seq=").append(lastSeq)
+                .append(", 距上次快照 ").append(eventsSinceSnapshot).append(" 个事件\n");
+        }
 
         stats.append("═══════════════════════════════════════");
         return stats.toString();
@@ -302,12 +385,80 @@ public class TaskContextCacheManager {
     /**
      * 清空当前会话的所有缓存
      */
-    public void clearCurrentSession() {
-        // 这是一个简化的实现
-        // 真实场景可能需要更复杂的清理逻辑
+    public synchronized void clearCurrentSession() {
+        eventLog.delete(currentSessionId);
+        resetState(currentSessionId);
         logger.info("🗑️ 清空会话缓存: {}", currentSessionId);
     }
 
+    // ==================== 事件记录与重放 ====================
+
+    private synchronized Event newEvent(EventType type) {
+        return new Event(++lastSeq, type);
+    }
+
+    /**
+     * 应用事件到内存状态并追加到日志，按间隔写快照
+     */
+    private synchronized void record(Event event) {
+        apply(event);
+        eventLog.append(currentSessionId, event);
+        if (++eventsSinceSnapshot >= eventLog.getSnapshotInterval()) {
+            state.lastSeq = lastSeq;
+            eventLog.writeSnapshot(currentSessionId, state);
+            eventsSinceSnapshot = 0;
+        }
+    }
+
+    /**
+     * 将单个事件应用到内存状态（记录和重放共用）
+     */
+    private void apply(Event event) {
+        switch (event.type) {
+            case REQUIREMENT -> state.requirement = event.text;
+            case ANALYSIS -> state.analysisResult = event.text;
+            case PLAN -> state.tasks = event.tasks != null ? new ArrayList<>(event.tasks) : new ArrayList<>();
+            case TASK_STARTED -> setTaskStatus(event.taskId, Task.TaskStatus.IN_PROGRESS);
+            case TASK_SKIPPED -> setTaskStatus(event.taskId, Task.TaskStatus.SKIPPED);
+            case TASK_RESULT -> {
+                state.results.put(event.taskId, new ResultRecord(event.taskId, event.key, event.text,
+                    Boolean.TRUE.equals(event.success), event.timestamp));
+                if (Boolean.TRUE.equals(event.success)) {
+                    setTaskStatus(event.taskId, Task.TaskStatus.COMPLETED);
+                }
+            }
+            case DECISION -> state.decisions.put(event.key, event.text);
+            case CONSTRAINT -> state.constraints.add(event.text);
+            case RISK -> state.risks.add(event.text);
+        }
+    }
+
+    private void setTaskStatus(Integer taskId, Task.TaskStatus status) {
+        if (taskId == null) {
+            return;
+        }
+        for (TaskRecord task : state.tasks) {
+            if (task.id == taskId) {
+                task.status = status;
+                return;
+            }
+        }
+    }
+
+    private void resetState(String sessionId) {
+        this.currentSessionId = sessionId;
+        this.state = new SessionSnapshot();
+        this.lastSeq = 0L;
+        this.eventsSinceSnapshot = 0;
+    }
+
+    private TaskResultCache toResultCache(ResultRecord record) {
+        LocalDateTime time = LocalDateTime.ofInstant(
+            Instant.ofEpochMilli(record.timestamp), ZoneId.systemDefault());
+        return new TaskResultCache(record.taskId, record.description, record.output,
+            record.success, time);
+    }
+
     /**
      * 截断日志字符串便于显示
      */
@@ -345,27 +496,4 @@ public class TaskContextCacheManager {
             this.timestamp = timestamp;
         }
     }
-
-    /**
-     * 执行上下文缓存对象
-     */
-    public static class ExecutionContextCache {
-        public String originalRequirement;
-        public String analysisResult;
-        public Map<String, String> decisions;
-        public List<String> constraints;
-        public List<String> risks;
-        public LocalDateTime timestamp;
-
-        public ExecutionContextCache(String originalRequirement, String analysisResult,
-                                     Map<String, String> decisions, List<String> constraints,
-                                     List<String> risks, LocalDateTime timestamp) {
-            this.originalRequirement = originalRequirement;
-            this.analysisResult = analysisResult;
-            this.decisions = new HashMap<>(decisions);
-            this.constraints = new ArrayList<>(constraints);
-            this.risks = new ArrayList<>(risks);
-            this.timestamp = timestamp;
-        }
-    }
 }
@@ -0,0 +1,318 @@
+package com.harmony.agent.task;
+
+import com.google.gson.Gson;
+import com.google.gson.JsonParseException;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.*;
+import java.util.*;
+
+/**
+ * 任务会话事件日志（追加写 + 周期快照）
+ *
+ * 每个会话对应两个文件:
+ * - {sessionId}.log      每行一个紧凑 JSON 事件，只追加
+ * - {sessionId}.snapshot 最近一次快照（原子替换），记录其覆盖到的事件序号
+ *
+ * 写入成本为 O(单个事件)；恢复时读取快照并只重放其后的日志尾部。
+ * 快照写入后日志被截断，崩溃发生在两者之间时依靠序号跳过已包含的事件。
+ *
+ * 交互模式启动时恢复最近的未完成计划（见 TodoListManager#recoverUnfinishedPlan），
+ * 计划完成、中止或清除后删除其会话文件，其余遗留会话在恢复时一并清理。
+ */
+public class TaskEventLog {
+    private static final Logger logger = LoggerFactory.getLogger(TaskEventLog.class);
+
+    private static final String SESSION_DIR =
+        System.getProperty("user.home") + "/.harmony_agent/task-sessions";
+    private static final String LOG_SUFFIX = ".log";
+    private static final String SNAPSHOT_SUFFIX = ".snapshot";
+
+    /** 每累计多少个事件写一次快照 */
+    public static final int DEFAULT_SNAPSHOT_INTERVAL = 64;
+
+    private final Path directory;
+    private final int snapshotInterval;
+    private final Gson gson;
+
+    /**
+     * 使用默认目录 (~/.harmony_agent/task-sessions)
+     */
+    public TaskEventLog() {
+        this(Paths.get(SESSION_DIR), DEFAULT_SNAPSHOT_INTERVAL);
+    }
+
+    public TaskEventLog(Path directory, int snapshotInterval) {
+        this.directory = directory;
+        this.snapshotInterval = Math.max(1, snapshotInterval);
+        // 紧凑格式：一行一个事件
+        this.gson = new Gson();
+        try {
+            Files.createDirectories(directory);
+        } catch (IOException e) {
+            logger.warn("无法创建任务会话目录: {}", directory, e);
+        }
+    }
+
+    public int getSnapshotInterval() {
+        return snapshotInterval;
+    }
+
+    /**
+     * 追加一个事件（单行 JSON）
+     *
+     * @return 是否写入成功；失败只影响持久化，不影响内存状态
+     */
+    public boolean append(String sessionId, Event event) {
+        String line = gson.toJson(event) + "\n";
+        try {
+            Files.writeString(logFile(sessionId), line, StandardCharsets.UTF_8,
+                StandardOpenOption.CREATE, StandardOpenOption.APPEND);
+            return true;
+        } catch (IOException e) {
+            logger.warn("写入任务事件失败 (session: {}): {}", sessionId, e.getMessage());
+            return false;
+        }
+    }
+
+    /**
+     * 写入快照并截断日志
+     * 快照先写临时文件再原子替换，保证任何时刻磁盘上都有一个完整快照
+     */
+    public void writeSnapshot(String sessionId, SessionSnapshot snapshot) {
+        Path target = snapshotFile(sessionId);
+        Path tmp = directory.resolve(sessionId + SNAPSHOT_SUFFIX + ".tmp");
+        try {
+            Files.writeString(tmp, gson.toJson(snapshot), StandardCharsets.UTF_8);
+            try {
+                Files.move(tmp, target, StandardCopyOption.REPLACE_EXISTING,
+                    StandardCopyOption.ATOMIC_MOVE);
+            } catch (AtomicMoveNotSupportedException e) {
+                Files.move(tmp, target, StandardCopyOption.REPLACE_EXISTING);
+            }
+            // 快照已包含全部事件，日志从空开始
+            Files.writeString(logFile(sessionId), "", StandardCharsets.UTF_8,
+                StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING);
+            logger.debug("任务会话快照已写入 (session: {}, seq: {})", sessionId, snapshot.lastSeq);
+        } catch (IOException e) {
+            logger.warn("写入任务会话快照失败 (session: {}): {}", sessionId, e.getMessage());
+        }
+    }
+
+    /**
+     * 恢复会话：快照 + 日志尾部
+     *
+     * @return 恢复结果；会话不存在时返回 null
+     */
+    public Recovery recover(String sessionId) {
+        SessionSnapshot snapshot = readSnapshot(sessionId);
+        List<Event> tail = new ArrayList<>();
+        long afterSeq = snapshot != null ? snapshot.lastSeq : 0L;
+
+        Path log = logFile(sessionId);
+        if (Files.exists(log)) {
+            try (BufferedReader reader = Files.newBufferedReader(log, StandardCharsets.UTF_8)) {
+                String line;
+                while ((line = reader.readLine()) != null) {
+                    if (line.isBlank()) {
+                        continue;
+                    }
+                    Event event;
+                    try {
+                        event = gson.fromJson(line, Event.class);
+                    } catch (JsonParseException e) {
+                        // 崩溃时最后一行可能写了一半，之后的内容不可信
+                        logger.warn("任务事件日志尾部损坏，停止重放 (session: {})", sessionId);
+                        break;
+                    }
+                    if (event != null && event.seq > afterSeq) {
+                        tail.add(event);
+                    }
+                }
+            } catch (IOException e) {
+                logger.warn("读取任务事件日志失败 (session: {}): {}", sessionId, e.getMessage());
+            }
+        }
+
+        if (snapshot == null && tail.isEmpty()) {
+            return null;
+        }
+        return new Recovery(snapshot, tail);
+    }
+
+    /**
+     * 删除会话的日志和快照
+     */
+    public void delete(String sessionId) {
+        try {
+            Files.deleteIfExists(logFile(sessionId));
+            Files.deleteIfExists(snapshotFile(sessionId));
+        } catch (IOException e) {
+            logger.warn("删除任务会话文件失败 (session: {}): {}", sessionId, e.getMessage());
+        }
+    }
+
+    /**
+     * 列出磁盘上的所有会话，最近修改的在前
+     */
+    public List<String> listSessions() {
+        Map<String, Long> modified = new HashMap<>();
+        try (DirectoryStream<Path> files = Files.newDirectoryStream(directory)) {
+            for (Path file : files) {
+                String name = file.getFileName().toString();
+                String sessionId = name.endsWith(LOG_SUFFIX) ? name.substring(0, name.length() - LOG_SUFFIX.length())
+                    : name.endsWith(SNAPSHOT_SUFFIX) ? name.substring(0, name.length() - SNAPSHOT_SUFFIX.length())
+                    : null;
+                if (sessionId != null) {
+                    modified.merge(sessionId, Files.getLastModifiedTime(file).toMillis(), Math::max);
+                }
+            }
+        } catch (IOException e) {
+            logger.warn("列出任务会话失败: {}", e.getMessage());
+        }
+        List<String> sessions = new ArrayList<>(modified.keySet());
+        sessions.sort(Comparator.comparing(modified::get, Comparator.reverseOrder()));
+        return sessions;
+    }
+
+    private SessionSnapshot readSnapshot(String sessionId) {
+        Path file = snapshotFile(sessionId);
+        if (!Files.exists(file)) {
+            return null;
+        }
+        try {
+            return gson.fromJson(Files.readString(file, StandardCharsets.UTF_8), SessionSnapshot.class);
+        } catch (IOException | JsonParseException e) {
+            logger.warn("读取任务会话快照失败 (session: {}): {}", sessionId, e.getMessage());
+            return null;
+        }
+    }
+
+    private Path logFile(String sessionId) {
+        return directory.resolve(sessionId + LOG_SUFFIX);
+    }
+
+    private Path snapshotFile(String sessionId) {
+        return directory.resolve(sessionId + SNAPSHOT_SUFFIX);
+    }
+
+    // ==================== 数据类 ====================
+
+    /**
+     * 事件类型
+     */
+    public enum EventType {
+        REQUIREMENT,
+        ANALYSIS,
+        PLAN,
+        TASK_STARTED,
+        TASK_RESULT,
+        TASK_SKIPPED,
+        DECISION,
+        CONSTRAINT,
+        RISK
+    }
+
+    /**
+     * 单个事件；未使用的字段为 null，Gson 不会序列化
+     */
+    public static class Event {
+        public long seq;
+        public EventType type;
+        public long timestamp;
+        public Integer taskId;
+        public String key;
+        public String text;
+        public Boolean success;
+        public List<TaskRecord> tasks;
+
+        public Event(long seq, EventType type) {
+            this.seq = seq;
+            this.type = type;
+            this.timestamp = System.currentTimeMillis();
+        }
+    }
+
+    /**
+     * 任务的可序列化表示（不依赖 LocalDateTime 的反射序列化）
+     */
+    public static class TaskRecord {
+        public int id;
+        public String description;
+        public Task.TaskStatus status;
+        public List<Integer> dependsOn;
+
+        public TaskRecord(int id, String description, Task.TaskStatus status, List<Integer> dependsOn) {
+            this.id = id;
+            this.description = description;
+            this.status = status;
+            this.dependsOn = dependsOn;
+        }
+
+        public static TaskRecord from(Task task) {
+            return new TaskRecord(task.getId(), task.getDescription(), task.getStatus(),
+                task.getDependencies());
+        }
+
+        public Task toTask() {
+            Task task = new Task(id, description);
+            if (status != null) {
+                task.setStatus(status);
+            }
+            if (dependsOn != null) {
+                dependsOn.forEach(task::addDependency);
+            }
+            return task;
+        }
+    }
+
+    /**
+     * 任务结果的可序列化表示
+     */
+    public static class ResultRecord {
+        public int taskId;
+        public String description;
+        public String output;
+        public boolean success;
+        public long timestamp;
+
+        public ResultRecord(int taskId, String description, String output, boolean success, long timestamp) {
+            this.taskId = taskId;
+            this.description = description;
+            this.output = output;
+            this.success = success;
+            this.timestamp = timestamp;
+        }
+    }
+
+    /**
+     * 会话快照：完整的会话状态 + 覆盖到的最后一个事件序号
+     */
+    public static class SessionSnapshot {
+        public long lastSeq;
+        public String requirement;
+        public String analysisResult;
+        public List<TaskRecord> tasks = new ArrayList<>();
+        public Map<Integer, ResultRecord> results = new LinkedHashMap<>();
+        public Map<String, String> decisions = new LinkedHashMap<>();
+        public List<String> constraints = new ArrayList<>();
+        public List<String> risks = new ArrayList<>();
+    }
+
+    /**
+     * 恢复结果
+     */
+    public static class Recovery {
+        public final SessionSnapshot snapshot;
+        public final List<Event> tail;
+
+        public Recovery(SessionSnapshot snapshot, List<Event> tail) {
+            this.snapshot = snapshot;
+            this.tail = tail;
+        }
+    }
+}
@@ -22,16 +22,37 @@ public class TaskExecutionContext {
     private String sessionId;  // 关联的会话 ID
 
     public TaskExecutionContext(String requirement) {
+        this(requirement, new TaskContextCacheManager());
+
+        // 立即缓存需求
+        cacheManager.cacheRequirement(requirement);
+    }
+
+    /**
+     * 绑定到已有缓存管理器（用于会话恢复，不重复记录需求）
+     */
+    TaskExecutionContext(String requirement, TaskContextCacheManager cacheManager) {
         this.originalRequirement = requirement;
         this.decisions = new HashMap<>();
         this.constraints = new ArrayList<>();
         this.risks = new ArrayList<>();
         this.taskResults = new HashMap<>();
-        this.cacheManager = new TaskContextCacheManager();
+        this.cacheManager = cacheManager;
         this.sessionId = cacheManager.getCurrentSessionId();
+    }
 
-        // 立即缓存需求
-        cacheManager.cacheRequirement(requirement);
+    /**
+     * 从会话状态恢复字段，不产生新的缓存事件
+     */
+    void restore(String analysisResult, Map<String, String> decisions, List<String> constraints,
+                 List<String> risks, Map<Integer, TaskResult> taskResults) {
+        this.analysisResult = analysisResult;
+        // 分析结果中的约束/风险重新提取，显式记录的再去重追加
+        this.extractMetadataFromAnalysis();
+        this.decisions.putAll(decisions);
+        constraints.stream().filter(c -> !this.constraints.contains(c)).forEach(this.constraints::add);
+        risks.stream().filter(r -> !this.risks.contains(r)).forEach(this.risks::add);
+        this.taskResults.putAll(taskResults);
     }
 
     public String getOriginalRequirement() {
@@ -53,6 +74,9 @@ public class TaskExecutionContext {
 
     public void addDecision(String decision, String reasoning) {
         decisions.put(decision, reasoning);
+        if (cacheManager != null) {
+            cacheManager.recordDecision(decision, reasoning);
+        }
     }
 
     public Map<String, String> getDecisions() {
@@ -61,6 +85,9 @@ public class TaskExecutionContext {
 
     public void addConstraint(String constraint) {
         constraints.add(constraint);
+        if (cacheManager != null) {
+            cacheManager.recordConstraint(constraint);
+        }
     }
 
     public List<String> getConstraints() {
@@ -69,6 +96,9 @@ public class TaskExecutionContext {
 
     public void addRisk(String risk) {
         risks.add(risk);
+        if (cacheManager != null) {
+            cacheManager.recordRisk(risk);
+        }
     }
 
     public List<String> getRisks() {
@@ -83,6 +113,24 @@ public class TaskExecutionContext {
         }
     }
 
+    /**
+     * 记录任务开始执行
+     */
+    public void recordTaskStarted(int taskId) {
+        if (cacheManager != null) {
+            cacheManager.recordTaskStarted(taskId);
+        }
+    }
+
+    /**
+     * 记录任务被跳过
+     */
+    public void recordTaskSkipped(int taskId) {
+        if (cacheManager != null) {
+            cacheManager.recordTaskSkipped(taskId);
+        }
+    }
+
     public TaskResult getTaskResult(int taskId) {
         return taskResults.get(taskId);
     }
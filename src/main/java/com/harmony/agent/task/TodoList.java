@@ -30,6 +30,23 @@ public class TodoList {
         }
     }
 
+    /**
+     * 从恢复的会话重建任务列表，当前任务为第一个未完成且未跳过的任务
+     */
+    static TodoList restore(String requirement, String analysisResult, List<Task> restoredTasks) {
+        TodoList todoList = new TodoList(requirement, List.of());
+        todoList.tasks.addAll(restoredTasks);
+        todoList.analysisResult = analysisResult;
+        while (todoList.currentTaskIndex < todoList.tasks.size()) {
+            Task task = todoList.tasks.get(todoList.currentTaskIndex);
+            if (!task.isCompleted() && !task.isSkipped()) {
+                break;
+            }
+            todoList.currentTaskIndex++;
+        }
+        return todoList;
+    }
+
     /**
      * Get the current task being worked on
      */
@@ -9,6 +9,7 @@ import org.slf4j.LoggerFactory;
 
 import java.util.List;
 import java.util.Optional;
+import java.util.function.Supplier;
 
 /**
  * Enhanced Todo List Manager with parallel execution support
@@ -22,22 +23,84 @@ import java.util.Optional;
 public class TodoListManager {
     private static final Logger logger = LoggerFactory.getLogger(TodoListManager.class);
 
-    private final LLMClient llmClient;
+    private final Supplier<LLMClient> llmClient;  // 首次需要时才创建（恢复计划不需要 LLM）
     private final ConsolePrinter printer;
     private TodoList activeTodoList;
     private TaskRetryPolicy retryPolicy;
     private TaskExecutionContext executionContext;
     private TaskDependencyResolver dependencyResolver;
     private InteractiveTaskExecutor interactiveExecutor;
-    private AIMemoryManager aiMemoryManager;  // AI 记忆管理器
+    private AIMemoryManager aiMemoryManager;  // AI 记忆管理器（首次使用时创建）
+    private final TaskEventLog eventLog;  // 任务会话事件日志（计划完成或放弃时删除）
 
     public TodoListManager(LLMClient llmClient, ConsolePrinter printer) {
+        this(() -> llmClient, printer);
+    }
+
+    public TodoListManager(Supplier<LLMClient> llmClient, ConsolePrinter printer) {
+        this(llmClient, printer, new TaskEventLog());
+    }
+
+    TodoListManager(Supplier<LLMClient> llmClient, ConsolePrinter printer, TaskEventLog eventLog) {
         this.llmClient = llmClient;
         this.printer = printer;
+        this.eventLog = eventLog;
         this.retryPolicy = new TaskRetryPolicy();
         this.interactiveExecutor = new InteractiveTaskExecutor(printer);
-        this.aiMemoryManager = new AIMemoryManager();  // 初始化 AI 记忆管理器
-        logger.info("AI 记忆管理器已初始化");
+    }
+
+    /**
+     * 恢复上次运行中未完成的任务计划（最近的一个会话）
+     * 其余会话（已无法继续或更早的计划）从磁盘删除
+     *
+     * @return 恢复了未完成的计划返回 true
+     */
+    public boolean recoverUnfinishedPlan() {
+        if (activeTodoList != null) {
+            return false;
+        }
+        for (String sessionId : eventLog.listSessions()) {
+            if (activeTodoList == null && restoreSession(sessionId)) {
+                continue;
+            }
+            eventLog.delete(sessionId);
+        }
+        if (activeTodoList == null) {
+            return false;
+        }
+
+        printer.info("已恢复上次未完成的任务计划: " + activeTodoList.getRequirement());
+        printer.info("当前进度: " + getProgressSummary());
+        printer.info("使用 /next 继续执行，或 /tasks 查看所有任务");
+        return true;
+    }
+
+    private boolean restoreSession(String sessionId) {
+        TaskContextCacheManager cacheManager = new TaskContextCacheManager(eventLog);
+        if (!cacheManager.recoverSession(sessionId)) {
+            return false;
+        }
+        List<Task> tasks = cacheManager.getCachedTaskList();
+        if (tasks.stream().allMatch(task -> task.isCompleted() || task.isSkipped())) {
+            return false;  // 没有计划或计划已结束
+        }
+        TaskExecutionContext context = cacheManager.recoverExecutionContext();
+        if (context == null) {
+            return false;
+        }
+
+        for (Task task : tasks) {
+            TaskContextCacheManager.TaskResultCache result = cacheManager.getCachedTaskResult(task.getId());
+            if (result != null && task.isCompleted()) {
+                task.setOutput(result.output);
+            }
+        }
+        activeTodoList = TodoList.restore(context.getOriginalRequirement(), context.getAnalysisResult(), tasks);
+        executionContext = context;
+        retryPolicy = new TaskRetryPolicy();
+        dependencyResolver = new TaskDependencyResolver(activeTodoList.getAllTasks());
+        logger.info("已恢复任务会话 {}，共 {} 个任务", sessionId, tasks.size());
+        return true;
     }
 
     /**
@@ -72,7 +135,9 @@ public class TodoListManager {
         }
 
         // 第三步：初始化执行上下文
-        executionContext = new TaskExecutionContext(requirement);
+        TaskContextCacheManager cacheManager = new TaskContextCacheManager(eventLog);
+        executionContext = new TaskExecutionContext(requirement, cacheManager);
+        cacheManager.cacheRequirement(requirement);
         retryPolicy = new TaskRetryPolicy();
 
         // 显示分析进度
@@ -81,13 +146,14 @@ public class TodoListManager {
 
         try {
             // 第四步：调用 PlannerRole 进行需求分析
-            List<String> tasks = llmClient.breakdownRequirement(requirement);
+            List<String> tasks = llmClient.get().breakdownRequirement(requirement);
 
             printer.spinner("分析需求并生成任务计划", true);
 
             if (tasks == null || tasks.isEmpty()) {
                 printer.error("需求分析失败：未生成任务");
                 logger.error("PlannerRole 返回空任务列表");
+                discardSession();
                 return null;
             }
 
@@ -106,6 +172,7 @@ public class TodoListManager {
                 printer.error("任务间存在循环依赖，无法执行");
                 logger.error("Task dependency graph contains cycles");
                 activeTodoList = null;
+                discardSession();
                 return null;
             }
 
@@ -119,7 +186,7 @@ public class TodoListManager {
             printer.info(dependencyResolver.getExecutionStats());
 
             // 自动启动第一个任务
-            if (activeTodoList.startCurrentTask()) {
+            if (startCurrentTask()) {
                 printer.blank();
                 printer.info("开始执行第一个任务...");
                 displayCurrentTask();
@@ -133,6 +200,7 @@ public class TodoListManager {
             printer.error("创建任务列表失败: " + e.getMessage());
             logger.error("创建任务列表时发生异常", e);
             activeTodoList = null;
+            discardSession();
             return null;
         }
     }
@@ -163,7 +231,7 @@ public class TodoListManager {
         if (retryPolicy.isTaskSkipped(task.getId())) {
             printer.warning(String.format("任务 %d 已被跳过（失败次数过多）", task.getId()));
             printer.info(String.format("失败原因: %s", retryPolicy.getFailureReason(task.getId())));
-            activeTodoList.skipTask(task.getId());
+            skipTask(task.getId());
             return executeCurrentTask();
         }
 
@@ -210,7 +278,7 @@ public class TodoListManager {
                 }
 
                 // 启动下一个任务
-                activeTodoList.startCurrentTask();
+                startCurrentTask();
                 printer.blank();
                 displayCurrentTask();
                 return true;
@@ -262,7 +330,7 @@ public class TodoListManager {
         return switch (type) {
             case ROLE -> {
                 String roleName = AdvancedTaskRouter.getLLMRole(decision);
-                yield llmClient.executeTask(task.getDescription(), context);
+                yield llmClient.get().executeTask(task.getDescription(), context);
             }
             case LOCAL_TOOL -> {
                 String toolName = AdvancedTaskRouter.getLocalTool(decision);
@@ -319,17 +387,40 @@ public class TodoListManager {
             }
             case SKIP_TASK -> {
                 printer.error(String.format("❌ 任务 %d 已被跳过", task.getId()));
-                activeTodoList.skipTask(task.getId());
+                skipTask(task.getId());
                 yield executeCurrentTask();
             }
             case ABORT_PLAN -> {
                 printer.error("计划已被用户中止");
                 activeTodoList = null;
+                discardSession();
                 yield false;
             }
         };
     }
 
+    /**
+     * 启动当前任务并记录到会话事件日志
+     */
+    private boolean startCurrentTask() {
+        boolean started = activeTodoList.startCurrentTask();
+        if (started && executionContext != null) {
+            activeTodoList.getCurrentTask()
+                .ifPresent(task -> executionContext.recordTaskStarted(task.getId()));
+        }
+        return started;
+    }
+
+    /**
+     * 跳过任务并记录到会话事件日志
+     */
+    private void skipTask(int taskId) {
+        activeTodoList.skipTask(taskId);
+        if (executionContext != null) {
+            executionContext.recordTaskSkipped(taskId);
+        }
+    }
+
     /**
      * 处理所有任务完成的情况
      */
@@ -351,10 +442,20 @@ public class TodoListManager {
         }
 
         activeTodoList = null;  // 清除活跃列表
-        executionContext = null;
+        discardSession();
         retryPolicy = null;
     }
 
+    /**
+     * 删除当前计划的会话日志和快照（计划完成、中止或清除后不再需要恢复）
+     */
+    private void discardSession() {
+        if (executionContext != null && executionContext.getCacheManager() != null) {
+            executionContext.getCacheManager().clearCurrentSession();
+        }
+        executionContext = null;
+    }
+
     /**
      * Display the current todo list
      */
@@ -400,6 +501,7 @@ public class TodoListManager {
      */
     public void clearTodoList() {
         activeTodoList = null;
+        discardSession();
         printer.info("Todo list cleared.");
     }
 
@@ -445,7 +547,7 @@ public class TodoListManager {
         }
 
         // 添加 AI 记忆信息（已知的代码问题库）
-        String issueContext = aiMemoryManager.buildIssueContext();
+        String issueContext = getAIMemoryManager().buildIssueContext();
         if (issueContext != null && !issueContext.isEmpty()) {
             context.append(issueContext).append("\n");
         }
@@ -483,7 +585,7 @@ public class TodoListManager {
      * 获取 AI 记忆统计信息
      */
     public String getAIMemoryStats() {
-        return aiMemoryManager.getCacheStats();
+        return getAIMemoryManager().getCacheStats();
     }
 
     /**
@@ -513,6 +615,10 @@ public class TodoListManager {
      * 获取 AI 记忆管理器（允许外部访问）
      */
     public AIMemoryManager getAIMemoryManager() {
+        if (aiMemoryManager == null) {
+            aiMemoryManager = new AIMemoryManager();
+            logger.info("AI 记忆管理器已初始化");
+        }
         return aiMemoryManager;
     }
 
@@ -0,0 +1,237 @@
+package com.harmony.agent.core.ai;
+
+import com.harmony.agent.core.metrics.AnalysisMetrics;
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.parser.SourceModel;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.List;
+import java.util.Optional;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.ArgumentMatchers.*;
+import static org.mockito.Mockito.*;
+
+/**
+ * DataflowPrefilter 单元测试
+ */
+@DisplayName("单元测试: DataflowPrefilter")
+class DataflowPrefilterTest {
+
+    private final DataflowPrefilter prefilter = new DataflowPrefilter();
+
+    @Test
+    @DisplayName("分配结果在下一行判空：排除")
+    void testAllocationNullChecked() {
+        String code = """
+            void f(int n) {
+                struct node *p = malloc(sizeof(*p));
+                if (p == NULL) {
+                    return;
+                }
+                p->next = 0;
+            }
+            void g(void) {
+                s->buf = (char *) calloc(1, 16);
+                if (!s->buf) return;
+            }
+            void h(void) {
+                q = malloc(8);
+                q->x = 1;
+                if (q) {}
+            }
+            """;
+
+        assertTrue(refute(code, "null-deref-after-malloc", 2).orElseThrow().contains("line 3"));
+        assertTrue(refute(code, "null-deref-after-malloc", 9).isPresent());
+        assertTrue(refute(code, "null-deref-after-malloc", 13).isEmpty());
+        // 其他规则不受影响
+        assertTrue(refute(code, "memory-leak-malloc", 2).isEmpty());
+    }
+
+    @Test
+    @DisplayName("判空嵌套在其他条件下或不是紧随的语句：保留")
+    void testNestedNullCheckKept() {
+        String code = """
+            void f(int n, int flag) {
+                char *p = malloc(n);
+                if (flag) { if (!p) return; }
+                memcpy(p, "x", 1);
+            }
+            void g(int n) {
+                char *q = malloc(n);
+                log_size(n);
+                if (q == NULL) return;
+            }
+            void h(int n) {
+                char *r = malloc(n);
+                if (n > 0 && r != NULL) { r[0] = 0; }
+            }
+            """;
+
+        assertTrue(refute(code, "null-deref-after-malloc", 2).isEmpty());
+        assertTrue(refute(code, "null-deref-after-malloc", 7).isEmpty());
+        // && 组合：n <= 0 时 NULL 的 r 照样落到后面
+        assertTrue(refute(code, "null-deref-after-malloc", 12).isEmpty());
+    }
+
+    @Test
+    @DisplayName("只有在 NULL 时离开的检查才算判空：assert、真值测试、不离开的分支：保留")
+    void testOnlyLeavingNullCheckCounts() {
+        String code = """
+            void a(int n) {
+                char *p = malloc(n);
+                assert(p != NULL);
+                p[0] = 0;
+            }
+            void b(int n) {
+                char *q = malloc(n);
+                if (q) { q[0] = 0; }
+                q[1] = 0;
+            }
+            void c(int n) {
+                char *r = malloc(n);
+                if (r == NULL) { log_error("oom"); }
+                r[0] = 0;
+            }
+            void d(int n) {
+                char *s = malloc(n);
+                if (n == 0 || NULL == s) { log_error("oom"); exit(1); }
+                s[0] = 0;
+            }
+            int e(int n) {
+                char *t;
+                if ((t = malloc(n)) == NULL) goto fail;
+                return 0;
+            fail:
+                return -1;
+            }
+            void f(int n) {
+                char *u;
+                if ((u = malloc(n)) == NULL) { u = fallback; }
+            }
+            """;
+
+        assertTrue(refute(code, "null-deref-after-malloc", 2).isEmpty());
+        assertTrue(refute(code, "null-deref-after-malloc", 7).isEmpty());
+        assertTrue(refute(code, "null-deref-after-malloc", 12).isEmpty());
+        assertTrue(refute(code, "null-deref-after-malloc", 17).isPresent());
+        assertTrue(refute(code, "null-deref-after-malloc", 23).isPresent());
+        assertTrue(refute(code, "null-deref-after-malloc", 30).isEmpty());
+    }
+
+    @Test
+    @DisplayName("字符串字面量拷贝进足够大的数组：排除；数组不够或非字面量：保留")
+    void testLiteralCopyFits() {
+        String code = """
+            static char global_name[4];
+            void f(const char *user) {
+                char buf[16];
+                char small[5];
+                strcpy(buf, "hello");
+                strcpy(small, "hello");
+                strcpy(buf, user);
+                strcpy(global_name, "abc");
+                strcpy(buf, "a\\x41\\n" "b");
+            }
+            void g(char dst[64]) {
+                strcpy(dst, "x");
+            }
+            """;
+
+        assertTrue(refute(code, "buffer-overflow-strcpy", 5).orElseThrow().contains("char buf[16] at line 3"));
+        assertTrue(refute(code, "buffer-overflow-strcpy", 6).isEmpty());
+        assertTrue(refute(code, "buffer-overflow-strcpy", 7).isEmpty());
+        assertTrue(refute(code, "Unsafe use of strcpy() can lead to buffer overflow", 8).isPresent());
+        assertTrue(refute(code, "buffer-overflow-strcpy", 9).orElseThrow().contains("5-byte"));
+        // 数组形参退化为指针，不据此排除
+        assertTrue(refute(code, "buffer-overflow-strcpy", 12).isEmpty());
+    }
+
+    @Test
+    @DisplayName("兄弟作用域中的同名声明不参与判断")
+    void testSiblingScopeIgnored() {
+        String code = """
+            void f(char *buf) {
+                {
+                    char buf[64];
+                }
+                strcpy(buf, "hello");
+            }
+            """;
+
+        assertTrue(refute(code, "buffer-overflow-strcpy", 5).isEmpty());
+    }
+
+    @Test
+    @DisplayName("free 后立即置空：排除 double-free / use-after-free")
+    void testNulledAfterFree() {
+        String code = """
+            void f(struct ctx *c) {
+                free(c->data);
+                c->data = NULL;
+                free(c->data);
+            }
+            void g(char *p) {
+                free(p);
+                log(p);
+                p = NULL;
+            }
+            """;
+
+        assertTrue(refute(code, "double-free", 2).orElseThrow().contains("c->data is set to NULL"));
+        assertTrue(refute(code, "use-after-free", 4).isPresent());
+        assertTrue(refute(code, "double-free", 7).isEmpty());
+        assertTrue(refute(code, "use-after-free", 8).isEmpty());
+    }
+
+    @Test
+    @DisplayName("被排除的问题不再发送给 AI，原因写入统计")
+    void testDecisionEngineSkipsAi() throws Exception {
+        String code = """
+            void f(void) {
+                char buf[16];
+                strcpy(buf, "hello");
+            }
+            """;
+        CachedAiValidationClient aiClient = mock(CachedAiValidationClient.class);
+        CodeSlicer slicer = mock(CodeSlicer.class);
+        when(slicer.getContextSlice(any(), anyInt())).thenReturn("mock code context");
+        when(slicer.getModel(any())).thenReturn(SourceModel.parse(code));
+        ExecutorService executor = Executors.newSingleThreadExecutor();
+        try {
+            DecisionEngine engine = new DecisionEngine(aiClient, slicer, executor, 2);
+            AnalysisMetrics metrics = new AnalysisMetrics();
+
+            List<SecurityIssue> result = engine.enhanceIssues(List.of(issue("buffer-overflow-strcpy", 3)), metrics);
+
+            assertTrue(result.isEmpty());
+            assertEquals(1, metrics.getCounter("dataflow_refuted"));
+            verify(aiClient, never()).sendRequest(anyString(), anyBoolean());
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+
+    private Optional<String> refute(String code, String rule, int line) {
+        return prefilter.refute(issue(rule, line), SourceModel.parse(code));
+    }
+
+    private static SecurityIssue issue(String rule, int line) {
+        return new SecurityIssue.Builder()
+            .id(rule + "-" + line)
+            .title(rule)
+            .description("test")
+            .severity(IssueSeverity.HIGH)
+            .category(IssueCategory.BUFFER_OVERFLOW)
+            .location(new CodeLocation("test.c", line))
+            .analyzer("Semgrep")
+            .build();
+    }
+}
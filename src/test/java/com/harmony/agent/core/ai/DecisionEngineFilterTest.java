@@ -1,9 +1,16 @@
 package com.harmony.agent.core.ai;
 
+import com.harmony.agent.core.metrics.AnalysisMetrics;
 import com.harmony.agent.core.model.*;
+import com.harmony.agent.core.parser.CallGraph;
+import com.harmony.agent.core.parser.ProjectFacts;
+import com.harmony.agent.core.parser.SourceModelCache;
 import org.junit.jupiter.api.Test;
 import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.io.TempDir;
 
+import java.nio.file.Files;
+import java.nio.file.Path;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.concurrent.Executors;
@@ -123,6 +130,84 @@ class DecisionEngineFilterTest {
         System.out.println("   Output: 0 issues (all filtered)");
     }
 
+    @Test
+    void testRaceConditionPrefilterUsesProjectFacts(@TempDir Path tempDir) throws Exception {
+        Path counter = tempDir.resolve("counter.c");
+        Files.writeString(counter, "int counter;\nvoid bump(void) {\n    counter++;\n}\n");
+        SecurityIssue race = new SecurityIssue.Builder()
+            .id("RACE-001")
+            .title("missing-mutex-lock")
+            .description("Potential race condition. Global variable modified without mutex protection.")
+            .severity(IssueSeverity.MEDIUM)
+            .category(IssueCategory.RACE_CONDITION)
+            .location(new CodeLocation(counter.toString(), 3))
+            .analyzer("SemgrepAnalyzer")
+            .build();
+        when(mockAiClient.sendRequest(anyString(), anyBoolean()))
+            .thenReturn("{\"is_vulnerability\": true, \"reason\": \"Shared counter\", \"suggested_severity\": \"MEDIUM\"}");
+
+        // The slice mentions "async", but no file in the project creates a thread
+        when(mockCodeSlicer.getContextSlice(any(), anyInt())).thenReturn("void bump(void) { counter++; } // async");
+        decisionEngine.setProjectFacts(ProjectFacts.build(List.of(counter), null, new SourceModelCache()));
+        assertTrue(decisionEngine.enhanceIssues(List.of(race)).isEmpty());
+        verify(mockAiClient, never()).sendRequest(anyString(), anyBoolean());
+
+        // The slice looks single-threaded, but another file starts threads: ask the AI with project facts
+        Path worker = tempDir.resolve("worker.c");
+        Files.writeString(worker, "void start(void) {\n    pthread_create(&t, NULL, run, NULL);\n}\n");
+        when(mockCodeSlicer.getContextSlice(any(), anyInt())).thenReturn("int main() { counter++; }");
+        decisionEngine.setProjectFacts(ProjectFacts.build(List.of(counter, worker), null, new SourceModelCache()));
+        assertEquals(1, decisionEngine.enhanceIssues(List.of(race)).size());
+        verify(mockAiClient).sendRequest(contains("Threads: created in 1 file(s), e.g. worker.c"), anyBoolean());
+    }
+
+    @Test
+    void testReachableIssuesSpendTokenBudgetFirst(@TempDir Path tempDir) throws Exception {
+        Path app = tempDir.resolve("app.c");
+        Files.writeString(app, "int main(void) {\n    return handle();\n}\n"
+            + "int handle(void) {\n    return 0;\n}\n"
+            + "int dead_code(void) {\n    return 1;\n}\n");
+        SecurityIssue dead = createTestIssue("DEAD-001", "Issue in dead code", IssueSeverity.HIGH, app, 8);
+        SecurityIssue live = createTestIssue("LIVE-001", "Issue in reachable code", IssueSeverity.HIGH, app, 5);
+        when(mockCodeSlicer.getContextSlice(any(), anyInt())).thenReturn("mock code context");
+        when(mockAiClient.sendRequest(anyString(), anyBoolean()))
+            .thenReturn("{\"is_vulnerability\": true, \"reason\": \"Real issue\", \"suggested_severity\": \"HIGH\"}");
+
+        ExecutorService single = Executors.newSingleThreadExecutor();
+        try {
+            DecisionEngine engine = new DecisionEngine(mockAiClient, mockCodeSlicer, single, 1);
+            engine.setCallGraph(CallGraph.build(List.of(app), new SourceModelCache(), null));
+            engine.setValidationTokenBudget(1);
+            AnalysisMetrics metrics = new AnalysisMetrics();
+
+            List<SecurityIssue> result = engine.enhanceIssues(List.of(dead, live), metrics);
+
+            // Only the reachable issue reaches the AI; the dead-code issue keeps static confidence
+            assertEquals(2, result.size());
+            verify(mockAiClient).sendRequest(contains("LIVE-001"), anyBoolean());
+            verify(mockAiClient, never()).sendRequest(contains("DEAD-001"), anyBoolean());
+            SecurityIssue skipped = result.stream().filter(i -> i.getId().equals("DEAD-001")).findFirst().orElseThrow();
+            assertEquals("AI token budget exhausted", skipped.getMetadata().get("validation_skipped"));
+            assertEquals(1, metrics.getCounter("ai_budget_skipped"));
+            assertEquals(1, metrics.getCounter("ai_reachable_issues"));
+            assertEquals(1, metrics.getCounter("ai_unreachable_issues"));
+        } finally {
+            single.shutdownNow();
+        }
+    }
+
+    private SecurityIssue createTestIssue(String id, String title, IssueSeverity severity, Path file, int line) {
+        return new SecurityIssue.Builder()
+            .id(id)
+            .title(title)
+            .description("Test issue description")
+            .severity(severity)
+            .category(IssueCategory.BUFFER_OVERFLOW)
+            .location(new CodeLocation(file.toString(), line))
+            .analyzer("SemgrepAnalyzer")
+            .build();
+    }
+
     private SecurityIssue createTestIssue(String id, String title, IssueSeverity severity) {
         return new SecurityIssue.Builder()
             .id(id)
@@ -0,0 +1,105 @@
+package com.harmony.agent.core.ai;
+
+import com.google.gson.JsonObject;
+import com.harmony.agent.core.metrics.AnalysisMetrics;
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.ArgumentMatchers.*;
+import static org.mockito.Mockito.*;
+
+/**
+ * JsonResponseExtractor 单元测试
+ */
+@DisplayName("单元测试: JsonResponseExtractor")
+class JsonResponseExtractorTest {
+
+    private static final String KEY = "is_vulnerability";
+
+    @Test
+    @DisplayName("从 markdown 代码块与前后说明文字中提取对象")
+    void testExtractFromProseAndFences() {
+        String fenced = """
+            Here is my analysis of the finding:
+            ```json
+            {
+              "is_vulnerability": true,
+              "reason": "strcpy into a {fixed} buffer",
+              "suggested_severity": "High"
+            }
+            ```
+            Let me know if you need more detail.
+            """;
+
+        assertTrue(JsonResponseExtractor.parseObject(fenced, KEY).isEmpty());
+        JsonObject object = JsonResponseExtractor.extractObject(fenced, KEY).orElseThrow();
+        assertTrue(object.get(KEY).getAsBoolean());
+        assertEquals("strcpy into a {fixed} buffer", object.get("reason").getAsString());
+    }
+
+    @Test
+    @DisplayName("跳过不含目标字段或未闭合的对象，容忍尾逗号与单引号")
+    void testSkipsUnrelatedObjectsAndTolerance() {
+        String text = "Format {like this} and {\"note\": 1}. Stray { brace. "
+            + "Answer: {'is_vulnerability': false, 'reason': \"it's dead code\", 'suggested_severity': 'Info',}";
+
+        JsonObject object = JsonResponseExtractor.extractObject(text, KEY).orElseThrow();
+        assertFalse(object.get(KEY).getAsBoolean());
+        assertEquals("it's dead code", object.get("reason").getAsString());
+
+        assertTrue(JsonResponseExtractor.extractObject("I cannot determine this.", KEY).isEmpty());
+        assertTrue(JsonResponseExtractor.extractObject("{\"reason\": \"no verdict\"}", KEY).isEmpty());
+        assertTrue(JsonResponseExtractor.extractObject("{\"is_vulnerability\": true, \"reason\": \"cut", KEY).isEmpty());
+    }
+
+    @Test
+    @DisplayName("DecisionEngine 恢复包裹的响应并统计解析失败，失败响应不留在缓存中")
+    void testParseMetrics() throws Exception {
+        CachedAiValidationClient aiClient = mock(CachedAiValidationClient.class);
+        CodeSlicer slicer = mock(CodeSlicer.class);
+        when(slicer.getContextSlice(any(), anyInt())).thenReturn("void f(void) {\n    gets(buf);\n}\n");
+        when(aiClient.sendRequest(contains("WRAPPED-1"), anyBoolean()))
+            .thenReturn("Sure.\n```json\n{\"is_vulnerability\": true, \"reason\": \"Unbounded read\", "
+                + "\"suggested_severity\": \"High\"}\n```");
+        when(aiClient.sendRequest(contains("GARBLED-1"), anyBoolean()))
+            .thenReturn("The code looks risky but I am not sure.");
+        List<SecurityIssue> issues = List.of(issue("WRAPPED-1"), issue("GARBLED-1"));
+
+        ExecutorService executor = Executors.newSingleThreadExecutor();
+        try {
+            DecisionEngine engine = new DecisionEngine(aiClient, slicer, executor, 2);
+            AnalysisMetrics metrics = new AnalysisMetrics();
+            List<SecurityIssue> result = engine.enhanceIssues(issues, metrics);
+
+            // 可恢复的响应得到 AI 结论；无法解析的保留静态结果
+            assertEquals(2, result.size());
+            assertEquals(1, metrics.getCounter("ai_parse_recovered"));
+            assertEquals(1, metrics.getCounter("ai_parse_failures"));
+            verify(aiClient).invalidate(contains("GARBLED-1"), eq(true));
+            verify(aiClient, never()).invalidate(contains("WRAPPED-1"), anyBoolean());
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+
+    private static SecurityIssue issue(String id) {
+        return new SecurityIssue.Builder()
+            .id(id)
+            .title("dangerous-gets")
+            .description("test")
+            .severity(IssueSeverity.HIGH)
+            .category(IssueCategory.BUFFER_OVERFLOW)
+            .location(new CodeLocation("test.c", 2))
+            .analyzer("Semgrep")
+            .build();
+    }
+}
@@ -0,0 +1,240 @@
+package com.harmony.agent.core.ai;
+
+import com.harmony.agent.core.metrics.AnalysisMetrics;
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Path;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.ArgumentMatchers.*;
+import static org.mockito.Mockito.*;
+
+/**
+ * VerdictStore 单元测试
+ */
+@DisplayName("单元测试: VerdictStore")
+class VerdictStoreTest {
+
+    private static final String MODEL = "test-model";
+    private static final String PROMPT = PromptBuilder.VALIDATION_PROMPT_VERSION;
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    @DisplayName("指纹忽略行号与空白，代码或规则变化时改变")
+    void testFingerprint() {
+        String slice = """
+            // File: a.c (lines 10-12)
+              10: void f(char *s) {
+              11:     strcpy(buf, s); <<< ISSUE HERE
+              12: }
+            """;
+        String moved = """
+            // File: a.c (lines 40-42)
+              40: void f(char *s)   {
+              41:   strcpy(buf, s); <<< ISSUE HERE
+              42: }
+            """;
+        String changed = slice.replace("strcpy(buf, s)", "strncpy(buf, s, 8)");
+
+        assertEquals(VerdictStore.fingerprint("strcpy", slice), VerdictStore.fingerprint("strcpy", moved));
+        assertNotEquals(VerdictStore.fingerprint("strcpy", slice), VerdictStore.fingerprint("strcpy", changed));
+        assertNotEquals(VerdictStore.fingerprint("strcpy", slice), VerdictStore.fingerprint("other", slice));
+    }
+
+    @Test
+    @DisplayName("跨会话保留；AI 结论只对同一模型与提示词版本复用，人工结论优先")
+    void testPersistenceAndPrecedence() {
+        VerdictStore store = new VerdictStore(tempDir);
+        store.record(verdict("fp-1", "a.c#strcpy#f()", false, VerdictStore.Source.AI));
+
+        VerdictStore reopened = new VerdictStore(tempDir);
+        assertEquals(1, reopened.size());
+        assertTrue(reopened.lookup("fp-1", MODEL, PROMPT).isPresent());
+        assertTrue(reopened.lookup("fp-1", "other-model", PROMPT).isEmpty());
+        assertTrue(reopened.lookup("fp-1", MODEL, "issue-validation-v0").isEmpty());
+
+        assertTrue(reopened.record(verdict("fp-1", "a.c#strcpy#f()", true, VerdictStore.Source.HUMAN)));
+        assertFalse(reopened.record(verdict("fp-1", "a.c#strcpy#f()", false, VerdictStore.Source.AI)));
+
+        VerdictStore.Verdict human = new VerdictStore(tempDir).lookup("fp-1", "other-model", null).orElseThrow();
+        assertEquals(VerdictStore.Source.HUMAN, human.source());
+        assertTrue(human.vulnerability());
+    }
+
+    @Test
+    @DisplayName("扫描结束时移除同一函数同一规则的未见 AI 结论，未变化的同位置结论与人工结论保留")
+    void testStaleVerdictsRemovedOnCodeChange() {
+        VerdictStore first = new VerdictStore(tempDir);
+        VerdictStore.Scan firstScan = first.beginScan();
+        firstScan.record(verdict("old", "a.c#strcpy#f()", true, VerdictStore.Source.AI));
+        firstScan.record(verdict("sibling", "a.c#strcpy#f()", false, VerdictStore.Source.AI));
+        first.record(verdict("human", "a.c#strcpy#f()", true, VerdictStore.Source.HUMAN));
+        assertEquals(0, firstScan.evictUnseen());
+        assertEquals(3, first.size());
+
+        // Next scan: f() changed, so neither old AI fingerprint is seen; the human verdict stays
+        VerdictStore second = new VerdictStore(tempDir);
+        VerdictStore.Scan secondScan = second.beginScan();
+        assertTrue(secondScan.lookup("new", MODEL, PROMPT).isEmpty());
+        secondScan.record(verdict("new", "a.c#strcpy#f()", true, VerdictStore.Source.AI));
+        assertEquals(4, second.size());
+        assertEquals(2, secondScan.evictUnseen());
+        assertEquals(2, second.size());
+
+        // A finding recorded before its unchanged sibling is looked up does not evict it
+        VerdictStore third = new VerdictStore(tempDir);
+        VerdictStore.Scan thirdScan = third.beginScan();
+        assertTrue(thirdScan.lookup("second-finding", MODEL, PROMPT).isEmpty());
+        thirdScan.record(verdict("second-finding", "a.c#strcpy#f()", false, VerdictStore.Source.AI));
+        assertTrue(thirdScan.lookup("new", MODEL, PROMPT).isPresent());
+        assertEquals(0, thirdScan.evictUnseen());
+
+        VerdictStore reopened = new VerdictStore(tempDir);
+        assertEquals(3, reopened.size());
+        assertTrue(reopened.get("old").isEmpty());
+        assertTrue(reopened.get("new").isPresent());
+        assertTrue(reopened.get("human").isPresent());
+
+        // Each scan tracks its own lookups: a concurrent scan that has not looked anything up yet
+        // is not affected, and a later scan evicts what it does not see
+        VerdictStore.Scan current = reopened.beginScan();
+        VerdictStore.Scan concurrent = reopened.beginScan();
+        current.lookup("second-finding", MODEL, PROMPT);
+        current.lookup("new", MODEL, PROMPT);
+        current.record(verdict("newer", "a.c#strcpy#f()", true, VerdictStore.Source.AI));
+        assertEquals(0, current.evictUnseen());
+        assertEquals(0, concurrent.evictUnseen());
+        VerdictStore.Scan later = reopened.beginScan();
+        later.record(verdict("newest", "a.c#strcpy#f()", true, VerdictStore.Source.AI));
+        assertEquals(3, later.evictUnseen());
+        assertEquals(List.of("human", "newest"),
+            reopened.getVerdicts().stream().map(VerdictStore.Verdict::fingerprint).sorted().toList());
+    }
+
+    @Test
+    @DisplayName("多个实例共享同一文件：互相看到追加的结论，压缩不丢失其他实例的结论")
+    void testInstancesShareFile() {
+        VerdictStore engine = new VerdictStore(tempDir);
+        VerdictStore triage = new VerdictStore(tempDir);
+        engine.record(verdict("fp-1", "a.c#strcpy#f()", false, VerdictStore.Source.AI));
+
+        // A reviewer overrides the AI rejection from another instance; the resident one sees it
+        assertTrue(triage.record(verdict("fp-1", "a.c#strcpy#f()", true, VerdictStore.Source.HUMAN)));
+        VerdictStore.Verdict seen = engine.lookup("fp-1", MODEL, PROMPT).orElseThrow();
+        assertEquals(VerdictStore.Source.HUMAN, seen.source());
+        assertFalse(engine.record(verdict("fp-1", "a.c#strcpy#f()", false, VerdictStore.Source.AI)));
+
+        // Compaction by one instance keeps what the other appended meanwhile
+        triage.record(verdict("fp-2", "b.c#strcpy#g()", true, VerdictStore.Source.HUMAN));
+        engine.compact();
+        triage.record(verdict("fp-3", "c.c#strcpy#h()", true, VerdictStore.Source.HUMAN));
+        assertEquals(3, engine.size());
+        assertEquals(3, new VerdictStore(tempDir).size());
+        assertEquals(VerdictStore.Source.HUMAN, new VerdictStore(tempDir).get("fp-1").orElseThrow().source());
+    }
+
+    @Test
+    @DisplayName("稳态扫描：已有结论的问题不再调用 LLM")
+    void testSteadyStateScanSkipsLlm() throws Exception {
+        CachedAiValidationClient aiClient = mock(CachedAiValidationClient.class);
+        CodeSlicer slicer = mock(CodeSlicer.class);
+        when(aiClient.getModelName()).thenReturn(MODEL);
+        when(slicer.getContextSlice(any(), anyInt())).thenReturn("void f(void) {\n    gets(buf);\n}\n");
+        when(aiClient.sendRequest(contains("REAL-1"), anyBoolean()))
+            .thenReturn("{\"is_vulnerability\": true, \"reason\": \"Unbounded read\", \"suggested_severity\": \"HIGH\"}");
+        when(aiClient.sendRequest(contains("FP-1"), anyBoolean()))
+            .thenReturn("{\"is_vulnerability\": false, \"reason\": \"Dead branch\", \"suggested_severity\": \"INFO\"}");
+        List<SecurityIssue> issues = List.of(issue("REAL-1", "dangerous-gets"), issue("FP-1", "unchecked-return"));
+
+        ExecutorService executor = Executors.newSingleThreadExecutor();
+        try {
+            DecisionEngine engine = new DecisionEngine(aiClient, slicer, executor, 2);
+            engine.setVerdictStore(new VerdictStore(tempDir));
+            assertEquals(1, engine.enhanceIssues(issues).size());
+            verify(aiClient, times(2)).sendRequest(anyString(), anyBoolean());
+
+            // A new process with the same store asks the LLM nothing
+            DecisionEngine nextScan = new DecisionEngine(aiClient, slicer, executor, 2);
+            nextScan.setVerdictStore(new VerdictStore(tempDir));
+            AnalysisMetrics metrics = new AnalysisMetrics();
+            List<SecurityIssue> result = nextScan.enhanceIssues(issues, metrics);
+
+            assertEquals(1, result.size());
+            assertEquals("REAL-1", result.get(0).getId());
+            assertEquals("ai", result.get(0).getMetadata().get("verdict_source"));
+            assertEquals(2, metrics.getCounter("verdict_store_hits"));
+            verify(aiClient, times(2)).sendRequest(anyString(), anyBoolean());
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+
+    @Test
+    @DisplayName("跳过 AI 的 Clang 问题与 AI 失败回退的问题也带指纹，人工结论对 Clang 问题生效")
+    void testFingerprintOnEveryPath() throws Exception {
+        CachedAiValidationClient aiClient = mock(CachedAiValidationClient.class);
+        CodeSlicer slicer = mock(CodeSlicer.class);
+        when(aiClient.getModelName()).thenReturn(MODEL);
+        when(slicer.getContextSlice(any(), anyInt())).thenReturn("void f(void) {\n    gets(buf);\n}\n");
+        when(aiClient.sendRequest(anyString(), anyBoolean())).thenThrow(new RuntimeException("provider down"));
+        SecurityIssue clang = issue("CLANG-1", "clang-analyzer-core", "Clang-Tidy");
+        SecurityIssue semgrep = issue("FAIL-1", "dangerous-gets");
+
+        ExecutorService executor = Executors.newSingleThreadExecutor();
+        try {
+            VerdictStore store = new VerdictStore(tempDir);
+            DecisionEngine engine = new DecisionEngine(aiClient, slicer, executor, 2);
+            engine.setVerdictStore(store);
+            List<SecurityIssue> result = engine.enhanceIssues(List.of(clang, semgrep));
+
+            assertEquals(2, result.size());
+            String clangFingerprint = (String) result.stream().filter(i -> i.getId().equals("CLANG-1"))
+                .findFirst().orElseThrow().getMetadata().get("verdict_fingerprint");
+            assertNotNull(clangFingerprint);
+            assertNotNull(result.stream().filter(i -> i.getId().equals("FAIL-1"))
+                .findFirst().orElseThrow().getMetadata().get("verdict_fingerprint"));
+
+            // A reviewer rejects the Clang finding; the next scan drops it without asking the AI
+            store.record(new VerdictStore.Verdict(clangFingerprint, null, null, "clang-analyzer-core", false,
+                null, "reviewed", VerdictStore.Source.HUMAN, null, null, System.currentTimeMillis()));
+            List<SecurityIssue> next = engine.enhanceIssues(List.of(clang));
+            assertTrue(next.isEmpty());
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+
+    private static VerdictStore.Verdict verdict(String fingerprint, String location, boolean vulnerability,
+                                                VerdictStore.Source source) {
+        boolean ai = source == VerdictStore.Source.AI;
+        return new VerdictStore.Verdict(fingerprint, location, null, "strcpy", vulnerability, "HIGH", "test",
+            source, ai ? MODEL : null, ai ? PROMPT : null, System.currentTimeMillis());
+    }
+
+    private static SecurityIssue issue(String id, String rule) {
+        return issue(id, rule, "Semgrep");
+    }
+
+    private static SecurityIssue issue(String id, String rule, String analyzer) {
+        return new SecurityIssue.Builder()
+            .id(id)
+            .title(rule)
+            .description("test")
+            .severity(IssueSeverity.HIGH)
+            .category(IssueCategory.BUFFER_OVERFLOW)
+            .location(new CodeLocation("test.c", 2))
+            .analyzer(analyzer)
+            .build();
+    }
+}
@@ -0,0 +1,59 @@
+package com.harmony.agent.core.analyzer;
+
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.test.bench.StubToolchain;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.condition.EnabledOnOs;
+import org.junit.jupiter.api.condition.OS;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * ClangAnalyzer 并行结果收集单元测试（使用桩 clang-tidy）
+ */
+@DisplayName("单元测试: ClangAnalyzer")
+@EnabledOnOs({OS.LINUX, OS.MAC})
+class ClangAnalyzerTest {
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    @DisplayName("并行分析：列表结果按文件顺序合并，sink 按文件分批接收")
+    void testParallelCollection() throws Exception {
+        StubToolchain tools = StubToolchain.install(tempDir.resolve("bin"), 0, 3);
+        List<Path> files = new ArrayList<>();
+        for (int i = 0; i < 12; i++) {
+            Path source = tempDir.resolve("f" + i + ".c");
+            Files.writeString(source, "int f" + i + "(void) { return 0; }\n");
+            files.add(source);
+        }
+
+        ExecutorService executor = Executors.newFixedThreadPool(4);
+        try {
+            ClangAnalyzer clang = new ClangAnalyzer(tools.getClangTidy().toString(), null, executor);
+
+            List<SecurityIssue> issues = clang.analyzeAll(files);
+            assertEquals(36, issues.size());
+            for (int i = 0; i < files.size(); i++) {
+                assertTrue(issues.get(i * 3).getLocation().getFilePath().endsWith("f" + i + ".c"));
+            }
+
+            List<List<SecurityIssue>> batches = new ArrayList<>();
+            clang.analyzeAll(files, batches::add);
+            assertEquals(12, batches.size());
+            assertTrue(batches.stream().allMatch(batch -> batch.size() == 3));
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+}
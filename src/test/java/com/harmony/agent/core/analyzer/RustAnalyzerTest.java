@@ -0,0 +1,211 @@
+package com.harmony.agent.core.analyzer;
+
+import com.harmony.agent.core.ai.PersistentCacheManager;
+import com.harmony.agent.core.model.SecurityIssue;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.condition.EnabledOnOs;
+import org.junit.jupiter.api.condition.OS;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.attribute.PosixFilePermissions;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * RustAnalyzer 工作区分组、Clippy 与 Geiger 缓存单元测试（使用桩 cargo）
+ */
+@DisplayName("单元测试: RustAnalyzer")
+@EnabledOnOs({OS.LINUX, OS.MAC})
+class RustAnalyzerTest {
+
+    @TempDir
+    Path tempDir;
+
+    private Path workspace;
+    private Path invocations;
+    private Path geigerFailure;
+    private RustAnalyzer analyzer;
+
+    @BeforeEach
+    void setUp() throws Exception {
+        workspace = tempDir.resolve("ws");
+        write(workspace.resolve("Cargo.toml"), "[workspace]\nmembers = [\"crates/*\"]\n");
+        write(workspace.resolve("Cargo.lock"), "version = 3\n");
+        for (String name : List.of("alpha", "beta")) {
+            write(workspace.resolve("crates/" + name + "/Cargo.toml"), "[package]\nname = \"" + name + "\"\n");
+            write(workspace.resolve("crates/" + name + "/src/lib.rs"), "pub fn f() {}\n");
+            write(workspace.resolve("crates/" + name + "/src/util.rs"), "pub fn g() {}\n");
+        }
+
+        // Stub cargo: logs each call, emits two clippy diagnostics per selected package,
+        // a graph of alpha + beta + libc for metadata, and libc's unsafety for geiger
+        // (geiger exits non-zero while geiger.fail exists)
+        invocations = tempDir.resolve("invocations.log");
+        geigerFailure = tempDir.resolve("geiger.fail");
+        String metadata = "{\"packages\":["
+            + metadataPackage("alpha", null) + "," + metadataPackage("beta", null) + ","
+            + metadataPackage("libc", "registry+https://github.com/rust-lang/crates.io-index")
+            + "],\"resolve\":{\"nodes\":[{\"id\":\"alpha\",\"features\":[]},{\"id\":\"beta\",\"features\":[]},"
+            + "{\"id\":\"libc\",\"features\":[\"std\",\"default\"]}]}}";
+        String geiger = "{\"packages\":[{\"package\":{\"id\":{\"name\":\"libc\",\"version\":\"0.2.150\"}},"
+            + "\"unsafety\":{\"used\":{\"functions\":{\"safe\":0,\"unsafe_\":3},"
+            + "\"exprs\":{\"safe\":5,\"unsafe_\":10}},\"forbids_unsafe\":false}}]}";
+        String diagnostic = "{\"reason\":\"compiler-message\",\"message\":{\"message\":\"used unwrap()\","
+            + "\"level\":\"warning\",\"code\":{\"code\":\"clippy::unwrap_used\"},\"spans\":[{\"file_name\":"
+            + "\"crates/%s/src/%s\",\"line_start\":3,\"column_start\":5,\"is_primary\":true,"
+            + "\"text\":[{\"text\":\"x.unwrap()\"}]}]}}\\n";
+        String script = "#!/bin/sh\n"
+            + "if [ \"$1\" = \"--version\" ]; then echo \"cargo 1.75.0 (stub)\"; exit 0; fi\n"
+            + "echo \"$*\" >> '" + invocations + "'\n"
+            + "if [ \"$1\" = \"metadata\" ]; then echo '" + metadata + "'; exit 0; fi\n"
+            + "if [ \"$1\" = \"geiger\" ]; then echo '" + geiger + "'; "
+            + "if [ -f '" + geigerFailure + "' ]; then exit 1; fi; exit 0; fi\n"
+            + "echo '   Compiling stub' >&2\n"
+            + "echo '{\"reason\":\"compiler-artifact\"}'\n"
+            + "prev=''\n"
+            + "for arg; do\n"
+            + "  if [ \"$prev\" = \"-p\" ]; then\n"
+            + "    printf '" + diagnostic + "' \"$arg\" lib.rs\n"
+            + "    printf '" + diagnostic + "' \"$arg\" util.rs\n"
+            + "  fi\n"
+            + "  prev=\"$arg\"\n"
+            + "done\n"
+            + "exit 0\n";
+        Path cargo = tempDir.resolve("cargo");
+        Files.writeString(cargo, script);
+        Files.setPosixFilePermissions(cargo, PosixFilePermissions.fromString("rwxr-xr-x"));
+
+        analyzer = new RustAnalyzer(cargo.toString(), null,
+            new PersistentCacheManager("clippy-test", false), new PersistentCacheManager("geiger-test", false));
+    }
+
+    @Test
+    @DisplayName("按工作区一次运行 Clippy，结果按 crate 缓存，仅重跑源码变更的 crate")
+    void testWorkspaceRunAndCache() throws Exception {
+        List<Path> files = List.of(
+            workspace.resolve("crates/alpha/src/lib.rs"),
+            workspace.resolve("crates/beta/src/lib.rs"));
+
+        List<SecurityIssue> first = clippyIssues(analyzer.analyzeAll(files));
+        assertEquals(4, first.size());
+        assertTrue(first.stream().allMatch(issue -> Path.of(issue.getLocation().getFilePath()).isAbsolute()));
+        assertEquals(List.of("clippy --message-format=json -p alpha -p beta -- -W clippy::all"), clippyCalls());
+
+        assertEquals(4, clippyIssues(analyzer.analyzeAll(files)).size());
+        assertEquals(1, clippyCalls().size());
+
+        write(workspace.resolve("crates/beta/src/lib.rs"), "pub fn f() { let _ = 1; }\n");
+        assertEquals(4, clippyIssues(analyzer.analyzeAll(files)).size());
+        assertEquals("clippy --message-format=json -p beta -- -W clippy::all", clippyCalls().get(1));
+    }
+
+    @Test
+    @DisplayName("路径依赖的源码变更使依赖它的 crate 缓存失效")
+    void testPathDependencyInvalidatesCache() throws Exception {
+        write(workspace.resolve("crates/alpha/Cargo.toml"),
+            "[package]\nname = \"alpha\"\n\n[dependencies]\nbeta = { path = \"../beta\" }\n");
+        List<Path> files = List.of(workspace.resolve("crates/alpha/src/lib.rs"));
+
+        assertEquals(2, clippyIssues(analyzer.analyzeAll(files)).size());
+        assertEquals(2, clippyIssues(analyzer.analyzeAll(files)).size());
+        assertEquals(1, clippyCalls().size());
+
+        write(workspace.resolve("crates/beta/src/lib.rs"), "pub fn f() { let _ = 1; }\n");
+        assertEquals(2, clippyIssues(analyzer.analyzeAll(files)).size());
+        assertEquals(List.of("clippy --message-format=json -p alpha -- -W clippy::all",
+            "clippy --message-format=json -p alpha -- -W clippy::all"), clippyCalls());
+    }
+
+    @Test
+    @DisplayName("单文件分析按解析后的绝对路径过滤 Clippy 结果")
+    void testAnalyzeSingleFile() throws Exception {
+        Path util = workspace.resolve("crates/alpha/src/util.rs");
+
+        List<SecurityIssue> issues = clippyIssues(analyzer.analyze(util));
+        assertEquals(1, issues.size());
+        assertEquals(util.toAbsolutePath().normalize().toString(), issues.get(0).getLocation().getFilePath());
+    }
+
+    @Test
+    @DisplayName("Geiger：依赖按版本缓存，命中后不再运行 cargo geiger，自有 crate 在进程内统计")
+    void testGeigerDependencyCache() throws Exception {
+        write(workspace.resolve("crates/alpha/src/lib.rs"),
+            "// unsafe in a comment\npub fn f(p: *const u8) -> u8 { let s = \"unsafe\"; unsafe { *p } }\n");
+        List<Path> files = List.of(workspace.resolve("crates/alpha/src/lib.rs"));
+
+        List<SecurityIssue> first = unsafeIssues(analyzer.analyzeAll(files));
+        assertEquals(List.of("Package 'alpha' contains 1 unsafe usage(s)", "Package 'libc' contains 13 unsafe usage(s)"),
+            first.stream().map(SecurityIssue::getDescription).sorted().toList());
+        assertEquals(1, calls("geiger").size());
+
+        List<SecurityIssue> second = unsafeIssues(analyzer.analyzeAll(files));
+        assertEquals(2, second.size());
+        assertEquals(1, calls("geiger").size());
+        assertEquals(2, calls("metadata").size());
+    }
+
+    @Test
+    @DisplayName("Geiger 非零退出时仍报告依赖，但不写入缓存")
+    void testGeigerFailureNotCached() throws Exception {
+        Files.createFile(geigerFailure);
+        List<Path> files = List.of(workspace.resolve("crates/alpha/src/lib.rs"));
+
+        assertEquals(1, unsafeIssues(analyzer.analyzeAll(files)).stream()
+            .filter(issue -> issue.getDescription().contains("'libc'")).count());
+        assertEquals(1, calls("geiger").size());
+
+        Files.delete(geigerFailure);
+        unsafeIssues(analyzer.analyzeAll(files));
+        assertEquals(2, calls("geiger").size());
+        unsafeIssues(analyzer.analyzeAll(files));
+        assertEquals(2, calls("geiger").size());
+    }
+
+    @Test
+    @DisplayName("unsafe 计数忽略注释、字符串、字符字面量与原始标识符")
+    void testCountUnsafeKeywords() {
+        String code = """
+            /* outer /* nested unsafe */ still comment unsafe */
+            fn a<'a>(x: &'a u8) -> char { let _ = r#"unsafe "quoted" "#; let r#unsafe_ok = 1; 'u' }
+            unsafe fn b() {}
+            unsafe impl Send for T {}
+            fn c() { unsafe { b() } } // unsafe
+            """;
+        assertEquals(3, RustAnalyzer.countUnsafeKeywords(code));
+    }
+
+    private String metadataPackage(String name, String source) {
+        String manifest = source == null
+            ? workspace.resolve("crates/" + name + "/Cargo.toml").toString()
+            : "/registry/" + name + "/Cargo.toml";
+        return "{\"id\":\"" + name + "\",\"name\":\"" + name + "\",\"version\":\""
+            + (source == null ? "0.1.0" : "0.2.150") + "\",\"source\":"
+            + (source == null ? "null" : "\"" + source + "\"") + ",\"manifest_path\":\"" + manifest + "\"}";
+    }
+
+    private static List<SecurityIssue> clippyIssues(List<SecurityIssue> issues) {
+        return issues.stream().filter(issue -> issue.getTitle().startsWith("clippy::")).toList();
+    }
+
+    private static List<SecurityIssue> unsafeIssues(List<SecurityIssue> issues) {
+        return issues.stream().filter(issue -> issue.getTitle().equals("Unsafe code detected")).toList();
+    }
+
+    private List<String> clippyCalls() throws Exception {
+        return calls("clippy");
+    }
+
+    private List<String> calls(String subcommand) throws Exception {
+        return Files.readAllLines(invocations).stream().filter(line -> line.startsWith(subcommand)).toList();
+    }
+
+    private static void write(Path file, String content) throws Exception {
+        Files.createDirectories(file.getParent());
+        Files.writeString(file, content);
+    }
+}
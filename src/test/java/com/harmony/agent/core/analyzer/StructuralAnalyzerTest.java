@@ -0,0 +1,178 @@
+package com.harmony.agent.core.analyzer;
+
+import com.harmony.agent.core.analyzer.pattern.PatternRule;
+import com.harmony.agent.core.model.SecurityIssue;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * StructuralAnalyzer 内置规则包进程内匹配单元测试
+ */
+@DisplayName("单元测试: StructuralAnalyzer")
+class StructuralAnalyzerTest {
+
+    private static final String SAMPLE = """
+        void leak(void) {
+            buf = malloc(16);
+            use(buf);
+        }
+        void freed(void) {
+            data = malloc(16);
+            free(data);
+            free(data);
+        }
+        void fmt(char *user) {
+            printf(user);
+            printf("hello");
+        }
+        char *db_password = "hunter2";
+        char *greeting = "hi";
+        void paths(void) {
+            fopen("../etc/passwd", "r");
+            fopen("/tmp/x", "r");
+        }
+        void locked(void) {
+            pthread_mutex_lock(&m);
+            counter = 1;
+            pthread_mutex_unlock(&m);
+        }
+        void uaf(struct node *n) {
+            free(n);
+            if (n) {
+                log(n->next);
+            }
+        }
+        """;
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    @DisplayName("内置规则包全部可加载")
+    void testBundledRulesLoad() {
+        assertEquals(20, new StructuralAnalyzer().getRuleCount());
+    }
+
+    @Test
+    @DisplayName("元变量、省略号、pattern-not、pattern-not-inside 与 metavariable 条件")
+    void testBundledRulesMatch() throws Exception {
+        Path file = write("sample.c", SAMPLE);
+
+        Map<String, List<Integer>> lines = linesByRule(new StructuralAnalyzer().analyze(file));
+
+        assertEquals(List.of(2), lines.get("memory-leak-malloc"));
+        assertEquals(List.of(7), lines.get("double-free"));
+        assertEquals(List.of(26), lines.get("use-after-free"));
+        assertEquals(List.of(11), lines.get("format-string-vulnerability"));
+        assertEquals(List.of(14), lines.get("hardcoded-password"));
+        assertEquals(List.of(17), lines.get("path-traversal"));
+        assertEquals(List.of(2, 6, 14, 15), lines.get("missing-mutex-lock"));
+        assertNull(lines.get("uninitialized-variable"));
+    }
+
+    @Test
+    @DisplayName("结果与 Semgrep 一致：标题为规则 id，严重级别与分类按同一映射")
+    void testIssueShape() throws Exception {
+        Path file = write("free.c", "void f(char *p) {\n  free(p);\n  free(p);\n}\n");
+
+        SecurityIssue issue = new StructuralAnalyzer().analyze(file).get(0);
+
+        assertEquals("double-free", issue.getTitle());
+        assertEquals(SemgrepAnalyzer.mapSemgrepSeverity("ERROR"), issue.getSeverity());
+        assertEquals(SemgrepAnalyzer.determineCategory("double-free", issue.getDescription()), issue.getCategory());
+        assertEquals(2, issue.getLocation().getLineNumber());
+        assertEquals(3, issue.getLocation().getColumnNumber());
+        assertEquals("free(p);", issue.getLocation().getSnippet());
+        assertEquals("CWE-415: Double Free", issue.getMetadata().get("semgrep_cwe"));
+    }
+
+    @Test
+    @DisplayName("并行匹配结果与顺序一致；线程池被占满时由调用线程完成，不会死锁")
+    void testParallelMatchesSequential() throws Exception {
+        List<Path> files = new ArrayList<>();
+        for (int i = 0; i < 8; i++) {
+            files.add(write("f" + i + ".c", SAMPLE));
+        }
+        List<String> sequential = keys(new StructuralAnalyzer().analyzeAll(files));
+
+        ExecutorService pool = Executors.newFixedThreadPool(4);
+        try {
+            assertEquals(sequential, keys(new StructuralAnalyzer(pool).analyzeAll(files)));
+        } finally {
+            pool.shutdownNow();
+        }
+
+        ExecutorService busy = Executors.newSingleThreadExecutor();
+        CountDownLatch release = new CountDownLatch(1);
+        try {
+            busy.submit(() -> {
+                release.await();
+                return null;
+            });
+            assertEquals(sequential, keys(new StructuralAnalyzer(busy).analyzeAll(files)));
+        } finally {
+            release.countDown();
+            busy.shutdownNow();
+        }
+    }
+
+    @Test
+    @DisplayName("不支持的规则语法被跳过，其余规则照常加载")
+    void testUnsupportedRulesSkipped() {
+        String yaml = """
+            rules:
+              - id: supported
+                pattern: gets($BUF)
+                message: m
+                severity: ERROR
+                languages: [c]
+              - id: regex-only
+                pattern-regex: "gets\\\\("
+                message: m
+                severity: ERROR
+                languages: [c]
+              - id: python-only
+                pattern: eval(...)
+                message: m
+                severity: ERROR
+                languages: [python]
+            """;
+
+        List<PatternRule> rules = PatternRule.parse(yaml);
+
+        assertEquals(List.of("supported"), rules.stream().map(PatternRule::getId).toList());
+    }
+
+    private static Map<String, List<Integer>> linesByRule(List<SecurityIssue> issues) {
+        Map<String, List<Integer>> lines = new TreeMap<>();
+        for (SecurityIssue issue : issues) {
+            lines.computeIfAbsent(issue.getTitle(), k -> new ArrayList<>()).add(issue.getLocation().getLineNumber());
+        }
+        return lines;
+    }
+
+    private static List<String> keys(List<SecurityIssue> issues) {
+        return issues.stream()
+            .map(issue -> issue.getLocation().getFilePath() + ":" + issue.getLocation().getLineNumber() + ":" + issue.getTitle())
+            .toList();
+    }
+
+    private Path write(String name, String content) throws Exception {
+        Path file = tempDir.resolve(name);
+        Files.writeString(file, content);
+        return file;
+    }
+}
@@ -0,0 +1,98 @@
+package com.harmony.agent.core.memory;
+
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * IssueSpillBuffer / HeapBudget 单元测试
+ */
+@DisplayName("单元测试: IssueSpillBuffer")
+class IssueSpillBufferTest {
+
+    @Test
+    @DisplayName("超出内存上限的问题溢写到磁盘并按顺序回放")
+    void testSpillAndDrain() throws Exception {
+        List<SecurityIssue> issues = new ArrayList<>();
+        for (int i = 0; i < 5; i++) {
+            issues.add(new SecurityIssue.Builder()
+                .id("issue-" + i)
+                .title("Issue " + i)
+                .description("test")
+                .severity(IssueSeverity.HIGH)
+                .category(IssueCategory.BUFFER_OVERFLOW)
+                .location(new CodeLocation("src/a.c", 10 + i, 4, "strcpy(buf, s);"))
+                .analyzer("test")
+                .metadata("line_count", 3)
+                .build());
+        }
+
+        List<SecurityIssue> replayed = new ArrayList<>();
+        try (IssueSpillBuffer buffer = new IssueSpillBuffer(2)) {
+            buffer.addAll(issues.subList(0, 3));
+            buffer.addAll(issues.subList(3, 5));
+            assertEquals(5, buffer.size());
+            assertEquals(3, buffer.getSpilledCount());
+            buffer.drain(replayed::add);
+        }
+
+        assertEquals(5, replayed.size());
+        for (int i = 0; i < 5; i++) {
+            assertEquals(issues.get(i).getId(), replayed.get(i).getId());
+            assertEquals(issues.get(i).getHash(), replayed.get(i).getHash());
+        }
+        SecurityIssue spilled = replayed.get(4);
+        assertEquals(IssueSeverity.HIGH, spilled.getSeverity());
+        assertEquals("strcpy(buf, s);", spilled.getLocation().getSnippet());
+        assertEquals(3L, spilled.getMetadata().get("line_count"));
+    }
+
+    @Test
+    @DisplayName("关闭后的添加被忽略，不再创建临时文件")
+    void testAddAfterClose() throws Exception {
+        SecurityIssue issue = new SecurityIssue.Builder()
+            .id("late")
+            .title("Late issue")
+            .description("test")
+            .severity(IssueSeverity.LOW)
+            .category(IssueCategory.BUFFER_OVERFLOW)
+            .location(new CodeLocation("src/a.c", 1))
+            .analyzer("test")
+            .build();
+
+        IssueSpillBuffer buffer = new IssueSpillBuffer(0);
+        buffer.addAll(List.of(issue));
+        assertEquals(1, buffer.getSpilledCount());
+        buffer.close();
+
+        buffer.addAll(List.of(issue, issue));
+        assertEquals(1, buffer.getSpilledCount());
+        // 没有新的溢写文件可回放
+        List<SecurityIssue> replayed = new ArrayList<>();
+        buffer.drain(replayed::add);
+        assertTrue(replayed.isEmpty());
+    }
+
+    @Test
+    @DisplayName("预算解析与缓存定容")
+    void testHeapBudget() {
+        HeapBudget budget = HeapBudget.parse("2g");
+        assertEquals(2L * 1024 * 1024 * 1024, budget.getBytes());
+        assertEquals(1638, budget.sliceCacheFiles());
+        assertEquals(104857, budget.issueBufferSize());
+        assertEquals(512L * 1024 * 1024, HeapBudget.parse("512M").getBytes());
+        assertThrows(IllegalArgumentException.class, () -> HeapBudget.parse("lots"));
+
+        assertFalse(HeapBudget.UNLIMITED.isLimited());
+        assertEquals(0, HeapBudget.UNLIMITED.sliceCacheFiles());
+        assertEquals(Integer.MAX_VALUE, HeapBudget.UNLIMITED.issueBufferSize());
+    }
+}
@@ -0,0 +1,75 @@
+package com.harmony.agent.core.metrics;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.HashMap;
+import java.util.Map;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * AnalysisMetrics 单元测试
+ */
+@DisplayName("单元测试: AnalysisMetrics")
+class AnalysisMetricsTest {
+
+    @Test
+    @DisplayName("阶段计时输出 wall/cpu 统计项")
+    void testPhaseTiming() throws Exception {
+        AnalysisMetrics metrics = new AnalysisMetrics();
+        try (AnalysisMetrics.Timer ignored = metrics.time(AnalysisMetrics.PHASE_SCAN)) {
+            Thread.sleep(20);
+        }
+
+        Map<String, Object> stats = metrics.toStatistics();
+        assertTrue(((Number) stats.get("phase_scan_wall_ms")).longValue() >= 20);
+        assertTrue(stats.containsKey("phase_scan_cpu_ms"));
+        assertTrue(stats.containsKey("phase_scan_peak_heap_mb"));
+        assertTrue(AnalysisMetrics.formatHeapSummary(stats).startsWith("scan "));
+        assertEquals(metrics.getPhaseWallMs(AnalysisMetrics.PHASE_SCAN),
+            ((Number) stats.get("phase_scan_wall_ms")).longValue());
+    }
+
+    @Test
+    @DisplayName("分析器统计、计数器与缓存命中率")
+    void testAnalyzerAndCounters() {
+        AnalysisMetrics metrics = new AnalysisMetrics();
+        metrics.recordAnalyzer("Clang-Tidy", 200, 15, 2_000_000_000L);
+        metrics.increment("ai_requests", 4);
+        metrics.increment("ai_requests", 1);
+        metrics.increment("ai_cache_hits", 3);
+        metrics.increment("ai_cache_misses", 1);
+        metrics.addDuration("slicing", 5_000_000L);
+        metrics.addDuration("slicing", 7_000_000L);
+
+        Map<String, Object> stats = metrics.toStatistics();
+        assertEquals(2000L, stats.get("analyzer_clang_tidy_ms"));
+        assertEquals(200, stats.get("analyzer_clang_tidy_files"));
+        assertEquals(100.0, stats.get("analyzer_clang_tidy_files_per_sec"));
+        assertEquals(5L, stats.get("ai_requests"));
+        assertEquals(0.75, stats.get("ai_cache_hit_ratio"));
+        assertEquals(12L, stats.get("slicing_ms"));
+    }
+
+    @Test
+    @DisplayName("控制台摘要按标准阶段顺序输出")
+    void testSummaries() {
+        Map<String, Object> stats = new HashMap<>();
+        stats.put("phase_ai_validation_wall_ms", 12_100L);
+        stats.put("phase_scan_wall_ms", 120L);
+        stats.put("phase_analysis_wall_ms", 3_400L);
+
+        assertEquals("scan 120ms · analysis 3.4s · ai_validation 12.1s",
+            AnalysisMetrics.formatPhaseSummary(stats));
+        assertNull(AnalysisMetrics.formatAiSummary(stats));
+
+        stats.put("ai_requests", 10L);
+        stats.put("ai_prompt_tokens", 900L);
+        stats.put("ai_completion_tokens", 100L);
+        stats.put("ai_cache_hit_ratio", 0.5);
+        stats.put("ai_filtered_count", 3);
+        assertEquals("10 requests · 1000 tokens · cache hit 50% · 0 retries · 3 filtered",
+            AnalysisMetrics.formatAiSummary(stats));
+    }
+}
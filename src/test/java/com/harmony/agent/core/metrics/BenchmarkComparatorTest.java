@@ -0,0 +1,108 @@
+package com.harmony.agent.core.metrics;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * BenchmarkComparator 单元测试
+ */
+@DisplayName("单元测试: BenchmarkComparator")
+class BenchmarkComparatorTest {
+
+    private static final String JMH_TEMPLATE = """
+        [{
+          "benchmark": "com.harmony.agent.bench.RegexAnalyzerBenchmark.analyze",
+          "mode": "%s",
+          "params": {"lines": "2000"},
+          "primaryMetric": {"score": 0, "scoreUnit": "ops/s", "rawData": [[%s], [%s]]}
+        }]
+        """;
+
+    @Test
+    @DisplayName("JMH 吞吐显著下降判定为回归，噪声内的变化不判定")
+    void testJmhRegression(@TempDir Path tempDir) throws Exception {
+        Path base = write(tempDir, "base.json", JMH_TEMPLATE.formatted("thrpt", "100, 101, 99", "100, 102, 98"));
+        Path slow = write(tempDir, "slow.json", JMH_TEMPLATE.formatted("thrpt", "80, 81, 79", "80, 82, 78"));
+        Path noisy = write(tempDir, "noisy.json", JMH_TEMPLATE.formatted("thrpt", "60, 140, 90", "130, 70, 110"));
+
+        BenchmarkComparator comparator = new BenchmarkComparator();
+        BenchmarkComparator.ResultSet baseline = BenchmarkComparator.load(List.of(base));
+
+        BenchmarkComparator.Comparison slower = comparator
+            .compare(baseline, BenchmarkComparator.load(List.of(slow))).get(0);
+        assertEquals("jmh.RegexAnalyzerBenchmark.analyze[lines=2000]", slower.metric());
+        assertEquals(6, slower.baselineCount());
+        assertEquals(-20.0, slower.changePct(), 0.01);
+        assertTrue(slower.ciHighPct() < 0);
+        assertEquals(BenchmarkComparator.Verdict.REGRESSION, slower.verdict());
+
+        BenchmarkComparator.Comparison unclear = comparator
+            .compare(baseline, BenchmarkComparator.load(List.of(noisy))).get(0);
+        assertEquals(BenchmarkComparator.Verdict.UNCHANGED, unclear.verdict());
+    }
+
+    @Test
+    @DisplayName("E2E 报告按文件计样本，单样本不参与门禁，阈值按指标覆盖")
+    void testE2eSamplesAndThresholds(@TempDir Path tempDir) throws Exception {
+        Path baseDir = Files.createDirectories(tempDir.resolve("base"));
+        Path headDir = Files.createDirectories(tempDir.resolve("head"));
+        write(baseDir, "1.json", e2e(1000, 10.0));
+        write(baseDir, "2.json", e2e(1010, 10.1));
+        write(baseDir, "3.json", e2e(990, 9.9));
+        write(headDir, "1.json", e2e(1080, 9.3));
+        write(headDir, "2.json", e2e(1090, 9.2));
+        write(headDir, "3.json", e2e(1070, 9.4));
+
+        BenchmarkComparator comparator = new BenchmarkComparator(5.0).threshold("e2e.phases.*", 10.0);
+        List<BenchmarkComparator.Comparison> result = comparator.compare(
+            BenchmarkComparator.load(List.of(baseDir)), BenchmarkComparator.load(List.of(headDir)));
+
+        BenchmarkComparator.Comparison analyze = find(result, "e2e.phases.analyze_ms");
+        assertEquals(10.0, analyze.thresholdPct());
+        assertEquals(BenchmarkComparator.Verdict.UNCHANGED, analyze.verdict()); // +8% < 10%
+
+        BenchmarkComparator.Comparison filesPerSec = find(result, "e2e.throughput.files_per_sec");
+        assertEquals(BenchmarkComparator.Direction.HIGHER_IS_BETTER, filesPerSec.direction());
+        assertEquals(BenchmarkComparator.Verdict.REGRESSION, filesPerSec.verdict()); // -7% > 5%
+
+        List<BenchmarkComparator.Comparison> single = comparator.compare(
+            BenchmarkComparator.load(List.of(baseDir.resolve("1.json"))),
+            BenchmarkComparator.load(List.of(headDir.resolve("1.json"))));
+        assertEquals(BenchmarkComparator.Verdict.INSUFFICIENT_DATA,
+            find(single, "e2e.throughput.files_per_sec").verdict());
+    }
+
+    @Test
+    @DisplayName("t 分位数：小自由度查表，大自由度趋近正态")
+    void testTCritical() {
+        assertEquals(12.706, BenchmarkComparator.tCritical95(1), 1e-3);
+        assertEquals(2.228, BenchmarkComparator.tCritical95(10.4), 1e-3);
+        assertEquals(2.000, BenchmarkComparator.tCritical95(60), 2e-3);
+        assertEquals(1.962, BenchmarkComparator.tCritical95(1000), 2e-3);
+    }
+
+    private static String e2e(long analyzeMs, double filesPerSec) {
+        return """
+            {"phases": {"analyze_ms": %d},
+             "throughput": {"files_per_sec": %s},
+             "memory": {"peak_rss_kb": -1, "peak_heap_mb": 256}}
+            """.formatted(analyzeMs, filesPerSec);
+    }
+
+    private static BenchmarkComparator.Comparison find(List<BenchmarkComparator.Comparison> list, String metric) {
+        return list.stream().filter(c -> c.metric().equals(metric)).findFirst().orElseThrow();
+    }
+
+    private static Path write(Path dir, String name, String content) throws Exception {
+        Path file = dir.resolve(name);
+        Files.writeString(file, content);
+        return file;
+    }
+}
@@ -0,0 +1,97 @@
+package com.harmony.agent.core.metrics;
+
+import com.google.gson.JsonArray;
+import com.google.gson.JsonElement;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParser;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * IssueTracer 单元测试
+ */
+@DisplayName("单元测试: IssueTracer")
+class IssueTracerTest {
+
+    @Test
+    @DisplayName("每个问题一行，输出 Chrome trace-event JSON")
+    void testChromeTrace(@TempDir Path tempDir) throws Exception {
+        IssueTracer tracer = IssueTracer.create();
+        try (IssueTracer.Span span = tracer.engineSpan("RegexAnalyzer")) {
+            span.arg("files", 3);
+        }
+        tracer.instant("issue-1", "emitted", "analyzer", "RegexAnalyzer");
+        tracer.instant("issue-2", "dedup", "result", "duplicate", "duplicate_of", "issue-1");
+        try (IssueTracer.Span span = tracer.span("issue-1", "slice")) {
+            span.arg("chars", 120);
+        }
+
+        Path output = tempDir.resolve("trace.json");
+        tracer.writeChromeTrace(output);
+
+        JsonArray events = JsonParser.parseString(Files.readString(output))
+            .getAsJsonObject().getAsJsonArray("traceEvents");
+        List<String> trackNames = new ArrayList<>();
+        JsonObject slice = null;
+        JsonObject dedup = null;
+        for (JsonElement element : events) {
+            JsonObject event = element.getAsJsonObject();
+            String phase = event.get("ph").getAsString();
+            if (phase.equals("M")) {
+                trackNames.add(event.getAsJsonObject("args").get("name").getAsString());
+            } else if (event.get("name").getAsString().equals("slice")) {
+                slice = event;
+            } else if (event.get("name").getAsString().equals("dedup")) {
+                dedup = event;
+            }
+        }
+
+        assertTrue(trackNames.containsAll(List.of("engine", "issue-1", "issue-2")));
+        assertNotNull(slice);
+        assertEquals("X", slice.get("ph").getAsString());
+        assertTrue(slice.has("dur"));
+        assertEquals(120, slice.getAsJsonObject("args").get("chars").getAsInt());
+        assertNotNull(dedup);
+        assertEquals("issue-1", dedup.getAsJsonObject("args").get("duplicate_of").getAsString());
+    }
+
+    @Test
+    @DisplayName("activate 绑定线程后 currentSpan 记录到对应问题")
+    void testCurrentSpan() {
+        IssueTracer tracer = IssueTracer.create();
+        try (IssueTracer.Span outside = IssueTracer.currentSpan("cache_lookup")) {
+            outside.arg("result", "miss");
+        }
+        assertEquals(0, tracer.getEventCount());
+
+        try (IssueTracer.Scope ignored = tracer.activate("issue-7")) {
+            IssueTracer.currentSpan("cache_lookup").arg("result", "hit").close();
+        }
+        assertEquals(1, tracer.getEventCount());
+
+        IssueTracer.currentSpan("llm_call").close();
+        assertEquals(1, tracer.getEventCount());
+    }
+
+    @Test
+    @DisplayName("禁用时不记录任何事件")
+    void testDisabled() {
+        IssueTracer tracer = IssueTracer.DISABLED;
+        try (IssueTracer.Scope ignored = tracer.activate("issue-1");
+             IssueTracer.Span span = tracer.span("issue-1", "slice")) {
+            span.arg("chars", 1);
+            IssueTracer.currentSpan("cache_lookup").close();
+        }
+        tracer.instant("issue-1", "verdict", "result", "rejected");
+        assertFalse(tracer.isEnabled());
+        assertEquals(0, tracer.getEventCount());
+    }
+}
@@ -0,0 +1,76 @@
+package com.harmony.agent.core.metrics;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.net.URI;
+import java.net.http.HttpClient;
+import java.net.http.HttpRequest;
+import java.net.http.HttpResponse;
+import java.nio.file.Files;
+import java.nio.file.Path;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * MetricsRegistry / MetricsExporter 单元测试
+ */
+@DisplayName("单元测试: MetricsRegistry")
+class MetricsRegistryTest {
+
+    @Test
+    @DisplayName("按 OpenMetrics 文本格式输出 counter / gauge / summary")
+    void testRender() {
+        MetricsRegistry registry = new MetricsRegistry();
+        registry.counter("harmony_llm_requests", "LLM requests", "provider", "openai", "outcome", "success").inc();
+        registry.counter("harmony_llm_requests", "LLM requests", "provider", "openai", "outcome", "success").inc(2);
+        MetricsRegistry.Gauge inFlight = registry.gauge("harmony_llm_requests_in_flight", "In flight");
+        inFlight.inc();
+        inFlight.inc();
+        inFlight.dec();
+        registry.summary("harmony_llm_request_duration_seconds", "Latency").observe(0.25);
+        registry.summary("harmony_llm_request_duration_seconds", "Latency").observe(0.5);
+
+        String text = registry.render();
+        assertTrue(text.contains("# TYPE harmony_llm_requests counter\n"));
+        assertTrue(text.contains("harmony_llm_requests_total{provider=\"openai\",outcome=\"success\"} 3\n"));
+        assertTrue(text.contains("# TYPE harmony_llm_requests_in_flight gauge\n"));
+        assertTrue(text.contains("harmony_llm_requests_in_flight 1\n"));
+        assertTrue(text.contains("harmony_llm_request_duration_seconds_count 2\n"));
+        assertTrue(text.contains("harmony_llm_request_duration_seconds_sum 0.75\n"));
+        assertTrue(text.endsWith("# EOF\n"));
+    }
+
+    @Test
+    @DisplayName("标签值转义，同名不同类型注册失败")
+    void testEscapingAndTypeConflict() {
+        MetricsRegistry registry = new MetricsRegistry();
+        registry.counter("harmony_mcp_calls", "MCP calls", "service", "a\"b\\c").inc();
+        assertTrue(registry.render().contains("harmony_mcp_calls_total{service=\"a\\\"b\\\\c\"} 1\n"));
+        assertThrows(IllegalArgumentException.class, () -> registry.gauge("harmony_mcp_calls", "MCP calls"));
+    }
+
+    @Test
+    @DisplayName("HTTP 端点与 textfile 导出")
+    void testExporters(@TempDir Path tempDir) throws Exception {
+        MetricsRegistry registry = new MetricsRegistry();
+        registry.counter("harmony_analyses", "Analyses", "outcome", "success").inc();
+
+        try (MetricsExporter http = MetricsExporter.startHttp(registry, 0)) {
+            HttpResponse<String> response = HttpClient.newHttpClient().send(
+                HttpRequest.newBuilder(URI.create("http://127.0.0.1:" + http.getPort() + "/metrics")).build(),
+                HttpResponse.BodyHandlers.ofString());
+            assertEquals(200, response.statusCode());
+            assertTrue(response.headers().firstValue("Content-Type").orElse("").startsWith("application/openmetrics-text"));
+            assertTrue(response.body().contains("harmony_analyses_total{outcome=\"success\"} 1\n"));
+        }
+
+        Path textfile = tempDir.resolve("collector/harmony.prom");
+        MetricsExporter exporter = MetricsExporter.startTextfile(registry, textfile, 3600);
+        registry.counter("harmony_analyses", "Analyses", "outcome", "success").inc();
+        exporter.close();
+        assertTrue(Files.readString(textfile).contains("harmony_analyses_total{outcome=\"success\"} 2\n"));
+        assertFalse(Files.exists(tempDir.resolve("collector/harmony.prom.tmp")));
+    }
+}
@@ -0,0 +1,60 @@
+package com.harmony.agent.core.metrics;
+
+import com.harmony.agent.core.ai.PersistentCacheManager;
+import com.harmony.agent.core.analyzer.RegexAnalyzer;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordingFile;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * ProfileRecorder / JfrEvents 单元测试
+ */
+@DisplayName("单元测试: ProfileRecorder")
+class ProfileRecorderTest {
+
+    @AfterEach
+    void tearDown() {
+        ProfileRecorder.stop();
+    }
+
+    @Test
+    @DisplayName("录制文件包含分析器与缓存自定义事件")
+    void testRecordsCustomEvents(@TempDir Path tempDir) throws Exception {
+        Path source = tempDir.resolve("a.c");
+        Files.writeString(source, "void f(char *s) { char buf[8]; strcpy(buf, s); }\n");
+
+        Path output = ProfileRecorder.start(tempDir.resolve("run.jfr"));
+        assertTrue(ProfileRecorder.isRecording());
+
+        int issues = new RegexAnalyzer().analyze(source).size();
+        PersistentCacheManager cache = new PersistentCacheManager("jfr-test", false);
+        cache.put("k", "v");
+        cache.get("k");
+        cache.get("missing");
+
+        assertEquals(output, ProfileRecorder.stop());
+        assertFalse(ProfileRecorder.isRecording());
+
+        List<RecordedEvent> events = RecordingFile.readAllEvents(output);
+        RecordedEvent analyzerRun = events.stream()
+            .filter(e -> e.getEventType().getName().equals("com.harmony.agent.AnalyzerRun"))
+            .findFirst().orElseThrow();
+        assertEquals("RegexAnalyzer", analyzerRun.getString("analyzer"));
+        assertEquals(issues, analyzerRun.getInt("issues"));
+
+        List<String> lookups = events.stream()
+            .filter(e -> e.getEventType().getName().equals("com.harmony.agent.CacheLookup"))
+            .map(e -> e.getString("result"))
+            .toList();
+        assertEquals(List.of("l1_hit", "miss"), lookups);
+    }
+}
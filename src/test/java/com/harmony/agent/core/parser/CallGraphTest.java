@@ -0,0 +1,163 @@
+package com.harmony.agent.core.parser;
+
+import com.harmony.agent.core.ai.PersistentCacheManager;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * CallGraph 项目调用图单元测试
+ */
+@DisplayName("单元测试: CallGraph")
+class CallGraphTest {
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    @DisplayName("从 main 出发的可达性、调用深度与回调边")
+    void testReachability() throws Exception {
+        Path main = write("src/main.c", """
+            int main(int argc, char **argv) {
+                return parse(argv[1]);
+            }
+            """);
+        Path parser = write("src/parser.c", """
+            static int on_token(const char *t) {
+                return copy_token(t);
+            }
+            int parse(const char *s) {
+                return walk(s, on_token);
+            }
+            int unused_helper(void) {
+                return copy_token("x");
+            }
+            """);
+        Path util = write("src/util.c", """
+            int copy_token(const char *t) {
+                char buf[8];
+                strcpy(buf, t);
+                return 0;
+            }
+            int walk(const char *s, int (*cb)(const char *)) {
+                return cb(s);
+            }
+            """);
+        Path test = write("tests/test_parser.c", """
+            int only_tested(void) {
+                return 1;
+            }
+            int main(void) {
+                return only_tested();
+            }
+            """);
+
+        CallGraph graph = CallGraph.build(List.of(main, parser, util, test), new SourceModelCache(), null);
+
+        assertEquals(4, graph.getFileCount());
+        assertEquals(CallGraph.Reachability.REACHABLE, graph.reachability(main.toString(), 2));
+        assertEquals(0, graph.depth(main.toString(), 2));
+        assertEquals(1, graph.depth(parser.toString(), 5));
+        // on_token 只作为回调传给 walk
+        assertEquals(2, graph.depth(parser.toString(), 2));
+        assertEquals(3, graph.depth(util.toString(), 3));
+        assertEquals(CallGraph.Reachability.UNREACHABLE, graph.reachability(parser.toString(), 8));
+        // 测试文件中的 main 不是入口
+        assertEquals(CallGraph.Reachability.UNREACHABLE, graph.reachability(test.toString(), 2));
+        assertEquals(CallGraph.Reachability.UNKNOWN, graph.reachability(util.toString(), 100));
+
+        List<CallGraph.CallSite> callers = graph.callersOf(util.toString(), 3);
+        assertEquals(2, callers.size());
+        // 可达的调用者在前
+        assertEquals("on_token", callers.get(0).caller());
+        assertEquals(2, callers.get(0).line());
+        assertEquals("unused_helper", callers.get(1).caller());
+    }
+
+    @Test
+    @DisplayName("static 函数只被同文件调用解析；没有 main 的库以非 static 函数为入口")
+    void testStaticResolutionAndLibraryRoots() throws Exception {
+        Path a = write("a.c", """
+            static void reset(void) {
+            }
+            void api_open(void) {
+                reset();
+            }
+            """);
+        Path b = write("b.c", """
+            static void reset(void) {
+            }
+            static void never_called(void) {
+                reset();
+            }
+            """);
+
+        CallGraph graph = CallGraph.build(List.of(a, b), new SourceModelCache(), null);
+
+        assertEquals(CallGraph.Reachability.REACHABLE, graph.reachability(a.toString(), 4));
+        assertEquals(1, graph.depth(a.toString(), 1));
+        assertEquals(CallGraph.Reachability.UNREACHABLE, graph.reachability(b.toString(), 1));
+        assertEquals(CallGraph.Reachability.UNREACHABLE, graph.reachability(b.toString(), 4));
+        assertEquals(1, graph.callersOf(b.toString(), 1).size());
+    }
+
+    @Test
+    @DisplayName("未改动文件的提取结果从缓存读取，改动后重新解析")
+    void testPersistedSummaries() throws Exception {
+        Path main = write("main.c", """
+            int main(void) {
+                return run();
+            }
+            """);
+        Path run = write("run.c", """
+            int run(void) {
+                return 0;
+            }
+            """);
+        PersistentCacheManager cache = new PersistentCacheManager("callgraph-test", false);
+
+        CallGraph first = CallGraph.build(List.of(main, run), new SourceModelCache(), cache);
+        CallGraph second = CallGraph.build(List.of(main, run), new SourceModelCache(), cache);
+
+        assertEquals(0, first.getCachedFileCount());
+        assertEquals(2, second.getCachedFileCount());
+        assertEquals(first.getEdgeCount(), second.getEdgeCount());
+        assertEquals(1, second.depth(run.toString(), 2));
+
+        Files.writeString(run, """
+            int run(void) {
+                return helper();
+            }
+            int helper(void) {
+                return 0;
+            }
+            """);
+        CallGraph third = CallGraph.build(List.of(main, run), new SourceModelCache(), cache);
+
+        assertEquals(1, third.getCachedFileCount());
+        assertEquals(2, third.depth(run.toString(), 5));
+    }
+
+    @Test
+    @DisplayName("测试路径判定只看项目根之下的目录")
+    void testTestFileDetection() {
+        Path root = Path.of("/work/tests/project");
+        assertFalse(CallGraph.isTestFile(root.resolve("src/main.c"), root));
+        assertTrue(CallGraph.isTestFile(root.resolve("test/main.c"), root));
+        assertTrue(CallGraph.isTestFile(root.resolve("src/parser_test.cc"), root));
+        assertTrue(CallGraph.isTestFile(root.resolve("src/test_parser.c"), root));
+    }
+
+    private Path write(String name, String content) throws Exception {
+        Path file = tempDir.resolve(name);
+        Files.createDirectories(file.getParent());
+        Files.writeString(file, content);
+        return file;
+    }
+}
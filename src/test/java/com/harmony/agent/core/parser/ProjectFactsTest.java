@@ -0,0 +1,106 @@
+package com.harmony.agent.core.parser;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.Set;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * ProjectFacts 项目级事实索引单元测试
+ */
+@DisplayName("单元测试: ProjectFacts")
+class ProjectFactsTest {
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    @DisplayName("识别线程创建、线程相关文件、入口点与分配包装函数")
+    void testFacts() throws Exception {
+        Path main = write("main.c", """
+            #include <stdio.h>
+            int main(int argc, char **argv) {
+                start_workers();
+                return 0;
+            }
+            """);
+        Path worker = write("worker.c", """
+            #include <pthread.h>
+            void start_workers(void) {
+                pthread_t t;
+                pthread_create(&t, NULL, run, NULL);
+            }
+            """);
+        Path memory = write("memory.c", """
+            void *xmalloc(size_t n) {
+                void *p = malloc(n);
+                if (!p) abort();
+                return p;
+            }
+            void xfree(void *p) {
+                if (p) free(p);
+            }
+            void process(void) {
+                char *buf = malloc(16);
+                use(buf);
+                free(buf);
+            }
+            """);
+
+        ProjectFacts facts = ProjectFacts.build(List.of(main, worker, memory), null, new SourceModelCache());
+
+        assertEquals(3, facts.getFileCount());
+        assertTrue(facts.createsThreads());
+        assertEquals(Set.of(worker.toAbsolutePath().normalize()), facts.getThreadCreatingFiles());
+        assertTrue(facts.isThreadAware(worker.toString()));
+        assertFalse(facts.isThreadAware(main.toString()));
+        assertEquals(Set.of(main.toAbsolutePath().normalize()), facts.getEntryPointFiles());
+        assertEquals(Set.of("xmalloc"), facts.getAllocatorWrappers());
+        assertTrue(facts.isDeallocatorWrapper("xfree"));
+        assertFalse(facts.isDeallocatorWrapper("process"));
+        assertTrue(facts.describe(worker.toString()).get(0).contains("this file is thread-aware"));
+    }
+
+    @Test
+    @DisplayName("只引用线程类型而不创建线程的项目视为单线程")
+    void testSingleThreaded() throws Exception {
+        Path file = write("ids.cpp", """
+            #include <thread>
+            std::thread::id owner;
+            void record(void) {
+                owner = std::this_thread::get_id();
+            }
+            """);
+
+        ProjectFacts facts = ProjectFacts.build(List.of(file), null, new SourceModelCache());
+
+        assertFalse(facts.createsThreads());
+        assertTrue(facts.isThreadAware(file.toString()));
+        assertTrue(facts.describe(file.toString()).get(0).startsWith("Threads: none of the 1 indexed files"));
+    }
+
+    @Test
+    @DisplayName("OpenMP parallel 区域计为线程创建")
+    void testOpenMp() throws Exception {
+        Path file = write("omp.c", """
+            void sum(int *a, int n) {
+                #pragma omp parallel for
+                for (int i = 0; i < n; i++) a[i]++;
+            }
+            """);
+
+        assertTrue(ProjectFacts.build(List.of(file), null, new SourceModelCache()).createsThreads());
+    }
+
+    private Path write(String name, String content) throws Exception {
+        Path file = tempDir.resolve(name);
+        Files.writeString(file, content);
+        return file;
+    }
+}
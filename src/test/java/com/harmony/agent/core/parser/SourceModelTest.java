@@ -0,0 +1,190 @@
+package com.harmony.agent.core.parser;
+
+import com.harmony.agent.core.parser.CLexer.Token;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.Random;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * SourceModel 增量重新解析单元测试
+ */
+@DisplayName("单元测试: SourceModel")
+class SourceModelTest {
+
+    private static final String SAMPLE = """
+        #include <stdio.h>
+        /* header */
+        static int table[] = { 1, 2, 3 };
+
+        int first(int a) {
+            if (a > 0) {
+                return a->b;
+            }
+            return 0;
+        }
+
+        void second(char *s) {
+            printf("%s\\n", s);
+        }
+        """;
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    @DisplayName("函数体内的单行编辑只重新切分少量 Token，并复用函数结构")
+    void testEditInsideFunctionReusesStructure() {
+        SourceModel model = SourceModel.parse(SAMPLE);
+        int offset = SAMPLE.indexOf("return 0;");
+
+        SourceModel edited = model.applyEdit(offset, 0, "a = a + 1;\n    ");
+
+        assertTrue(edited.isStructureReused());
+        assertTrue(edited.getRelexedTokenCount() < 10, "relexed " + edited.getRelexedTokenCount());
+        assertSameModel(SourceModel.parse(edited.getText()), edited);
+        assertEquals(List.of("first", "second"), edited.getFunctions().stream().map(SourceModel.Function::name).toList());
+        assertEquals(11, edited.getFunctions().get(0).endLine());
+        assertEquals(13, edited.getFunctions().get(1).startLine());
+    }
+
+    @Test
+    @DisplayName("改动括号或函数签名时重新识别函数")
+    void testStructuralEditRecomputesFunctions() {
+        SourceModel model = SourceModel.parse(SAMPLE);
+
+        SourceModel renamed = model.applyEdit(SAMPLE.indexOf("second"), "second".length(), "third");
+        assertSameModel(SourceModel.parse(renamed.getText()), renamed);
+        assertEquals("third", renamed.getFunctions().get(1).name());
+
+        SourceModel unbalanced = model.applyEdit(SAMPLE.indexOf("return 0;"), 0, "{");
+        assertFalse(unbalanced.isStructureReused());
+        assertSameModel(SourceModel.parse(unbalanced.getText()), unbalanced);
+    }
+
+    @Test
+    @DisplayName("与相邻 Token 合并、注释开合与行首 # 均与完整解析一致")
+    void testLexicalBoundaryEdits() {
+        String code = "int f(int *p) {\n    return p - 1;\n}\n";
+        SourceModel model = SourceModel.parse(code);
+
+        SourceModel arrow = model.applyEdit(code.indexOf("- 1") + 1, 1, ">");
+        assertSameModel(SourceModel.parse(arrow.getText()), arrow);
+        assertTrue(arrow.getTokens().stream().anyMatch(token -> token.is("->")));
+
+        SourceModel comment = model.applyEdit(code.indexOf("return"), 0, "/* ");
+        assertSameModel(SourceModel.parse(comment.getText()), comment);
+        assertEquals(-1, comment.getFunctions().get(0).closeBrace());
+
+        // 行首注释之后的 # 仍是预处理指令，从它重新切分时须保持
+        String guarded = "int y;\n/* c */ #define A 1\nint x;\n";
+        SourceModel directive = SourceModel.parse(guarded).applyEdit(guarded.indexOf("int x"), 3, "long");
+        assertSameModel(SourceModel.parse(directive.getText()), directive);
+        assertEquals(CLexer.Kind.PREPROCESSOR, directive.getToken(3).getKind());
+    }
+
+    @Test
+    @DisplayName("随机编辑序列：增量结果始终与完整解析一致")
+    void testRandomEditsMatchFullParse() {
+        String[] snippets = {
+            "x", " ", "\n", "{", "}", "(", ")", ";", "-", ">", "/*", "*/", "//", "\"", "'",
+            "#define Y 1\n", "if (a) { b(); }\n", "void g(void) {\n}\n", "R\"(", ")\""
+        };
+        Random random = new Random(42);
+        SourceModel model = SourceModel.parse(SAMPLE);
+
+        for (int i = 0; i < 500; i++) {
+            String text = model.getText();
+            int offset = random.nextInt(text.length() + 1);
+            int removed = random.nextInt(Math.min(8, text.length() - offset) + 1);
+            String inserted = random.nextBoolean() ? snippets[random.nextInt(snippets.length)] : "";
+            model = model.applyEdit(offset, removed, inserted);
+            assertSameModel(SourceModel.parse(model.getText()), model);
+        }
+    }
+
+    @Test
+    @DisplayName("withText 由公共前后缀推导编辑")
+    void testWithText() {
+        SourceModel model = SourceModel.parse(SAMPLE);
+        String changed = SAMPLE.replace("return a->b;", "return a->c + 1;");
+
+        SourceModel updated = model.withText(changed);
+
+        assertEquals(changed, updated.getText());
+        assertTrue(updated.isStructureReused());
+        assertSameModel(SourceModel.parse(changed), updated);
+        assertSame(model, model.withText(SAMPLE));
+    }
+
+    @Test
+    @DisplayName("按行查询所在函数")
+    void testFunctionAt() {
+        SourceModel model = SourceModel.parse(SAMPLE);
+
+        assertEquals("first", model.functionAt(7).orElseThrow().name());
+        assertEquals("second", model.functionAt(13).orElseThrow().name());
+        assertTrue(model.functionAt(3).isEmpty());
+        assertEquals(List.of(SAMPLE.split("\n", -1)).subList(0, model.getLineCount() - 1), model.getLines());
+    }
+
+    @Test
+    @DisplayName("文件缓存：内容变化时在旧模型上增量更新")
+    void testCacheUpdatesIncrementally() throws Exception {
+        Path file = tempDir.resolve("sample.c");
+        Files.writeString(file, SAMPLE);
+        SourceModelCache cache = new SourceModelCache();
+
+        SourceModel first = cache.get(file);
+        assertSame(first, cache.get(file));
+        assertEquals(1, cache.getFullParseCount());
+
+        String changed = SAMPLE.replace("return 0;", "return -1;");
+        Files.writeString(file, changed);
+        SourceModel updated = cache.update(file, changed);
+
+        assertEquals(changed, updated.getText());
+        assertSame(updated, cache.get(file));
+        assertEquals(1, cache.getFullParseCount());
+        assertEquals(1, cache.getIncrementalUpdateCount());
+    }
+
+    @Test
+    @DisplayName("缓存按条数限容，最近最少使用者先淘汰")
+    void testCacheEviction() throws Exception {
+        SourceModelCache cache = new SourceModelCache(2);
+        for (int i = 0; i < 3; i++) {
+            Path file = tempDir.resolve("f" + i + ".c");
+            Files.writeString(file, "int v" + i + ";\n");
+            cache.get(file);
+        }
+
+        assertEquals(2, cache.size());
+        cache.get(tempDir.resolve("f0.c"));
+        assertEquals(4, cache.getFullParseCount());
+    }
+
+    private static void assertSameModel(SourceModel expected, SourceModel actual) {
+        String text = actual.getText();
+        assertEquals(expected.getTokenCount(), actual.getTokenCount(), text);
+        for (int i = 0; i < expected.getTokenCount(); i++) {
+            Token want = expected.getToken(i);
+            Token got = actual.getToken(i);
+            assertEquals(describe(want), describe(got), "token " + i + " in:\n" + text);
+            assertEquals(expected.getMatchingBracket(i), actual.getMatchingBracket(i), "partner " + i + " in:\n" + text);
+        }
+        assertEquals(expected.getFunctions(), actual.getFunctions(), text);
+        assertEquals(expected.getLineCount(), actual.getLineCount(), text);
+        assertEquals(expected.getLines(), actual.getLines(), text);
+    }
+
+    private static String describe(Token token) {
+        return token.getKind() + " " + token.getText() + " @" + token.getLine() + ":" + token.getStart() + "-" + token.getEnd();
+    }
+}
@@ -0,0 +1,57 @@
+package com.harmony.agent.core.scanner;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * CodeScanner 单元测试
+ */
+@DisplayName("单元测试: CodeScanner")
+class CodeScannerTest {
+
+    @Test
+    @DisplayName("混合语言扫描：一次遍历区分 C/C++ 与 Rust，Rust 按 Cargo workspace 分组")
+    void testScanMixedGroupsByWorkspace(@TempDir Path root) throws Exception {
+        write(root.resolve("native/src/a.c"), "int main(void) { return 0; }");
+        write(root.resolve("native/include/a.h"), "int f(void);");
+        write(root.resolve("rust/Cargo.toml"), "[workspace]\nmembers = [\"crates/*\"]\n");
+        write(root.resolve("rust/crates/core/Cargo.toml"), "[package]\nname = \"core\"\n");
+        write(root.resolve("rust/crates/core/src/lib.rs"), "pub fn f() {}");
+        write(root.resolve("rust/crates/cli/Cargo.toml"), "[package]\nname = \"cli\"\n");
+        write(root.resolve("rust/crates/cli/src/main.rs"), "fn main() {}");
+        write(root.resolve("tool/Cargo.toml"), "[package]\nname = \"tool\"\n");
+        write(root.resolve("tool/src/main.rs"), "fn main() {}");
+        write(root.resolve("tool/target/debug/build.rs"), "fn main() {}");
+        write(root.resolve("scripts/orphan.rs"), "fn main() {}");
+        write(root.resolve("README.md"), "# monorepo");
+
+        CodeScanner.SourceSet sources = new CodeScanner(root.toString(), false).scanMixed();
+
+        assertEquals(Set.of(root.resolve("native/src/a.c"), root.resolve("native/include/a.h")),
+            Set.copyOf(sources.getCFiles()));
+
+        Map<Path, List<Path>> workspaces = sources.getRustWorkspaces();
+        assertEquals(Set.of(root.resolve("rust"), root.resolve("tool")), workspaces.keySet());
+        assertEquals(Set.of(root.resolve("rust/crates/core/src/lib.rs"), root.resolve("rust/crates/cli/src/main.rs")),
+            Set.copyOf(workspaces.get(root.resolve("rust"))));
+        assertEquals(List.of(root.resolve("tool/src/main.rs")), workspaces.get(root.resolve("tool")));
+
+        // target/ is ignored and files outside any crate are skipped
+        assertEquals(3, sources.getRustFileCount());
+        assertEquals(5, sources.getAllFiles().size());
+    }
+
+    private static void write(Path file, String content) throws Exception {
+        Files.createDirectories(file.getParent());
+        Files.writeString(file, content);
+    }
+}
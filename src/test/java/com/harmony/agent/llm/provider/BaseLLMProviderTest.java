@@ -0,0 +1,113 @@
+package com.harmony.agent.llm.provider;
+
+import com.harmony.agent.core.metrics.MetricsRegistry;
+import com.harmony.agent.llm.model.LLMRequest;
+import com.harmony.agent.llm.model.LLMResponse;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Deque;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * BaseLLMProvider 结构化输出回退单元测试
+ */
+@DisplayName("单元测试: BaseLLMProvider")
+class BaseLLMProviderTest {
+
+    private static final String MODEL = "test-model";
+
+    @AfterEach
+    void tearDown() {
+        BaseLLMProvider.disableRateLimiter();
+    }
+
+    @Test
+    @DisplayName("错误信息提到 response_format 时去掉结构化输出重试，重试前再次限流，之后的请求不再携带")
+    void testFallbackOnResponseFormatError() {
+        BaseLLMProvider.configureRateLimiter("qps", 1000, 0, 1.0);
+        ScriptedProvider provider = new ScriptedProvider("fallback-test",
+            error("API error: 400 - {\"error\":{\"message\":\"response_format json_schema is not supported\"}}"),
+            ok(), ok());
+
+        assertTrue(provider.sendRequest(request()).isSuccess());
+        assertEquals(List.of(true, false), provider.sentFormats);
+        assertEquals(2, rateLimiterWaits("fallback-test"));
+
+        assertTrue(provider.sendRequest(request()).isSuccess());
+        assertEquals(List.of(true, false, false), provider.sentFormats);
+        assertEquals(3, rateLimiterWaits("fallback-test"));
+    }
+
+    @Test
+    @DisplayName("与结构化输出无关的 400 错误原样返回，不重试也不关闭结构化输出")
+    void testNoFallbackOnOtherBadRequest() {
+        ScriptedProvider provider = new ScriptedProvider("no-fallback-test",
+            error("API error: 400 - {\"error\":{\"message\":\"maximum context length exceeded\"}}"), ok());
+
+        LLMResponse response = provider.sendRequest(request());
+        assertFalse(response.isSuccess());
+        assertTrue(response.getErrorMessage().contains("context length"));
+        assertEquals(List.of(true), provider.sentFormats);
+
+        assertTrue(provider.sendRequest(request()).isSuccess());
+        assertEquals(List.of(true, true), provider.sentFormats);
+    }
+
+    private static LLMRequest request() {
+        return LLMRequest.builder()
+            .model(MODEL)
+            .addUserMessage("Is strcpy(dst, input) exploitable?")
+            .jsonSchema("verdict", "{\"type\":\"object\"}")
+            .build();
+    }
+
+    private static LLMResponse ok() {
+        return LLMResponse.builder().content("{\"is_vulnerability\": false}").model(MODEL).build();
+    }
+
+    private static LLMResponse error(String message) {
+        return LLMResponse.builder().errorMessage(message).build();
+    }
+
+    private static long rateLimiterWaits(String provider) {
+        return MetricsRegistry.global().summary("harmony_llm_rate_limiter_wait_seconds",
+            "Time spent waiting for the LLM rate limiter", "provider", provider).getCount();
+    }
+
+    /**
+     * 按脚本返回响应，并记录每次请求是否携带 response_format
+     */
+    private static final class ScriptedProvider extends BaseLLMProvider {
+        private final String name;
+        private final Deque<LLMResponse> script;
+        private final List<Boolean> sentFormats = new ArrayList<>();
+
+        ScriptedProvider(String name, LLMResponse... responses) {
+            super("test-key", "http://127.0.0.1:1");
+            this.name = name;
+            this.script = new ArrayDeque<>(List.of(responses));
+        }
+
+        @Override
+        protected LLMResponse sendHttpRequest(LLMRequest request) {
+            sentFormats.add(responseFormat(request, true) != null);
+            return script.removeFirst();
+        }
+
+        @Override
+        public String getProviderName() {
+            return name;
+        }
+
+        @Override
+        public String[] getAvailableModels() {
+            return new String[]{MODEL};
+        }
+    }
+}
@@ -0,0 +1,179 @@
+package com.harmony.agent.server;
+
+import com.google.gson.JsonObject;
+import com.harmony.agent.core.model.CodeLocation;
+import com.harmony.agent.core.model.IssueCategory;
+import com.harmony.agent.core.model.IssueSeverity;
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.core.store.UnifiedIssueStore;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.io.ByteArrayOutputStream;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.io.PrintStream;
+import java.net.InetAddress;
+import java.net.Socket;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * 常驻服务 JSON-RPC 接口测试（不依赖外部分析工具）
+ */
+@DisplayName("单元测试: AgentServer")
+public class AgentServerTest {
+
+    @TempDir
+    Path tokenDir;
+
+    private AgentServer server;
+    private RemoteClient client;
+
+    @BeforeEach
+    public void setUp() throws Exception {
+        UnifiedIssueStore store = new UnifiedIssueStore();
+        store.addIssue(issue("a", "/project/src/a.c", IssueSeverity.CRITICAL, IssueCategory.BUFFER_OVERFLOW));
+        store.addIssue(issue("b", "/project/src/b.c", IssueSeverity.LOW, IssueCategory.MEMORY_LEAK));
+        store.addIssue(issue("c", "/other/c.c", IssueSeverity.HIGH, IssueCategory.BUFFER_OVERFLOW));
+
+        server = new AgentServer(new AgentService(store), 0, 2, tokenDir);
+        server.start();
+        client = new RemoteClient("http://127.0.0.1:" + server.getPort(), tokenDir);
+    }
+
+    @AfterEach
+    public void tearDown() {
+        server.stop();
+    }
+
+    @Test
+    @DisplayName("query 按路径和最低严重级别过滤，结果按严重级别排序")
+    public void testQuery() throws Exception {
+        JsonObject params = new JsonObject();
+        params.addProperty("severity", "high");
+        JsonObject result = client.call("query", params).getAsJsonObject();
+
+        assertEquals(2, result.get("total").getAsInt());
+        assertEquals("CRITICAL", result.getAsJsonArray("issues").get(0).getAsJsonObject().get("severity").getAsString());
+
+        params = new JsonObject();
+        params.addProperty("path", "/project");
+        result = client.call("query", params).getAsJsonObject();
+        assertEquals(2, result.get("total").getAsInt());
+    }
+
+    @Test
+    @DisplayName("未知方法和非法参数返回 JSON-RPC 错误")
+    public void testErrors() {
+        RpcException unknown = assertThrows(RpcException.class, () -> client.call("nope", null));
+        assertEquals(RpcException.METHOD_NOT_FOUND, unknown.getCode());
+
+        JsonObject params = new JsonObject();
+        params.addProperty("severity", "urgent");
+        RpcException invalid = assertThrows(RpcException.class, () -> client.call("query", params));
+        assertEquals(RpcException.INVALID_PARAMS, invalid.getCode());
+
+        JsonObject parseError = server.dispatch("{not json");
+        assertEquals(RpcException.PARSE_ERROR, parseError.getAsJsonObject("error").get("code").getAsInt());
+    }
+
+    @Test
+    @DisplayName("status 报告常驻状态，shutdown 停止服务")
+    public void testStatusAndShutdown() throws Exception {
+        JsonObject status = client.call("status", null).getAsJsonObject();
+        assertEquals(3, status.get("storedIssues").getAsInt());
+        assertEquals(0, status.get("engines").getAsInt());
+
+        client.call("shutdown", null);
+        server.awaitShutdown();
+        assertFalse(Files.exists(server.getTokenFile()));
+    }
+
+    @Test
+    @DisplayName("--remote 可出现在子命令之后；服务端不支持的命令明确报错")
+    public void testRemoteCommandScope() {
+        assertEquals(1, RemoteClient.remoteFlagIndex(new String[]{"suggest", "--remote", "src"}));
+        assertEquals(0, RemoteClient.remoteFlagIndex(new String[]{"--remote=http://127.0.0.1:1", "status"}));
+        assertEquals(-1, RemoteClient.remoteFlagIndex(new String[]{"analyze", "src"}));
+
+        for (String command : new String[]{"suggest", "refactor", "review"}) {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            ByteArrayOutputStream err = new ByteArrayOutputStream();
+            assertEquals(1, client.run(new String[]{command, "src"}, new PrintStream(out), new PrintStream(err)));
+            assertEquals(0, out.size());
+            assertTrue(err.toString(StandardCharsets.UTF_8).contains("'" + command + "' is not available with --remote"));
+        }
+
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        assertEquals(0, client.run(new String[]{"-v", "status"}, new PrintStream(out), System.err));
+        assertTrue(out.toString(StandardCharsets.UTF_8).contains("storedIssues"));
+    }
+
+    @Test
+    @DisplayName("缺少令牌、跨域、非 JSON 内容类型或非本机 Host 的请求被拒绝")
+    public void testRejectsUntrustedRequests() throws Exception {
+        String token = Files.readString(server.getTokenFile()).trim();
+        String body = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"status\"}";
+        String host = "127.0.0.1:" + server.getPort();
+
+        assertTrue(post(host, "application/json", token, null, body).startsWith("HTTP/1.1 200"));
+        assertTrue(post(host, "application/json", null, null, body).startsWith("HTTP/1.1 401"));
+        assertTrue(post(host, "application/json", "wrong", null, body).startsWith("HTTP/1.1 401"));
+        assertTrue(post(host, "text/plain", token, null, body).startsWith("HTTP/1.1 403"));
+        assertTrue(post(host, "application/json", token, "http://evil.example", body).startsWith("HTTP/1.1 403"));
+        assertTrue(post("evil.example:" + server.getPort(), "application/json", token, null, body)
+            .startsWith("HTTP/1.1 403"));
+
+        // 另一个令牌目录下的客户端拿不到令牌
+        RemoteClient stranger = new RemoteClient("http://127.0.0.1:" + server.getPort(), tokenDir.resolve("other"));
+        assertThrows(java.io.IOException.class, () -> stranger.call("status", null));
+    }
+
+    /**
+     * 用原始套接字发送请求（HttpClient 不允许设置 Host 头），返回完整响应文本
+     */
+    private String post(String host, String contentType, String token, String origin, String body) throws Exception {
+        byte[] payload = body.getBytes(StandardCharsets.UTF_8);
+        StringBuilder request = new StringBuilder()
+            .append("POST /rpc HTTP/1.1\r\n")
+            .append("Host: ").append(host).append("\r\n")
+            .append("Content-Type: ").append(contentType).append("\r\n")
+            .append("Content-Length: ").append(payload.length).append("\r\n")
+            .append("Connection: close\r\n");
+        if (token != null) {
+            request.append(AgentServer.TOKEN_HEADER).append(": ").append(token).append("\r\n");
+        }
+        if (origin != null) {
+            request.append("Origin: ").append(origin).append("\r\n");
+        }
+        request.append("\r\n");
+
+        try (Socket socket = new Socket(InetAddress.getLoopbackAddress(), server.getPort())) {
+            OutputStream out = socket.getOutputStream();
+            out.write(request.toString().getBytes(StandardCharsets.UTF_8));
+            out.write(payload);
+            out.flush();
+            InputStream in = socket.getInputStream();
+            return new String(in.readAllBytes(), StandardCharsets.UTF_8);
+        }
+    }
+
+    private static SecurityIssue issue(String id, String file, IssueSeverity severity, IssueCategory category) {
+        return new SecurityIssue.Builder()
+            .id(id)
+            .title("Issue " + id)
+            .description("test")
+            .severity(severity)
+            .category(category)
+            .location(new CodeLocation(file, 10))
+            .analyzer("test")
+            .build();
+    }
+}
@@ -0,0 +1,111 @@
+package com.harmony.agent.strategic;
+
+import com.harmony.agent.strategic.CodeMetrics.FunctionMetrics;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * CodeMetricsAnalyzer 单遍度量测试
+ */
+@DisplayName("单元测试: CodeMetricsAnalyzer")
+public class CodeMetricsAnalyzerTest {
+
+    private final CodeMetricsAnalyzer analyzer = new CodeMetricsAnalyzer();
+
+    @Test
+    @DisplayName("按函数统计圈复杂度和嵌套深度")
+    public void testComplexityAndNesting() {
+        String code = """
+            #include <stdio.h>
+            static int table[] = { 1, 2, 3 };
+
+            int classify(int a, int b) {
+                if (a > 0 && b > 0) {
+                    for (int i = 0; i < a; i++) {
+                        if (i % 2) {
+                            b++;
+                        }
+                    }
+                } else if (a < 0 || b < 0) {
+                    return -1;
+                }
+                return b > 10 ? 1 : 0;
+            }
+
+            void empty(void) {
+            }
+            """;
+
+        CodeMetrics metrics = analyzer.analyze(code);
+
+        assertEquals(2, metrics.getFunctionCount());
+        FunctionMetrics classify = metrics.getFunctions().get(0);
+        assertEquals("classify", classify.getName());
+        assertEquals(4, classify.getStartLine());
+        // 1 + if + && + for + if + if + || + ?
+        assertEquals(8, classify.getCyclomaticComplexity());
+        assertEquals(4, classify.getMaxNestingDepth());
+
+        FunctionMetrics empty = metrics.getFunctions().get(1);
+        assertEquals("empty", empty.getName());
+        assertEquals(1, empty.getCyclomaticComplexity());
+    }
+
+    @Test
+    @DisplayName("注释和字符串中的关键字不计数")
+    public void testIgnoresCommentsAndStrings() {
+        String code = """
+            void f(char *dst) {
+                // strcpy(dst, "x"); goto out;
+                /* if (x) { longjmp(env, 1); } */
+                puts("if (a && b) strcpy(dst, src)");
+                strcpy(dst, "ok");
+            }
+            """;
+
+        FunctionMetrics f = analyzer.analyze(code).getFunctions().get(0);
+
+        assertEquals(1, f.getCyclomaticComplexity());
+        assertEquals(0, f.getGotoCount());
+        assertEquals(0, f.getLongjmpCount());
+        assertEquals(1, f.getUnsafeCallCount());
+    }
+
+    @Test
+    @DisplayName("识别 goto、setjmp/longjmp 和 C++ 成员函数")
+    public void testDangerousControlFlowAndCppMethods() {
+        String code = """
+            namespace io {
+            int Reader::read(jmp_buf env) {
+                if (setjmp(env)) goto fail;
+                longjmp(env, 1);
+            fail:
+                return 0;
+            }
+            }
+            """;
+
+        CodeMetrics metrics = analyzer.analyze(code);
+
+        assertEquals(1, metrics.getFunctionCount());
+        FunctionMetrics read = metrics.getFunctions().get(0);
+        assertEquals("Reader::read", read.getName());
+        assertEquals(1, read.getGotoCount());
+        assertEquals(2, read.getLongjmpCount());
+    }
+
+    @Test
+    @DisplayName("复杂度惩罚上限为 15 分")
+    public void testPenaltyCap() {
+        StringBuilder code = new StringBuilder("void f(void) {\n");
+        for (int i = 0; i < 10; i++) {
+            code.append("    goto l").append(i).append(";\n");
+        }
+        code.append("}\n");
+
+        SecurityScoringService service = new SecurityScoringService(null);
+        assertEquals(15, service.calculateComplexityPenalty(analyzer.analyze(code)));
+    }
+}
@@ -0,0 +1,65 @@
+package com.harmony.agent.strategic;
+
+import com.harmony.agent.strategic.SecurityScoringService.SecurityScore;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * 模块聚合与构建目标解析测试
+ */
+@DisplayName("单元测试: ModuleScore / ModuleResolver")
+public class ModuleScoreTest {
+
+    @TempDir
+    Path root;
+
+    @Test
+    @DisplayName("从 CMake 目标文件路径提取构建目标")
+    public void testExtractTarget() {
+        assertEquals("bz2", ModuleResolver.extractTarget("CMakeFiles/bz2.dir/src/blocksort.c.o"));
+        assertEquals("zlib", ModuleResolver.extractTarget("lib\\CMakeFiles\\zlib.dir\\inflate.c.obj"));
+        assertNull(ModuleResolver.extractTarget("blocksort.o"));
+        assertNull(ModuleResolver.extractTarget(null));
+    }
+
+    @Test
+    @DisplayName("按目录聚合：单个高危文件拉低模块分数")
+    public void testAggregateByDirectory() {
+        String a = root.resolve("src/a.c").toString();
+        String b = root.resolve("src/b.c").toString();
+        String c = root.resolve("lib/c.c").toString();
+        List<SecurityScore> files = List.of(
+            new SecurityScore(a, 100, "LOW", 0, 0, 0, 0, 0),
+            new SecurityScore(b, 40, "HIGH", 1, 1, 0, 0, 0),
+            new SecurityScore(c, 90, "LOW", 0, 0, 0, 2, 0)
+        );
+
+        List<SecurityScore> modules = ModuleScore.aggregate(files,
+            ModuleResolver.create(root, ModuleResolver.Granularity.DIRECTORY));
+
+        assertEquals(2, modules.size());
+        ModuleScore src = (ModuleScore) modules.get(0);
+        assertEquals("src", src.getModuleName());
+        // (平均 70 + 最低 40) / 2
+        assertEquals(55, src.getScore());
+        assertEquals(1, src.getCriticalCount());
+        assertEquals(2, src.getFileScores().size());
+        assertEquals("lib", modules.get(1).getModuleName());
+    }
+
+    @Test
+    @DisplayName("FILE 粒度保持原有按文件评分")
+    public void testFileGranularityPassesThrough() {
+        List<SecurityScore> files = List.of(
+            new SecurityScore(root.resolve("a.c").toString(), 80, "MEDIUM", 0, 0, 1, 0, 0));
+
+        assertSame(files, ModuleScore.aggregate(files,
+            ModuleResolver.create(root, ModuleResolver.Granularity.FILE)));
+    }
+}
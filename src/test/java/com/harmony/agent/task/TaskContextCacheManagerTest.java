@@ -0,0 +1,142 @@
+package com.harmony.agent.task;
+
+import com.harmony.agent.cli.ConsolePrinter;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * TaskContextCacheManager 事件日志持久化测试
+ */
+@DisplayName("单元测试: TaskContextCacheManager 事件日志")
+public class TaskContextCacheManagerTest {
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    @DisplayName("每次状态变化只追加一行事件")
+    public void testAppendOnlyLog() throws Exception {
+        TaskContextCacheManager manager = new TaskContextCacheManager(new TaskEventLog(tempDir, 1000));
+        String sessionId = manager.getCurrentSessionId();
+
+        manager.cacheRequirement("实现登录功能");
+        manager.cacheTaskList(List.of(new Task(1, "设计接口"), new Task(2, "编写代码")));
+        manager.recordTaskStarted(1);
+
+        List<String> lines = Files.readAllLines(tempDir.resolve(sessionId + ".log"));
+        assertEquals(3, lines.size());
+        assertTrue(lines.get(2).contains("TASK_STARTED"));
+        assertTrue(lines.get(0).startsWith("{\"seq\":1,"), "事件应为紧凑的单行 JSON");
+    }
+
+    @Test
+    @DisplayName("崩溃后可通过日志重放恢复会话")
+    public void testRecoverFromLogOnly() {
+        TaskContextCacheManager writer = new TaskContextCacheManager(new TaskEventLog(tempDir, 1000));
+        String sessionId = writer.getCurrentSessionId();
+
+        writer.cacheRequirement("实现登录功能");
+        writer.cacheTaskList(List.of(new Task(1, "设计接口"), new Task(2, "编写代码")));
+        writer.recordTaskStarted(1);
+        writer.cacheTaskResult(1, "设计接口", "接口已完成", true);
+        writer.recordTaskStarted(2);
+        writer.recordDecision("使用 JWT", "无状态");
+
+        TaskContextCacheManager reader = new TaskContextCacheManager(new TaskEventLog(tempDir, 1000));
+        assertTrue(reader.recoverSession(sessionId));
+
+        assertEquals("实现登录功能", reader.getCachedRequirement());
+        List<Task> tasks = reader.getCachedTaskList();
+        assertEquals(2, tasks.size());
+        assertTrue(tasks.get(0).isCompleted());
+        assertTrue(tasks.get(1).isInProgress());
+        assertEquals("接口已完成", reader.getCachedTaskResult(1).output);
+
+        TaskExecutionContext context = reader.recoverExecutionContext();
+        assertNotNull(context);
+        assertEquals("无状态", context.getDecisions().get("使用 JWT"));
+        assertTrue(context.getTaskResult(1).isSuccess());
+    }
+
+    @Test
+    @DisplayName("快照后只重放日志尾部")
+    public void testRecoverFromSnapshotAndTail() throws Exception {
+        TaskContextCacheManager writer = new TaskContextCacheManager(new TaskEventLog(tempDir, 3));
+        String sessionId = writer.getCurrentSessionId();
+
+        writer.cacheRequirement("需求");
+        writer.cacheTaskList(List.of(new Task(1, "a"), new Task(2, "b")));
+        writer.recordTaskStarted(1);           // 第 3 个事件触发快照
+        writer.cacheTaskResult(1, "a", "ok", true);
+
+        assertTrue(Files.exists(tempDir.resolve(sessionId + ".snapshot")));
+        assertEquals(1, Files.readAllLines(tempDir.resolve(sessionId + ".log")).size());
+
+        TaskContextCacheManager reader = new TaskContextCacheManager(new TaskEventLog(tempDir, 3));
+        assertTrue(reader.recoverSession(sessionId));
+        assertEquals("需求", reader.getCachedRequirement());
+        assertTrue(reader.getCachedTaskList().get(0).isCompleted());
+        assertEquals(1, reader.getAllCachedTaskResults().size());
+    }
+
+    @Test
+    @DisplayName("损坏的日志尾部被忽略")
+    public void testTornTailIgnored() throws Exception {
+        TaskContextCacheManager writer = new TaskContextCacheManager(new TaskEventLog(tempDir, 1000));
+        String sessionId = writer.getCurrentSessionId();
+        writer.cacheRequirement("需求");
+        Files.writeString(tempDir.resolve(sessionId + ".log"), "{\"seq\":2,\"type\":\"ANA",
+            java.nio.file.StandardOpenOption.APPEND);
+
+        TaskContextCacheManager reader = new TaskContextCacheManager(new TaskEventLog(tempDir, 1000));
+        assertTrue(reader.recoverSession(sessionId));
+        assertEquals("需求", reader.getCachedRequirement());
+        assertNull(reader.getCachedAnalysisResult());
+    }
+
+    @Test
+    @DisplayName("启动时恢复最近的未完成计划，其余会话文件被删除")
+    public void testRecoverUnfinishedPlan() throws Exception {
+        TaskEventLog log = new TaskEventLog(tempDir, 1000);
+
+        TaskContextCacheManager finished = new TaskContextCacheManager(log);
+        finished.cacheRequirement("已完成的需求");
+        finished.cacheTaskList(List.of(new Task(1, "a")));
+        finished.cacheTaskResult(1, "a", "ok", true);
+
+        TaskContextCacheManager noPlan = new TaskContextCacheManager(log);
+        noPlan.cacheRequirement("规划时中断的需求");
+
+        TaskContextCacheManager unfinished = new TaskContextCacheManager(log);
+        String unfinishedId = unfinished.getCurrentSessionId();
+        unfinished.cacheRequirement("实现登录功能");
+        unfinished.cacheTaskList(List.of(new Task(1, "设计接口"), new Task(2, "编写代码")));
+        unfinished.recordTaskStarted(1);
+        unfinished.cacheTaskResult(1, "设计接口", "接口已完成", true);
+        unfinished.recordTaskStarted(2);
+
+        // 恢复只回放事件日志，不创建 LLM 客户端
+        TodoListManager manager = new TodoListManager(() -> {
+            throw new AssertionError("LLM client created during recovery");
+        }, new ConsolePrinter(false), log);
+        assertTrue(manager.recoverUnfinishedPlan());
+
+        TodoList plan = manager.getActiveTodoList();
+        assertEquals("实现登录功能", plan.getRequirement());
+        assertEquals(2, plan.getCurrentTask().orElseThrow().getId());
+        assertEquals("接口已完成", plan.getCompletedTasks().get(0).getOutput());
+        assertEquals(List.of(unfinishedId), log.listSessions());
+
+        // 清除计划后会话文件也被删除
+        manager.clearTodoList();
+        assertTrue(log.listSessions().isEmpty());
+        assertFalse(manager.recoverUnfinishedPlan());
+    }
+}
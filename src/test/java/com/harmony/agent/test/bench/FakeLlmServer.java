@@ -0,0 +1,236 @@
+package com.harmony.agent.test.bench;
+
+import com.google.gson.JsonArray;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParser;
+import com.sun.net.httpserver.HttpExchange;
+import com.sun.net.httpserver.HttpServer;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * 本地 OpenAI 兼容 LLM 桩服务（测试工具）
+ *
+ * 实现 POST {base}/chat/completions，可配置：
+ * - 响应延迟分布：对数正态分布（中位数 + sigma；sigma=0 时为固定延迟）
+ * - 429 注入概率（带 Retry-After 头）
+ * - 每次响应的 completion token 数；prompt token 按请求字符数 / 4 估算
+ * - 确认率：响应中 is_vulnerability=true 的比例（按请求内容哈希确定，结果可复现）
+ *
+ * 用法：
+ * <pre>
+ * try (FakeLlmServer server = FakeLlmServer.builder().medianLatencyMs(300).throttleRate(0.05).start()) {
+ *     new SiliconFlowProvider("any-key", server.getBaseUrl());
+ * }
+ * </pre>
+ */
+public class FakeLlmServer implements AutoCloseable {
+
+    private final HttpServer httpServer;
+    private final ExecutorService workers;
+
+    private final long medianLatencyMs;
+    private final double latencySigma;
+    private final double throttleRate;
+    private final int completionTokens;
+    private final double confirmRate;
+
+    private final AtomicLong requests = new AtomicLong();
+    private final AtomicLong throttled = new AtomicLong();
+    private final AtomicLong promptTokens = new AtomicLong();
+    private final AtomicLong completionTokensTotal = new AtomicLong();
+    private final AtomicLong latencyTotalMs = new AtomicLong();
+
+    private FakeLlmServer(Builder builder) throws IOException {
+        this.medianLatencyMs = builder.medianLatencyMs;
+        this.latencySigma = builder.latencySigma;
+        this.throttleRate = builder.throttleRate;
+        this.completionTokens = builder.completionTokens;
+        this.confirmRate = builder.confirmRate;
+
+        this.httpServer = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        // 延迟通过 sleep 模拟，每个请求占用一个线程，避免排队放大延迟
+        this.workers = Executors.newCachedThreadPool(r -> {
+            Thread thread = new Thread(r, "fake-llm-worker");
+            thread.setDaemon(true);
+            return thread;
+        });
+        httpServer.createContext("/", this::handle);
+        httpServer.setExecutor(workers);
+        httpServer.start();
+    }
+
+    public static Builder builder() {
+        return new Builder();
+    }
+
+    /**
+     * OpenAI 兼容的 base URL（可直接作为 providers.siliconflow.base_url）
+     */
+    public String getBaseUrl() {
+        return "http://127.0.0.1:" + httpServer.getAddress().getPort() + "/v1";
+    }
+
+    public long getRequestCount() {
+        return requests.get();
+    }
+
+    public long getThrottledCount() {
+        return throttled.get();
+    }
+
+    public long getPromptTokens() {
+        return promptTokens.get();
+    }
+
+    public long getCompletionTokens() {
+        return completionTokensTotal.get();
+    }
+
+    /**
+     * 已成功响应请求的平均注入延迟
+     */
+    public double getAverageLatencyMs() {
+        long served = requests.get() - throttled.get();
+        return served > 0 ? (double) latencyTotalMs.get() / served : 0.0;
+    }
+
+    @Override
+    public void close() {
+        httpServer.stop(0);
+        workers.shutdownNow();
+    }
+
+    private void handle(HttpExchange exchange) throws IOException {
+        String body;
+        try (InputStream in = exchange.getRequestBody()) {
+            body = new String(in.readAllBytes(), StandardCharsets.UTF_8);
+        }
+
+        if (!"POST".equalsIgnoreCase(exchange.getRequestMethod())
+                || !exchange.getRequestURI().getPath().endsWith("/chat/completions")) {
+            send(exchange, 404, "{\"error\":{\"message\":\"not found\"}}");
+            return;
+        }
+
+        requests.incrementAndGet();
+        ThreadLocalRandom random = ThreadLocalRandom.current();
+
+        if (throttleRate > 0 && random.nextDouble() < throttleRate) {
+            throttled.incrementAndGet();
+            exchange.getResponseHeaders().set("Retry-After", "1");
+            send(exchange, 429, "{\"error\":{\"message\":\"Rate limit exceeded\",\"type\":\"rate_limit\"}}");
+            return;
+        }
+
+        long latency = sampleLatency(random);
+        if (latency > 0) {
+            try {
+                Thread.sleep(latency);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                return;
+            }
+        }
+        latencyTotalMs.addAndGet(latency);
+
+        JsonObject request;
+        try {
+            request = JsonParser.parseString(body).getAsJsonObject();
+        } catch (RuntimeException e) {
+            send(exchange, 400, "{\"error\":{\"message\":\"invalid JSON\"}}");
+            return;
+        }
+
+        int prompt = Math.max(1, body.length() / 4);
+        promptTokens.addAndGet(prompt);
+        completionTokensTotal.addAndGet(completionTokens);
+
+        send(exchange, 200, completion(request, body, prompt).toString());
+    }
+
+    private long sampleLatency(ThreadLocalRandom random) {
+        if (medianLatencyMs <= 0) {
+            return 0;
+        }
+        if (latencySigma <= 0) {
+            return medianLatencyMs;
+        }
+        return Math.round(medianLatencyMs * Math.exp(latencySigma * random.nextGaussian()));
+    }
+
+    private JsonObject completion(JsonObject request, String body, int prompt) {
+        boolean confirmed = Math.floorMod(body.hashCode(), 1000) < confirmRate * 1000;
+
+        JsonObject verdict = new JsonObject();
+        verdict.addProperty("is_vulnerability", confirmed);
+        verdict.addProperty("reason", confirmed
+            ? "Untrusted input reaches the sink without bounds checking (offline stub)"
+            : "Input is validated before use (offline stub)");
+        verdict.addProperty("suggested_severity", confirmed ? "HIGH" : "LOW");
+
+        JsonObject message = new JsonObject();
+        message.addProperty("role", "assistant");
+        message.addProperty("content", verdict.toString());
+
+        JsonObject choice = new JsonObject();
+        choice.addProperty("index", 0);
+        choice.add("message", message);
+        choice.addProperty("finish_reason", "stop");
+        JsonArray choices = new JsonArray();
+        choices.add(choice);
+
+        JsonObject usage = new JsonObject();
+        usage.addProperty("prompt_tokens", prompt);
+        usage.addProperty("completion_tokens", completionTokens);
+        usage.addProperty("total_tokens", prompt + completionTokens);
+
+        JsonObject response = new JsonObject();
+        response.addProperty("id", "chatcmpl-offline-" + requests.get());
+        response.addProperty("object", "chat.completion");
+        response.addProperty("created", System.currentTimeMillis() / 1000);
+        response.addProperty("model", request.has("model") ? request.get("model").getAsString() : "offline-stub");
+        response.add("choices", choices);
+        response.add("usage", usage);
+        return response;
+    }
+
+    private static void send(HttpExchange exchange, int status, String json) throws IOException {
+        byte[] bytes = json.getBytes(StandardCharsets.UTF_8);
+        exchange.getResponseHeaders().set("Content-Type", "application/json");
+        exchange.sendResponseHeaders(status, bytes.length);
+        try (OutputStream out = exchange.getResponseBody()) {
+            out.write(bytes);
+        }
+    }
+
+    /**
+     * 桩服务参数
+     */
+    public static class Builder {
+        private long medianLatencyMs = 0;
+        private double latencySigma = 0;
+        private double throttleRate = 0;
+        private int completionTokens = 60;
+        private double confirmRate = 0.7;
+
+        public Builder medianLatencyMs(long medianLatencyMs) { this.medianLatencyMs = medianLatencyMs; return this; }
+        public Builder latencySigma(double latencySigma) { this.latencySigma = latencySigma; return this; }
+        public Builder throttleRate(double throttleRate) { this.throttleRate = throttleRate; return this; }
+        public Builder completionTokens(int completionTokens) { this.completionTokens = completionTokens; return this; }
+        public Builder confirmRate(double confirmRate) { this.confirmRate = confirmRate; return this; }
+
+        public FakeLlmServer start() throws IOException {
+            return new FakeLlmServer(this);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+package com.harmony.agent.test.bench;
+
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParser;
+import com.harmony.agent.core.analyzer.ClangAnalyzer;
+import com.harmony.agent.core.analyzer.SemgrepAnalyzer;
+import com.harmony.agent.core.model.SecurityIssue;
+import com.harmony.agent.llm.model.LLMRequest;
+import com.harmony.agent.llm.model.LLMResponse;
+import com.harmony.agent.llm.provider.SiliconFlowProvider;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.condition.EnabledOnOs;
+import org.junit.jupiter.api.condition.OS;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * 离线基准桩（FakeLlmServer / StubToolchain）单元测试
+ */
+@DisplayName("单元测试: 离线基准桩")
+class FakeLlmServerTest {
+
+    @TempDir
+    Path tempDir;
+
+    private static LLMRequest request() {
+        return LLMRequest.builder()
+            .model("Qwen/Qwen2.5-7B-Instruct")
+            .addUserMessage("Is strcpy(dst, input) exploitable?")
+            .temperature(0.3)
+            .maxTokens(200)
+            .build();
+    }
+
+    @Test
+    @DisplayName("SiliconFlowProvider 通过 base_url 访问桩服务并解析 token 用量")
+    void testProviderTargetsStub() throws Exception {
+        try (FakeLlmServer server = FakeLlmServer.builder().completionTokens(42).start()) {
+            SiliconFlowProvider provider = new SiliconFlowProvider("offline", server.getBaseUrl());
+            LLMResponse response = provider.sendRequest(request());
+
+            assertTrue(response.isSuccess(), response.getErrorMessage());
+            assertEquals(42, response.getCompletionTokens());
+            assertTrue(response.getPromptTokens() > 0);
+
+            JsonObject verdict = JsonParser.parseString(response.getContent()).getAsJsonObject();
+            assertTrue(verdict.has("is_vulnerability"));
+            assertTrue(verdict.has("suggested_severity"));
+            assertEquals(1, server.getRequestCount());
+        }
+    }
+
+    @Test
+    @DisplayName("注入 429 时返回错误响应并计数")
+    void testThrottleInjection() throws Exception {
+        try (FakeLlmServer server = FakeLlmServer.builder().throttleRate(1.0).start()) {
+            LLMResponse response = new SiliconFlowProvider("offline", server.getBaseUrl()).sendRequest(request());
+
+            assertFalse(response.isSuccess());
+            assertTrue(response.getErrorMessage().contains("429"));
+            assertEquals(1, server.getThrottledCount());
+        }
+    }
+
+    @Test
+    @DisplayName("固定延迟生效")
+    void testLatency() throws Exception {
+        try (FakeLlmServer server = FakeLlmServer.builder().medianLatencyMs(150).start()) {
+            long start = System.nanoTime();
+            new SiliconFlowProvider("offline", server.getBaseUrl()).sendRequest(request());
+            assertTrue((System.nanoTime() - start) / 1_000_000 >= 150);
+            assertEquals(150.0, server.getAverageLatencyMs(), 0.001);
+        }
+    }
+
+    @Test
+    @EnabledOnOs({OS.LINUX, OS.MAC})
+    @DisplayName("桩 clang-tidy / semgrep 的输出可被分析器解析")
+    void testStubToolchain() throws Exception {
+        StubToolchain tools = StubToolchain.install(tempDir.resolve("bin"), 0, 2);
+        Path source = tempDir.resolve("a.c");
+        Files.writeString(source, "int main(void) { return 0; }\n");
+
+        ClangAnalyzer clang = new ClangAnalyzer(tools.getClangTidy().toString());
+        assertTrue(clang.isAvailable());
+        List<SecurityIssue> clangIssues = clang.analyzeAll(List.of(source));
+        assertEquals(2, clangIssues.size());
+        assertEquals(10, clangIssues.get(0).getLocation().getLineNumber());
+
+        SemgrepAnalyzer semgrep = new SemgrepAnalyzer(tools.getSemgrep().toString(), tempDir.resolve("rules"));
+        assertTrue(semgrep.isAvailable());
+        assertEquals(2, semgrep.analyzeAll(List.of(source)).size());
+    }
+}
@@ -0,0 +1,297 @@
+package com.harmony.agent.test.bench;
+
+import com.google.gson.GsonBuilder;
+import com.google.gson.JsonObject;
+import com.harmony.agent.config.AppConfig;
+import com.harmony.agent.config.ConfigManager;
+import com.harmony.agent.core.AnalysisEngine;
+import com.harmony.agent.core.model.ScanResult;
+import com.harmony.agent.test.corpus.SyntheticCorpusGenerator;
+
+import java.io.IOException;
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.lang.management.MemoryType;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * 离线端到端基准测试（测试工具）
+ *
+ * 在合成语料上完整运行 AnalysisEngine.analyze，外部依赖全部替换为本地桩：
+ * - LLM：{@link FakeLlmServer}，通过 providers.siliconflow.base_url 接入 SiliconFlowProvider
+ * - clang-tidy / semgrep：{@link StubToolchain}
+ * - user.home 指向临时目录，缓存与配置不污染本机环境
+ *
+ * 输出各阶段耗时、吞吐量（文件/秒、行/秒）、LLM 请求统计与峰值 RSS，并写出 JSON 报告。
+ *
+ * 用法（test classpath）：
+ *   mvn -q test-compile exec:java -Dexec.classpathScope=test \
+ *     -Dexec.mainClass=com.harmony.agent.test.bench.OfflineE2EBenchmark \
+ *     -Dexec.args="--files 2000 --ai --llm-latency-ms 400 --llm-429-rate 0.05 --out target/bench-e2e.json"
+ */
+public class OfflineE2EBenchmark {
+
+    /**
+     * 基准参数
+     */
+    public static class Options {
+        int files = 500;
+        long seed = 42;
+        String level = "standard";
+        int threads = Runtime.getRuntime().availableProcessors();
+        boolean ai = false;
+        long llmLatencyMs = 300;
+        double llmLatencySigma = 0.4;
+        double llm429Rate = 0.0;
+        int llmCompletionTokens = 60;
+        double llmRequestsPerSecond = 50.0;
+        long toolDelayMs = 20;
+        int toolFindingsPerFile = 1;
+        double incrementalFraction = 0.0; // > 0 时先提交到 git，修改部分文件后以增量模式运行
+        Path workDir;
+        Path out;
+
+        static Options parse(String[] args) {
+            Options options = new Options();
+            for (int i = 0; i < args.length; i++) {
+                switch (args[i]) {
+                    case "--files" -> options.files = Integer.parseInt(args[++i]);
+                    case "--seed" -> options.seed = Long.parseLong(args[++i]);
+                    case "--level" -> options.level = args[++i];
+                    case "--threads" -> options.threads = Integer.parseInt(args[++i]);
+                    case "--ai" -> options.ai = true;
+                    case "--llm-latency-ms" -> options.llmLatencyMs = Long.parseLong(args[++i]);
+                    case "--llm-latency-sigma" -> options.llmLatencySigma = Double.parseDouble(args[++i]);
+                    case "--llm-429-rate" -> options.llm429Rate = Double.parseDouble(args[++i]);
+                    case "--llm-completion-tokens" -> options.llmCompletionTokens = Integer.parseInt(args[++i]);
+                    case "--llm-rps" -> options.llmRequestsPerSecond = Double.parseDouble(args[++i]);
+                    case "--tool-delay-ms" -> options.toolDelayMs = Long.parseLong(args[++i]);
+                    case "--tool-findings" -> options.toolFindingsPerFile = Integer.parseInt(args[++i]);
+                    case "--incremental" -> options.incrementalFraction = Double.parseDouble(args[++i]);
+                    case "--work-dir" -> options.workDir = Paths.get(args[++i]);
+                    case "--out" -> options.out = Paths.get(args[++i]);
+                    default -> throw new IllegalArgumentException("Unknown option: " + args[i]);
+                }
+            }
+            return options;
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Options options = Options.parse(args);
+        Path workDir = options.workDir != null ? options.workDir : Files.createTempDirectory("harmony-bench-e2e-");
+
+        // 必须在 ConfigManager / 缓存类加载前切换 user.home
+        Path home = workDir.resolve("home");
+        Files.createDirectories(home);
+        System.setProperty("user.home", home.toString());
+
+        JsonObject report = run(options, workDir);
+        String json = new GsonBuilder().setPrettyPrinting().create().toJson(report);
+        if (options.out != null) {
+            if (options.out.toAbsolutePath().getParent() != null) {
+                Files.createDirectories(options.out.toAbsolutePath().getParent());
+            }
+            Files.writeString(options.out, json);
+        }
+        printSummary(report);
+        System.exit(0);
+    }
+
+    /**
+     * 运行一次基准，返回 JSON 报告
+     */
+    static JsonObject run(Options options, Path workDir) throws Exception {
+        Map<String, Long> phases = new LinkedHashMap<>();
+        Path corpus = workDir.resolve("corpus");
+
+        long t0 = System.nanoTime();
+        SyntheticCorpusGenerator.Manifest manifest = new SyntheticCorpusGenerator(
+            new SyntheticCorpusGenerator.Config().seed(options.seed).files(options.files)).generate(corpus);
+        phases.put("corpus_generation_ms", elapsedMs(t0));
+
+        if (options.incrementalFraction > 0) {
+            t0 = System.nanoTime();
+            git(corpus, "init", "-q");
+            git(corpus, "add", "-A");
+            git(corpus, "-c", "user.name=bench", "-c", "user.email=bench@localhost", "commit", "-q", "-m", "baseline");
+            SyntheticCorpusGenerator.mutate(corpus, options.incrementalFraction, options.seed);
+            phases.put("incremental_setup_ms", elapsedMs(t0));
+        }
+
+        StubToolchain tools = StubToolchain.install(workDir.resolve("bin"), options.toolDelayMs,
+            options.toolFindingsPerFile);
+
+        try (FakeLlmServer llm = FakeLlmServer.builder()
+                .medianLatencyMs(options.llmLatencyMs)
+                .latencySigma(options.llmLatencySigma)
+                .throttleRate(options.llm429Rate)
+                .completionTokens(options.llmCompletionTokens)
+                .start()) {
+
+            configure(tools, llm, options);
+            resetPeakHeap();
+
+            t0 = System.nanoTime();
+            AnalysisEngine engine = new AnalysisEngine(corpus.toString(), new AnalysisEngine.AnalysisConfig(
+                options.level, options.incrementalFraction > 0, true, options.threads, 3600,
+                corpus.resolve("compile_commands.json").toString(), options.ai));
+            phases.put("engine_init_ms", elapsedMs(t0));
+
+            ScanResult result;
+            t0 = System.nanoTime();
+            try {
+                result = engine.analyze();
+            } finally {
+                engine.shutdown();
+            }
+            long analyzeMs = elapsedMs(t0);
+            phases.put("analyze_ms", analyzeMs);
+
+            // 引擎内部的分阶段统计（*_ms）直接并入
+            for (Map.Entry<String, Object> entry : result.getStatistics().entrySet()) {
+                if (entry.getKey().endsWith("_ms") && entry.getValue() instanceof Number number) {
+                    phases.put("engine." + entry.getKey(), number.longValue());
+                }
+            }
+
+            int analyzedFiles = ((Number) result.getStatistics().getOrDefault("total_files", 0)).intValue();
+            double seconds = Math.max(analyzeMs, 1) / 1000.0;
+
+            JsonObject report = new JsonObject();
+            JsonObject config = new JsonObject();
+            config.addProperty("files", options.files);
+            config.addProperty("seed", options.seed);
+            config.addProperty("level", options.level);
+            config.addProperty("threads", options.threads);
+            config.addProperty("ai", options.ai);
+            config.addProperty("llm_latency_ms", options.llmLatencyMs);
+            config.addProperty("llm_latency_sigma", options.llmLatencySigma);
+            config.addProperty("llm_429_rate", options.llm429Rate);
+            config.addProperty("tool_delay_ms", options.toolDelayMs);
+            config.addProperty("incremental_fraction", options.incrementalFraction);
+            report.add("config", config);
+
+            JsonObject phaseJson = new JsonObject();
+            phases.forEach(phaseJson::addProperty);
+            report.add("phases", phaseJson);
+
+            JsonObject throughput = new JsonObject();
+            throughput.addProperty("analyzed_files", analyzedFiles);
+            throughput.addProperty("corpus_lines", manifest.totalLines);
+            throughput.addProperty("files_per_sec", analyzedFiles / seconds);
+            throughput.addProperty("lines_per_sec", manifest.totalLines / seconds);
+            throughput.addProperty("issues", result.getTotalIssueCount());
+            throughput.addProperty("seeded_vulnerabilities", manifest.vulnerabilities.size());
+            report.add("throughput", throughput);
+
+            JsonObject llmJson = new JsonObject();
+            llmJson.addProperty("requests", llm.getRequestCount());
+            llmJson.addProperty("throttled_429", llm.getThrottledCount());
+            llmJson.addProperty("prompt_tokens", llm.getPromptTokens());
+            llmJson.addProperty("completion_tokens", llm.getCompletionTokens());
+            llmJson.addProperty("avg_latency_ms", llm.getAverageLatencyMs());
+            report.add("llm", llmJson);
+
+            JsonObject memoryJson = new JsonObject();
+            memoryJson.addProperty("peak_rss_kb", peakRssKb());
+            memoryJson.addProperty("peak_heap_mb", peakHeapBytes() / (1024 * 1024));
+            report.add("memory", memoryJson);
+
+            JsonObject statistics = new JsonObject();
+            result.getStatistics().forEach((key, value) -> {
+                if (value instanceof Number number) {
+                    statistics.addProperty(key, number);
+                } else if (value != null) {
+                    statistics.addProperty(key, value.toString());
+                }
+            });
+            report.add("statistics", statistics);
+            return report;
+        }
+    }
+
+    /**
+     * 让 ConfigManager 指向桩工具和桩 LLM 服务
+     */
+    private static void configure(StubToolchain tools, FakeLlmServer llm, Options options) {
+        AppConfig config = ConfigManager.getInstance().getConfig();
+        config.getTools().setClangPath(tools.getClangTidy().toString());
+        config.getTools().setSemgrepPath(tools.getSemgrep().toString());
+
+        AppConfig.ProviderConfig siliconflow = config.getAi().getProviders()
+            .computeIfAbsent("siliconflow", name -> new AppConfig.ProviderConfig());
+        siliconflow.setApiKey("offline-benchmark");
+        siliconflow.setBaseUrl(llm.getBaseUrl());
+        config.getAi().setProvider("siliconflow");
+        config.getAi().setRequestsPerSecondLimit(options.llmRequestsPerSecond);
+    }
+
+    private static void git(Path dir, String... args) throws IOException, InterruptedException {
+        String[] command = new String[args.length + 1];
+        command[0] = "git";
+        System.arraycopy(args, 0, command, 1, args.length);
+        Process process = new ProcessBuilder(command).directory(dir.toFile())
+            .redirectErrorStream(true)
+            .redirectOutput(ProcessBuilder.Redirect.DISCARD)
+            .start();
+        if (process.waitFor() != 0) {
+            throw new IOException("git " + String.join(" ", args) + " failed in " + dir);
+        }
+    }
+
+    private static long elapsedMs(long startNanos) {
+        return (System.nanoTime() - startNanos) / 1_000_000;
+    }
+
+    private static void printSummary(JsonObject report) {
+        System.out.println();
+        System.out.println("=== Offline E2E Benchmark ===");
+        for (String section : List.of("phases", "throughput", "llm", "memory")) {
+            System.out.println("[" + section + "]");
+            report.getAsJsonObject(section).entrySet().forEach(entry ->
+                System.out.printf("  %-28s %s%n", entry.getKey(), entry.getValue()));
+        }
+    }
+
+    private static void resetPeakHeap() {
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            pool.resetPeakUsage();
+        }
+    }
+
+    private static long peakHeapBytes() {
+        long total = 0;
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            if (pool.getType() == MemoryType.HEAP && pool.getPeakUsage() != null) {
+                total += pool.getPeakUsage().getUsed();
+            }
+        }
+        return total;
+    }
+
+    /**
+     * 进程生命周期内的 RSS 峰值（/proc/self/status 的 VmHWM），非 Linux 返回 -1
+     */
+    private static long peakRssKb() {
+        Path status = Paths.get("/proc/self/status");
+        if (!Files.isReadable(status)) {
+            return -1;
+        }
+        try {
+            for (String line : Files.readAllLines(status)) {
+                if (line.startsWith("VmHWM:")) {
+                    return Long.parseLong(line.replaceAll("[^0-9]", ""));
+                }
+            }
+        } catch (IOException | NumberFormatException ignored) {
+            // 读取失败时只报告堆峰值
+        }
+        return -1;
+    }
+}
@@ -0,0 +1,88 @@
+package com.harmony.agent.test.bench;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.attribute.PosixFilePermissions;
+
+/**
+ * clang-tidy / semgrep 桩可执行文件（测试工具，需要 POSIX sh）
+ *
+ * - clang-tidy：对命令行最后一个参数（源文件）按固定间隔输出 N 条 warning
+ * - semgrep：对每个 .c/.cpp/.h 参数输出 N 条 JSON 结果
+ *
+ * 两者都支持 --version，并在每次调用时 sleep 指定的毫秒数，用于模拟外部工具开销。
+ */
+public class StubToolchain {
+
+    private final Path clangTidy;
+    private final Path semgrep;
+
+    private StubToolchain(Path clangTidy, Path semgrep) {
+        this.clangTidy = clangTidy;
+        this.semgrep = semgrep;
+    }
+
+    /**
+     * 在目录中写出桩脚本
+     *
+     * @param dir 输出目录
+     * @param delayMs 每次调用的延迟
+     * @param findingsPerFile 每个文件输出的结果数
+     */
+    public static StubToolchain install(Path dir, long delayMs, int findingsPerFile) throws IOException {
+        Files.createDirectories(dir);
+        String sleep = delayMs > 0 ? String.format("sleep %d.%03d%n", delayMs / 1000, delayMs % 1000) : "";
+
+        String clang = "#!/bin/sh\n"
+            + "if [ \"$1\" = \"--version\" ]; then echo \"LLVM version 17.0.0 (offline stub)\"; exit 0; fi\n"
+            + "for last; do :; done\n"
+            + sleep
+            + "i=1\n"
+            + "while [ $i -le " + findingsPerFile + " ]; do\n"
+            + "  echo \"$last:$((i * 10)):5: warning: Call to function 'strcpy' is insecure"
+            + " [clang-analyzer-security.insecureAPI.strcpy]\"\n"
+            + "  i=$((i + 1))\n"
+            + "done\n"
+            + "exit 0\n";
+
+        String semgrep = "#!/bin/sh\n"
+            + "if [ \"$1\" = \"--version\" ]; then echo \"1.50.0\"; exit 0; fi\n"
+            + sleep
+            + "sep=''\n"
+            + "printf '{\"results\":['\n"
+            + "for arg; do\n"
+            + "  case \"$arg\" in\n"
+            + "    *.c|*.cpp|*.cc|*.h|*.hpp)\n"
+            + "      i=1\n"
+            + "      while [ $i -le " + findingsPerFile + " ]; do\n"
+            + "        printf '%s{\"check_id\":\"buffer-overflow-strcpy\",\"path\":\"%s\",\"start\":{\"line\":%d,\"col\":5},"
+            + "\"end\":{\"line\":%d,\"col\":30},\"extra\":{\"message\":\"Unsafe strcpy\",\"severity\":\"ERROR\",\"lines\":\"strcpy(dst, src);\"}}'"
+            + " \"$sep\" \"$arg\" $((i * 10 + 3)) $((i * 10 + 3))\n"
+            + "        sep=','\n"
+            + "        i=$((i + 1))\n"
+            + "      done\n"
+            + "      ;;\n"
+            + "  esac\n"
+            + "done\n"
+            + "printf '],\"errors\":[]}\\n'\n"
+            + "exit 0\n";
+
+        return new StubToolchain(writeExecutable(dir.resolve("clang-tidy"), clang),
+            writeExecutable(dir.resolve("semgrep"), semgrep));
+    }
+
+    public Path getClangTidy() {
+        return clangTidy;
+    }
+
+    public Path getSemgrep() {
+        return semgrep;
+    }
+
+    private static Path writeExecutable(Path path, String script) throws IOException {
+        Files.writeString(path, script);
+        Files.setPosixFilePermissions(path, PosixFilePermissions.fromString("rwxr-xr-x"));
+        return path;
+    }
+}
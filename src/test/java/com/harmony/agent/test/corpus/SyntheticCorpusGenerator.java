@@ -0,0 +1,555 @@
+package com.harmony.agent.test.corpus;
+
+import com.google.gson.Gson;
+import com.google.gson.GsonBuilder;
+
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.List;
+import java.util.Random;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+import java.util.stream.Collectors;
+import java.util.stream.IntStream;
+
+/**
+ * 确定性的 C/C++ 合成语料生成器（测试工具）
+ *
+ * 按给定种子生成可复现的项目树，用于扫描、分析和增量模式的离线规模测试：
+ * <pre>
+ * root/
+ *   include/common.h
+ *   include/&lt;module&gt;/&lt;module&gt;.h      模块头文件（相互包含，形成包含层次）
+ *   src/&lt;module&gt;/file_NNNNN.c|.cpp
+ *   compile_commands.json                 CMake 风格（-o CMakeFiles/&lt;module&gt;.dir/...）
+ *   corpus-manifest.json                  植入漏洞的真值清单（文件、行号、规则）
+ * </pre>
+ *
+ * 植入的漏洞模式与 RegexAnalyzer 规则和 rules/*.yml 中的 Semgrep 规则一一对应；
+ * 每个文件使用独立的派生种子，生成结果与并行度无关。.cpp 文件按 compile_commands.json
+ * 中的 -std=c++17 可编译：分配结果显式转换、字符串字面量绑定到 const char*、成员函数所属的
+ * Handler 结构体先行声明。
+ *
+ * 命令行用法（test classpath）：
+ *   mvn -q test-compile exec:java -Dexec.classpathScope=test \
+ *     -Dexec.mainClass=com.harmony.agent.test.corpus.SyntheticCorpusGenerator \
+ *     -Dexec.args="--files 10000 --out /tmp/corpus --seed 42"
+ */
+public class SyntheticCorpusGenerator {
+
+    public static final String MANIFEST_FILE = "corpus-manifest.json";
+
+    // C 中 void* 隐式转换的分配语句；C++ 需要显式转换
+    private static final Pattern C_ALLOCATION =
+        Pattern.compile("^(\\s*)((?:char|struct record) \\*)(\\w+ = )(malloc|calloc)\\(");
+
+    private final Config config;
+
+    public SyntheticCorpusGenerator(Config config) {
+        this.config = config;
+    }
+
+    /**
+     * 生成参数
+     */
+    public static class Config {
+        long seed = 42;
+        int fileCount = 100;
+        int moduleCount = 0;          // 0 表示按文件数自动取 sqrt(files)
+        int minLines = 80;
+        int maxLines = 400;
+        double vulnerabilityRate = 0.3; // 每个函数植入一个漏洞的概率
+        double cppRatio = 0.25;
+
+        public Config seed(long seed) { this.seed = seed; return this; }
+        public Config files(int fileCount) { this.fileCount = fileCount; return this; }
+        public Config modules(int moduleCount) { this.moduleCount = moduleCount; return this; }
+        public Config lines(int minLines, int maxLines) { this.minLines = minLines; this.maxLines = maxLines; return this; }
+        public Config vulnerabilityRate(double rate) { this.vulnerabilityRate = rate; return this; }
+        public Config cppRatio(double ratio) { this.cppRatio = ratio; return this; }
+
+        int effectiveModules() {
+            return moduleCount > 0 ? moduleCount : Math.max(1, (int) Math.sqrt(fileCount));
+        }
+    }
+
+    /**
+     * 植入的漏洞（真值）
+     */
+    public static class SeededVulnerability {
+        public final String file;       // 相对根目录
+        public final int line;
+        public final String ruleId;     // rules/*.yml 中的规则 ID（无对应规则时为 null）
+        public final String regexRuleId; // RegexAnalyzer 规则 ID（无对应规则时为 null）
+
+        SeededVulnerability(String file, int line, String ruleId, String regexRuleId) {
+            this.file = file;
+            this.line = line;
+            this.ruleId = ruleId;
+            this.regexRuleId = regexRuleId;
+        }
+    }
+
+    /**
+     * 生成结果清单
+     */
+    public static class Manifest {
+        public long seed;
+        public int files;
+        public long totalLines;
+        public List<String> sources = new ArrayList<>();
+        public List<SeededVulnerability> vulnerabilities = new ArrayList<>();
+
+        public static Manifest read(Path root) throws IOException {
+            return new Gson().fromJson(Files.readString(root.resolve(MANIFEST_FILE)), Manifest.class);
+        }
+    }
+
+    /**
+     * 漏洞模板：hit 为命中行在 lines 中的下标
+     */
+    private record Template(String ruleId, String regexRuleId, int hit, String... lines) {
+    }
+
+    private static final List<Template> TEMPLATES = List.of(
+        new Template("buffer-overflow-strcpy", "buffer-overflow-strcpy", 1,
+            "    char dst[32];",
+            "    strcpy(dst, input);",
+            "    total += dst[0];"),
+        new Template("buffer-overflow-strcat", "buffer-overflow-strcat", 1,
+            "    char path[64] = \"/var/data/\";",
+            "    strcat(path, input);",
+            "    total += (int) path[0];"),
+        new Template("buffer-overflow-sprintf", "buffer-overflow-sprintf", 1,
+            "    char msg[32];",
+            "    sprintf(msg, \"%s:%d\", input, len);",
+            "    total += msg[0];"),
+        new Template("buffer-overflow-gets", "buffer-overflow-gets", 1,
+            "    char line[128];",
+            "    gets(line);",
+            "    total += line[0];"),
+        new Template("format-string-vulnerability", "format-string-printf", 0,
+            "    printf(input);"),
+        new Template("command-injection", "command-injection-system", 0,
+            "    system(input);"),
+        new Template("command-injection", "command-injection-popen", 0,
+            "    FILE *pipe = popen(input, \"r\"); if (pipe) { pclose(pipe); }"),
+        new Template("weak-random-rand", "weak-random-rand", 0,
+            "    int token = rand();",
+            "    total += token;"),
+        new Template("weak-hash-md5", "weak-crypto-md5", 1,
+            "    unsigned char digest[16];",
+            "    MD5((const unsigned char *) input, len, digest);",
+            "    total += digest[0];"),
+        new Template("memory-leak-malloc", "memory-leak-malloc", 0,
+            "    char *copy = malloc(len + 1);",
+            "    if (copy == NULL) { return -1; }",
+            "    memcpy(copy, input, len);",
+            "    total += copy[0];"),
+        new Template("double-free", null, 3,
+            "    char *tmp = calloc(len + 1, 1);",
+            "    if (tmp == NULL) { return -1; }",
+            "    free(tmp);",
+            "    free(tmp);"),
+        new Template("use-after-free", null, 3,
+            "    struct record *rec = calloc(1, 64);",
+            "    if (rec == NULL) { return -1; }",
+            "    free(rec);",
+            "    total += rec->id;"),
+        new Template("race-condition-check-then-use", "toctou-access-open", 0,
+            "    if (access(input, R_OK) == 0) { int fd = open(input, O_RDONLY); total += fd; }"),
+        new Template("path-traversal", "path-traversal", 0,
+            "    FILE *cfg = fopen(\"../etc/app.conf\", \"r\"); if (cfg) { fclose(cfg); }"),
+        new Template("hardcoded-password", null, 0,
+            "    char *db_password = \"hunter2\";",
+            "    total += db_password[0];"),
+        new Template("sql-injection", "buffer-overflow-sprintf", 1,
+            "    char query[256];",
+            "    sprintf(query, \"SELECT * FROM users WHERE name = '%s'\", input);",
+            "    total += query[0];"),
+        new Template(null, "integer-overflow-multiply", 0,
+            "    struct record *items = calloc(1, len * sizeof(struct record));",
+            "    if (items) { total += items[0].id; free(items); }")
+    );
+
+    /**
+     * 生成语料
+     */
+    public Manifest generate(Path root) throws IOException {
+        Files.createDirectories(root);
+        int modules = config.effectiveModules();
+
+        writeCommonHeader(root);
+        for (int m = 0; m < modules; m++) {
+            writeModuleHeader(root, m);
+        }
+
+        // 每个文件独立派生种子：结果与并行度无关
+        List<FileResult> results;
+        try {
+            results = IntStream.range(0, config.fileCount).parallel()
+                .mapToObj(i -> writeSource(root, i, modules))
+                .sorted(Comparator.comparingInt(r -> r.index))
+                .collect(Collectors.toList());
+        } catch (UncheckedIOException e) {
+            throw e.getCause();
+        }
+
+        Manifest manifest = new Manifest();
+        manifest.seed = config.seed;
+        manifest.files = config.fileCount;
+        for (FileResult result : results) {
+            manifest.sources.add(result.relativePath);
+            manifest.totalLines += result.lines;
+            manifest.vulnerabilities.addAll(result.vulnerabilities);
+        }
+
+        writeCompileCommands(root, results);
+        Files.writeString(root.resolve(MANIFEST_FILE),
+            new GsonBuilder().setPrettyPrinting().create().toJson(manifest));
+        return manifest;
+    }
+
+    /**
+     * 修改确定性选出的一部分源文件（在文件末尾追加函数），用于增量模式测试
+     *
+     * @return 被修改文件的相对路径
+     */
+    public static List<String> mutate(Path root, double fraction, long seed) throws IOException {
+        Manifest manifest = Manifest.read(root);
+        List<String> sources = new ArrayList<>(manifest.sources);
+        Collections.shuffle(sources, new Random(seed));
+
+        int count = (int) Math.ceil(sources.size() * fraction);
+        List<String> changed = new ArrayList<>(sources.subList(0, Math.min(count, sources.size())));
+        Collections.sort(changed);
+        for (String relative : changed) {
+            Path file = root.resolve(relative);
+            Files.writeString(file, Files.readString(file)
+                + "\nint mutated_" + Long.toHexString(seed) + "(int value) {\n    return value ^ 0x5a;\n}\n");
+        }
+        return changed;
+    }
+
+    private static final class FileResult {
+        final int index;
+        final int module;
+        final String relativePath;
+        final boolean cpp;
+        final int lines;
+        final List<SeededVulnerability> vulnerabilities;
+
+        FileResult(int index, int module, String relativePath, boolean cpp, int lines,
+                   List<SeededVulnerability> vulnerabilities) {
+            this.index = index;
+            this.module = module;
+            this.relativePath = relativePath;
+            this.cpp = cpp;
+            this.lines = lines;
+            this.vulnerabilities = vulnerabilities;
+        }
+    }
+
+    private FileResult writeSource(Path root, int index, int modules) {
+        Random random = new Random(config.seed * 1_000_003L + index);
+        int module = index % modules;
+        boolean cpp = random.nextDouble() < config.cppRatio;
+        String relative = String.format("src/%s/file_%05d.%s", moduleName(module), index, cpp ? "cpp" : "c");
+        int targetLines = config.minLines + random.nextInt(Math.max(1, config.maxLines - config.minLines + 1));
+
+        List<String> lines = new ArrayList<>(targetLines + 32);
+        List<SeededVulnerability> vulnerabilities = new ArrayList<>();
+
+        lines.add("/* Synthetic corpus file " + index + " (seed " + config.seed + ") */");
+        lines.add("#include <fcntl.h>");
+        lines.add("#include <unistd.h>");
+        lines.add("#include \"common.h\"");
+        lines.add("#include \"" + moduleName(module) + "/" + moduleName(module) + ".h\"");
+        int extraIncludes = random.nextInt(3);
+        for (int k = 0; k < extraIncludes && modules > 1; k++) {
+            int other = random.nextInt(modules);
+            if (other != module) {
+                lines.add("#include \"" + moduleName(other) + "/" + moduleName(other) + ".h\"");
+            }
+        }
+        lines.add("");
+        lines.add("static int table_" + index + "[16] = { 1, 2, 3, 5, 8, 13, 21, 34 };");
+        lines.add("");
+        if (cpp) {
+            lines.add("namespace " + moduleName(module) + " {");
+            lines.add("");
+        }
+        int functionsStart = lines.size();
+
+        int function = 0;
+        while (lines.size() < targetLines) {
+            String name = cpp
+                ? "Handler" + index + "::process_" + function
+                : moduleName(module) + "_fn_" + index + "_" + function;
+            Template template = random.nextDouble() < config.vulnerabilityRate
+                ? TEMPLATES.get(random.nextInt(TEMPLATES.size()))
+                : null;
+            writeFunction(lines, name, index, random, template, relative, vulnerabilities, cpp);
+            function++;
+        }
+
+        if (cpp) {
+            lines.add("}  // namespace " + moduleName(module));
+
+            // 声明成员函数所属的结构体；插入在函数之前，植入漏洞的行号随之后移
+            List<String> declaration = new ArrayList<>();
+            declaration.add("struct Handler" + index + " {");
+            for (int k = 0; k < function; k++) {
+                declaration.add("    static int process_" + k + "(const char *input, size_t len);");
+            }
+            declaration.add("};");
+            declaration.add("");
+            lines.addAll(functionsStart, declaration);
+            int shift = declaration.size();
+            vulnerabilities.replaceAll(v -> new SeededVulnerability(v.file, v.line + shift, v.ruleId, v.regexRuleId));
+        }
+
+        try {
+            Path file = root.resolve(relative);
+            Files.createDirectories(file.getParent());
+            Files.write(file, lines, StandardCharsets.UTF_8);
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+        return new FileResult(index, module, relative, cpp, lines.size(), vulnerabilities);
+    }
+
+    /**
+     * 写出一个函数：从几种常见形状中选择函数体，并在随机位置插入漏洞模板
+     */
+    private static void writeFunction(List<String> lines, String name, int fileIndex, Random random,
+                                      Template template, String relative, List<SeededVulnerability> out,
+                                      boolean cpp) {
+        lines.add("int " + name + "(const char *input, size_t len) {");
+        lines.add("    int total = 0;");
+
+        List<String> body = switch (random.nextInt(5)) {
+            case 0 -> checksumLoop(random, fileIndex);
+            case 1 -> stateMachine(random);
+            case 2 -> cleanupPath(random, cpp);
+            case 3 -> validation(random);
+            default -> nestedLoops(random, fileIndex);
+        };
+
+        // 模板只放在函数体首尾，避免声明出现在 case/标签之后或被 goto 跨越
+        int insertAt = template == null ? -1 : (random.nextBoolean() ? 0 : body.size());
+        for (int i = 0; i <= body.size(); i++) {
+            if (i == insertAt) {
+                int hitLine = lines.size() + template.hit() + 1;
+                for (String line : template.lines()) {
+                    lines.add(cpp ? cppLine(line) : line);
+                }
+                out.add(new SeededVulnerability(relative, hitLine, template.ruleId(), template.regexRuleId()));
+            }
+            if (i < body.size()) {
+                lines.add(body.get(i));
+            }
+        }
+
+        lines.add("    return total;");
+        lines.add("}");
+        lines.add("");
+    }
+
+    private static List<String> checksumLoop(Random random, int fileIndex) {
+        int mult = 3 + random.nextInt(29);
+        return List.of(
+            "    for (size_t i = 0; i < len; i++) {",
+            "        total = total * " + mult + " + (unsigned char) input[i];",
+            "        total ^= table_" + fileIndex + "[i % 16];",
+            "    }");
+    }
+
+    private static List<String> stateMachine(Random random) {
+        List<String> body = new ArrayList<>();
+        int states = 3 + random.nextInt(4);
+        body.add("    int state = 0;");
+        body.add("    for (size_t i = 0; i < len; i++) {");
+        body.add("        switch (state) {");
+        for (int s = 0; s < states; s++) {
+            body.add("            case " + s + ":");
+            body.add("                if (input[i] == '" + (char) ('a' + s) + "') { state = " + ((s + 1) % states) + "; }");
+            body.add("                total += " + (s + 1) + ";");
+            body.add("                break;");
+        }
+        body.add("            default:");
+        body.add("                state = 0;");
+        body.add("        }");
+        body.add("    }");
+        return body;
+    }
+
+    private static List<String> cleanupPath(Random random, boolean cpp) {
+        int size = 16 << random.nextInt(4);
+        return List.of(
+            "    char *scratch = " + (cpp ? "(char *) " : "") + "calloc(" + size + ", 1);",
+            "    if (scratch == NULL) {",
+            "        goto out;",
+            "    }",
+            "    if (len >= " + size + ") {",
+            "        total = -1;",
+            "        goto cleanup;",
+            "    }",
+            "    memcpy(scratch, input, len);",
+            "    total = (int) scratch[0];",
+            "cleanup:",
+            "    free(scratch);",
+            "out: ;");
+    }
+
+    /**
+     * C 语句的 C++17 写法：分配结果显式转换，字符串字面量绑定到 const char*（行数不变）
+     */
+    static String cppLine(String line) {
+        Matcher allocation = C_ALLOCATION.matcher(line);
+        if (allocation.find()) {
+            return allocation.replaceFirst("$1$2$3($2) $4(");
+        }
+        return line.replace("    char *db_password = \"", "    const char *db_password = \"");
+    }
+
+    private static List<String> validation(Random random) {
+        int limit = 8 + random.nextInt(120);
+        return List.of(
+            "    if (input == NULL || len == 0) {",
+            "        return -1;",
+            "    }",
+            "    if (len > " + limit + ") {",
+            "        return -2;",
+            "    }",
+            "    total = (int) len + (input[0] == '#' ? 1 : 0);");
+    }
+
+    private static List<String> nestedLoops(Random random, int fileIndex) {
+        int rows = 2 + random.nextInt(6);
+        return List.of(
+            "    for (int r = 0; r < " + rows + "; r++) {",
+            "        for (size_t c = 0; c < len && c < 16; c++) {",
+            "            if ((r + (int) c) % 3 == 0) {",
+            "                total += table_" + fileIndex + "[c] * r;",
+            "            } else if (input[c] == ' ') {",
+            "                total -= r;",
+            "            }",
+            "        }",
+            "    }");
+    }
+
+    private void writeCommonHeader(Path root) throws IOException {
+        Path include = root.resolve("include");
+        Files.createDirectories(include);
+        Files.writeString(include.resolve("common.h"), String.join("\n",
+            "#ifndef SYNTH_COMMON_H",
+            "#define SYNTH_COMMON_H",
+            "#include <stdio.h>",
+            "#include <stdlib.h>",
+            "#include <string.h>",
+            "",
+            "struct record {",
+            "    int id;",
+            "    char name[32];",
+            "    struct record *next;",
+            "};",
+            "",
+            "unsigned char *MD5(const unsigned char *data, size_t len, unsigned char *md);",
+            "",
+            "#endif",
+            ""));
+    }
+
+    private void writeModuleHeader(Path root, int module) throws IOException {
+        String name = moduleName(module);
+        Path dir = root.resolve("include").resolve(name);
+        Files.createDirectories(dir);
+
+        List<String> header = new ArrayList<>();
+        String guard = "SYNTH_" + name.toUpperCase() + "_H";
+        header.add("#ifndef " + guard);
+        header.add("#define " + guard);
+        header.add("#include \"common.h\"");
+        // 模块按编号依赖前一个模块，形成多层包含链
+        if (module > 0) {
+            String parent = moduleName((module - 1) / 2);
+            header.add("#include \"" + parent + "/" + parent + ".h\"");
+        }
+        header.add("");
+        header.add("#define " + name.toUpperCase() + "_VERSION " + (module + 1));
+        header.add("int " + name + "_init(void);");
+        header.add("");
+        header.add("#endif");
+        header.add("");
+        Files.write(dir.resolve(name + ".h"), header, StandardCharsets.UTF_8);
+    }
+
+    private void writeCompileCommands(Path root, List<FileResult> results) throws IOException {
+        Path absoluteRoot = root.toAbsolutePath().normalize();
+        String include = absoluteRoot.resolve("include").toString();
+        String buildDir = absoluteRoot.resolve("build").toString();
+        Files.createDirectories(absoluteRoot.resolve("build"));
+
+        StringBuilder json = new StringBuilder(results.size() * 320).append("[\n");
+        for (int i = 0; i < results.size(); i++) {
+            FileResult result = results.get(i);
+            String module = moduleName(result.module);
+            String source = absoluteRoot.resolve(result.relativePath).toString();
+            String command = (result.cpp ? "/usr/bin/c++ -std=c++17" : "/usr/bin/cc -std=c11")
+                + " -I" + include + " -DMODULE_" + module.toUpperCase() + "=1 -O2"
+                + " -o CMakeFiles/" + module + ".dir/" + result.relativePath + ".o"
+                + " -c " + source;
+
+            json.append("  {\n")
+                .append("    \"directory\": \"").append(escape(buildDir)).append("\",\n")
+                .append("    \"command\": \"").append(escape(command)).append("\",\n")
+                .append("    \"file\": \"").append(escape(source)).append("\"\n")
+                .append(i + 1 < results.size() ? "  },\n" : "  }\n");
+        }
+        json.append("]\n");
+        Files.writeString(root.resolve("compile_commands.json"), json);
+    }
+
+    private static String escape(String value) {
+        return value.replace("\\", "\\\\").replace("\"", "\\\"");
+    }
+
+    private static String moduleName(int module) {
+        return String.format("mod%03d", module);
+    }
+
+    /**
+     * 命令行入口
+     */
+    public static void main(String[] args) throws IOException {
+        Config config = new Config();
+        Path out = Paths.get("target", "synthetic-corpus");
+        for (int i = 0; i < args.length; i++) {
+            switch (args[i]) {
+                case "--files" -> config.files(Integer.parseInt(args[++i]));
+                case "--modules" -> config.modules(Integer.parseInt(args[++i]));
+                case "--seed" -> config.seed(Long.parseLong(args[++i]));
+                case "--min-lines" -> config.minLines = Integer.parseInt(args[++i]);
+                case "--max-lines" -> config.maxLines = Integer.parseInt(args[++i]);
+                case "--vuln-rate" -> config.vulnerabilityRate(Double.parseDouble(args[++i]));
+                case "--cpp-ratio" -> config.cppRatio(Double.parseDouble(args[++i]));
+                case "--out" -> out = Paths.get(args[++i]);
+                default -> throw new IllegalArgumentException("Unknown option: " + args[i]);
+            }
+        }
+
+        long start = System.nanoTime();
+        Manifest manifest = new SyntheticCorpusGenerator(config).generate(out);
+        System.out.printf("Generated %d files (%d lines, %d seeded vulnerabilities) in %s [%d ms]%n",
+            manifest.files, manifest.totalLines, manifest.vulnerabilities.size(),
+            out.toAbsolutePath(), (System.nanoTime() - start) / 1_000_000);
+    }
+}
@@ -0,0 +1,143 @@
+package com.harmony.agent.test.corpus;
+
+import com.google.gson.JsonArray;
+import com.google.gson.JsonParser;
+import com.harmony.agent.core.analyzer.RegexAnalyzer;
+import com.harmony.agent.core.model.SecurityIssue;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.Set;
+import java.util.stream.Collectors;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * SyntheticCorpusGenerator 单元测试
+ */
+@DisplayName("单元测试: SyntheticCorpusGenerator")
+class SyntheticCorpusGeneratorTest {
+
+    @TempDir
+    Path tempDir;
+
+    private SyntheticCorpusGenerator.Config smallConfig(long seed) {
+        return new SyntheticCorpusGenerator.Config()
+            .seed(seed)
+            .files(40)
+            .lines(60, 160)
+            .vulnerabilityRate(0.4);
+    }
+
+    @Test
+    @DisplayName("相同种子生成完全相同的语料")
+    void testDeterministic() throws Exception {
+        Path first = tempDir.resolve("a");
+        Path second = tempDir.resolve("b");
+        SyntheticCorpusGenerator.Manifest m1 = new SyntheticCorpusGenerator(smallConfig(7)).generate(first);
+        SyntheticCorpusGenerator.Manifest m2 = new SyntheticCorpusGenerator(smallConfig(7)).generate(second);
+
+        assertEquals(m1.sources, m2.sources);
+        assertEquals(m1.totalLines, m2.totalLines);
+        assertEquals(m1.vulnerabilities.size(), m2.vulnerabilities.size());
+        for (String source : m1.sources) {
+            assertEquals(Files.readString(first.resolve(source)), Files.readString(second.resolve(source)),
+                "File differs between runs: " + source);
+        }
+
+        Path third = tempDir.resolve("c");
+        SyntheticCorpusGenerator.Manifest other = new SyntheticCorpusGenerator(smallConfig(8)).generate(third);
+        assertNotEquals(Files.readString(first.resolve(m1.sources.get(0))),
+            Files.readString(third.resolve(other.sources.get(0))));
+    }
+
+    @Test
+    @DisplayName("compile_commands.json 覆盖所有源文件")
+    void testCompileCommands() throws Exception {
+        SyntheticCorpusGenerator.Manifest manifest = new SyntheticCorpusGenerator(smallConfig(1)).generate(tempDir);
+
+        JsonArray entries = JsonParser.parseString(
+            Files.readString(tempDir.resolve("compile_commands.json"))).getAsJsonArray();
+        assertEquals(manifest.files, entries.size());
+
+        for (int i = 0; i < entries.size(); i++) {
+            String file = entries.get(i).getAsJsonObject().get("file").getAsString();
+            assertTrue(Files.exists(Path.of(file)), "Missing source: " + file);
+            assertTrue(entries.get(i).getAsJsonObject().get("command").getAsString().contains(" -c " + file));
+        }
+    }
+
+    @Test
+    @DisplayName("RegexAnalyzer 在清单记录的行号上检出植入的漏洞")
+    void testSeededVulnerabilitiesDetected() throws Exception {
+        SyntheticCorpusGenerator.Manifest manifest = new SyntheticCorpusGenerator(smallConfig(3)).generate(tempDir);
+        assertFalse(manifest.vulnerabilities.isEmpty());
+
+        RegexAnalyzer analyzer = new RegexAnalyzer();
+        for (String source : manifest.sources) {
+            Path file = tempDir.resolve(source);
+            Set<String> found = analyzer.analyze(file).stream()
+                .map(SecurityIssue::getId)
+                .collect(Collectors.toSet());
+
+            for (SyntheticCorpusGenerator.SeededVulnerability vuln : manifest.vulnerabilities) {
+                if (vuln.file.equals(source) && vuln.regexRuleId != null) {
+                    String expectedId = vuln.regexRuleId + "-" + file.getFileName() + "-" + vuln.line;
+                    assertTrue(found.contains(expectedId), "Not detected: " + expectedId);
+                }
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("C++ 文件先声明 Handler 结构体，分配结果显式转换，植入漏洞的行号仍然准确")
+    void testCppSourcesAreCpp17() throws Exception {
+        SyntheticCorpusGenerator.Manifest manifest = new SyntheticCorpusGenerator(smallConfig(4).cppRatio(1.0))
+            .generate(tempDir);
+
+        RegexAnalyzer analyzer = new RegexAnalyzer();
+        for (String source : manifest.sources) {
+            assertTrue(source.endsWith(".cpp"));
+            Path file = tempDir.resolve(source);
+            String content = Files.readString(file);
+            String handler = "Handler" + source.replaceAll(".*file_0*(\\d+)\\.cpp", "$1");
+            int declaration = content.indexOf("struct " + handler + " {");
+            assertTrue(declaration >= 0, "Missing declaration: " + source);
+            assertTrue(declaration < content.indexOf("int " + handler + "::process_0("));
+            assertFalse(content.matches("(?s).*\\*\\w+ = (malloc|calloc)\\(.*"), "Implicit void* conversion: " + source);
+            assertFalse(content.contains("    char *db_password"));
+
+            Set<String> found = analyzer.analyze(file).stream()
+                .map(SecurityIssue::getId)
+                .collect(Collectors.toSet());
+            for (SyntheticCorpusGenerator.SeededVulnerability vuln : manifest.vulnerabilities) {
+                if (vuln.file.equals(source) && vuln.regexRuleId != null) {
+                    assertTrue(found.contains(vuln.regexRuleId + "-" + file.getFileName() + "-" + vuln.line));
+                }
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("mutate 按种子确定性地修改部分文件")
+    void testMutate() throws Exception {
+        new SyntheticCorpusGenerator(smallConfig(5)).generate(tempDir);
+        String before = Files.readString(tempDir.resolve(
+            SyntheticCorpusGenerator.Manifest.read(tempDir).sources.get(0)));
+
+        List<String> changed = SyntheticCorpusGenerator.mutate(tempDir, 0.1, 99);
+        assertEquals(4, changed.size());
+        for (String relative : changed) {
+            assertTrue(Files.readString(tempDir.resolve(relative)).contains("mutated_"));
+        }
+
+        String first = SyntheticCorpusGenerator.Manifest.read(tempDir).sources.get(0);
+        if (!changed.contains(first)) {
+            assertEquals(before, Files.readString(tempDir.resolve(first)));
+        }
+    }
+}